@@ -42,6 +42,9 @@ namespace common
         /// <summary> Number of epochs. </summary>
         size_t numEpochs;
 
+        /// <summary> Number of threads used by matrix multiplication (0 means one per core). </summary>
+        size_t numThreads;
+
         /// <summary> Generate verbose output. </summary>
         bool verbose;
     };
@@ -21,6 +21,13 @@ namespace common
             "The number of training epochs to perform",
             1);
 
+        parser.AddOption(
+            numThreads,
+            "numThreads",
+            "nt",
+            "The number of threads used by matrix multiplication (0 means one per core)",
+            1);
+
         parser.AddOption(
             verbose,
             "verbose",
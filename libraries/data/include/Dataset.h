@@ -13,6 +13,9 @@
 #include "Example.h"
 #include "ExampleIterator.h"
 
+// math
+#include "SparseMatrix.h"
+
 // utilities
 #include "AbstractInvoker.h"
 #include "TypeTraits.h"
@@ -277,6 +280,22 @@ namespace data
     /// <returns> A Dataset. </returns>
     template <typename ExampleType>
     Dataset<ExampleType> MakeDataset(ExampleIterator<ExampleType> exampleIterator);
+
+    /// <summary>
+    /// Copies the data vectors of a dataset into a compressed sparse matrix, visiting only their
+    /// nonzeros, so sparse data is never densified. A row major (CSR) matrix has one row per example
+    /// and a column major (CSC) matrix has one column per example.
+    /// </summary>
+    ///
+    /// <typeparam name="ElementType"> The matrix element type. </typeparam>
+    /// <typeparam name="layout"> The matrix layout. </typeparam>
+    /// <typeparam name="ExampleType"> The example type. </typeparam>
+    /// <param name="dataset"> The dataset. </param>
+    /// <param name="numFeatures"> The number of features to copy from each data vector, or 0 to use dataset.NumFeatures(). Features beyond this prefix are ignored. </param>
+    ///
+    /// <returns> The sparse matrix. </returns>
+    template <typename ElementType, math::MatrixLayout layout, typename ExampleType>
+    math::SparseMatrix<ElementType, layout> MakeSparseMatrix(const Dataset<ExampleType>& dataset, size_t numFeatures = 0);
 }
 }
 
@@ -220,5 +220,57 @@ namespace data
     {
         return Dataset<ExampleType>(std::move(exampleIterator));
     }
+
+    namespace DatasetDetail
+    {
+        // CopyAs constructs its return type from an iterator over the nonzeros of the data vector
+        struct NonzeroList
+        {
+            template <typename IndexValueIteratorType>
+            NonzeroList(IndexValueIteratorType iterator)
+            {
+                while (iterator.IsValid())
+                {
+                    nonzeros.push_back(iterator.Get());
+                    iterator.Next();
+                }
+            }
+
+            std::vector<IndexValue> nonzeros;
+        };
+    }
+
+    template <typename ElementType, math::MatrixLayout layout, typename ExampleType>
+    math::SparseMatrix<ElementType, layout> MakeSparseMatrix(const Dataset<ExampleType>& dataset, size_t numFeatures)
+    {
+        if (numFeatures == 0)
+        {
+            numFeatures = dataset.NumFeatures();
+        }
+
+        std::vector<size_t> offsets;
+        std::vector<size_t> indices;
+        std::vector<ElementType> values;
+        offsets.reserve(dataset.NumExamples() + 1);
+        offsets.push_back(0);
+        for (size_t i = 0; i < dataset.NumExamples(); ++i)
+        {
+            auto list = dataset.GetExample(i).GetDataVector().template CopyAs<DatasetDetail::NonzeroList>();
+            for (const auto& indexValue : list.nonzeros)
+            {
+                if (indexValue.index >= numFeatures)
+                {
+                    break;
+                }
+                indices.push_back(indexValue.index);
+                values.push_back(static_cast<ElementType>(indexValue.value));
+            }
+            offsets.push_back(indices.size());
+        }
+
+        auto numRows = layout == math::MatrixLayout::rowMajor ? dataset.NumExamples() : numFeatures;
+        auto numColumns = layout == math::MatrixLayout::rowMajor ? numFeatures : dataset.NumExamples();
+        return { numRows, numColumns, std::move(offsets), std::move(indices), std::move(values) };
+    }
 }
 }
@@ -11,4 +11,5 @@
 namespace ell
 {
 void DatasetCastingTests();
+void DatasetSparseMatrixTests();
 }
\ No newline at end of file
@@ -66,4 +66,32 @@ void DatasetCastingTests()
     DatasetCastingTestDispatch<data::AutoSupervisedExample>();
     DatasetCastingTestDispatch<data::DenseSupervisedExample>();
 }
-}
\ No newline at end of file
+
+template <typename ExampleType, math::MatrixLayout layout>
+void DatasetSparseMatrixTest()
+{
+    using DataVectorType = typename ExampleType::DataVectorType;
+    data::Dataset<ExampleType> dataset;
+    dataset.AddExample(ExampleType(std::make_shared<DataVectorType>(DataVectorType{ 1, 0, 2, 0, 0 }), data::WeightLabel{ 1, 1 }));
+    dataset.AddExample(ExampleType(std::make_shared<DataVectorType>(DataVectorType{ 0, 0, 0 }), data::WeightLabel{ 1, 1 }));
+    dataset.AddExample(ExampleType(std::make_shared<DataVectorType>(DataVectorType{ 0, 3, 0, 0, 4 }), data::WeightLabel{ 1, 1 }));
+
+    auto matrix = data::MakeSparseMatrix<float, layout>(dataset);
+    auto example = [&](size_t i, size_t j) { return layout == math::MatrixLayout::rowMajor ? matrix(i, j) : matrix(j, i); };
+
+    bool isCorrect = matrix.NumIntervals() == 3 && matrix.NumNonzeros() == 4 && example(0, 0) == 1 && example(0, 2) == 2 && example(2, 1) == 3 && example(2, 4) == 4 && example(1, 1) == 0;
+    auto prefix = data::MakeSparseMatrix<float, layout>(dataset, 3);
+    isCorrect = isCorrect && prefix.NumNonzeros() == 3;
+
+    std::string name = typeid(ExampleType).name();
+    testing::ProcessTest("MakeSparseMatrix(Dataset<" + name + ">) [" + (layout == math::MatrixLayout::rowMajor ? "CSR" : "CSC") + "]", isCorrect);
+}
+
+void DatasetSparseMatrixTests()
+{
+    DatasetSparseMatrixTest<data::AutoSupervisedExample, math::MatrixLayout::rowMajor>();
+    DatasetSparseMatrixTest<data::AutoSupervisedExample, math::MatrixLayout::columnMajor>();
+    DatasetSparseMatrixTest<data::DenseSupervisedExample, math::MatrixLayout::rowMajor>();
+    DatasetSparseMatrixTest<data::Example<data::SparseDoubleDataVector, data::WeightLabel>, math::MatrixLayout::columnMajor>();
+}
+}
@@ -27,6 +27,7 @@ int main()
     IteratorTests();
     ExampleCopyAsTests();
     DatasetCastingTests();
+    DatasetSparseMatrixTests();
     DataVectorParseTest();
     AutoDataVectorParseTest();
     SingleFileParseTest();
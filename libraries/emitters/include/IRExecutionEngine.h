@@ -7,6 +7,9 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include "IRLazyJit.h"
+#include "IRObjectCache.h"
+
 // llvm
 #include "llvm/ADT/Triple.h"
 #include "llvm/IR/Module.h"
@@ -21,7 +24,11 @@ namespace emitters
     /// <summary> Function signature for a basic function that takes no input and returns no output </summary>
     typedef void (*DynamicFunction)(void);
 
-    /// <summary> Wrapper class to setup and manage the LLVM Execution Engine. By default, we us the new "MCJIT" </summary>
+    /// <summary>
+    /// Wrapper class to setup and manage the LLVM Execution Engine. By default, we us the new "MCJIT", which
+    /// compiles each module completely the first time a function address is requested. Optionally, an
+    /// ORC-based lazy JIT can be used instead, which compiles each function on its first call.
+    /// </summary>
     class IRExecutionEngine
     {
     public:
@@ -30,12 +37,14 @@ namespace emitters
         /// </summary>
         ///
         /// <param name="module"> [in,out] The module. </param>
-        IRExecutionEngine(IRModuleEmitter&& module);
+        /// <param name="lazyCompile"> If true, compile functions lazily, the first time they're called. </param>
+        IRExecutionEngine(IRModuleEmitter&& module, bool lazyCompile = false);
 
         /// <summary> Inject the primary "owner" module into the execution engine. </summary>
         ///
         /// <param name="pModule"> The module. </param>
-        IRExecutionEngine(std::unique_ptr<llvm::Module> pModule);
+        /// <param name="lazyCompile"> If true, compile functions lazily, the first time they're called. </param>
+        IRExecutionEngine(std::unique_ptr<llvm::Module> pModule, bool lazyCompile = false);
 
         /// <summary>
         /// Similar to LLI.exe. Set the CPU type, architecture and so on that the execution engine should
@@ -53,6 +62,20 @@ namespace emitters
         /// <param name="pModule"> The module to add. </param>
         void AddModule(std::unique_ptr<llvm::Module> pModule);
 
+        /// <summary>
+        /// Set the cache the execution engine consults before generating code for a module, and
+        /// notifies after generating it. Must be called before any function address is requested.
+        /// Not supported by the lazy JIT.
+        /// </summary>
+        ///
+        /// <param name="pCache"> The object cache. </param>
+        void SetObjectCache(std::unique_ptr<IRObjectCache> pCache);
+
+        /// <summary> Gets the object cache the execution engine uses, if any. </summary>
+        ///
+        /// <returns> The object cache, or nullptr if none was set. </returns>
+        IRObjectCache* GetObjectCache() const { return _pObjectCache.get(); }
+
         /// <summary>
         /// Return the address of a named function, JITTing code as needed. Returns 0 if not found.
         /// </summary>
@@ -69,6 +92,16 @@ namespace emitters
         /// <returns> The function address. </returns>
         uint64_t ResolveFunctionAddress(const std::string& name);
 
+        /// <summary>
+        /// Indicates if the code for a named function has been generated. Only supported by the lazy JIT, which
+        /// generates a function's code the first time it's called.
+        /// </summary>
+        ///
+        /// <param name="name"> Name of the function. </param>
+        ///
+        /// <returns> true if the function has been compiled. </returns>
+        bool IsFunctionCompiled(const std::string& name);
+
         /// <summary>
         /// Return a main function that takes no arguments - if one exists. Returns nullptr if not found.
         /// </summary>
@@ -89,7 +122,14 @@ namespace emitters
         void EnsureClockGetTime();
 
         std::unique_ptr<llvm::EngineBuilder> _pBuilder;
+        std::unique_ptr<IRObjectCache> _pObjectCache; // must outlive _pEngine
         std::unique_ptr<llvm::ExecutionEngine> _pEngine;
+
+        // Used instead of _pEngine when compiling lazily
+        bool _lazyCompile = false;
+        std::unique_ptr<llvm::TargetMachine> _pLazyTargetMachine;
+        std::vector<std::unique_ptr<llvm::Module>> _pendingModules;
+        std::unique_ptr<IRLazyJit> _pLazyJit;
     };
 }
 }
@@ -211,7 +211,9 @@ namespace emitters
 
         /// <summary>
         /// Emit binary operator over 2 equal sized vector arguments. The operator is applied to each
-        /// pair of scalars. Also supply an aggregator function.
+        /// pair of scalars. Also supply an aggregator function. The main loop works on SIMD vectors
+        /// sized for the target device, so the aggregator may receive a vector value covering the
+        /// elements starting at the given index, followed by scalar values for the remainder.
         /// </summary>
         ///
         /// <param name="type"> The operator type. </param>
@@ -223,7 +225,9 @@ namespace emitters
 
         /// <summary>
         /// Emit binary operator over 2 equal sized vector arguments. The operator is applied to each
-        /// pair of scalars. Also supply an aggregator function.
+        /// pair of scalars. Also supply an aggregator function. The main loop works on SIMD vectors
+        /// sized for the target device, so the aggregator may receive a vector value covering the
+        /// elements starting at the given index, followed by scalar values for the remainder.
         /// </summary>
         ///
         /// <param name="type"> The operator type. </param>
@@ -235,7 +239,8 @@ namespace emitters
 
         /// <summary>
         /// Emit binary operator over a scalar and a vector. The operator is applied to each
-        /// pair of scalars. Also supply an aggregator function.
+        /// pair of scalars. Also supply an aggregator function. As with the vector-vector version,
+        /// the aggregator may receive SIMD vector values.
         /// </summary>
         ///
         /// <param name="type"> The operator type. </param>
@@ -248,7 +253,8 @@ namespace emitters
 
         /// <summary>
         /// Emit binary operator over a scalar and a vector. The operator is applied to each
-        /// pair of scalars. Also supply an aggregator function.
+        /// pair of scalars. Also supply an aggregator function. As with the vector-vector version,
+        /// the aggregator may receive SIMD vector values.
         /// </summary>
         ///
         /// <param name="type"> The operator type. </param>
@@ -261,7 +267,9 @@ namespace emitters
 
         /// <summary>
         /// Emit binary operator over 2 equal sized vector arguments. The operator is applied to each
-        /// pair of scalars. Also supply an aggregator function.
+        /// pair of scalars. Also supply an aggregator function. The main loop works on SIMD vectors
+        /// sized for the target device, so the aggregator may receive a vector value covering the
+        /// elements starting at the given index, followed by scalar values for the remainder.
         /// </summary>
         ///
         /// <param name="type"> The operator type. </param>
@@ -273,6 +281,42 @@ namespace emitters
         /// <param name="aggregator"> The aggregator function. </param>
         void VectorOperator(TypedOperator type, size_t size, llvm::Value* pLeftValue, int LeftStartAt, llvm::Value* pRightValue, int RightStartAt, std::function<void(llvm::Value*, llvm::Value*)> aggregator);
 
+        /// <summary> Gets the number of elements of the given type that fit in a SIMD register of the target device. </summary>
+        ///
+        /// <param name="pElementType"> The element type. </param>
+        ///
+        /// <returns> The number of elements per vector, or 1 if values of this type should not be vectorized. </returns>
+        size_t GetVectorWidth(llvm::Type* pElementType) const;
+
+        /// <summary>
+        /// Emits a loop over the elements of an array that works on SIMD vectors sized for the target device, followed by a
+        /// loop over the elements left over. The body is called with the index of the first element and the number of
+        /// elements to process there, which is either the vector width or 1. The loop vectorizer is told to leave both loops alone.
+        /// </summary>
+        ///
+        /// <param name="size"> The number of elements. </param>
+        /// <param name="pElementType"> The element type. </param>
+        /// <param name="body"> The function that emits the loop body. </param>
+        void VectorLoop(size_t size, llvm::Type* pElementType, std::function<void(llvm::Value*, size_t)> body);
+
+        /// <summary>
+        /// Emits a loop over the elements of an array that works on SIMD vectors sized for the target device, followed by a
+        /// loop over the elements left over, for a number of elements known only at runtime.
+        /// </summary>
+        ///
+        /// <param name="pSize"> The number of elements. </param>
+        /// <param name="pElementType"> The element type. </param>
+        /// <param name="body"> The function that emits the loop body. </param>
+        void VectorLoop(llvm::Value* pSize, llvm::Type* pElementType, std::function<void(llvm::Value*, size_t)> body);
+
+        /// <summary> Emits a horizontal reduction of a vector value, combining its elements with the given operator. </summary>
+        ///
+        /// <param name="type"> The operator type. </param>
+        /// <param name="pValue"> The vector value. Scalar values are returned unchanged. </param>
+        ///
+        /// <returns> The scalar result of the reduction. </returns>
+        llvm::Value* VectorReduce(TypedOperator type, llvm::Value* pValue);
+
         /// <summary> Emit an unconditional branch to the given block. </summary>
         ///
         /// <param name="pDestinationBlock"> Pointer to the destination block. </param>
@@ -625,7 +669,16 @@ namespace emitters
         /// <returns> The value of the entry at the given offset in the array. </returns>
         llvm::Value* ValueAt(llvm::GlobalVariable* pGlobal);
 
-        /// <summary> Set an element in an array. </summary>
+        /// <summary> Get a vector of consecutive values starting at an offset in an array. </summary>
+        ///
+        /// <param name="pPointer"> Pointer to the array. </param>
+        /// <param name="pOffset"> The offset of the first element. </param>
+        /// <param name="width"> The number of elements to load. </param>
+        ///
+        /// <returns> A vector value holding the entries, or a scalar value if `width` is 1. </returns>
+        llvm::Value* VectorValueAt(llvm::Value* pPointer, llvm::Value* pOffset, size_t width);
+
+        /// <summary> Set an element in an array. If the value is a vector, consecutive elements starting at the offset are set. </summary>
         ///
         /// <param name="pPointer"> Pointer to the array. </param>
         /// <param name="pOffset"> The offset. </param>
@@ -687,6 +740,20 @@ namespace emitters
         /// <returns> A for loop emitter. </returns>
         IRForLoopEmitter ForLoop();
 
+        /// <summary>
+        /// Emits a loop whose iterations may run concurrently. When the `parallelize` compiler parameter is set,
+        /// the body is outlined into a task function and the iterations are split among the threads of the
+        /// runtime's thread pool (see ThreadingInterface.h); otherwise a serial for loop is emitted. The body is
+        /// emitted into the function it is given, which may not be this one, so values computed in this function
+        /// must be passed in `capturedValues` and accessed through the list the body receives. Global variables and
+        /// constants may be used directly.
+        /// </summary>
+        ///
+        /// <param name="numIterations"> The number of iterations. </param>
+        /// <param name="capturedValues"> The values from this function that the body uses. </param>
+        /// <param name="body"> A function that emits the loop body, given the function to emit into, the iteration variable and the captured values. </param>
+        void ParallelFor(int numIterations, const IRValueList& capturedValues, std::function<void(IRFunctionEmitter&, llvm::Value*, const IRValueList&)> body);
+
         /// <summary> Gets an if statement emitter. </summary>
         ///
         /// <returns> An if statement emitter. </returns>
@@ -816,6 +883,24 @@ namespace emitters
         /// <remarks> To insert well-known metadata, prefer the "IncludeInXXX" metadata methods. </remarks>
         void InsertMetadata(const std::string& tag, const std::string& content = "");
 
+        /// <summary>
+        /// Marks a pointer argument as `noalias`: the memory it points to isn't accessed through any other
+        /// pointer while the function runs. This lets the optimizer vectorize loops over the argument without
+        /// runtime overlap checks, so it must only be used for buffers the caller guarantees are distinct.
+        /// </summary>
+        ///
+        /// <param name="argumentIndex"> The zero-based index of the argument. </param>
+        void AddNoAliasAttribute(size_t argumentIndex);
+
+        /// <summary>
+        /// Marks a pointer argument as `dereferenceable`: it always points to at least the given number of
+        /// elements, so loads from it may be speculated (e.g., hoisted out of loops or conditionals).
+        /// </summary>
+        ///
+        /// <param name="argumentIndex"> The zero-based index of the argument. </param>
+        /// <param name="numElements"> The number of elements the argument points to. </param>
+        void AddDereferenceableAttribute(size_t argumentIndex, size_t numElements);
+
         /// <summary> Emits an ELL_GetXXClockMilliseconds library function. </summary>
         ///
         /// <typeparam name="ClockType"> The clock type to use. </typeparam>
@@ -1000,6 +1085,10 @@ namespace emitters
         llvm::Value* ValueAtH(llvm::Value* pPointer, int offset);
         llvm::Value* ValueAtH(llvm::Value* pPointer, llvm::Value* pOffset);
         llvm::Value* SetValueAtH(llvm::Value* pPointer, int offset, llvm::Value* pValue);
+        llvm::Value* SetVectorValueAt(llvm::Value* pPointer, llvm::Value* pOffset, llvm::Value* pValue);
+        llvm::Value* SplatToMatch(llvm::Value* pValue, llvm::Value* pOther);
+        llvm::Type* GetPointerElementType(llvm::Value* pPointer) const;
+        llvm::Argument* GetPointerArgument(size_t argumentIndex);
 
         llvm::BasicBlock* GetEntryBlock() { return _entryBlock; }
         void SetUpFunction();
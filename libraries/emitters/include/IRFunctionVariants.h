@@ -0,0 +1,42 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     IRFunctionVariants.h (emitters)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "IRModuleEmitter.h"
+
+// stl
+#include <string>
+#include <vector>
+
+namespace ell
+{
+namespace emitters
+{
+    /// <summary>
+    /// Emits copies of a function, and of all the functions it uses, specialized for the given x86 instruction
+    /// sets ("sse4.2", "avx2" and "avx512"). The function itself becomes a dispatcher that checks CPUID on its
+    /// first call and from then on calls the best variant the CPU supports. If the CPU supports none of them,
+    /// the original code, generated for the module's target device, is used. So the target device should be
+    /// the least capable CPU the code needs to run on. Variants are named after the function and instruction set
+    /// (e.g., "predict_avx2"). An extra function, `<functionName>_GetVariant`, returns the index in `instructionSets`
+    /// of the variant the CPU uses, or -1 if it uses the original code.
+    /// </summary>
+    ///
+    /// <param name="moduleEmitter"> The module containing the function. </param>
+    /// <param name="functionName"> The name of the function. Its name, signature and metadata are unchanged. </param>
+    /// <param name="instructionSets"> The instruction sets to emit variants for. </param>
+    void EmitFunctionVariants(IRModuleEmitter& moduleEmitter, const std::string& functionName, const std::vector<std::string>& instructionSets);
+
+    /// <summary> Gets the target features the variants for an instruction set are compiled with. </summary>
+    ///
+    /// <param name="instructionSet"> The instruction set ("sse4.2", "avx2" or "avx512"). </param>
+    ///
+    /// <returns> The comma-separated list of LLVM target features, e.g. "+sse4.2,+popcnt". </returns>
+    std::string GetFunctionVariantFeatures(const std::string& instructionSet);
+}
+}
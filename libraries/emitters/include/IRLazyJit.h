@@ -0,0 +1,79 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     IRLazyJit.h (emitters)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// llvm
+#include "llvm/ExecutionEngine/Orc/CompileOnDemandLayer.h"
+#include "llvm/ExecutionEngine/Orc/CompileUtils.h"
+#include "llvm/ExecutionEngine/Orc/IRCompileLayer.h"
+#include "llvm/ExecutionEngine/Orc/IndirectionUtils.h"
+#include "llvm/ExecutionEngine/Orc/ObjectLinkingLayer.h"
+#include "llvm/IR/DataLayout.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Target/TargetMachine.h"
+
+// stl
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace ell
+{
+namespace emitters
+{
+    /// <summary>
+    /// A JIT built on LLVM's ORC layers that compiles each function the first time it is called,
+    /// rather than compiling the whole module up front. Functions that are never called (for instance,
+    /// profiling and diagnostic helpers) are never compiled.
+    /// </summary>
+    class IRLazyJit
+    {
+    public:
+        /// <summary> Constructor </summary>
+        ///
+        /// <param name="pTargetMachine"> The target machine to generate code for. Must be the host. </param>
+        IRLazyJit(std::unique_ptr<llvm::TargetMachine> pTargetMachine);
+
+        /// <summary> Add a module to the JIT. No code is generated until a function is requested. </summary>
+        ///
+        /// <param name="pModule"> The module to add. </param>
+        void AddModule(std::unique_ptr<llvm::Module> pModule);
+
+        /// <summary>
+        /// Return the address of a named function, or 0 if not found. The address may point to a stub
+        /// that compiles the function on its first call.
+        /// </summary>
+        ///
+        /// <param name="name"> Name of the requested function. </param>
+        ///
+        /// <returns> The function address. </returns>
+        uint64_t GetFunctionAddress(const std::string& name);
+
+        /// <summary> Indicates if the code for a named function has been generated, that is, if it has been called. </summary>
+        ///
+        /// <param name="name"> Name of the function. </param>
+        ///
+        /// <returns> true if the function has been compiled. </returns>
+        bool IsFunctionCompiled(const std::string& name);
+
+    private:
+        using ObjectLayer = llvm::orc::ObjectLinkingLayer<>;
+        using CompileLayer = llvm::orc::IRCompileLayer<ObjectLayer>;
+        using CompileOnDemandLayer = llvm::orc::CompileOnDemandLayer<CompileLayer>;
+
+        std::string Mangle(const std::string& name) const;
+
+        std::unique_ptr<llvm::TargetMachine> _pTargetMachine;
+        llvm::DataLayout _dataLayout;
+        std::unique_ptr<llvm::orc::JITCompileCallbackManager> _pCompileCallbackManager;
+        ObjectLayer _objectLayer;
+        CompileLayer _compileLayer;
+        std::unique_ptr<CompileOnDemandLayer> _pCompileOnDemandLayer;
+    };
+}
+}
@@ -16,6 +16,28 @@ namespace emitters
 {
     class IRFunctionEmitter;
 
+    /// <summary>
+    /// Hints for how the optimizer should transform a loop, which are attached to the loop as `llvm.loop` metadata.
+    /// A value of zero leaves the choice to the optimizer.
+    /// </summary>
+    struct LoopHints
+    {
+        /// <summary> The number of times to unroll the loop. 1 disables unrolling. </summary>
+        int unrollCount = 0;
+
+        /// <summary> The number of iterations to combine into SIMD vectors. 1 disables vectorization. </summary>
+        int vectorizeWidth = 0;
+
+        /// <summary> The number of (possibly vectorized) iterations to interleave. 1 disables interleaving. </summary>
+        int interleaveCount = 0;
+
+        /// <summary>
+        /// Promises that no iteration reads or writes memory that another iteration writes, other than local
+        /// variables of the function, so the optimizer may vectorize the loop without proving it is safe.
+        /// </summary>
+        bool parallelAccesses = false;
+    };
+
     ///<summary> Class that simplifies for loop creation. </summary>
     class IRForLoopEmitter
     {
@@ -49,7 +71,7 @@ namespace emitters
 
         /// <summary> Emits the beginning of a for loop that repeats the given number of times. </summary>
         ///
-        /// <param name="pRepeatCount"> Pointer to an llvm::Value that contains the number of repetitions. </param>
+        /// <param name="pRepeatCount"> Pointer to an llvm::Value that contains the number of repetitions, a 32 or 64 bit integer. The iteration variable has the same type. </param>
         ///
         /// <returns> Pointer to the llvm::BasicBlock that represents the for loop. </returns>
         llvm::BasicBlock* Begin(llvm::Value* pRepeatCount);
@@ -75,6 +97,11 @@ namespace emitters
         template <typename ValueType, BinaryPredicateType predicate>
         llvm::BasicBlock* Begin(llvm::Value* pStart, llvm::Value* pIncrement, llvm::Value* pTestValuePointer);
 
+        /// <summary> Sets the optimization hints for this loop. They are attached when the loop ends. </summary>
+        ///
+        /// <param name="hints"> The hints. </param>
+        void SetHints(const LoopHints& hints) { _hints = hints; }
+
         /// <summary> Emit the end of this for loop. </summary>
         void End();
 
@@ -88,6 +115,7 @@ namespace emitters
         void EmitMutableCondition(TypedComparison type, llvm::Value* pTestValuePointer);
         void EmitIncrement(VariableType type, llvm::Value* pIncrementValue);
         llvm::BasicBlock* PrepareBody();
+        void AddHintMetadata();
 
         IRFunctionEmitter& _functionEmitter; // Loop written into this function
         llvm::BasicBlock* _pInitializationBlock = nullptr; // The for loop is set up in this block - such as initializing iteration variables
@@ -96,6 +124,7 @@ namespace emitters
         llvm::BasicBlock* _pIncrementBlock = nullptr; // Here we increment the iteration variable
         llvm::BasicBlock* _pAfterBlock = nullptr; // When the loop is done, we branch to this block
         llvm::Value* _pIterationVariable = nullptr;
+        LoopHints _hints;
     };
 }
 }
@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     IRObjectCache.h (emitters)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// llvm
+#include "llvm/ExecutionEngine/ObjectCache.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/MemoryBuffer.h"
+
+// stl
+#include <memory>
+#include <string>
+
+namespace ell
+{
+namespace emitters
+{
+    /// <summary>
+    /// An on-disk cache of the object code the execution engine generates for a module. The cache
+    /// holds a single entry, stored in `directory` under the given key. When the entry exists, the
+    /// execution engine loads it instead of generating code for the module.
+    /// </summary>
+    class IRObjectCache : public llvm::ObjectCache
+    {
+    public:
+        /// <summary> Constructor </summary>
+        ///
+        /// <param name="directory"> The directory holding the cached object files. </param>
+        /// <param name="key"> The key identifying the module's object code, typically a hash of everything the code depends on. </param>
+        IRObjectCache(const std::string& directory, const std::string& key);
+
+        /// <summary> Indicates if the object code for this cache's key has already been stored. </summary>
+        ///
+        /// <returns> true if the cached object file exists and is readable. </returns>
+        bool HasObject() const;
+
+        /// <summary> Gets the path of the cached object file. </summary>
+        ///
+        /// <returns> The path of the cached object file. </returns>
+        std::string GetObjectPath() const;
+
+        /// <summary> Gets the number of times the execution engine loaded the object code from this cache. </summary>
+        ///
+        /// <returns> The number of objects loaded. </returns>
+        int GetNumObjectsLoaded() const { return _numObjectsLoaded; }
+
+        /// <summary> Gets the number of times the execution engine stored newly generated object code in this cache. </summary>
+        ///
+        /// <returns> The number of objects stored. </returns>
+        int GetNumObjectsStored() const { return _numObjectsStored; }
+
+        /// <summary> Called by the execution engine after it generates the object code for a module. </summary>
+        ///
+        /// <param name="pModule"> The module that was compiled. </param>
+        /// <param name="object"> The generated object code. </param>
+        void notifyObjectCompiled(const llvm::Module* pModule, llvm::MemoryBufferRef object) override;
+
+        /// <summary> Called by the execution engine before it generates the object code for a module. </summary>
+        ///
+        /// <param name="pModule"> The module about to be compiled. </param>
+        ///
+        /// <returns> The cached object code, or nullptr if there is none. </returns>
+        std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module* pModule) override;
+
+    private:
+        std::string _directory;
+        std::string _key;
+        int _numObjectsLoaded = 0;
+        int _numObjectsStored = 0;
+    };
+}
+}
@@ -7,11 +7,13 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include "ModuleEmitter.h"
+
 // llvm
 #include "llvm/IR/Function.h"
 #include "llvm/IR/LegacyPassManager.h"
 #include "llvm/IR/Module.h"
-#include "llvm/IR/PassManager.h"
+#include "llvm/Target/TargetMachine.h"
 
 namespace ell
 {
@@ -29,6 +31,15 @@ namespace emitters
         /// <summary> Add common optimizations to the optimizer pipeline. </summary>
         void AddStandardPasses();
 
+        /// <summary>
+        /// Add the per-function passes of the standard LLVM pipeline for the given optimization level. These are
+        /// the early simplifications; the rest of the pipeline is run by `IRModuleOptimizer`.
+        /// </summary>
+        ///
+        /// <param name="level"> The optimization level. </param>
+        /// <param name="pTargetMachine"> The target machine whose cost model the passes should use, or nullptr to use a generic one. </param>
+        void AddStandardPasses(OptimizerLevel level, llvm::TargetMachine* pTargetMachine);
+
         /// <summary> Add an optimization pass to simplify instructions. </summary>
         void AddInstructionCombiner();
 
@@ -67,14 +78,22 @@ namespace emitters
         /// <summary> Add common optimizations to the optimizer pipeline. </summary>
         void AddStandardPasses();
 
+        /// <summary>
+        /// Add the standard LLVM pipeline for the given optimization level, including inlining, loop
+        /// optimizations (LICM, unrolling, etc.) and the loop and SLP vectorizers.
+        /// </summary>
+        ///
+        /// <param name="level"> The optimization level. </param>
+        /// <param name="pTargetMachine"> The target machine whose cost model the passes should use, or nullptr to use a generic one. </param>
+        void AddStandardPasses(OptimizerLevel level, llvm::TargetMachine* pTargetMachine);
+
         /// <summary> Optimize a given module. </summary>
         ///
         /// <param name="pModule"> pointer to an llvm module. </param>
         void Run(llvm::Module* pModule);
 
     private:
-        llvm::ModulePassManager _passes;
-        llvm::ModuleAnalysisManager _analysis;
+        llvm::legacy::PassManager _passes;
     };
 }
 }
\ No newline at end of file
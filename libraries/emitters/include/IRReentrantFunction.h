@@ -0,0 +1,40 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     IRReentrantFunction.h (emitters)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "IRModuleEmitter.h"
+
+// stl
+#include <string>
+
+namespace ell
+{
+namespace emitters
+{
+    /// <summary>
+    /// Makes a function reentrant, by moving the mutable global variables it uses (directly, or through the functions
+    /// it calls) into a context struct that the caller allocates. The function, and every function it calls that uses
+    /// that state, gets a pointer to the context as a new first argument. Two functions are added to the module and
+    /// declared in its header:
+    ///
+    /// `int32_t <prefix>_GetContextSize()` returns the size of the context, in bytes. The context must be aligned for
+    /// any scalar type (memory from `malloc` is).
+    ///
+    /// `void <prefix>_InitializeContext(int8_t* context)` resets a context to the state a freshly-loaded module starts in.
+    ///
+    /// Each context may only be used by one call at a time, but calls with different contexts can run concurrently.
+    /// Functions that use the state must only be called directly: one that's passed by address (e.g., as a task for
+    /// the thread pool) can't get the context, and the transformation throws.
+    /// </summary>
+    ///
+    /// <param name="moduleEmitter"> The module containing the function. </param>
+    /// <param name="functionName"> The name of the function. Its name and metadata are unchanged. </param>
+    /// <param name="contextFunctionPrefix"> The prefix for the names of the context functions. </param>
+    void EmitReentrantFunction(IRModuleEmitter& moduleEmitter, const std::string& functionName, const std::string& contextFunctionPrefix);
+}
+}
@@ -14,10 +14,15 @@
 // utilities
 #include "Exception.h"
 
+// stl
+#include <functional>
+#include <string>
+
 namespace ell
 {
 namespace emitters
 {
+    class IRFunctionEmitter;
     class IRModuleEmitter;
 
     /// <summary> Manages external as well as compiler auto-generated functions </summary>
@@ -38,6 +43,24 @@ namespace emitters
         /// <returns> An LLVM function pointer to the current time function. </returns>
         llvm::Function* GetCurrentTimeFunction(); // returns a double containing the current time (in _milliseconds_ from some arbitrary start time)
 
+        //
+        // Threading
+        //
+
+        /// <summary>
+        /// Get the function that runs a parallel loop on a thread pool, `void ELL_ParallelFor(int32 count, task, int8* context)`,
+        /// where `task` is a `void(int32 begin, int32 end, int8* context)` function that processes the iterations [begin, end).
+        /// A reference implementation is in ThreadingInterface.h.
+        /// </summary>
+        ///
+        /// <returns> An LLVM function pointer to the parallel-for function. </returns>
+        llvm::Function* GetParallelForFunction();
+
+        /// <summary> Get the type of the task functions passed to the parallel-for function. </summary>
+        ///
+        /// <returns> The LLVM function type of a parallel-for task. </returns>
+        llvm::FunctionType* GetParallelForTaskType();
+
         //
         // Standard math functions
         //
@@ -58,6 +81,39 @@ namespace emitters
         template <typename ValueType>
         llvm::Function* GetLogFunction();
 
+        /// <summary> Get the tanh function </summary>
+        template <typename ValueType>
+        llvm::Function* GetTanhFunction();
+
+        /// <summary> Get the logistic sigmoid function, 1 / (1 + exp(-x)) </summary>
+        template <typename ValueType>
+        llvm::Function* GetSigmoidFunction();
+
+        //
+        // Math functions on scalars or vectors. The argument type is a floating point type or a vector of one.
+        // If the compiler parameters specify `useFastMath`, exp, log, tanh and sigmoid are polynomial approximations
+        // emitted into the module, which the optimizer can inline and vectorize. They return NaN for NaN, and exp and log
+        // return infinity for infinity. Otherwise they are computed with the math library, one element at a time.
+        //
+
+        /// <summary> Get the sqrt function for the given argument type </summary>
+        llvm::Function* GetSqrtFunction(llvm::Type* pArgType);
+
+        /// <summary> Get the abs function for the given argument type </summary>
+        llvm::Function* GetAbsFunction(llvm::Type* pArgType);
+
+        /// <summary> Get the exp function for the given argument type </summary>
+        llvm::Function* GetExpFunction(llvm::Type* pArgType);
+
+        /// <summary> Get the log function for the given argument type </summary>
+        llvm::Function* GetLogFunction(llvm::Type* pArgType);
+
+        /// <summary> Get the tanh function for the given argument type </summary>
+        llvm::Function* GetTanhFunction(llvm::Type* pArgType);
+
+        /// <summary> Get the logistic sigmoid function for the given argument type </summary>
+        llvm::Function* GetSigmoidFunction(llvm::Type* pArgType);
+
         //
         // Dot product
         //
@@ -82,6 +138,37 @@ namespace emitters
         template <typename ValueType>
         llvm::Function* GetGEMMFunction();
 
+        /// <summary>
+        /// Get a function that computes a strided batch of row major matrix products, C_i = alpha * A_i * B_i + beta * C_i,
+        /// where A_i starts i * strideA elements after A, and likewise for B and C. A stride of zero shares an operand
+        /// across the batch. The arguments are those of gemm without the order, with each matrix followed by its stride,
+        /// and the batch count last. The function is emitted into the module the first time it is requested.
+        /// </summary>
+        ///
+        /// <typeparam name="ValueType"> The data type used (`float` or `double`) <typeparam>
+        /// <param name="useBlas"> If true, each product is computed by the BLAS gemm function, otherwise by emitted loops. </param>
+        template <typename ValueType>
+        llvm::Function* GetGEMMStridedBatchedFunction(bool useBlas);
+
+        /// <summary>
+        /// Get a function `void(A, B, C)` that computes the row major matrix product C = A * B, specialized to the given
+        /// sizes and leading dimensions. The product is computed by emitted code, tiled for the cache and blocked so that
+        /// a tile of C is accumulated in SIMD registers, so no BLAS library is needed. The function is emitted into the
+        /// module the first time it is requested with these parameters.
+        /// </summary>
+        ///
+        /// <typeparam name="ValueType"> The data type used (`float` or `double`) <typeparam>
+        /// <param name="transposeA"> If true, A is stored transposed (as a k x m matrix). </param>
+        /// <param name="transposeB"> If true, B is stored transposed (as an n x k matrix). </param>
+        /// <param name="m"> The number of rows of C. </param>
+        /// <param name="n"> The number of columns of C. </param>
+        /// <param name="k"> The inner dimension of the product. </param>
+        /// <param name="lda"> The distance between the rows of A, as stored. </param>
+        /// <param name="ldb"> The distance between the rows of B, as stored. </param>
+        /// <param name="ldc"> The distance between the rows of C. </param>
+        template <typename ValueType>
+        llvm::Function* GetTiledGEMMFunction(bool transposeA, bool transposeB, int m, int n, int k, int lda, int ldb, int ldc);
+
     private:
         std::string GetNamespacePrefix() const;
 
@@ -89,6 +176,15 @@ namespace emitters
         llvm::Function* GetAbsFunction(VariableType argType);
         llvm::Function* GetExpFunction(VariableType argType);
         llvm::Function* GetLogFunction(VariableType argType);
+        llvm::Function* GetTanhFunction(VariableType argType);
+        llvm::Function* GetSigmoidFunction(VariableType argType);
+
+        llvm::Function* EmitMathFunction(const std::string& name, llvm::Type* pArgType, std::function<llvm::Value*(IRFunctionEmitter&, llvm::Value*)> body);
+        llvm::Function* EmitFastExpFunction(llvm::Type* pArgType);
+        llvm::Function* EmitFastLogFunction(llvm::Type* pArgType);
+        llvm::Function* EmitTanhFunction(llvm::Type* pArgType);
+        llvm::Function* EmitSigmoidFunction(llvm::Type* pArgType);
+        bool UseFastMath() const;
 
         llvm::Function* EmitDotProductFunction();
         llvm::Function* EmitDotProductFunctionF();
@@ -97,6 +193,8 @@ namespace emitters
         llvm::Function* GetSGEMMFunction();
         llvm::Function* GetDGEMVFunction();
         llvm::Function* GetDGEMMFunction();
+        llvm::Function* EmitGEMMStridedBatchedFunction(VariableType valueType, bool useBlas);
+        llvm::Function* EmitTiledGEMMFunction(VariableType valueType, bool transposeA, bool transposeB, int m, int n, int k, int lda, int ldb, int ldc);
 
         llvm::Function* ResolveCurrentTimeFunction(llvm::StructType* timespecType);
 
@@ -30,13 +30,25 @@ namespace emitters
         swigInterface
     };
 
+    /// <summary> Levels of the standard optimization pipeline, corresponding to clang's -O1, -O2, -O3 and -Os </summary>
+    enum class OptimizerLevel
+    {
+        O1,
+        O2,
+        O3,
+        Os
+    };
+
     /// <summary> Standard compiler switches. </summary>
     struct CompilerParameters
     {
         bool unrollLoops = false;
         bool inlineOperators = true;
         bool useBlas = false;
+        bool parallelize = false;
+        bool useFastMath = false; // emit polynomial approximations of exp, log, tanh and sigmoid instead of calling the math library
         bool optimize = true;
+        OptimizerLevel optimizerLevel = OptimizerLevel::O3; // only used if `optimize` is true
         bool includeDiagnosticInfo = false;
 
         TargetDevice targetDevice;
@@ -28,6 +28,17 @@ namespace emitters
 
         /// <summary> Indicates if the target device is a Windows system </summary>
         bool IsWindows() const;
+
+        /// <summary> Gets the width, in bits, of the target device's SIMD registers, or 0 if it has none. </summary>
+        size_t GetVectorBits() const;
     };
+
+    /// <summary>
+    /// Gets a description of the machine we're running on, as detected by LLVM: the host triple, data layout,
+    /// CPU name and the full set of CPU features (the equivalent of clang's `-march=native`).
+    /// </summary>
+    ///
+    /// <returns> The host's TargetDevice, with `deviceName` set to "host". </returns>
+    TargetDevice GetHostTargetDevice();
 }
 }
@@ -0,0 +1,156 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ThreadingInterface.h (emitters)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ell_runtime
+{
+    /// <summary> A task that processes the iterations [begin, end) of a parallel loop. </summary>
+    typedef void (*ParallelForTask)(int32_t begin, int32_t end, int8_t* context);
+
+    /// <summary>
+    /// A small pool of persistent worker threads that runs the parallel loops of emitted code.
+    /// The calling thread participates in each loop. A loop started while another one is running
+    /// (for example, from inside a task) runs serially on the calling thread.
+    /// </summary>
+    class ParallelForThreadPool
+    {
+    public:
+        static ParallelForThreadPool& GetInstance()
+        {
+            static ParallelForThreadPool pool;
+            return pool;
+        }
+
+        ParallelForThreadPool(const ParallelForThreadPool&) = delete;
+        ParallelForThreadPool& operator=(const ParallelForThreadPool&) = delete;
+
+        ~ParallelForThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stop = true;
+            }
+            _start.notify_all();
+            for (auto& worker : _workers)
+            {
+                worker.join();
+            }
+        }
+
+        void Run(int32_t count, ParallelForTask task, int8_t* context)
+        {
+            std::unique_lock<std::mutex> runLock(_runMutex, std::try_to_lock);
+            if (!runLock.owns_lock() || _workers.empty() || count < 2)
+            {
+                task(0, count, context);
+                return;
+            }
+
+            // Use a few chunks per thread, so that threads finishing early can pick up more work
+            const auto numThreads = static_cast<int32_t>(_workers.size() + 1);
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _task = task;
+                _context = context;
+                _count = count;
+                _numChunks = std::min(count, 4 * numThreads);
+                _nextChunk = 0;
+                _numBusyWorkers = _workers.size();
+                ++_generation;
+            }
+            _start.notify_all();
+
+            RunChunks();
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            _done.wait(lock, [this] { return _numBusyWorkers == 0; });
+        }
+
+    private:
+        ParallelForThreadPool()
+        {
+            const auto numThreads = std::max(1u, std::thread::hardware_concurrency());
+            for (unsigned int index = 1; index < numThreads; ++index)
+            {
+                _workers.emplace_back([this] { RunWorker(); });
+            }
+        }
+
+        void RunWorker()
+        {
+            uint64_t generation = 0;
+            while (true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _start.wait(lock, [this, generation] { return _stop || _generation != generation; });
+                    if (_stop)
+                    {
+                        return;
+                    }
+                    generation = _generation;
+                }
+
+                RunChunks();
+
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (--_numBusyWorkers == 0)
+                {
+                    _done.notify_one();
+                }
+            }
+        }
+
+        void RunChunks()
+        {
+            for (auto chunk = _nextChunk++; chunk < _numChunks; chunk = _nextChunk++)
+            {
+                auto begin = static_cast<int32_t>(static_cast<int64_t>(_count) * chunk / _numChunks);
+                auto end = static_cast<int32_t>(static_cast<int64_t>(_count) * (chunk + 1) / _numChunks);
+                _task(begin, end, _context);
+            }
+        }
+
+        std::vector<std::thread> _workers;
+        std::mutex _runMutex;
+        std::mutex _mutex;
+        std::condition_variable _start;
+        std::condition_variable _done;
+        bool _stop = false;
+        uint64_t _generation = 0;
+        size_t _numBusyWorkers = 0;
+
+        ParallelForTask _task = nullptr;
+        int8_t* _context = nullptr;
+        int32_t _count = 0;
+        int32_t _numChunks = 0;
+        std::atomic<int32_t> _nextChunk{ 0 };
+    };
+}
+
+/// <summary>
+/// Simple C wrapper for a thread pool, intended to be called from IR to run the parallel loops
+/// emitted by IRFunctionEmitter::ParallelFor.
+/// This is also a reference implementation that is replaceable for a given environment.
+/// </summary>
+extern "C" {
+
+void ELL_ParallelFor(int32_t count, ell_runtime::ParallelForTask task, int8_t* context)
+{
+    ell_runtime::ParallelForThreadPool::GetInstance().Run(count, task, context);
+}
+
+}
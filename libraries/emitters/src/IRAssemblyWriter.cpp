@@ -67,6 +67,12 @@ namespace emitters
             // Loop over the functions in the module, settings the cpu and features attributes
             for (auto& function : module)
             {
+                // Leave functions that were specialized for other features (e.g., by EmitFunctionVariants) alone
+                if (function.hasFnAttribute("target-features"))
+                {
+                    continue;
+                }
+
                 auto& context = function.getContext(); // Is it really possible the functions don't all have the same context?
 
                 // Attributes are non-mutable, so we have to replace newAttributes with the modified attributes
@@ -8,6 +8,7 @@
 
 #include "IRExecutionEngine.h"
 #include "IRModuleEmitter.h"
+#include "TargetDevice.h"
 
 // llvm
 #include "llvm/Support/TargetSelect.h"
@@ -26,18 +27,40 @@ namespace emitters
         throw emitters::EmitterException(emitters::EmitterError::unexpected, msg);
     }
 
-    IRExecutionEngine::IRExecutionEngine(IRModuleEmitter&& module)
-        : IRExecutionEngine(module.TransferOwnership())
+    IRExecutionEngine::IRExecutionEngine(IRModuleEmitter&& module, bool lazyCompile)
+        : IRExecutionEngine(module.TransferOwnership(), lazyCompile)
     {
     }
 
-    IRExecutionEngine::IRExecutionEngine(std::unique_ptr<llvm::Module> pModule)
+    IRExecutionEngine::IRExecutionEngine(std::unique_ptr<llvm::Module> pModule, bool lazyCompile)
+        : _lazyCompile(lazyCompile)
     {
         llvm::InitializeNativeTarget();
         llvm::InitializeNativeTargetAsmPrinter();
 
-        _pBuilder = std::make_unique<llvm::EngineBuilder>(std::move(pModule));
-        _pBuilder->setEngineKind(llvm::EngineKind::JIT).setUseOrcMCJITReplacement(false);
+        if (_lazyCompile)
+        {
+            // The builder is only used to select the target machine; the module is added once the JIT is created
+            _pBuilder = std::make_unique<llvm::EngineBuilder>();
+            _pendingModules.push_back(std::move(pModule));
+        }
+        else
+        {
+            _pBuilder = std::make_unique<llvm::EngineBuilder>(std::move(pModule));
+            _pBuilder->setEngineKind(llvm::EngineKind::JIT).setUseOrcMCJITReplacement(false);
+        }
+
+        // By default, generate code for the host CPU and all of its features (unless SelectTarget overrides it)
+        auto hostDevice = GetHostTargetDevice();
+        std::vector<std::string> hostAttributes;
+        std::stringstream featureStream(hostDevice.features);
+        std::string feature;
+        while (std::getline(featureStream, feature, ','))
+        {
+            hostAttributes.push_back(feature);
+        }
+        _pBuilder->setMCPU(hostDevice.cpu);
+        _pBuilder->setMAttrs(hostAttributes);
 
         static bool installed = false;
         if (!installed)
@@ -55,19 +78,53 @@ namespace emitters
         {
             attrs.push_back(attribute);
         }
-        _pBuilder->selectTarget(targetTriple, cpuArchitecture, cpuName, attrs);
+        if (_lazyCompile)
+        {
+            _pLazyTargetMachine.reset(_pBuilder->selectTarget(targetTriple, cpuArchitecture, cpuName, attrs));
+        }
+        else
+        {
+            // selectTarget() just returns a new TargetMachine; the builder has to be configured instead. MCJIT
+            // takes the triple from the module.
+            _pBuilder->setMArch(cpuArchitecture);
+            _pBuilder->setMCPU(cpuName);
+            _pBuilder->setMAttrs(attributes);
+        }
     }
 
     void IRExecutionEngine::AddModule(std::unique_ptr<llvm::Module> pModule)
     {
         assert(pModule != nullptr);
         EnsureEngine();
-        _pEngine->addModule(std::move(pModule));
+        if (_lazyCompile)
+        {
+            _pLazyJit->AddModule(std::move(pModule));
+        }
+        else
+        {
+            _pEngine->addModule(std::move(pModule));
+        }
+    }
+
+    void IRExecutionEngine::SetObjectCache(std::unique_ptr<IRObjectCache> pCache)
+    {
+        if (_lazyCompile)
+        {
+            throw EmitterException(EmitterError::notSupported, "Object caching isn't supported by the lazy JIT");
+        }
+
+        EnsureEngine();
+        _pObjectCache = std::move(pCache);
+        _pEngine->setObjectCache(_pObjectCache.get());
     }
 
     uint64_t IRExecutionEngine::GetFunctionAddress(const std::string& name)
     {
         EnsureEngine();
+        if (_lazyCompile)
+        {
+            return _pLazyJit->GetFunctionAddress(name);
+        }
         return _pEngine->getFunctionAddress(name);
     }
 
@@ -81,6 +138,17 @@ namespace emitters
         return functionAddress;
     }
 
+    bool IRExecutionEngine::IsFunctionCompiled(const std::string& name)
+    {
+        if (!_lazyCompile)
+        {
+            throw EmitterException(EmitterError::notSupported, "Only the lazy JIT can tell which functions have been compiled");
+        }
+
+        EnsureEngine();
+        return _pLazyJit->IsFunctionCompiled(name);
+    }
+
     DynamicFunction IRExecutionEngine::GetMain()
     {
         return reinterpret_cast<DynamicFunction>(GetFunctionAddress("main"));
@@ -105,6 +173,24 @@ namespace emitters
 
     void IRExecutionEngine::EnsureEngine()
     {
+        if (_lazyCompile)
+        {
+            if (!_pLazyJit)
+            {
+                if (!_pLazyTargetMachine)
+                {
+                    _pLazyTargetMachine.reset(_pBuilder->selectTarget());
+                }
+                _pLazyJit = std::make_unique<IRLazyJit>(std::move(_pLazyTargetMachine));
+                for (auto& pModule : _pendingModules)
+                {
+                    _pLazyJit->AddModule(std::move(pModule));
+                }
+                _pendingModules.clear();
+            }
+            return;
+        }
+
         if (!_pEngine)
         {
             auto pEngine = _pBuilder->create();
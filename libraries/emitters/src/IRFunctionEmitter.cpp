@@ -16,6 +16,8 @@
 // stl
 #include <chrono>
 #include <iostream>
+#include <iterator>
+#include <string>
 
 // llvm
 #include "llvm/IR/Verifier.h"
@@ -187,6 +189,9 @@ namespace emitters
 
     llvm::Value* IRFunctionEmitter::Operator(TypedOperator type, llvm::Value* pLeftValue, llvm::Value* pRightValue)
     {
+        // A scalar combined with a vector is broadcast across the vector's lanes
+        pLeftValue = SplatToMatch(pLeftValue, pRightValue);
+        pRightValue = SplatToMatch(pRightValue, pLeftValue);
         return _pEmitter->BinaryOperation(type, pLeftValue, pRightValue);
     }
 
@@ -204,16 +209,12 @@ namespace emitters
         assert(pLeftValue != nullptr);
         assert(pRightValue != nullptr);
 
-        auto forLoop = ForLoop();
-        forLoop.Begin(size);
-        {
-            auto i = forLoop.LoadIterationVariable();
-            llvm::Value* pLeftItem = ValueAt(pLeftValue, i);
-            llvm::Value* pRightItem = ValueAt(pRightValue, i);
+        VectorLoop(size, GetPointerElementType(pLeftValue), [&](llvm::Value* i, size_t width) {
+            llvm::Value* pLeftItem = VectorValueAt(pLeftValue, i, width);
+            llvm::Value* pRightItem = VectorValueAt(pRightValue, i, width);
             llvm::Value* pTemp = Operator(type, pLeftItem, pRightItem);
             aggregator(i, pTemp);
-        }
-        forLoop.End();
+        });
     }
 
     void IRFunctionEmitter::VectorOperator(TypedOperator type, llvm::Value* pSize, llvm::Value* pLeftValue, llvm::Value* pRightValue, std::function<void(llvm::Value*, llvm::Value*)> aggregator)
@@ -222,16 +223,12 @@ namespace emitters
         assert(pLeftValue != nullptr);
         assert(pRightValue != nullptr);
 
-        auto forLoop = ForLoop();
-        forLoop.Begin(pSize);
-        {
-            auto i = forLoop.LoadIterationVariable();
-            llvm::Value* pLeftItem = ValueAt(pLeftValue, i);
-            llvm::Value* pRightItem = ValueAt(pRightValue, i);
+        VectorLoop(pSize, GetPointerElementType(pLeftValue), [&](llvm::Value* i, size_t width) {
+            llvm::Value* pLeftItem = VectorValueAt(pLeftValue, i, width);
+            llvm::Value* pRightItem = VectorValueAt(pRightValue, i, width);
             llvm::Value* pTemp = Operator(type, pLeftItem, pRightItem);
             aggregator(i, pTemp);
-        }
-        forLoop.End();
+        });
     }
 
     void IRFunctionEmitter::VectorOperator(TypedOperator type, size_t size, llvm::Value* pLeftValue, int LeftStartAt, llvm::Value* pRightValue, int RightStartAt, std::function<void(llvm::Value*, llvm::Value*)> aggregator)
@@ -239,19 +236,54 @@ namespace emitters
         assert(pLeftValue != nullptr);
         assert(pRightValue != nullptr);
 
-        auto forLoop = ForLoop();
-        forLoop.Begin(size);
-        {
-            auto i = forLoop.LoadIterationVariable();
-
+        VectorLoop(size, GetPointerElementType(pLeftValue), [&](llvm::Value* i, size_t width) {
             llvm::Value* leftOffset = Operator(TypedOperator::add, i, Literal(LeftStartAt));
-            llvm::Value* pLeftItem = ValueAt(pLeftValue, leftOffset);
+            llvm::Value* pLeftItem = VectorValueAt(pLeftValue, leftOffset, width);
             llvm::Value* rightOffset = Operator(TypedOperator::add, i, Literal(RightStartAt));
-            llvm::Value* pRightItem = ValueAt(pRightValue, rightOffset);
+            llvm::Value* pRightItem = VectorValueAt(pRightValue, rightOffset, width);
             llvm::Value* pTemp = Operator(type, pLeftItem, pRightItem);
             aggregator(i, pTemp);
+        });
+    }
+
+    size_t IRFunctionEmitter::GetVectorWidth(llvm::Type* pElementType) const
+    {
+        if (pElementType == nullptr || !(pElementType->isFloatingPointTy() || pElementType->isIntegerTy()))
+        {
+            return 1;
         }
-        forLoop.End();
+
+        auto elementBits = pElementType->getPrimitiveSizeInBits();
+        auto vectorBits = GetModule().GetCompilerParameters().targetDevice.GetVectorBits();
+        if (elementBits < 8 || vectorBits < 2 * elementBits)
+        {
+            return 1;
+        }
+        return vectorBits / elementBits;
+    }
+
+    llvm::Value* IRFunctionEmitter::VectorReduce(TypedOperator type, llvm::Value* pValue)
+    {
+        assert(pValue != nullptr);
+        if (!pValue->getType()->isVectorTy())
+        {
+            return pValue;
+        }
+
+        // Repeatedly fold the upper half of the vector onto the lower half; lanes beyond the half are don't-cares
+        auto& irBuilder = _pEmitter->GetIRBuilder();
+        auto size = pValue->getType()->getVectorNumElements();
+        for (auto half = size / 2; half > 0; half /= 2)
+        {
+            std::vector<llvm::Constant*> mask;
+            for (unsigned index = 0; index < size; ++index)
+            {
+                mask.push_back(index < half ? irBuilder.getInt32(half + index) : llvm::UndefValue::get(irBuilder.getInt32Ty()));
+            }
+            auto pUpper = irBuilder.CreateShuffleVector(pValue, llvm::UndefValue::get(pValue->getType()), llvm::ConstantVector::get(mask));
+            pValue = Operator(type, pValue, pUpper);
+        }
+        return irBuilder.CreateExtractElement(pValue, irBuilder.getInt32(0));
     }
 
     void IRFunctionEmitter::Branch(llvm::BasicBlock* pDestinationBlock)
@@ -333,11 +365,15 @@ namespace emitters
 
     llvm::Value* IRFunctionEmitter::Comparison(TypedComparison type, llvm::Value* pValue, llvm::Value* pTestValue)
     {
+        pValue = SplatToMatch(pValue, pTestValue);
+        pTestValue = SplatToMatch(pTestValue, pValue);
         return _pEmitter->Comparison(type, pValue, pTestValue);
     }
 
     llvm::Value* IRFunctionEmitter::Select(llvm::Value* pCmp, llvm::Value* pTrueValue, llvm::Value* pFalseValue)
     {
+        pTrueValue = SplatToMatch(pTrueValue, pCmp);
+        pFalseValue = SplatToMatch(pFalseValue, pCmp);
         return _pEmitter->Select(pCmp, pTrueValue, pFalseValue);
     }
 
@@ -709,13 +745,47 @@ namespace emitters
         return ValueAt(pPointer, 0);
     }
 
+    llvm::Value* IRFunctionEmitter::VectorValueAt(llvm::Value* pPointer, llvm::Value* pOffset, size_t width)
+    {
+        if (width == 1)
+        {
+            return ValueAt(pPointer, pOffset);
+        }
+
+        // Arrays are only guaranteed to be aligned to their element size
+        auto pElementPointer = PointerOffset(pPointer, pOffset);
+        auto pElementType = pElementPointer->getType()->getPointerElementType();
+        auto pVectorType = llvm::VectorType::get(pElementType, width);
+        auto& irBuilder = _pEmitter->GetIRBuilder();
+        auto pVectorPointer = irBuilder.CreateBitCast(pElementPointer, pVectorType->getPointerTo());
+        return irBuilder.CreateAlignedLoad(pVectorPointer, pElementType->getPrimitiveSizeInBits() / 8);
+    }
+
+    llvm::Value* IRFunctionEmitter::SetVectorValueAt(llvm::Value* pPointer, llvm::Value* pOffset, llvm::Value* pValue)
+    {
+        auto pElementPointer = PointerOffset(pPointer, pOffset);
+        auto pElementType = pValue->getType()->getVectorElementType();
+        auto& irBuilder = _pEmitter->GetIRBuilder();
+        auto pVectorPointer = irBuilder.CreateBitCast(pElementPointer, pValue->getType()->getPointerTo());
+        return irBuilder.CreateAlignedStore(pValue, pVectorPointer, pElementType->getPrimitiveSizeInBits() / 8);
+    }
+
     llvm::Value* IRFunctionEmitter::SetValueAt(llvm::GlobalVariable* pGlobal, llvm::Value* pOffset, llvm::Value* pValue)
     {
+        if (pValue->getType()->isVectorTy())
+        {
+            return SetVectorValueAt(pGlobal, pOffset, pValue);
+        }
         return Store(PointerOffset(pGlobal, pOffset), pValue);
     }
 
     llvm::Value* IRFunctionEmitter::SetValueAt(llvm::Value* pPointer, llvm::Value* pOffset, llvm::Value* pValue)
     {
+        if (pValue->getType()->isVectorTy())
+        {
+            return SetVectorValueAt(pPointer, pOffset, pValue);
+        }
+
         llvm::GlobalVariable* pGlobal = llvm::dyn_cast<llvm::GlobalVariable>(pPointer);
         if (pGlobal != nullptr)
         {
@@ -734,6 +804,79 @@ namespace emitters
         return IRForLoopEmitter(*this);
     }
 
+    void IRFunctionEmitter::ParallelFor(int numIterations, const IRValueList& capturedValues, std::function<void(IRFunctionEmitter&, llvm::Value*, const IRValueList&)> body)
+    {
+        if (!GetModule().GetCompilerParameters().parallelize || numIterations < 2)
+        {
+            auto forLoop = ForLoop();
+            forLoop.Begin(numIterations);
+            {
+                body(*this, forLoop.LoadIterationVariable(), capturedValues);
+            }
+            forLoop.End();
+            return;
+        }
+
+        // Pack the captured values into a struct that is passed to the task function as an opaque pointer.
+        // Constants (including global variables) are valid in any function, so they are passed through as-is.
+        auto& irBuilder = _pEmitter->GetIRBuilder();
+        std::vector<llvm::Type*> contextFieldTypes;
+        for (auto pValue : capturedValues)
+        {
+            contextFieldTypes.push_back(pValue->getType());
+        }
+        auto pContextType = llvm::StructType::get(GetLLVMContext(), contextFieldTypes);
+        auto pContext = Variable(pContextType, "parallelForContext");
+        for (size_t index = 0; index < capturedValues.size(); ++index)
+        {
+            if (!llvm::isa<llvm::Constant>(capturedValues[index]))
+            {
+                Store(irBuilder.CreateStructGEP(pContextType, pContext, index), capturedValues[index]);
+            }
+        }
+
+        // Emit the task function, which runs the iterations [begin, end)
+        auto& runtime = GetModule().GetRuntime();
+        auto pTaskType = runtime.GetParallelForTaskType();
+        std::string taskName;
+        int taskIndex = 0;
+        do
+        {
+            taskName = _name + "_ParallelForTask" + std::to_string(taskIndex++);
+        } while (GetModule().GetFunction(taskName) != nullptr);
+
+        std::vector<llvm::Type*> taskArgumentTypes(pTaskType->param_begin(), pTaskType->param_end());
+        auto& taskFunction = GetModule().BeginFunction(taskName, pTaskType->getReturnType(), taskArgumentTypes);
+        {
+            auto arguments = taskFunction.Arguments().begin();
+            llvm::Argument& begin = *arguments++;
+            llvm::Argument& end = *arguments++;
+            llvm::Argument& context = *arguments++;
+
+            auto& taskBuilder = taskFunction.GetEmitter().GetIRBuilder();
+            auto pTaskContext = taskBuilder.CreateBitCast(&context, pContextType->getPointerTo());
+            IRValueList taskCapturedValues;
+            for (size_t index = 0; index < capturedValues.size(); ++index)
+            {
+                auto pValue = capturedValues[index];
+                taskCapturedValues.push_back(llvm::isa<llvm::Constant>(pValue) ? pValue : taskFunction.Load(taskBuilder.CreateStructGEP(pContextType, pTaskContext, index)));
+            }
+
+            auto forLoop = taskFunction.ForLoop();
+            forLoop.Begin(taskFunction.Operator(TypedOperator::subtract, &end, &begin));
+            {
+                auto i = taskFunction.Operator(TypedOperator::add, &begin, forLoop.LoadIterationVariable());
+                body(taskFunction, i, taskCapturedValues);
+            }
+            forLoop.End();
+            taskFunction.Return();
+        }
+        auto pTaskFunction = taskFunction.GetFunction();
+        GetModule().EndFunction();
+
+        Call(runtime.GetParallelForFunction(), { Literal(numIterations), pTaskFunction, irBuilder.CreateBitCast(pContext, _pEmitter->Type(VariableType::BytePointer)) });
+    }
+
     IRIfEmitter IRFunctionEmitter::If()
     {
         return IRIfEmitter(*this);
@@ -747,7 +890,7 @@ namespace emitters
     void IRFunctionEmitter::Optimize()
     {
         IRFunctionOptimizer optimizer(GetLLVMModule());
-        optimizer.AddStandardPasses();
+        optimizer.AddStandardPasses(GetModule().GetCompilerParameters().optimizerLevel, nullptr);
         Optimize(optimizer);
     }
 
@@ -806,6 +949,39 @@ namespace emitters
         _pFunction->setMetadata(tag, metadataNode);
     }
 
+    void IRFunctionEmitter::AddNoAliasAttribute(size_t argumentIndex)
+    {
+        GetPointerArgument(argumentIndex);
+
+        // Attribute index 0 is the return value, so argument attributes start at 1
+        _pFunction->addAttribute(argumentIndex + 1, llvm::Attribute::NoAlias);
+    }
+
+    void IRFunctionEmitter::AddDereferenceableAttribute(size_t argumentIndex, size_t numElements)
+    {
+        auto pArgument = GetPointerArgument(argumentIndex);
+        auto pElementType = pArgument->getType()->getPointerElementType();
+        auto elementSize = GetLLVMModule()->getDataLayout().getTypeAllocSize(pElementType);
+        _pFunction->addDereferenceableAttr(argumentIndex + 1, elementSize * numElements);
+    }
+
+    llvm::Argument* IRFunctionEmitter::GetPointerArgument(size_t argumentIndex)
+    {
+        if (argumentIndex >= _pFunction->arg_size())
+        {
+            throw EmitterException(EmitterError::indexOutOfRange);
+        }
+
+        auto argumentsIterator = Arguments().begin();
+        std::advance(argumentsIterator, argumentIndex);
+        auto pArgument = &(*argumentsIterator);
+        if (!pArgument->getType()->isPointerTy())
+        {
+            throw EmitterException(EmitterError::badFunctionArguments, "Attribute requires a pointer argument");
+        }
+        return pArgument;
+    }
+
     llvm::Value* IRFunctionEmitter::DotProductFloat(int size, llvm::Value* pLeftValue, llvm::Value* pRightValue)
     {
         llvm::Value* pTotal = Variable(VariableType::Double);
@@ -817,7 +993,7 @@ namespace emitters
     {
         Store(pDestination, Literal(0.0));
         VectorOperator(TypedOperator::multiplyFloat, size, pLeftValue, pRightValue, [&pDestination, this](llvm::Value* i, llvm::Value* pValue) {
-            OperationAndUpdate(pDestination, TypedOperator::addFloat, pValue);
+            OperationAndUpdate(pDestination, TypedOperator::addFloat, VectorReduce(TypedOperator::addFloat, pValue));
         });
     }
 
@@ -825,7 +1001,7 @@ namespace emitters
     {
         Store(pDestination, Literal(0.0));
         VectorOperator(TypedOperator::multiplyFloat, pSize, pLeftValue, pRightValue, [&pDestination, this](llvm::Value* i, llvm::Value* pValue) {
-            OperationAndUpdate(pDestination, TypedOperator::addFloat, pValue);
+            OperationAndUpdate(pDestination, TypedOperator::addFloat, VectorReduce(TypedOperator::addFloat, pValue));
         });
     }
 
@@ -840,7 +1016,7 @@ namespace emitters
     {
         Store(pDestination, Literal(0));
         VectorOperator(TypedOperator::multiply, size, pLeftValue, pRightValue, [&pDestination, this](llvm::Value* i, llvm::Value* pValue) {
-            OperationAndUpdate(pDestination, TypedOperator::add, pValue);
+            OperationAndUpdate(pDestination, TypedOperator::add, VectorReduce(TypedOperator::add, pValue));
         });
     }
 
@@ -848,10 +1024,95 @@ namespace emitters
     {
         Store(pDestination, Literal(0));
         VectorOperator(TypedOperator::multiply, pSize, pLeftValue, pRightValue, [&pDestination, this](llvm::Value* i, llvm::Value* pValue) {
-            OperationAndUpdate(pDestination, TypedOperator::add, pValue);
+            OperationAndUpdate(pDestination, TypedOperator::add, VectorReduce(TypedOperator::add, pValue));
         });
     }
 
+    llvm::Value* IRFunctionEmitter::SplatToMatch(llvm::Value* pValue, llvm::Value* pOther)
+    {
+        if (pOther->getType()->isVectorTy() && !pValue->getType()->isVectorTy())
+        {
+            return _pEmitter->GetIRBuilder().CreateVectorSplat(pOther->getType()->getVectorNumElements(), pValue);
+        }
+        return pValue;
+    }
+
+    llvm::Type* IRFunctionEmitter::GetPointerElementType(llvm::Value* pPointer) const
+    {
+        auto pType = pPointer->getType();
+        if (!pType->isPointerTy())
+        {
+            return nullptr;
+        }
+
+        // Global arrays are pointers to an array type
+        pType = pType->getPointerElementType();
+        return pType->isArrayTy() ? pType->getArrayElementType() : pType;
+    }
+
+    void IRFunctionEmitter::VectorLoop(size_t size, llvm::Type* pElementType, std::function<void(llvm::Value*, size_t)> body)
+    {
+        auto width = GetVectorWidth(pElementType);
+        auto numVectors = size / width;
+        // When the loops are vectorized explicitly, the loop vectorizer is told to leave them alone
+        LoopHints hints;
+        hints.vectorizeWidth = width > 1 ? 1 : 0;
+        if (width > 1 && numVectors > 0)
+        {
+            auto forLoop = ForLoop();
+            forLoop.SetHints(hints);
+            forLoop.Begin(static_cast<int>(numVectors));
+            {
+                auto i = Operator(TypedOperator::multiply, forLoop.LoadIterationVariable(), Literal(static_cast<int>(width)));
+                body(i, width);
+            }
+            forLoop.End();
+        }
+
+        auto remainderStart = (width > 1) ? numVectors * width : 0;
+        if (remainderStart < size)
+        {
+            auto forLoop = ForLoop();
+            forLoop.SetHints(hints);
+            forLoop.Begin(static_cast<int>(remainderStart), static_cast<int>(size), 1);
+            {
+                body(forLoop.LoadIterationVariable(), 1);
+            }
+            forLoop.End();
+        }
+    }
+
+    void IRFunctionEmitter::VectorLoop(llvm::Value* pSize, llvm::Type* pElementType, std::function<void(llvm::Value*, size_t)> body)
+    {
+        auto width = GetVectorWidth(pElementType);
+        llvm::Value* pRemainderStart = Literal(0);
+        LoopHints hints;
+        hints.vectorizeWidth = width > 1 ? 1 : 0;
+        if (width > 1)
+        {
+            auto pWidth = Literal(static_cast<int>(width));
+            auto pNumVectors = Operator(TypedOperator::divideSigned, pSize, pWidth);
+            auto forLoop = ForLoop();
+            forLoop.SetHints(hints);
+            forLoop.Begin(pNumVectors);
+            {
+                auto i = Operator(TypedOperator::multiply, forLoop.LoadIterationVariable(), pWidth);
+                body(i, width);
+            }
+            forLoop.End();
+            pRemainderStart = Operator(TypedOperator::multiply, pNumVectors, pWidth);
+        }
+
+        auto forLoop = ForLoop();
+        forLoop.SetHints(hints);
+        forLoop.Begin(Operator(TypedOperator::subtract, pSize, pRemainderStart));
+        {
+            auto i = Operator(TypedOperator::add, pRemainderStart, forLoop.LoadIterationVariable());
+            body(i, 1);
+        }
+        forLoop.End();
+    }
+
     llvm::Function* IRFunctionEmitter::ResolveFunction(const std::string& name)
     {
         llvm::Function* pFunction = GetLLVMModule()->getFunction(name);
@@ -0,0 +1,340 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     IRFunctionVariants.cpp (emitters)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "IRFunctionVariants.h"
+#include "EmitterException.h"
+
+// llvm
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Triple.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/InlineAsm.h"
+#include "llvm/Support/Host.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+#include "llvm/Transforms/Utils/ValueMapper.h"
+
+// stl
+#include <algorithm>
+#include <cstdint>
+#include <unordered_set>
+#include <utility>
+
+namespace ell
+{
+namespace emitters
+{
+    namespace
+    {
+        // An instruction set a function variant can be specialized for, along with the CPUID
+        // (and XCR0) bits that must all be set for the CPU and OS to support it
+        struct InstructionSet
+        {
+            std::string name;
+            std::string features;
+            uint32_t leaf1Ecx;
+            uint32_t leaf7Ebx;
+            uint32_t xcr0;
+        };
+
+        const uint32_t c_sse42Ecx = (1u << 19) | (1u << 20) | (1u << 23); // SSE4.1, SSE4.2, POPCNT
+        const uint32_t c_avxEcx = c_sse42Ecx | (1u << 12) | (1u << 27) | (1u << 28) | (1u << 29); // FMA, OSXSAVE, AVX, F16C
+        const uint32_t c_avx2Ebx = (1u << 3) | (1u << 5) | (1u << 8); // BMI1, AVX2, BMI2
+        const uint32_t c_avx512Ebx = c_avx2Ebx | (1u << 16) | (1u << 17) | (1u << 28) | (1u << 30) | (1u << 31); // AVX512 F, DQ, CD, BW, VL
+        const uint32_t c_avxXcr0 = 0x6; // SSE and AVX state
+        const uint32_t c_avx512Xcr0 = c_avxXcr0 | 0xe0; // opmask, ZMM_Hi256 and Hi16_ZMM state
+
+        // In increasing order of capability
+        const std::vector<InstructionSet> c_instructionSets = {
+            { "sse4.2", "+sse4.2,+popcnt", c_sse42Ecx, 0, 0 },
+            { "avx2", "+avx2,+fma,+f16c,+bmi,+bmi2,+popcnt", c_avxEcx, c_avx2Ebx, c_avxXcr0 },
+            { "avx512", "+avx512f,+avx512cd,+avx512bw,+avx512dq,+avx512vl,+avx2,+fma,+f16c,+bmi,+bmi2,+popcnt", c_avxEcx, c_avx512Ebx, c_avx512Xcr0 }
+        };
+
+        // Returns the given function and all the functions defined in the module that it calls or
+        // otherwise refers to (e.g., tasks passed to the thread pool), directly or indirectly
+        std::vector<llvm::Function*> GetFunctionAndDependencies(llvm::Function* pFunction)
+        {
+            std::vector<llvm::Function*> result = { pFunction };
+            std::unordered_set<llvm::Function*> visited = { pFunction };
+            for (size_t index = 0; index < result.size(); ++index)
+            {
+                for (auto& block : *result[index])
+                {
+                    for (auto& instruction : block)
+                    {
+                        for (auto& operand : instruction.operands())
+                        {
+                            auto pReferencedFunction = llvm::dyn_cast<llvm::Function>(operand->stripPointerCasts());
+                            if (pReferencedFunction != nullptr && !pReferencedFunction->isDeclaration() && visited.insert(pReferencedFunction).second)
+                            {
+                                result.push_back(pReferencedFunction);
+                            }
+                        }
+                    }
+                }
+            }
+            return result;
+        }
+
+        // Clones a set of functions, redirecting the references between them to the clones
+        std::vector<llvm::Function*> CloneFunctions(const std::vector<llvm::Function*>& functions, const std::string& suffix)
+        {
+            llvm::ValueToValueMapTy valueMap;
+            std::vector<llvm::Function*> clones;
+            for (auto pFunction : functions)
+            {
+                auto pClone = llvm::Function::Create(pFunction->getFunctionType(), llvm::Function::InternalLinkage, pFunction->getName() + suffix, pFunction->getParent());
+                valueMap[pFunction] = pClone;
+                clones.push_back(pClone);
+            }
+
+            for (size_t index = 0; index < functions.size(); ++index)
+            {
+                auto pFunction = functions[index];
+                auto pClone = clones[index];
+                auto cloneArgument = pClone->arg_begin();
+                for (auto& argument : pFunction->args())
+                {
+                    cloneArgument->setName(argument.getName());
+                    valueMap[&argument] = &(*cloneArgument);
+                    ++cloneArgument;
+                }
+
+                llvm::SmallVector<llvm::ReturnInst*, 4> returns;
+                llvm::CloneFunctionInto(pClone, pFunction, valueMap, false, returns);
+
+                // Variants are only reachable through the dispatcher, and shouldn't show up in the headers
+                pClone->setLinkage(llvm::Function::InternalLinkage);
+                pClone->clearMetadata();
+            }
+            return clones;
+        }
+
+        // Emits `cpuid` for the given leaf and subleaf, returning { eax, ebx, ecx, edx }
+        llvm::Value* EmitCpuid(llvm::IRBuilder<>& builder, uint32_t leaf, uint32_t subleaf)
+        {
+            llvm::Type* int32Type = builder.getInt32Ty();
+            auto resultType = llvm::StructType::get(int32Type, int32Type, int32Type, int32Type, nullptr);
+            auto asmType = llvm::FunctionType::get(resultType, { int32Type, int32Type }, false);
+            auto cpuid = llvm::InlineAsm::get(asmType, "cpuid", "={ax},={bx},={cx},={dx},{ax},{cx},~{dirflag},~{fpsr},~{flags}", false);
+            return builder.CreateCall(cpuid, { builder.getInt32(leaf), builder.getInt32(subleaf) });
+        }
+
+        // Emits `xgetbv` for XCR0, returning the low 32 bits. Only valid if CPUID reports OSXSAVE.
+        llvm::Value* EmitXgetbv(llvm::IRBuilder<>& builder)
+        {
+            llvm::Type* int32Type = builder.getInt32Ty();
+            auto resultType = llvm::StructType::get(int32Type, int32Type, nullptr);
+            auto asmType = llvm::FunctionType::get(resultType, { int32Type }, false);
+            auto xgetbv = llvm::InlineAsm::get(asmType, "xgetbv", "={ax},={dx},{cx},~{dirflag},~{fpsr},~{flags}", false);
+            return builder.CreateExtractValue(builder.CreateCall(xgetbv, { builder.getInt32(0) }), 0);
+        }
+
+        llvm::Value* EmitHasAllBits(llvm::IRBuilder<>& builder, llvm::Value* pValue, uint32_t bits)
+        {
+            return builder.CreateICmpEQ(builder.CreateAnd(pValue, builder.getInt32(bits)), builder.getInt32(bits));
+        }
+
+        // Emits a function that returns the best variant the CPU supports
+        llvm::Function* EmitVariantSelector(llvm::Module& module, const std::string& name, llvm::Function* pGenericVariant, const std::vector<std::pair<const InstructionSet*, llvm::Function*>>& variants)
+        {
+            auto& context = module.getContext();
+            auto pointerType = pGenericVariant->getType();
+            auto pSelector = llvm::Function::Create(llvm::FunctionType::get(pointerType, false), llvm::Function::InternalLinkage, name, &module);
+            pSelector->addFnAttr(llvm::Attribute::NoInline);
+
+            auto pEntryBlock = llvm::BasicBlock::Create(context, "entry", pSelector);
+            auto pLeaf7Block = llvm::BasicBlock::Create(context, "leaf7", pSelector);
+            auto pCheckXsaveBlock = llvm::BasicBlock::Create(context, "checkXsave", pSelector);
+            auto pXgetbvBlock = llvm::BasicBlock::Create(context, "xgetbv", pSelector);
+            auto pSelectBlock = llvm::BasicBlock::Create(context, "select", pSelector);
+            llvm::IRBuilder<> builder(pEntryBlock);
+            auto int32Type = builder.getInt32Ty();
+
+            // Leaf 7 (extended features) is only valid if the CPU reports it
+            auto pMaxLeaf = builder.CreateExtractValue(EmitCpuid(builder, 0, 0), 0);
+            auto pLeaf1Ecx = builder.CreateExtractValue(EmitCpuid(builder, 1, 0), 2);
+            builder.CreateCondBr(builder.CreateICmpUGE(pMaxLeaf, builder.getInt32(7)), pLeaf7Block, pCheckXsaveBlock);
+
+            builder.SetInsertPoint(pLeaf7Block);
+            auto pCpuidLeaf7Ebx = builder.CreateExtractValue(EmitCpuid(builder, 7, 0), 1);
+            builder.CreateBr(pCheckXsaveBlock);
+
+            // The OS state bits in XCR0 are only readable if the OS has enabled XSAVE
+            builder.SetInsertPoint(pCheckXsaveBlock);
+            auto pLeaf7Ebx = builder.CreatePHI(int32Type, 2);
+            pLeaf7Ebx->addIncoming(builder.getInt32(0), pEntryBlock);
+            pLeaf7Ebx->addIncoming(pCpuidLeaf7Ebx, pLeaf7Block);
+            builder.CreateCondBr(EmitHasAllBits(builder, pLeaf1Ecx, 1u << 27), pXgetbvBlock, pSelectBlock);
+
+            builder.SetInsertPoint(pXgetbvBlock);
+            auto pXgetbvResult = EmitXgetbv(builder);
+            builder.CreateBr(pSelectBlock);
+
+            builder.SetInsertPoint(pSelectBlock);
+            auto pXcr0 = builder.CreatePHI(int32Type, 2);
+            pXcr0->addIncoming(builder.getInt32(0), pCheckXsaveBlock);
+            pXcr0->addIncoming(pXgetbvResult, pXgetbvBlock);
+
+            // The variants are in increasing order of capability, so later matches take precedence
+            llvm::Value* pResult = pGenericVariant;
+            for (const auto& variant : variants)
+            {
+                const auto& instructionSet = *variant.first;
+                auto pSupported = builder.CreateAnd(builder.CreateAnd(EmitHasAllBits(builder, pLeaf1Ecx, instructionSet.leaf1Ecx), EmitHasAllBits(builder, pLeaf7Ebx, instructionSet.leaf7Ebx)), EmitHasAllBits(builder, pXcr0, instructionSet.xcr0));
+                pResult = builder.CreateSelect(pSupported, variant.second, pResult);
+            }
+            builder.CreateRet(pResult);
+            return pSelector;
+        }
+
+        // Emits a function that returns the index, among the requested instruction sets, of the variant
+        // the selector picks, or -1 for the original code
+        void EmitGetVariantFunction(llvm::Module& module, const std::string& name, llvm::Function* pSelector, const std::vector<std::pair<int, llvm::Function*>>& variantIndices)
+        {
+            auto& context = module.getContext();
+            auto int32Type = llvm::Type::getInt32Ty(context);
+            auto pFunction = llvm::Function::Create(llvm::FunctionType::get(int32Type, false), llvm::Function::ExternalLinkage, name, &module);
+            llvm::IRBuilder<> builder(llvm::BasicBlock::Create(context, "entry", pFunction));
+
+            auto pSelectedVariant = builder.CreateCall(pSelector);
+            llvm::Value* pResult = llvm::ConstantInt::getSigned(int32Type, -1);
+            for (const auto& entry : variantIndices)
+            {
+                pResult = builder.CreateSelect(builder.CreateICmpEQ(pSelectedVariant, entry.second), builder.getInt32(entry.first), pResult);
+            }
+            builder.CreateRet(pResult);
+        }
+
+        const InstructionSet& GetInstructionSet(const std::string& name)
+        {
+            auto matchesName = [&name](const InstructionSet& instructionSet) { return instructionSet.name == name; };
+            auto instructionSet = std::find_if(c_instructionSets.begin(), c_instructionSets.end(), matchesName);
+            if (instructionSet == c_instructionSets.end())
+            {
+                throw EmitterException(EmitterError::notSupported, "Unknown instruction set for function variant: " + name);
+            }
+            return *instructionSet;
+        }
+
+        // Replaces the body of the function with one that forwards its arguments to the variant stored in
+        // `pVariantPointer`, calling the selector to fill it in on the first call
+        void EmitDispatcher(llvm::Function* pFunction, llvm::GlobalVariable* pVariantPointer, llvm::Function* pSelector)
+        {
+            // Keep the function's tags (e.g., "declare in header") and linkage
+            llvm::SmallVector<std::pair<unsigned, llvm::MDNode*>, 4> metadata;
+            pFunction->getAllMetadata(metadata);
+            auto linkage = pFunction->getLinkage();
+            pFunction->deleteBody();
+            pFunction->setLinkage(linkage);
+            for (const auto& entry : metadata)
+            {
+                pFunction->setMetadata(entry.first, entry.second);
+            }
+
+            auto& context = pFunction->getContext();
+            auto pointerAlignment = pFunction->getParent()->getDataLayout().getPointerABIAlignment();
+            auto pEntryBlock = llvm::BasicBlock::Create(context, "entry", pFunction);
+            auto pSelectBlock = llvm::BasicBlock::Create(context, "selectVariant", pFunction);
+            auto pCallBlock = llvm::BasicBlock::Create(context, "call", pFunction);
+            llvm::IRBuilder<> builder(pEntryBlock);
+
+            // Racing threads all store the same value, so relaxed atomics suffice
+            auto pLoadedVariant = builder.CreateLoad(pVariantPointer);
+            pLoadedVariant->setAlignment(pointerAlignment);
+            pLoadedVariant->setAtomic(llvm::AtomicOrdering::Monotonic);
+            builder.CreateCondBr(builder.CreateIsNull(pLoadedVariant), pSelectBlock, pCallBlock);
+
+            builder.SetInsertPoint(pSelectBlock);
+            auto pSelectedVariant = builder.CreateCall(pSelector);
+            auto pStore = builder.CreateStore(pSelectedVariant, pVariantPointer);
+            pStore->setAlignment(pointerAlignment);
+            pStore->setAtomic(llvm::AtomicOrdering::Monotonic);
+            builder.CreateBr(pCallBlock);
+
+            builder.SetInsertPoint(pCallBlock);
+            auto pVariant = builder.CreatePHI(pLoadedVariant->getType(), 2);
+            pVariant->addIncoming(pLoadedVariant, pEntryBlock);
+            pVariant->addIncoming(pSelectedVariant, pSelectBlock);
+            std::vector<llvm::Value*> arguments;
+            for (auto& argument : pFunction->args())
+            {
+                arguments.push_back(&argument);
+            }
+            auto pResult = builder.CreateCall(pVariant, arguments);
+            if (pFunction->getReturnType()->isVoidTy())
+            {
+                builder.CreateRetVoid();
+            }
+            else
+            {
+                builder.CreateRet(pResult);
+            }
+        }
+    }
+
+    void EmitFunctionVariants(IRModuleEmitter& moduleEmitter, const std::string& functionName, const std::vector<std::string>& instructionSets)
+    {
+        auto pModule = moduleEmitter.GetLLVMModule();
+        auto pFunction = pModule->getFunction(functionName);
+        if (pFunction == nullptr || pFunction->isDeclaration())
+        {
+            throw EmitterException(EmitterError::functionNotFound, "Can't emit variants of undefined function " + functionName);
+        }
+
+        auto triple = llvm::Triple(pModule->getTargetTriple().empty() ? llvm::sys::getDefaultTargetTriple() : pModule->getTargetTriple());
+        if (triple.getArch() != llvm::Triple::x86 && triple.getArch() != llvm::Triple::x86_64)
+        {
+            throw EmitterException(EmitterError::notSupported, "Function variants are only supported on x86 targets");
+        }
+
+        for (const auto& name : instructionSets)
+        {
+            GetInstructionSet(name);
+        }
+
+        // Keep the original code as the fallback for CPUs that support none of the variants
+        auto functions = GetFunctionAndDependencies(pFunction);
+        auto pGenericVariant = CloneFunctions({ pFunction }, "_generic")[0];
+
+        std::vector<std::pair<const InstructionSet*, llvm::Function*>> variants;
+        std::vector<std::pair<int, llvm::Function*>> variantIndices;
+        for (const auto& instructionSet : c_instructionSets)
+        {
+            auto requested = std::find(instructionSets.begin(), instructionSets.end(), instructionSet.name);
+            if (requested == instructionSets.end())
+            {
+                continue;
+            }
+
+            std::string suffix = "_" + instructionSet.name;
+            std::replace(suffix.begin(), suffix.end(), '.', '_');
+            auto clones = CloneFunctions(functions, suffix);
+            for (auto pClone : clones)
+            {
+                // Use a generic CPU, so the CPU of the target device doesn't imply more features than the variant's
+                pClone->addFnAttr("target-cpu", triple.getArch() == llvm::Triple::x86_64 ? "x86-64" : "i686");
+                pClone->addFnAttr("target-features", instructionSet.features);
+            }
+            variants.emplace_back(&instructionSet, clones[0]);
+            variantIndices.emplace_back(static_cast<int>(requested - instructionSets.begin()), clones[0]);
+        }
+
+        auto pointerType = pFunction->getType();
+        auto pVariantPointer = new llvm::GlobalVariable(*pModule, pointerType, false, llvm::GlobalValue::InternalLinkage, llvm::ConstantPointerNull::get(pointerType), functionName + "_variant");
+        auto pSelector = EmitVariantSelector(*pModule, functionName + "_SelectVariant", pGenericVariant, variants);
+        EmitDispatcher(pFunction, pVariantPointer, pSelector);
+        EmitGetVariantFunction(*pModule, functionName + "_GetVariant", pSelector, variantIndices);
+    }
+
+    std::string GetFunctionVariantFeatures(const std::string& instructionSet)
+    {
+        return GetInstructionSet(instructionSet).features;
+    }
+}
+}
@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     IRLazyJit.cpp (emitters)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "IRLazyJit.h"
+#include "EmitterException.h"
+
+// llvm
+#include "llvm/ExecutionEngine/Orc/LambdaResolver.h"
+#include "llvm/ExecutionEngine/RTDyldMemoryManager.h"
+#include "llvm/ExecutionEngine/SectionMemoryManager.h"
+#include "llvm/IR/Mangler.h"
+#include "llvm/Support/DynamicLibrary.h"
+#include "llvm/Support/raw_ostream.h"
+
+// stl
+#include <set>
+#include <vector>
+
+namespace ell
+{
+namespace emitters
+{
+    namespace
+    {
+        // Put each function in its own partition, so functions are compiled one at a time
+        std::set<llvm::Function*> ExtractSingleFunction(llvm::Function& function)
+        {
+            return { &function };
+        }
+    }
+
+    IRLazyJit::IRLazyJit(std::unique_ptr<llvm::TargetMachine> pTargetMachine)
+        : _pTargetMachine(std::move(pTargetMachine)), _dataLayout(_pTargetMachine->createDataLayout()), _pCompileCallbackManager(llvm::orc::createLocalCompileCallbackManager(_pTargetMachine->getTargetTriple(), 0)), _compileLayer(_objectLayer, llvm::orc::SimpleCompiler(*_pTargetMachine))
+    {
+        auto indirectStubsManagerBuilder = llvm::orc::createLocalIndirectStubsManagerBuilder(_pTargetMachine->getTargetTriple());
+        if (_pCompileCallbackManager == nullptr || !indirectStubsManagerBuilder)
+        {
+            throw EmitterException(EmitterError::notSupported, "Lazy JIT compilation isn't supported on this architecture");
+        }
+        _pCompileOnDemandLayer = std::make_unique<CompileOnDemandLayer>(_compileLayer, ExtractSingleFunction, *_pCompileCallbackManager, std::move(indirectStubsManagerBuilder));
+
+        // Make the symbols of the host process (e.g., runtime functions called by emitted code) visible to the JIT
+        llvm::sys::DynamicLibrary::LoadLibraryPermanently(nullptr);
+    }
+
+    void IRLazyJit::AddModule(std::unique_ptr<llvm::Module> pModule)
+    {
+        if (pModule->getDataLayout().isDefault())
+        {
+            pModule->setDataLayout(_dataLayout);
+        }
+
+        // Resolve symbols first against the JIT'd code, then against the host process
+        auto resolver = llvm::orc::createLambdaResolver(
+            [this](const std::string& name) {
+                if (auto symbol = _pCompileOnDemandLayer->findSymbol(name, false))
+                {
+                    return symbol.toRuntimeDyldSymbol();
+                }
+                if (auto address = llvm::RTDyldMemoryManager::getSymbolAddressInProcess(name))
+                {
+                    return llvm::RuntimeDyld::SymbolInfo(address, llvm::JITSymbolFlags::Exported);
+                }
+                return llvm::RuntimeDyld::SymbolInfo(nullptr);
+            },
+            [](const std::string& name) { return llvm::RuntimeDyld::SymbolInfo(nullptr); });
+
+        std::vector<std::unique_ptr<llvm::Module>> modules;
+        modules.push_back(std::move(pModule));
+        _pCompileOnDemandLayer->addModuleSet(std::move(modules), std::make_unique<llvm::SectionMemoryManager>(), std::move(resolver));
+    }
+
+    uint64_t IRLazyJit::GetFunctionAddress(const std::string& name)
+    {
+        auto symbol = _pCompileOnDemandLayer->findSymbol(Mangle(name), true);
+        return symbol ? symbol.getAddress() : 0;
+    }
+
+    bool IRLazyJit::IsFunctionCompiled(const std::string& name)
+    {
+        // The compile-on-demand layer only hands a function's body to the compile layer when its stub is first called
+        return static_cast<bool>(_compileLayer.findSymbol(Mangle(name), false));
+    }
+
+    std::string IRLazyJit::Mangle(const std::string& name) const
+    {
+        std::string mangledName;
+        {
+            llvm::raw_string_ostream mangledNameStream(mangledName);
+            llvm::Mangler::getNameWithPrefix(mangledNameStream, name, _dataLayout);
+        }
+        return mangledName;
+    }
+}
+}
@@ -8,6 +8,15 @@
 #include "IRLoopEmitter.h"
 #include "IRFunctionEmitter.h"
 
+// llvm
+#include "llvm/IR/CFG.h"
+#include "llvm/IR/Metadata.h"
+
+// stl
+#include <set>
+#include <string>
+#include <vector>
+
 namespace ell
 {
 namespace emitters
@@ -24,11 +33,13 @@ namespace emitters
 
         // Caller is done generating the body. Add a branch from the Body block to the increment block
         _functionEmitter.Branch(_pIncrementBlock);
+        AddHintMetadata();
         _functionEmitter.SetCurrentBlock(_pAfterBlock);
     }
 
     void IRForLoopEmitter::Clear()
     {
+        _hints = LoopHints();
         _pInitializationBlock = nullptr;
         _pConditionBlock = nullptr;
         _pBodyBlock = nullptr;
@@ -63,10 +74,20 @@ namespace emitters
     {
         assert(pRepeatCount != nullptr);
 
+        // the iteration variable has the type of the count, so 64-bit counts get a 64-bit index
         CreateBlocks();
-        EmitIterationVariable(VariableType::Int32, _functionEmitter.Literal(0));
-        EmitCondition(TypedComparison::lessThan, pRepeatCount);
-        EmitIncrement(VariableType::Int32, _functionEmitter.Literal(1));
+        if (pRepeatCount->getType()->isIntegerTy(64))
+        {
+            EmitIterationVariable(VariableType::Int64, _functionEmitter.Literal(static_cast<int64_t>(0)));
+            EmitCondition(TypedComparison::lessThan, pRepeatCount);
+            EmitIncrement(VariableType::Int64, _functionEmitter.Literal(static_cast<int64_t>(1)));
+        }
+        else
+        {
+            EmitIterationVariable(VariableType::Int32, _functionEmitter.Literal(0));
+            EmitCondition(TypedComparison::lessThan, pRepeatCount);
+            EmitIncrement(VariableType::Int32, _functionEmitter.Literal(1));
+        }
         return PrepareBody();
     }
 
@@ -123,5 +144,85 @@ namespace emitters
         _functionEmitter.SetCurrentBlock(_pBodyBlock);
         return _pBodyBlock;
     }
+
+    void IRForLoopEmitter::AddHintMetadata()
+    {
+        if (_hints.unrollCount <= 0 && _hints.vectorizeWidth <= 0 && _hints.interleaveCount <= 0 && !_hints.parallelAccesses)
+        {
+            return;
+        }
+
+        auto& context = _functionEmitter.GetLLVMContext();
+        auto hint = [&context](const std::string& name, llvm::Metadata* pValue) -> llvm::Metadata* {
+            if (pValue == nullptr)
+            {
+                return llvm::MDNode::get(context, { llvm::MDString::get(context, name) });
+            }
+            return llvm::MDNode::get(context, { llvm::MDString::get(context, name), pValue });
+        };
+        auto intValue = [&context](int value) {
+            return llvm::ConstantAsMetadata::get(llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), value));
+        };
+
+        // The loop ID is a distinct node whose first operand refers to itself, followed by the hints
+        std::vector<llvm::Metadata*> operands = { nullptr };
+        if (_hints.unrollCount == 1)
+        {
+            operands.push_back(hint("llvm.loop.unroll.disable", nullptr));
+        }
+        else if (_hints.unrollCount > 1)
+        {
+            operands.push_back(hint("llvm.loop.unroll.count", intValue(_hints.unrollCount)));
+        }
+        if (_hints.vectorizeWidth > 0)
+        {
+            operands.push_back(hint("llvm.loop.vectorize.width", intValue(_hints.vectorizeWidth)));
+        }
+        if (_hints.interleaveCount > 0)
+        {
+            operands.push_back(hint("llvm.loop.interleave.count", intValue(_hints.interleaveCount)));
+        }
+        auto pLoopId = llvm::MDNode::getDistinct(context, operands);
+        pLoopId->replaceOperandWith(0, pLoopId);
+
+        // The loop's back edge is the branch at the end of the increment block
+        _pIncrementBlock->getTerminator()->setMetadata(llvm::LLVMContext::MD_loop, pLoopId);
+
+        if (_hints.parallelAccesses)
+        {
+            // Every memory access in the loop, including those in nested loops, is tagged with a list of the
+            // parallel loops it belongs to
+            std::vector<llvm::BasicBlock*> blocks = { _pBodyBlock };
+            std::set<llvm::BasicBlock*> visited = { _pBodyBlock, _pConditionBlock, _pAfterBlock };
+            for (size_t index = 0; index < blocks.size(); ++index)
+            {
+                for (auto pSuccessor : llvm::successors(blocks[index]))
+                {
+                    if (visited.insert(pSuccessor).second)
+                    {
+                        blocks.push_back(pSuccessor);
+                    }
+                }
+            }
+
+            for (auto pBlock : blocks)
+            {
+                for (auto& instruction : *pBlock)
+                {
+                    if (!instruction.mayReadOrWriteMemory())
+                    {
+                        continue;
+                    }
+
+                    std::vector<llvm::Metadata*> loopIds = { pLoopId };
+                    if (auto pExisting = instruction.getMetadata(llvm::LLVMContext::MD_mem_parallel_loop_access))
+                    {
+                        loopIds.insert(loopIds.begin(), pExisting->op_begin(), pExisting->op_end());
+                    }
+                    instruction.setMetadata(llvm::LLVMContext::MD_mem_parallel_loop_access, llvm::MDNode::get(context, loopIds));
+                }
+            }
+        }
+    }
 }
 }
\ No newline at end of file
@@ -14,6 +14,7 @@
 #include "IRHeaderWriter.h"
 #include "IRLoader.h"
 #include "IRMetadata.h"
+#include "IROptimizer.h"
 #include "IRSwigInterfaceWriter.h"
 
 // utilities
@@ -23,6 +24,8 @@
 #include "llvm/AsmParser/Parser.h"
 #include "llvm/Bitcode/ReaderWriter.h"
 #include "llvm/IR/TypeBuilder.h"
+#include "llvm/Support/Host.h"
+#include "llvm/Support/TargetRegistry.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/ToolOutputFile.h"
 #include "llvm/Support/raw_os_ostream.h"
@@ -39,6 +42,24 @@ namespace emitters
         static llvm::LLVMContext g_globalLLVMContext;
         static bool g_llvmIsInitialized = false;
         static std::unique_ptr<IRDiagnosticHandler> g_globalDiagnosticHandler = nullptr;
+
+        // The alignment, in bytes, of global arrays (one AVX register)
+        static const unsigned c_globalArrayAlignment = 32;
+
+        // Returns nullptr if the target isn't available
+        std::unique_ptr<llvm::TargetMachine> CreateTargetMachine(const TargetDevice& targetDevice)
+        {
+            auto tripleString = targetDevice.triple.empty() ? llvm::sys::getDefaultTargetTriple() : targetDevice.triple;
+            llvm::Triple triple(llvm::Triple::normalize(tripleString));
+            std::string error;
+            const llvm::Target* target = llvm::TargetRegistry::lookupTarget(targetDevice.architecture, triple, error);
+            if (target == nullptr)
+            {
+                return nullptr;
+            }
+
+            return std::unique_ptr<llvm::TargetMachine>(target->createTargetMachine(triple.getTriple(), targetDevice.cpu, targetDevice.features, llvm::TargetOptions(), llvm::Reloc::Static));
+        }
     }
 
     //
@@ -353,7 +374,14 @@ namespace emitters
     // This is the actual implementation --- we should call it something different and/or put it in IREmitter
     llvm::GlobalVariable* IRModuleEmitter::Global(const std::string& name, llvm::Type* pType, llvm::Constant* pInitial, bool isConst)
     {
-        return new llvm::GlobalVariable(*GetLLVMModule(), pType, isConst, llvm::GlobalValue::InternalLinkage, pInitial, name); // TODO: make sure we really want to return a new'd pointer
+        auto pGlobal = new llvm::GlobalVariable(*GetLLVMModule(), pType, isConst, llvm::GlobalValue::InternalLinkage, pInitial, name); // TODO: make sure we really want to return a new'd pointer
+
+        // Align arrays for the widest vector loads, so vectorized loops over them don't need a peeled prologue
+        if (pType->isArrayTy())
+        {
+            pGlobal->setAlignment(c_globalArrayAlignment);
+        }
+        return pGlobal;
     }
 
     //
@@ -609,8 +637,16 @@ namespace emitters
 
     void IRModuleEmitter::Optimize()
     {
+        // Use the target's cost model, if we have one
+        const auto& parameters = GetCompilerParameters();
+        auto pTargetMachine = CreateTargetMachine(parameters.targetDevice);
+        if (pTargetMachine && GetLLVMModule()->getDataLayout().isDefault())
+        {
+            SetTargetMachine(pTargetMachine.get());
+        }
+
         IRModuleOptimizer optimizer;
-        optimizer.AddStandardPasses();
+        optimizer.AddStandardPasses(parameters.optimizerLevel, pTargetMachine.get());
         Optimize(optimizer);
     }
 
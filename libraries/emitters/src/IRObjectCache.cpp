@@ -0,0 +1,79 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     IRObjectCache.cpp (emitters)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "IRObjectCache.h"
+
+// utilities
+#include "Files.h"
+
+// stl
+#include <cstdio>
+#include <fstream>
+
+namespace ell
+{
+namespace emitters
+{
+    IRObjectCache::IRObjectCache(const std::string& directory, const std::string& key)
+        : _directory(directory), _key(key)
+    {
+    }
+
+    bool IRObjectCache::HasObject() const
+    {
+        return utilities::IsFileReadable(GetObjectPath());
+    }
+
+    std::string IRObjectCache::GetObjectPath() const
+    {
+        return utilities::JoinPaths(_directory, _key + ".o");
+    }
+
+    void IRObjectCache::notifyObjectCompiled(const llvm::Module* pModule, llvm::MemoryBufferRef object)
+    {
+        // Write to a temporary file first, so a concurrent reader never sees a partially-written object
+        auto objectPath = GetObjectPath();
+        auto tempPath = objectPath + ".tmp";
+        {
+            std::ofstream stream(tempPath, std::ios::out | std::ios::binary);
+            if (!stream)
+            {
+                // Failing to populate the cache isn't an error: the code will just be generated again next time
+                return;
+            }
+            stream.write(object.getBufferStart(), object.getBufferSize());
+            if (!stream)
+            {
+                stream.close();
+                std::remove(tempPath.c_str());
+                return;
+            }
+        }
+
+        std::remove(objectPath.c_str());
+        if (std::rename(tempPath.c_str(), objectPath.c_str()) != 0)
+        {
+            std::remove(tempPath.c_str());
+            return;
+        }
+        ++_numObjectsStored;
+    }
+
+    std::unique_ptr<llvm::MemoryBuffer> IRObjectCache::getObject(const llvm::Module* pModule)
+    {
+        auto buffer = llvm::MemoryBuffer::getFile(GetObjectPath());
+        if (!buffer)
+        {
+            return nullptr;
+        }
+
+        ++_numObjectsLoaded;
+        return std::move(*buffer);
+    }
+}
+}
@@ -11,6 +11,10 @@
 #include "LLVMInclude.h"
 
 // llvm
+#include "llvm/Analysis/TargetLibraryInfo.h"
+#include "llvm/Analysis/TargetTransformInfo.h"
+#include "llvm/Transforms/IPO.h"
+#include "llvm/Transforms/IPO/PassManagerBuilder.h"
 #include "llvm/Transforms/Scalar.h"
 #include "llvm/Transforms/Scalar/GVN.h"
 
@@ -70,6 +74,51 @@ namespace emitters
 {
     using namespace llvm;
 
+    namespace
+    {
+        void ConfigurePassManagerBuilder(PassManagerBuilder& builder, OptimizerLevel level)
+        {
+            switch (level)
+            {
+                case OptimizerLevel::O1:
+                    builder.OptLevel = 1;
+                    builder.SizeLevel = 0;
+                    break;
+                case OptimizerLevel::O2:
+                    builder.OptLevel = 2;
+                    builder.SizeLevel = 0;
+                    break;
+                case OptimizerLevel::O3:
+                    builder.OptLevel = 3;
+                    builder.SizeLevel = 0;
+                    break;
+                case OptimizerLevel::Os:
+                    builder.OptLevel = 2;
+                    builder.SizeLevel = 1;
+                    break;
+            }
+
+            // Same as clang: vectorize at -O2 and above (including -Os)
+            builder.LoopVectorize = builder.OptLevel > 1;
+            builder.SLPVectorize = builder.OptLevel > 1;
+        }
+
+        // Adds the target's cost model and library info, so that passes like the vectorizers and
+        // the loop unroller make decisions for the actual target
+        template <typename PassManagerType>
+        void AddTargetAnalysisPasses(PassManagerType& passes, llvm::TargetMachine* pTargetMachine)
+        {
+            if (pTargetMachine == nullptr)
+            {
+                passes.add(createTargetTransformInfoWrapperPass(TargetIRAnalysis()));
+                return;
+            }
+
+            passes.add(new TargetLibraryInfoWrapperPass(TargetLibraryInfoImpl(pTargetMachine->getTargetTriple())));
+            passes.add(createTargetTransformInfoWrapperPass(pTargetMachine->getTargetIRAnalysis()));
+        }
+    }
+
     IRFunctionOptimizer::IRFunctionOptimizer(llvm::Module* pModule)
     {
         assert(pModule != nullptr);
@@ -87,7 +136,16 @@ namespace emitters
         AddInstructionCombiner();
         AddVectorizationPasses();
     }
-    
+
+    void IRFunctionOptimizer::AddStandardPasses(OptimizerLevel level, llvm::TargetMachine* pTargetMachine)
+    {
+        AddTargetAnalysisPasses(*_pPasses, pTargetMachine);
+
+        PassManagerBuilder builder;
+        ConfigurePassManagerBuilder(builder, level);
+        builder.populateFunctionPassManager(*_pPasses);
+    }
+
     // void IRFunctionOptimizer::AddPassByName(const std::string& pass)
     // {
 // -aa
@@ -222,12 +280,23 @@ namespace emitters
 
     void IRModuleOptimizer::AddStandardPasses()
     {
+        AddStandardPasses(OptimizerLevel::O2, nullptr);
+    }
+
+    void IRModuleOptimizer::AddStandardPasses(OptimizerLevel level, llvm::TargetMachine* pTargetMachine)
+    {
+        AddTargetAnalysisPasses(_passes, pTargetMachine);
+
+        PassManagerBuilder builder;
+        ConfigurePassManagerBuilder(builder, level);
+        builder.Inliner = createFunctionInliningPass(builder.OptLevel, builder.SizeLevel);
+        builder.populateModulePassManager(_passes);
     }
 
     void IRModuleOptimizer::Run(llvm::Module* pModule)
     {
         assert(pModule != nullptr);
-        _passes.run(*pModule, _analysis);
+        _passes.run(*pModule);
     }
 }
 }
@@ -0,0 +1,454 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     IRReentrantFunction.cpp (emitters)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "IRReentrantFunction.h"
+#include "EmitterException.h"
+
+// llvm
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/Instructions.h"
+
+// stl
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace ell
+{
+namespace emitters
+{
+    namespace
+    {
+        using GlobalSet = std::unordered_set<llvm::GlobalVariable*>;
+        using FunctionSet = std::unordered_set<llvm::Function*>;
+
+        // Mutable globals the emitter creates for port buffers and node state
+        bool IsStateGlobal(const llvm::GlobalVariable* pGlobal)
+        {
+            return !pGlobal->isConstant() && pGlobal->hasInitializer() && pGlobal->hasLocalLinkage();
+        }
+
+        // Adds the state globals a constant refers to (e.g., through a constant GEP) to `globals`
+        void AddStateGlobals(const llvm::Constant* pConstant, GlobalSet& globals)
+        {
+            auto pGlobal = llvm::dyn_cast<llvm::GlobalVariable>(pConstant);
+            if (pGlobal != nullptr)
+            {
+                if (IsStateGlobal(pGlobal))
+                {
+                    globals.insert(const_cast<llvm::GlobalVariable*>(pGlobal));
+                }
+                return;
+            }
+
+            if (llvm::isa<llvm::GlobalValue>(pConstant))
+            {
+                return;
+            }
+
+            for (auto& operand : pConstant->operands())
+            {
+                if (auto pOperand = llvm::dyn_cast<llvm::Constant>(operand.get()))
+                {
+                    AddStateGlobals(pOperand, globals);
+                }
+            }
+        }
+
+        bool RefersToAny(const llvm::Constant* pConstant, const std::unordered_map<llvm::GlobalVariable*, llvm::Value*>& globals)
+        {
+            GlobalSet referencedGlobals;
+            AddStateGlobals(pConstant, referencedGlobals);
+            for (auto pGlobal : referencedGlobals)
+            {
+                if (globals.find(pGlobal) != globals.end())
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Returns true if every use of the value, looking through constant expressions, is in one of the given functions
+        bool IsOnlyUsedIn(llvm::Value* pValue, const FunctionSet& functions)
+        {
+            for (auto pUser : pValue->users())
+            {
+                if (auto pInstruction = llvm::dyn_cast<llvm::Instruction>(pUser))
+                {
+                    if (functions.find(pInstruction->getParent()->getParent()) == functions.end())
+                    {
+                        return false;
+                    }
+                }
+                else if (!llvm::isa<llvm::ConstantExpr>(pUser) || !IsOnlyUsedIn(pUser, functions))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Returns the function and all the functions defined in the module that it refers to, directly or indirectly
+        std::vector<llvm::Function*> GetReachableFunctions(llvm::Function* pFunction)
+        {
+            std::vector<llvm::Function*> result = { pFunction };
+            FunctionSet visited = { pFunction };
+            for (size_t index = 0; index < result.size(); ++index)
+            {
+                for (auto& block : *result[index])
+                {
+                    for (auto& instruction : block)
+                    {
+                        for (auto& operand : instruction.operands())
+                        {
+                            auto pReferencedFunction = llvm::dyn_cast<llvm::Function>(operand->stripPointerCasts());
+                            if (pReferencedFunction != nullptr && !pReferencedFunction->isDeclaration() && visited.insert(pReferencedFunction).second)
+                            {
+                                result.push_back(pReferencedFunction);
+                            }
+                        }
+                    }
+                }
+            }
+            return result;
+        }
+
+        GlobalSet GetStateGlobalsUsedBy(llvm::Function* pFunction)
+        {
+            GlobalSet globals;
+            for (auto& block : *pFunction)
+            {
+                for (auto& instruction : block)
+                {
+                    for (auto& operand : instruction.operands())
+                    {
+                        if (auto pConstant = llvm::dyn_cast<llvm::Constant>(operand.get()))
+                        {
+                            AddStateGlobals(pConstant, globals);
+                        }
+                    }
+                }
+            }
+            return globals;
+        }
+
+        // Returns the functions that call `pCallee`, or throws if anything else refers to it (e.g., passes it to the thread pool)
+        FunctionSet GetCallers(llvm::Function* pCallee)
+        {
+            FunctionSet callers;
+            for (auto pUser : pCallee->users())
+            {
+                auto pCall = llvm::dyn_cast<llvm::CallInst>(pUser);
+                if (pCall == nullptr || pCall->getCalledValue() != pCallee)
+                {
+                    throw EmitterException(EmitterError::notSupported, "Can't pass a context to " + pCallee->getName().str() + ", since it's called indirectly");
+                }
+                callers.insert(pCall->getParent()->getParent());
+            }
+            return callers;
+        }
+
+        // Moves the attributes of parameter i to parameter i + 1, making room for the context parameter
+        llvm::AttributeSet ShiftParameterAttributes(llvm::LLVMContext& context, const llvm::AttributeSet& attributes, unsigned numParameters)
+        {
+            llvm::SmallVector<llvm::AttributeSet, 8> shiftedAttributes;
+            if (attributes.hasAttributes(llvm::AttributeSet::ReturnIndex))
+            {
+                shiftedAttributes.push_back(llvm::AttributeSet::get(context, attributes.getRetAttributes()));
+            }
+
+            // Parameter attribute indices are one-based
+            for (unsigned index = 1; index <= numParameters; ++index)
+            {
+                if (attributes.hasAttributes(index))
+                {
+                    llvm::AttrBuilder builder(attributes, index);
+                    shiftedAttributes.push_back(llvm::AttributeSet::get(context, index + 1, builder));
+                }
+            }
+
+            if (attributes.hasAttributes(llvm::AttributeSet::FunctionIndex))
+            {
+                shiftedAttributes.push_back(llvm::AttributeSet::get(context, attributes.getFnAttributes()));
+            }
+            return llvm::AttributeSet::get(context, shiftedAttributes);
+        }
+
+        // Creates a copy of the function's declaration with a context pointer as a new first parameter,
+        // and moves the function's body into it
+        llvm::Function* AddContextParameter(llvm::Function* pFunction, llvm::Type* pContextPointerType)
+        {
+            auto pFunctionType = pFunction->getFunctionType();
+            std::vector<llvm::Type*> parameterTypes = { pContextPointerType };
+            parameterTypes.insert(parameterTypes.end(), pFunctionType->param_begin(), pFunctionType->param_end());
+            auto pNewFunctionType = llvm::FunctionType::get(pFunctionType->getReturnType(), parameterTypes, pFunctionType->isVarArg());
+
+            auto pNewFunction = llvm::Function::Create(pNewFunctionType, pFunction->getLinkage(), "", pFunction->getParent());
+            pNewFunction->takeName(pFunction);
+            pNewFunction->copyAttributesFrom(pFunction);
+            pNewFunction->setAttributes(ShiftParameterAttributes(pFunction->getContext(), pFunction->getAttributes(), pFunctionType->getNumParams()));
+
+            // Keep the function's tags (e.g., "declare in header")
+            llvm::SmallVector<std::pair<unsigned, llvm::MDNode*>, 4> metadata;
+            pFunction->getAllMetadata(metadata);
+            for (const auto& entry : metadata)
+            {
+                pNewFunction->setMetadata(entry.first, entry.second);
+            }
+
+            pNewFunction->getBasicBlockList().splice(pNewFunction->begin(), pFunction->getBasicBlockList());
+            auto newArgument = pNewFunction->arg_begin();
+            newArgument->setName("context");
+            ++newArgument;
+            for (auto& argument : pFunction->args())
+            {
+                argument.replaceAllUsesWith(&(*newArgument));
+                newArgument->takeName(&argument);
+                ++newArgument;
+            }
+            return pNewFunction;
+        }
+
+        // Replaces a call to a function that got a context parameter with a call to the new function
+        void ReplaceCall(llvm::CallInst* pCall, llvm::Function* pNewCallee, llvm::Value* pContext)
+        {
+            std::vector<llvm::Value*> arguments = { pContext };
+            arguments.insert(arguments.end(), pCall->arg_operands().begin(), pCall->arg_operands().end());
+            auto pNewCall = llvm::CallInst::Create(pNewCallee, arguments, "", pCall);
+            pNewCall->setCallingConv(pCall->getCallingConv());
+            pNewCall->setAttributes(ShiftParameterAttributes(pCall->getContext(), pCall->getAttributes(), pCall->getNumArgOperands()));
+            pNewCall->setTailCallKind(pCall->getTailCallKind());
+            pNewCall->setDebugLoc(pCall->getDebugLoc());
+            pNewCall->takeName(pCall);
+            pCall->replaceAllUsesWith(pNewCall);
+            pCall->eraseFromParent();
+        }
+
+        // Replaces the uses of globals in the function with the given values, expanding any constant expressions
+        // that refer to them into instructions
+        void ReplaceGlobals(llvm::Function* pFunction, const std::unordered_map<llvm::GlobalVariable*, llvm::Value*>& replacements)
+        {
+            std::vector<llvm::Instruction*> instructions;
+            for (auto& block : *pFunction)
+            {
+                for (auto& instruction : block)
+                {
+                    instructions.push_back(&instruction);
+                }
+            }
+
+            while (!instructions.empty())
+            {
+                auto pInstruction = instructions.back();
+                instructions.pop_back();
+                for (unsigned index = 0; index < pInstruction->getNumOperands(); ++index)
+                {
+                    auto pOperand = pInstruction->getOperand(index);
+                    if (auto pGlobal = llvm::dyn_cast<llvm::GlobalVariable>(pOperand))
+                    {
+                        auto replacement = replacements.find(pGlobal);
+                        if (replacement != replacements.end())
+                        {
+                            pInstruction->setOperand(index, replacement->second);
+                        }
+                    }
+                    else if (auto pExpression = llvm::dyn_cast<llvm::ConstantExpr>(pOperand))
+                    {
+                        if (RefersToAny(pExpression, replacements))
+                        {
+                            // A phi's operands must be available at the end of the incoming block
+                            auto pExpandedExpression = pExpression->getAsInstruction();
+                            auto pPhi = llvm::dyn_cast<llvm::PHINode>(pInstruction);
+                            pExpandedExpression->insertBefore(pPhi != nullptr ? pPhi->getIncomingBlock(index)->getTerminator() : pInstruction);
+                            pInstruction->setOperand(index, pExpandedExpression);
+                            instructions.push_back(pExpandedExpression);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void EmitReentrantFunction(IRModuleEmitter& moduleEmitter, const std::string& functionName, const std::string& contextFunctionPrefix)
+    {
+        auto pModule = moduleEmitter.GetLLVMModule();
+        auto pFunction = pModule->getFunction(functionName);
+        if (pFunction == nullptr || pFunction->isDeclaration())
+        {
+            throw EmitterException(EmitterError::functionNotFound, "Can't make undefined function " + functionName + " reentrant");
+        }
+
+        // Find the state the function uses, and the functions that need a context to get at it: the ones that
+        // use state directly, and the ones that call them
+        auto reachableFunctions = GetReachableFunctions(pFunction);
+        FunctionSet reachableFunctionSet(reachableFunctions.begin(), reachableFunctions.end());
+        std::vector<llvm::GlobalVariable*> stateGlobals;
+        std::unordered_map<llvm::Function*, GlobalSet> functionStateGlobals;
+        std::vector<llvm::Function*> contextFunctions = { pFunction };
+        FunctionSet contextFunctionSet = { pFunction };
+        GlobalSet stateGlobalSet;
+        for (auto pReachableFunction : reachableFunctions)
+        {
+            auto globals = GetStateGlobalsUsedBy(pReachableFunction);
+            for (auto pGlobal : globals)
+            {
+                if (stateGlobalSet.insert(pGlobal).second)
+                {
+                    stateGlobals.push_back(pGlobal);
+                }
+            }
+
+            if (!globals.empty() && contextFunctionSet.insert(pReachableFunction).second)
+            {
+                contextFunctions.push_back(pReachableFunction);
+            }
+            functionStateGlobals[pReachableFunction] = std::move(globals);
+        }
+
+        for (size_t index = 0; index < contextFunctions.size(); ++index)
+        {
+            auto pContextFunction = contextFunctions[index];
+            if (!IsOnlyUsedIn(pContextFunction, reachableFunctionSet))
+            {
+                throw EmitterException(EmitterError::notSupported, "Can't make " + functionName + " reentrant: " + pContextFunction->getName().str() + " is used by a function " + functionName + " doesn't call");
+            }
+
+            for (auto pCaller : GetCallers(pContextFunction))
+            {
+                if (contextFunctionSet.insert(pCaller).second)
+                {
+                    contextFunctions.push_back(pCaller);
+                }
+            }
+        }
+
+        for (auto pGlobal : stateGlobals)
+        {
+            if (!IsOnlyUsedIn(pGlobal, reachableFunctionSet))
+            {
+                throw EmitterException(EmitterError::notSupported, "Can't make " + functionName + " reentrant: global " + pGlobal->getName().str() + " is also used by a function " + functionName + " doesn't call");
+            }
+        }
+
+        // The context holds one field per global
+        auto& context = pModule->getContext();
+        std::vector<llvm::Type*> fieldTypes;
+        std::unordered_map<llvm::GlobalVariable*, unsigned> fieldIndices;
+        for (auto pGlobal : stateGlobals)
+        {
+            fieldIndices[pGlobal] = static_cast<unsigned>(fieldTypes.size());
+            fieldTypes.push_back(pGlobal->getValueType());
+        }
+        auto pContextType = llvm::StructType::create(context, fieldTypes, contextFunctionPrefix + "_Context");
+        auto pContextPointerType = llvm::Type::getInt8PtrTy(context);
+
+        // Add the context parameter, then pass the caller's context to each call
+        std::unordered_map<llvm::Function*, llvm::Function*> newFunctions;
+        for (auto pContextFunction : contextFunctions)
+        {
+            newFunctions[pContextFunction] = AddContextParameter(pContextFunction, pContextPointerType);
+        }
+
+        for (const auto& entry : newFunctions)
+        {
+            std::vector<llvm::CallInst*> calls;
+            for (auto pUser : entry.first->users())
+            {
+                calls.push_back(llvm::cast<llvm::CallInst>(pUser));
+            }
+
+            for (auto pCall : calls)
+            {
+                auto pCaller = pCall->getParent()->getParent();
+                ReplaceCall(pCall, entry.second, &(*pCaller->arg_begin()));
+            }
+        }
+
+        // Point the uses of the globals at the context's fields
+        for (const auto& entry : newFunctions)
+        {
+            const auto& globals = functionStateGlobals[entry.first];
+            if (globals.empty())
+            {
+                continue;
+            }
+
+            auto pNewFunction = entry.second;
+            llvm::IRBuilder<> builder(&(*pNewFunction->getEntryBlock().getFirstInsertionPt()));
+            auto pTypedContext = builder.CreateBitCast(&(*pNewFunction->arg_begin()), pContextType->getPointerTo());
+            std::unordered_map<llvm::GlobalVariable*, llvm::Value*> fieldPointers;
+            for (auto pGlobal : globals)
+            {
+                fieldPointers[pGlobal] = builder.CreateStructGEP(pContextType, pTypedContext, fieldIndices[pGlobal], pGlobal->getName());
+            }
+            ReplaceGlobals(pNewFunction, fieldPointers);
+        }
+
+        for (const auto& entry : newFunctions)
+        {
+            entry.first->eraseFromParent();
+        }
+
+        // Different contexts never overlap
+        auto pNewFunction = newFunctions[pFunction];
+        pNewFunction->addAttribute(1, llvm::Attribute::NoAlias);
+
+        // Emit `GetContextSize`. The sizes are constant expressions, so they follow the data layout the module is finally compiled with.
+        auto int32Type = llvm::Type::getInt32Ty(context);
+        auto getContextSizeName = contextFunctionPrefix + "_GetContextSize";
+        auto pGetContextSize = llvm::Function::Create(llvm::FunctionType::get(int32Type, false), llvm::Function::ExternalLinkage, getContextSizeName, pModule);
+        llvm::IRBuilder<> builder(llvm::BasicBlock::Create(context, "entry", pGetContextSize));
+        builder.CreateRet(llvm::ConstantExpr::getTrunc(llvm::ConstantExpr::getSizeOf(pContextType), int32Type));
+
+        // Emit `InitializeContext`: zero the context, then copy in the globals' non-zero initial values
+        auto initializeContextName = contextFunctionPrefix + "_InitializeContext";
+        auto pInitializeContext = llvm::Function::Create(llvm::FunctionType::get(llvm::Type::getVoidTy(context), { pContextPointerType }, false), llvm::Function::ExternalLinkage, initializeContextName, pModule);
+        auto pContextArgument = &(*pInitializeContext->arg_begin());
+        pContextArgument->setName("context");
+        builder.SetInsertPoint(llvm::BasicBlock::Create(context, "entry", pInitializeContext));
+        builder.CreateMemSet(pContextArgument, builder.getInt8(0), llvm::ConstantExpr::getSizeOf(pContextType), 1);
+        auto pTypedContext = builder.CreateBitCast(pContextArgument, pContextType->getPointerTo());
+        for (auto pGlobal : stateGlobals)
+        {
+            auto pInitializer = pGlobal->getInitializer();
+            if (pInitializer->isNullValue())
+            {
+                continue;
+            }
+
+            auto pField = builder.CreateStructGEP(pContextType, pTypedContext, fieldIndices[pGlobal]);
+            if (pInitializer->getType()->isAggregateType())
+            {
+                auto pInitialValue = new llvm::GlobalVariable(*pModule, pInitializer->getType(), true, llvm::GlobalValue::PrivateLinkage, pInitializer, pGlobal->getName() + "_initial");
+                builder.CreateMemCpy(pField, pInitialValue, llvm::ConstantExpr::getSizeOf(pInitializer->getType()), 1);
+            }
+            else
+            {
+                builder.CreateStore(pInitializer, pField);
+            }
+        }
+        builder.CreateRetVoid();
+
+        for (auto pGlobal : stateGlobals)
+        {
+            pGlobal->removeDeadConstantUsers();
+            pGlobal->eraseFromParent();
+        }
+
+        moduleEmitter.IncludeInHeader(getContextSizeName);
+        moduleEmitter.IncludeInHeader(initializeContextName);
+        auto comments = moduleEmitter.GetFunctionComments(functionName);
+        comments.push_back("The first argument is a context of " + getContextSizeName + "() bytes, initialized by " + initializeContextName + "()");
+        moduleEmitter.SetFunctionComments(functionName, comments);
+    }
+}
+}
@@ -7,11 +7,30 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "IRRuntime.h"
+#include "EmitterException.h"
+#include "IRFunctionEmitter.h"
 #include "IRMetadata.h"
 #include "IRModuleEmitter.h"
 
+#include <algorithm>
+#include <functional>
 #include <iostream>
+#include <string>
 #include <time.h>
+#include <vector>
+
+// BLAS (the emitters do not include cblas.h, so its enumerations are repeated, as in the nodes that call gemm)
+enum CBLAS_ORDER
+{
+    CblasRowMajor = 101,
+    CblasColMajor = 102
+};
+
+enum CBLAS_TRANSPOSE
+{
+    CblasNoTrans = 111,
+    CblasTrans = 112
+};
 
 namespace ell
 {
@@ -25,6 +44,61 @@ namespace emitters
     static const std::string& dotProductFloatName = "DotProductF";
     static const std::string& dotProductIntName = "DotProduct";
     static const std::string& getTimeFunctionName = "GetTime";
+    static const std::string& gemmStridedBatchedName = "GEMMStridedBatched";
+    static const std::string& tiledGemmName = "GEMM";
+    static const std::string& parallelForFunctionName = "ELL_ParallelFor";
+
+    // blocking parameters of the emitted GEMM kernel: a micro-tile of C is held in registers while a block of
+    // gemmBlockK rows of B, gemmBlockN columns wide, is reused from the cache across all the rows of A
+    static const int gemmTileRows = 4;
+    static const int gemmTileVectors = 2;
+    static const int gemmTileScalars = 4;
+    static const int gemmBlockK = 128;
+    static const int gemmBlockN = 256;
+
+    static const std::string& fastExpName = "FastExp";
+    static const std::string& fastLogName = "FastLog";
+    static const std::string& fastTanhName = "FastTanh";
+    static const std::string& fastSigmoidName = "FastSigmoid";
+    static const std::string& tanhName = "Tanh";
+    static const std::string& sigmoidName = "Sigmoid";
+
+    namespace
+    {
+        // Constants of the fast exp and log approximations, the same as math::TranscendentalConstants. Exp reduces its
+        // argument to r = x - n * ln(2) and evaluates the Taylor polynomial of exp(r) of degree expDegree. Log splits its
+        // argument into m * 2^e, with sqrt(1/2) <= m < sqrt(2), and sums the first logTerms terms of log(m) = 2 * atanh(t),
+        // with t = (m - 1) / (m + 1).
+        struct FastMathConstants
+        {
+            int expDegree;
+            int logTerms;
+            double minExpArgument;
+            double maxExpArgument;
+            double roundingConstant;
+            double ln2High;
+            double ln2Low;
+            double minNormal;
+            int mantissaBits;
+            int exponentBias;
+        };
+
+        FastMathConstants GetFastMathConstants(llvm::Type* pType)
+        {
+            if (pType->getScalarType()->isFloatTy())
+            {
+                return { 7, 5, -87.0, 88.0, 12582912.0, 0.693359375, -2.12194440e-4, 1.17549435e-38, 23, 127 };
+            }
+            return { 13, 11, -708.0, 709.0, 6755399441055744.0, 6.93145751953125e-1, 1.42860682030941723212e-6, 2.2250738585072014e-308, 52, 1023 };
+        }
+
+        // The integer type (or vector of them) with the same size as the given floating point type
+        llvm::Type* GetIntegerTypeOfSameSize(llvm::Type* pType)
+        {
+            auto pIntType = llvm::Type::getIntNTy(pType->getContext(), pType->getScalarSizeInBits());
+            return pType->isVectorTy() ? llvm::VectorType::get(pIntType, pType->getVectorNumElements()) : pIntType;
+        }
+    }
 
     IRRuntime::IRRuntime(IRModuleEmitter& module)
         : _module(module)
@@ -238,27 +312,274 @@ namespace emitters
 
     llvm::Function* IRRuntime::GetSqrtFunction(VariableType argType)
     {
-        return _module.GetIntrinsic(llvm::Intrinsic::sqrt, { argType });
+        return GetSqrtFunction(_module.GetIREmitter().Type(argType));
     }
 
     llvm::Function* IRRuntime::GetAbsFunction(VariableType argType)
     {
-        return _module.GetIntrinsic(llvm::Intrinsic::fabs, { argType });
+        return GetAbsFunction(_module.GetIREmitter().Type(argType));
     }
 
     llvm::Function* IRRuntime::GetExpFunction(VariableType argType)
     {
-        return _module.GetIntrinsic(llvm::Intrinsic::exp, { argType });
+        return GetExpFunction(_module.GetIREmitter().Type(argType));
     }
 
     llvm::Function* IRRuntime::GetLogFunction(VariableType argType)
     {
-        return _module.GetIntrinsic(llvm::Intrinsic::log, { argType });
+        return GetLogFunction(_module.GetIREmitter().Type(argType));
+    }
+
+    llvm::Function* IRRuntime::GetTanhFunction(VariableType argType)
+    {
+        return GetTanhFunction(_module.GetIREmitter().Type(argType));
+    }
+
+    llvm::Function* IRRuntime::GetSigmoidFunction(VariableType argType)
+    {
+        return GetSigmoidFunction(_module.GetIREmitter().Type(argType));
+    }
+
+    llvm::Function* IRRuntime::GetSqrtFunction(llvm::Type* pArgType)
+    {
+        return llvm::Intrinsic::getDeclaration(_module.GetLLVMModule(), llvm::Intrinsic::sqrt, { pArgType });
+    }
+
+    llvm::Function* IRRuntime::GetAbsFunction(llvm::Type* pArgType)
+    {
+        return llvm::Intrinsic::getDeclaration(_module.GetLLVMModule(), llvm::Intrinsic::fabs, { pArgType });
+    }
+
+    llvm::Function* IRRuntime::GetExpFunction(llvm::Type* pArgType)
+    {
+        if (UseFastMath())
+        {
+            return EmitFastExpFunction(pArgType);
+        }
+        return llvm::Intrinsic::getDeclaration(_module.GetLLVMModule(), llvm::Intrinsic::exp, { pArgType });
+    }
+
+    llvm::Function* IRRuntime::GetLogFunction(llvm::Type* pArgType)
+    {
+        if (UseFastMath())
+        {
+            return EmitFastLogFunction(pArgType);
+        }
+        return llvm::Intrinsic::getDeclaration(_module.GetLLVMModule(), llvm::Intrinsic::log, { pArgType });
+    }
+
+    llvm::Function* IRRuntime::GetTanhFunction(llvm::Type* pArgType)
+    {
+        return EmitTanhFunction(pArgType);
+    }
+
+    llvm::Function* IRRuntime::GetSigmoidFunction(llvm::Type* pArgType)
+    {
+        return EmitSigmoidFunction(pArgType);
+    }
+
+    bool IRRuntime::UseFastMath() const
+    {
+        return _module.GetCompilerParameters().useFastMath;
+    }
+
+    llvm::Function* IRRuntime::EmitMathFunction(const std::string& name, llvm::Type* pArgType, std::function<llvm::Value*(IRFunctionEmitter&, llvm::Value*)> body)
+    {
+        // e.g., "Exp" for double, "ExpF" for float and "ExpF_8" for a vector of 8 floats
+        auto pElementType = pArgType->getScalarType();
+        if (!pElementType->isFloatTy() && !pElementType->isDoubleTy())
+        {
+            throw EmitterException(EmitterError::valueTypeNotSupported, "Math functions require float or double arguments");
+        }
+        auto functionName = GetNamespacePrefix() + "_" + name + (pElementType->isFloatTy() ? "F" : "");
+        if (pArgType->isVectorTy())
+        {
+            functionName += "_" + std::to_string(pArgType->getVectorNumElements());
+        }
+
+        auto pExistingFunction = _module.GetFunction(functionName);
+        if (pExistingFunction != nullptr)
+        {
+            return pExistingFunction;
+        }
+
+        auto function = _module.BeginFunction(functionName, pArgType, { pArgType });
+        function.GetFunction()->addFnAttr(llvm::Attribute::AlwaysInline);
+        llvm::Value* x = &(*function.Arguments().begin());
+        function.Return(body(function, x));
+        _module.EndFunction();
+        return function.GetFunction();
+    }
+
+    llvm::Function* IRRuntime::EmitFastExpFunction(llvm::Type* pArgType)
+    {
+        return EmitMathFunction(fastExpName, pArgType, [this, pArgType](IRFunctionEmitter& function, llvm::Value* x) {
+            auto& irBuilder = _module.GetIREmitter().GetIRBuilder();
+            auto constants = GetFastMathConstants(pArgType);
+            auto constant = [pArgType](double value) { return llvm::ConstantFP::get(pArgType, value); };
+
+            // arguments outside the range saturate, to the largest result or to (nearly) zero
+            auto input = x;
+            x = function.Select(function.Comparison(TypedComparison::lessThanFloat, x, constant(constants.maxExpArgument)), x, constant(constants.maxExpArgument));
+            x = function.Select(function.Comparison(TypedComparison::greaterThanFloat, x, constant(constants.minExpArgument)), x, constant(constants.minExpArgument));
+
+            // n = round(x / ln(2)), by adding and subtracting a constant that leaves no fractional bits
+            auto rounding = constant(constants.roundingConstant);
+            auto n = function.Operator(TypedOperator::subtractFloat, function.Operator(TypedOperator::addFloat, function.Operator(TypedOperator::multiplyFloat, x, constant(1.44269504088896340736)), rounding), rounding);
+
+            // r = x - n * ln(2), where ln(2) is split in two so that the first product is exact
+            auto r = function.Operator(TypedOperator::subtractFloat, x, function.Operator(TypedOperator::multiplyFloat, n, constant(constants.ln2High)));
+            r = function.Operator(TypedOperator::subtractFloat, r, function.Operator(TypedOperator::multiplyFloat, n, constant(constants.ln2Low)));
+
+            // Horner's rule on the Taylor coefficients 1/k!
+            double factorial = 1;
+            for (int k = 2; k <= constants.expDegree; ++k)
+            {
+                factorial *= k;
+            }
+            llvm::Value* p = constant(1 / factorial);
+            for (int k = constants.expDegree; k > 0; --k)
+            {
+                factorial /= k;
+                p = function.Operator(TypedOperator::addFloat, function.Operator(TypedOperator::multiplyFloat, p, r), constant(1 / factorial));
+            }
+
+            // 2^n, by putting n + bias in the exponent field
+            auto pIntType = GetIntegerTypeOfSameSize(pArgType);
+            auto exponent = irBuilder.CreateAdd(irBuilder.CreateFPToSI(n, pIntType), llvm::ConstantInt::get(pIntType, constants.exponentBias));
+            auto pow2 = irBuilder.CreateBitCast(irBuilder.CreateShl(exponent, constants.mantissaBits), pArgType);
+            auto result = function.Operator(TypedOperator::multiplyFloat, p, pow2);
+
+            // the clamp turns infinity and NaN into numbers, so both are passed through at the end
+            result = function.Select(function.Comparison(TypedComparison::equalsFloat, input, llvm::ConstantFP::getInfinity(pArgType)), input, result);
+            return function.Select(irBuilder.CreateFCmpUNO(input, input), input, result);
+        });
+    }
+
+    llvm::Function* IRRuntime::EmitFastLogFunction(llvm::Type* pArgType)
+    {
+        return EmitMathFunction(fastLogName, pArgType, [this, pArgType](IRFunctionEmitter& function, llvm::Value* x) {
+            auto& irBuilder = _module.GetIREmitter().GetIRBuilder();
+            auto constants = GetFastMathConstants(pArgType);
+            auto constant = [pArgType](double value) { return llvm::ConstantFP::get(pArgType, value); };
+            auto pIntType = GetIntegerTypeOfSameSize(pArgType);
+            auto intConstant = [pIntType](uint64_t value) { return llvm::ConstantInt::get(pIntType, value); };
+
+            // zero, negative and denormal arguments are treated as the smallest positive normal number
+            auto input = x;
+            auto minNormal = constant(constants.minNormal);
+            x = function.Select(function.Comparison(TypedComparison::greaterThanFloat, x, minNormal), x, minNormal);
+
+            // split x into m * 2^e, with 1 <= m < 2, and then move m into [sqrt(1/2), sqrt(2))
+            auto bits = irBuilder.CreateBitCast(x, pIntType);
+            auto biasedExponent = irBuilder.CreateLShr(bits, constants.mantissaBits);
+            auto mantissaMask = (uint64_t(1) << constants.mantissaBits) - 1;
+            auto oneBits = uint64_t(constants.exponentBias) << constants.mantissaBits;
+            llvm::Value* m = irBuilder.CreateBitCast(irBuilder.CreateOr(irBuilder.CreateAnd(bits, intConstant(mantissaMask)), intConstant(oneBits)), pArgType);
+            llvm::Value* e = function.Operator(TypedOperator::subtractFloat, irBuilder.CreateSIToFP(biasedExponent, pArgType), constant(constants.exponentBias));
+            auto isLarge = function.Comparison(TypedComparison::greaterThanOrEqualsFloat, m, constant(1.41421356237309504880));
+            m = function.Select(isLarge, function.Operator(TypedOperator::multiplyFloat, m, constant(0.5)), m);
+            e = function.Select(isLarge, function.Operator(TypedOperator::addFloat, e, constant(1)), e);
+
+            auto one = constant(1);
+            auto t = function.Operator(TypedOperator::divideFloat, function.Operator(TypedOperator::subtractFloat, m, one), function.Operator(TypedOperator::addFloat, m, one));
+            auto t2 = function.Operator(TypedOperator::multiplyFloat, t, t);
+
+            // log(m) = 2 * (t + t^3 / 3 + t^5 / 5 + ...)
+            llvm::Value* p = constant(1.0 / (2 * constants.logTerms - 1));
+            for (int k = constants.logTerms - 2; k >= 0; --k)
+            {
+                p = function.Operator(TypedOperator::addFloat, function.Operator(TypedOperator::multiplyFloat, p, t2), constant(1.0 / (2 * k + 1)));
+            }
+            auto logM = function.Operator(TypedOperator::multiplyFloat, function.Operator(TypedOperator::addFloat, t, t), p);
+
+            // log(x) = e * ln(2) + log(m), adding the small terms first
+            auto lowTerms = function.Operator(TypedOperator::addFloat, function.Operator(TypedOperator::multiplyFloat, e, constant(constants.ln2Low)), logM);
+            llvm::Value* result = function.Operator(TypedOperator::addFloat, function.Operator(TypedOperator::multiplyFloat, e, constant(constants.ln2High)), lowTerms);
+
+            // infinity has no mantissa to split, and the clamp turns NaN into a number, so both are passed through at the end
+            result = function.Select(function.Comparison(TypedComparison::equalsFloat, input, llvm::ConstantFP::getInfinity(pArgType)), input, result);
+            return function.Select(irBuilder.CreateFCmpUNO(input, input), input, result);
+        });
+    }
+
+    llvm::Function* IRRuntime::EmitTanhFunction(llvm::Type* pArgType)
+    {
+        if (UseFastMath())
+        {
+            auto pExpFunction = GetExpFunction(pArgType);
+            return EmitMathFunction(fastTanhName, pArgType, [pArgType, pExpFunction](IRFunctionEmitter& function, llvm::Value* x) {
+                // tanh(x) = 1 - 2 / (exp(2x) + 1), which saturates correctly at both ends
+                auto one = llvm::ConstantFP::get(pArgType, 1.0);
+                auto expTwoX = function.Call(pExpFunction, { function.Operator(TypedOperator::addFloat, x, x) });
+                return function.Operator(TypedOperator::subtractFloat, one, function.Operator(TypedOperator::divideFloat, llvm::ConstantFP::get(pArgType, 2.0), function.Operator(TypedOperator::addFloat, expTwoX, one)));
+            });
+        }
+
+        // The math library's tanh, applied to each element
+        auto pElementType = pArgType->getScalarType();
+        auto pModule = _module.GetLLVMModule();
+        auto pTanhFunction = static_cast<llvm::Function*>(pModule->getOrInsertFunction(pElementType->isFloatTy() ? "tanhf" : "tanh", llvm::FunctionType::get(pElementType, { pElementType }, false)));
+        if (!pArgType->isVectorTy())
+        {
+            return pTanhFunction;
+        }
+
+        return EmitMathFunction(tanhName, pArgType, [this, pArgType, pTanhFunction](IRFunctionEmitter& function, llvm::Value* x) {
+            auto& irBuilder = _module.GetIREmitter().GetIRBuilder();
+            llvm::Value* result = llvm::UndefValue::get(pArgType);
+            for (unsigned index = 0; index < pArgType->getVectorNumElements(); ++index)
+            {
+                auto element = function.Call(pTanhFunction, { irBuilder.CreateExtractElement(x, irBuilder.getInt32(index)) });
+                result = irBuilder.CreateInsertElement(result, element, irBuilder.getInt32(index));
+            }
+            return result;
+        });
+    }
+
+    llvm::Function* IRRuntime::EmitSigmoidFunction(llvm::Type* pArgType)
+    {
+        auto pExpFunction = GetExpFunction(pArgType);
+        if (UseFastMath())
+        {
+            return EmitMathFunction(fastSigmoidName, pArgType, [pArgType, pExpFunction](IRFunctionEmitter& function, llvm::Value* x) {
+                // the fast exp saturates, so this doesn't overflow
+                auto one = llvm::ConstantFP::get(pArgType, 1.0);
+                auto expNegX = function.Call(pExpFunction, { function.Operator(TypedOperator::subtractFloat, llvm::ConstantFP::get(pArgType, 0.0), x) });
+                return function.Operator(TypedOperator::divideFloat, one, function.Operator(TypedOperator::addFloat, one, expNegX));
+            });
+        }
+
+        auto pAbsFunction = GetAbsFunction(pArgType);
+        return EmitMathFunction(sigmoidName, pArgType, [pArgType, pExpFunction, pAbsFunction](IRFunctionEmitter& function, llvm::Value* x) {
+            // with e = exp(-|x|), sigmoid(x) is 1 / (1 + e) for positive x and e / (1 + e) otherwise, so exp never overflows
+            auto one = llvm::ConstantFP::get(pArgType, 1.0);
+            auto e = function.Call(pExpFunction, { function.Operator(TypedOperator::subtractFloat, llvm::ConstantFP::get(pArgType, 0.0), function.Call(pAbsFunction, { x })) });
+            auto onePlusE = function.Operator(TypedOperator::addFloat, one, e);
+            auto isPositive = function.Comparison(TypedComparison::greaterThanFloat, x, llvm::ConstantFP::get(pArgType, 0.0));
+            return function.Select(isPositive, function.Operator(TypedOperator::divideFloat, one, onePlusE), function.Operator(TypedOperator::divideFloat, e, onePlusE));
+        });
     }
 
     //
     // BLAS
     //
+    llvm::FunctionType* IRRuntime::GetParallelForTaskType()
+    {
+        auto& emitter = _module.GetIREmitter();
+        auto int32Type = emitter.Type(VariableType::Int32);
+        return llvm::FunctionType::get(emitter.Type(VariableType::Void), { int32Type, int32Type, emitter.Type(VariableType::BytePointer) }, false);
+    }
+
+    llvm::Function* IRRuntime::GetParallelForFunction()
+    {
+        auto& emitter = _module.GetIREmitter();
+        auto pModule = _module.GetLLVMModule();
+        std::vector<llvm::Type*> argTypes = { emitter.Type(VariableType::Int32), GetParallelForTaskType()->getPointerTo(), emitter.Type(VariableType::BytePointer) };
+        auto functionType = llvm::FunctionType::get(emitter.Type(VariableType::Void), argTypes, false);
+        return static_cast<llvm::Function*>(pModule->getOrInsertFunction(parallelForFunctionName, functionType));
+    }
+
     llvm::Function* IRRuntime::GetSGEMVFunction()
     {
         ValueTypeList argTypes = {
@@ -355,6 +676,424 @@ namespace emitters
         return static_cast<llvm::Function*>(pModule->getOrInsertFunction("cblas_dgemm", functionType));
     }
 
+    llvm::Function* IRRuntime::EmitGEMMStridedBatchedFunction(VariableType valueType, bool useBlas)
+    {
+        auto functionName = GetNamespacePrefix() + "_" + gemmStridedBatchedName + (valueType == VariableType::Float ? "F" : "") + (useBlas ? "Blas" : "");
+        auto pExistingFunction = _module.GetFunction(functionName);
+        if (pExistingFunction != nullptr)
+        {
+            return pExistingFunction;
+        }
+
+        auto pointerType = GetPointerType(valueType);
+        NamedVariableTypeList argList = { { "transposeA", VariableType::Int32 },
+                                          { "transposeB", VariableType::Int32 },
+                                          { "m", VariableType::Int32 },
+                                          { "n", VariableType::Int32 },
+                                          { "k", VariableType::Int32 },
+                                          { "alpha", valueType },
+                                          { "A", pointerType },
+                                          { "lda", VariableType::Int32 },
+                                          { "strideA", VariableType::Int32 },
+                                          { "B", pointerType },
+                                          { "ldb", VariableType::Int32 },
+                                          { "strideB", VariableType::Int32 },
+                                          { "beta", valueType },
+                                          { "C", pointerType },
+                                          { "ldc", VariableType::Int32 },
+                                          { "strideC", VariableType::Int32 },
+                                          { "batchCount", VariableType::Int32 } };
+        auto function = _module.BeginFunction(functionName, VariableType::Void, argList);
+
+        auto arguments = function.Arguments().begin();
+        llvm::Argument& transposeA = *arguments++;
+        llvm::Argument& transposeB = *arguments++;
+        llvm::Argument& m = *arguments++;
+        llvm::Argument& n = *arguments++;
+        llvm::Argument& k = *arguments++;
+        llvm::Argument& alpha = *arguments++;
+        llvm::Argument& A = *arguments++;
+        llvm::Argument& lda = *arguments++;
+        llvm::Argument& strideA = *arguments++;
+        llvm::Argument& B = *arguments++;
+        llvm::Argument& ldb = *arguments++;
+        llvm::Argument& strideB = *arguments++;
+        llvm::Argument& beta = *arguments++;
+        llvm::Argument& C = *arguments++;
+        llvm::Argument& ldc = *arguments++;
+        llvm::Argument& strideC = *arguments++;
+        llvm::Argument& batchCount = *arguments++;
+
+        // the distances between consecutive rows and columns of A and B, which swap when the matrix is transposed
+        auto one = function.Literal(1);
+        auto isTransposedA = function.Comparison(TypedComparison::equals, &transposeA, function.Literal(CBLAS_TRANSPOSE::CblasTrans));
+        auto isTransposedB = function.Comparison(TypedComparison::equals, &transposeB, function.Literal(CBLAS_TRANSPOSE::CblasTrans));
+        auto aRowIncrement = function.Select(isTransposedA, one, &lda);
+        auto aColumnIncrement = function.Select(isTransposedA, &lda, one);
+        auto bRowIncrement = function.Select(isTransposedB, one, &ldb);
+        auto bColumnIncrement = function.Select(isTransposedB, &ldb, one);
+        auto isBetaZero = function.Comparison(TypedComparison::equalsFloat, &beta, llvm::ConstantFP::get(beta.getType(), 0.0));
+
+        llvm::Value* accum = function.Variable(valueType, "accum");
+
+        auto batchLoop = function.ForLoop();
+        batchLoop.Begin(&batchCount);
+        {
+            auto batchIndex = batchLoop.LoadIterationVariable();
+            auto pA = function.PointerOffset(&A, function.Operator(TypedOperator::multiply, batchIndex, &strideA));
+            auto pB = function.PointerOffset(&B, function.Operator(TypedOperator::multiply, batchIndex, &strideB));
+            auto pC = function.PointerOffset(&C, function.Operator(TypedOperator::multiply, batchIndex, &strideC));
+
+            if (useBlas)
+            {
+                auto gemm = valueType == VariableType::Float ? GetSGEMMFunction() : GetDGEMMFunction();
+                function.Call(gemm, { function.Literal(CBLAS_ORDER::CblasRowMajor), &transposeA, &transposeB, &m, &n, &k, &alpha, pA, &lda, pB, &ldb, &beta, pC, &ldc });
+            }
+            else
+            {
+                auto mLoop = function.ForLoop();
+                mLoop.Begin(&m);
+                {
+                    auto mIndex = mLoop.LoadIterationVariable();
+                    auto nLoop = function.ForLoop();
+                    nLoop.Begin(&n);
+                    {
+                        auto nIndex = nLoop.LoadIterationVariable();
+                        function.Store(accum, llvm::ConstantFP::get(beta.getType(), 0.0));
+
+                        auto kLoop = function.ForLoop();
+                        kLoop.Begin(&k);
+                        {
+                            auto kIndex = kLoop.LoadIterationVariable();
+                            auto aIndex = function.Operator(TypedOperator::add, function.Operator(TypedOperator::multiply, mIndex, aRowIncrement), function.Operator(TypedOperator::multiply, kIndex, aColumnIncrement));
+                            auto bIndex = function.Operator(TypedOperator::add, function.Operator(TypedOperator::multiply, kIndex, bRowIncrement), function.Operator(TypedOperator::multiply, nIndex, bColumnIncrement));
+                            auto product = function.Operator(TypedOperator::multiplyFloat, function.ValueAt(pA, aIndex), function.ValueAt(pB, bIndex));
+                            function.OperationAndUpdate(accum, TypedOperator::addFloat, product);
+                        }
+                        kLoop.End();
+
+                        // as in gemm, C is not read when beta is zero, so it may hold NaNs or uninitialized memory
+                        auto cIndex = function.Operator(TypedOperator::add, function.Operator(TypedOperator::multiply, mIndex, &ldc), nIndex);
+                        auto scaledProduct = function.Operator(TypedOperator::multiplyFloat, &alpha, function.Load(accum));
+                        auto ifEmitter = function.If();
+                        ifEmitter.If(isBetaZero);
+                        {
+                            function.SetValueAt(pC, cIndex, scaledProduct);
+                        }
+                        ifEmitter.Else();
+                        {
+                            auto scaledC = function.Operator(TypedOperator::multiplyFloat, &beta, function.ValueAt(pC, cIndex));
+                            function.SetValueAt(pC, cIndex, function.Operator(TypedOperator::addFloat, scaledProduct, scaledC));
+                        }
+                        ifEmitter.End();
+                    }
+                    nLoop.End();
+                }
+                mLoop.End();
+            }
+        }
+        batchLoop.End();
+
+        function.Return();
+        _module.EndFunction();
+        return function.GetFunction();
+    }
+
+    llvm::Function* IRRuntime::EmitTiledGEMMFunction(VariableType valueType, bool transposeA, bool transposeB, int m, int n, int k, int lda, int ldb, int ldc)
+    {
+        auto functionName = GetNamespacePrefix() + "_" + tiledGemmName + (valueType == VariableType::Float ? "F" : "") + "_" + (transposeA ? "T" : "N") + (transposeB ? "T" : "N") + "_" + std::to_string(m) + "x" + std::to_string(n) + "x" + std::to_string(k) + "_" + std::to_string(lda) + "_" + std::to_string(ldb) + "_" + std::to_string(ldc);
+        auto pExistingFunction = _module.GetFunction(functionName);
+        if (pExistingFunction != nullptr)
+        {
+            return pExistingFunction;
+        }
+
+        auto pointerType = GetPointerType(valueType);
+        NamedVariableTypeList argList = { { "A", pointerType },
+                                          { "B", pointerType },
+                                          { "C", pointerType } };
+        auto function = _module.BeginFunction(functionName, VariableType::Void, argList);
+
+        auto arguments = function.Arguments().begin();
+        llvm::Argument& A = *arguments++;
+        llvm::Argument& B = *arguments++;
+        llvm::Argument& C = *arguments++;
+
+        // Tiles of C are computed a vector at a time along the rows of B. A transposed B is packed, a tile of columns
+        // at a time, into a row-major scratch tile, so its tiles are computed with vectors too.
+        auto pElementType = _module.GetIREmitter().Type(valueType);
+        const int width = static_cast<int>(function.GetVectorWidth(pElementType));
+        const int packedTileColumns = width > 1 ? gemmTileVectors * width : gemmTileScalars;
+        llvm::Value* pPackedB = transposeB ? function.Variable(valueType, gemmBlockK * packedTileColumns) : nullptr;
+
+        // The accumulators for a micro-tile of C, which the optimizer promotes to registers
+        std::vector<std::vector<llvm::Value*>> vectorAccumulators(gemmTileRows);
+        std::vector<std::vector<llvm::Value*>> scalarAccumulators(gemmTileRows);
+        for (int row = 0; row < gemmTileRows; ++row)
+        {
+            if (width > 1)
+            {
+                for (int column = 0; column < gemmTileVectors; ++column)
+                {
+                    vectorAccumulators[row].push_back(function.Variable(llvm::VectorType::get(pElementType, width), "accum"));
+                }
+            }
+            for (int column = 0; column < gemmTileScalars; ++column)
+            {
+                scalarAccumulators[row].push_back(function.Variable(valueType, "accum"));
+            }
+        }
+
+        auto indexA = [&](llvm::Value* row, llvm::Value* p) {
+            return transposeA ? function.Operator(TypedOperator::add, function.Operator(TypedOperator::multiply, p, function.Literal(lda)), row) : function.Operator(TypedOperator::add, function.Operator(TypedOperator::multiply, row, function.Literal(lda)), p);
+        };
+        auto indexB = [&](llvm::Value* p, llvm::Value* column) {
+            return transposeB ? function.Operator(TypedOperator::add, function.Operator(TypedOperator::multiply, column, function.Literal(ldb)), p) : function.Operator(TypedOperator::add, function.Operator(TypedOperator::multiply, p, function.Literal(ldb)), column);
+        };
+        auto indexC = [&](llvm::Value* row, llvm::Value* column) {
+            return function.Operator(TypedOperator::add, function.Operator(TypedOperator::multiply, row, function.Literal(ldc)), column);
+        };
+        auto offset = [&](llvm::Value* value, int delta) {
+            return delta == 0 ? value : function.Operator(TypedOperator::add, value, function.Literal(delta));
+        };
+
+        // Computes a `rows` x (`groups` * `groupWidth`) tile of C over `kCount` steps of the inner dimension, starting from
+        // the current contents of C if `accumulate` is set, otherwise from zero. The rows of B are read from `pTileB`, at
+        // the indices given by `indexTileB`.
+        auto emitTile = [&](llvm::Value* rowStart, int rows, llvm::Value* columnStart, int groups, int groupWidth, llvm::Value* kStart, int kCount, bool accumulate, llvm::Value* pTileB, const std::function<llvm::Value*(llvm::Value*, llvm::Value*)>& indexTileB) {
+            auto& accumulators = groupWidth > 1 ? vectorAccumulators : scalarAccumulators;
+            for (int row = 0; row < rows; ++row)
+            {
+                for (int group = 0; group < groups; ++group)
+                {
+                    auto pAccumulator = accumulators[row][group];
+                    auto pAccumulatorType = pAccumulator->getType()->getPointerElementType();
+                    auto cIndex = indexC(offset(rowStart, row), offset(columnStart, group * groupWidth));
+                    function.Store(pAccumulator, accumulate ? function.VectorValueAt(&C, cIndex, groupWidth) : llvm::Constant::getNullValue(pAccumulatorType));
+                }
+            }
+
+            // the tile is already vectorized, and unrolling overlaps the loads of one step with the arithmetic of the previous one
+            LoopHints kLoopHints;
+            kLoopHints.unrollCount = 4;
+            kLoopHints.vectorizeWidth = 1;
+            auto kLoop = function.ForLoop();
+            kLoop.SetHints(kLoopHints);
+            kLoop.Begin(kCount);
+            {
+                auto p = function.Operator(TypedOperator::add, kStart, kLoop.LoadIterationVariable());
+                std::vector<llvm::Value*> bValues;
+                for (int group = 0; group < groups; ++group)
+                {
+                    bValues.push_back(function.VectorValueAt(pTileB, indexTileB(p, offset(columnStart, group * groupWidth)), groupWidth));
+                }
+
+                for (int row = 0; row < rows; ++row)
+                {
+                    auto aValue = function.ValueAt(&A, indexA(offset(rowStart, row), p));
+                    for (int group = 0; group < groups; ++group)
+                    {
+                        function.OperationAndUpdate(accumulators[row][group], TypedOperator::addFloat, function.Operator(TypedOperator::multiplyFloat, aValue, bValues[group]));
+                    }
+                }
+            }
+            kLoop.End();
+
+            for (int row = 0; row < rows; ++row)
+            {
+                for (int group = 0; group < groups; ++group)
+                {
+                    auto cIndex = indexC(offset(rowStart, row), offset(columnStart, group * groupWidth));
+                    function.SetValueAt(&C, cIndex, function.Load(accumulators[row][group]));
+                }
+            }
+        };
+
+        // Sweeps a row of micro-tiles across a panel of columns, with narrower tiles for the columns left over
+        auto emitColumns = [&](llvm::Value* rowStart, int rows, llvm::Value* panelStart, int panelColumns, llvm::Value* kStart, int kCount, bool accumulate) {
+            const int tileGroups = width > 1 ? gemmTileVectors : gemmTileScalars;
+            const int tileColumns = tileGroups * width;
+            const int numTiles = panelColumns / tileColumns;
+            if (numTiles > 0)
+            {
+                auto columnLoop = function.ForLoop();
+                columnLoop.Begin(numTiles);
+                {
+                    auto columnStart = function.Operator(TypedOperator::add, panelStart, function.Operator(TypedOperator::multiply, columnLoop.LoadIterationVariable(), function.Literal(tileColumns)));
+                    emitTile(rowStart, rows, columnStart, tileGroups, width, kStart, kCount, accumulate, &B, indexB);
+                }
+                columnLoop.End();
+            }
+
+            for (int column = numTiles * tileColumns; column < panelColumns;)
+            {
+                const int groupWidth = panelColumns - column >= width ? width : 1;
+                const int groups = std::min((panelColumns - column) / groupWidth, groupWidth > 1 ? gemmTileVectors : gemmTileScalars);
+                emitTile(rowStart, rows, offset(panelStart, column), groups, groupWidth, kStart, kCount, accumulate, &B, indexB);
+                column += groups * groupWidth;
+            }
+        };
+
+        // Calls `emitRowTile` for each tile of `gemmTileRows` rows of C, and for the rows left over
+        auto emitRowTiles = [&](const std::function<void(llvm::Value*, int)>& emitRowTile) {
+            const int numTiles = m / gemmTileRows;
+            if (numTiles > 0)
+            {
+                auto rowLoop = function.ForLoop();
+                rowLoop.Begin(numTiles);
+                {
+                    emitRowTile(function.Operator(TypedOperator::multiply, rowLoop.LoadIterationVariable(), function.Literal(gemmTileRows)), gemmTileRows);
+                }
+                rowLoop.End();
+            }
+
+            const int remainingRows = m % gemmTileRows;
+            if (remainingRows > 0)
+            {
+                emitRowTile(function.Literal(numTiles * gemmTileRows), remainingRows);
+            }
+        };
+
+        auto emitRows = [&](llvm::Value* panelStart, int panelColumns, llvm::Value* kStart, int kCount, bool accumulate) {
+            emitRowTiles([&](llvm::Value* rowStart, int rows) {
+                emitColumns(rowStart, rows, panelStart, panelColumns, kStart, kCount, accumulate);
+            });
+        };
+
+        // Packs `columns` columns of the transposed B, over `kCount` steps of the inner dimension, into the row-major
+        // scratch tile, and computes those columns of C for all the rows of A from it
+        auto emitPackedColumns = [&](llvm::Value* columnStart, int columns, llvm::Value* kStart, int kCount, bool accumulate) {
+            auto columnLoop = function.ForLoop();
+            columnLoop.Begin(columns);
+            {
+                auto column = columnLoop.LoadIterationVariable();
+                auto kLoop = function.ForLoop();
+                kLoop.Begin(kCount);
+                {
+                    auto p = kLoop.LoadIterationVariable();
+                    auto packedIndex = function.Operator(TypedOperator::add, function.Operator(TypedOperator::multiply, p, function.Literal(columns)), column);
+                    auto bIndex = indexB(function.Operator(TypedOperator::add, kStart, p), function.Operator(TypedOperator::add, columnStart, column));
+                    function.SetValueAt(pPackedB, packedIndex, function.ValueAt(&B, bIndex));
+                }
+                kLoop.End();
+            }
+            columnLoop.End();
+
+            auto indexPackedB = [&](llvm::Value* p, llvm::Value* column) {
+                auto row = function.Operator(TypedOperator::subtract, p, kStart);
+                return function.Operator(TypedOperator::add, function.Operator(TypedOperator::multiply, row, function.Literal(columns)), function.Operator(TypedOperator::subtract, column, columnStart));
+            };
+            emitRowTiles([&](llvm::Value* rowStart, int rows) {
+                for (int column = 0; column < columns;)
+                {
+                    const int groupWidth = columns - column >= width ? width : 1;
+                    const int groups = std::min((columns - column) / groupWidth, groupWidth > 1 ? gemmTileVectors : gemmTileScalars);
+                    emitTile(rowStart, rows, offset(columnStart, column), groups, groupWidth, kStart, kCount, accumulate, pPackedB, indexPackedB);
+                    column += groups * groupWidth;
+                }
+            });
+        };
+
+        auto emitPackedRows = [&](llvm::Value* panelStart, int panelColumns, llvm::Value* kStart, int kCount, bool accumulate) {
+            const int numTiles = panelColumns / packedTileColumns;
+            if (numTiles > 0)
+            {
+                auto columnTileLoop = function.ForLoop();
+                columnTileLoop.Begin(numTiles);
+                {
+                    auto columnStart = function.Operator(TypedOperator::add, panelStart, function.Operator(TypedOperator::multiply, columnTileLoop.LoadIterationVariable(), function.Literal(packedTileColumns)));
+                    emitPackedColumns(columnStart, packedTileColumns, kStart, kCount, accumulate);
+                }
+                columnTileLoop.End();
+            }
+
+            const int remainingColumns = panelColumns % packedTileColumns;
+            if (remainingColumns > 0)
+            {
+                emitPackedColumns(offset(panelStart, numTiles * packedTileColumns), remainingColumns, kStart, kCount, accumulate);
+            }
+        };
+        auto emitBlock = [&](llvm::Value* panelStart, int panelColumns, llvm::Value* kStart, int kCount, bool accumulate) {
+            if (transposeB)
+            {
+                emitPackedRows(panelStart, panelColumns, kStart, kCount, accumulate);
+            }
+            else
+            {
+                emitRows(panelStart, panelColumns, kStart, kCount, accumulate);
+            }
+        };
+
+        // The first block of the inner dimension initializes C, and the following ones accumulate into it
+        auto emitBlocksOfK = [&](llvm::Value* panelStart, int panelColumns) {
+            emitBlock(panelStart, panelColumns, function.Literal(0), std::min(k, gemmBlockK), false);
+
+            const int numBlocks = k / gemmBlockK;
+            if (numBlocks > 1)
+            {
+                auto kBlockLoop = function.ForLoop();
+                kBlockLoop.Begin(1, numBlocks, 1);
+                {
+                    auto kStart = function.Operator(TypedOperator::multiply, kBlockLoop.LoadIterationVariable(), function.Literal(gemmBlockK));
+                    emitBlock(panelStart, panelColumns, kStart, gemmBlockK, true);
+                }
+                kBlockLoop.End();
+            }
+
+            const int remainingK = k % gemmBlockK;
+            if (numBlocks > 0 && remainingK > 0)
+            {
+                emitBlock(panelStart, panelColumns, function.Literal(numBlocks * gemmBlockK), remainingK, true);
+            }
+        };
+
+        const int numPanels = n / gemmBlockN;
+        if (numPanels > 0)
+        {
+            auto panelLoop = function.ForLoop();
+            panelLoop.Begin(numPanels);
+            {
+                auto panelStart = function.Operator(TypedOperator::multiply, panelLoop.LoadIterationVariable(), function.Literal(gemmBlockN));
+                emitBlocksOfK(panelStart, gemmBlockN);
+            }
+            panelLoop.End();
+        }
+
+        const int remainingColumns = n % gemmBlockN;
+        if (remainingColumns > 0)
+        {
+            emitBlocksOfK(function.Literal(numPanels * gemmBlockN), remainingColumns);
+        }
+
+        function.Return();
+        _module.EndFunction();
+        return function.GetFunction();
+    }
+
+    template <>
+    llvm::Function* IRRuntime::GetGEMMStridedBatchedFunction<float>(bool useBlas)
+    {
+        return EmitGEMMStridedBatchedFunction(VariableType::Float, useBlas);
+    }
+
+    template <>
+    llvm::Function* IRRuntime::GetGEMMStridedBatchedFunction<double>(bool useBlas)
+    {
+        return EmitGEMMStridedBatchedFunction(VariableType::Double, useBlas);
+    }
+
+    template <>
+    llvm::Function* IRRuntime::GetTiledGEMMFunction<float>(bool transposeA, bool transposeB, int m, int n, int k, int lda, int ldb, int ldc)
+    {
+        return EmitTiledGEMMFunction(VariableType::Float, transposeA, transposeB, m, n, k, lda, ldb, ldc);
+    }
+
+    template <>
+    llvm::Function* IRRuntime::GetTiledGEMMFunction<double>(bool transposeA, bool transposeB, int m, int n, int k, int lda, int ldb, int ldc)
+    {
+        return EmitTiledGEMMFunction(VariableType::Double, transposeA, transposeB, m, n, k, lda, ldb, ldc);
+    }
+
     template <>
     llvm::Function* IRRuntime::GetGEMVFunction<float>()
     {
@@ -568,6 +568,12 @@ namespace emitters
                 os << "#include \"ClockInterface.h\"\n";
             }
 
+            // Thread pool for parallel loops, if used
+            if (moduleEmitter.GetCompilerParameters().parallelize)
+            {
+                os << "#include \"ThreadingInterface.h\"\n";
+            }
+
             // Module definitions (a.k.a. the C/C++ header)
             WriteModuleHeader(os, moduleEmitter);
         }
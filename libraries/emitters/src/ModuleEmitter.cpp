@@ -63,10 +63,42 @@ namespace emitters
             _parameters.targetDevice.numBits = c_defaultNumBits;
         }
 
+        // With no target specified at all, generate code for the machine we're running on
+        auto& targetDevice = _parameters.targetDevice;
+        if (targetDevice.deviceName == "" && targetDevice.triple == "" && targetDevice.cpu == "")
+        {
+            targetDevice.deviceName = "host";
+        }
+
         // Set low-level args based on target name (if present)
         if (_parameters.targetDevice.deviceName != "")
         {
-            if (_parameters.targetDevice.deviceName == "mac")
+            if (_parameters.targetDevice.deviceName == "host")
+            {
+                // Only fill in the properties that weren't explicitly set
+                auto hostDevice = GetHostTargetDevice();
+                if (targetDevice.triple == "")
+                {
+                    targetDevice.triple = hostDevice.triple;
+                }
+                if (targetDevice.dataLayout == "")
+                {
+                    targetDevice.dataLayout = hostDevice.dataLayout;
+                }
+                if (targetDevice.cpu == "")
+                {
+                    targetDevice.cpu = hostDevice.cpu;
+                }
+                if (targetDevice.features == "")
+                {
+                    targetDevice.features = hostDevice.features;
+                }
+                if (parameters.targetDevice.numBits == 0)
+                {
+                    targetDevice.numBits = hostDevice.numBits;
+                }
+            }
+            else if (_parameters.targetDevice.deviceName == "mac")
             {
                 _parameters.targetDevice.triple = c_macTriple;
                 _parameters.targetDevice.dataLayout = c_macDataLayout;
@@ -9,6 +9,16 @@
 #include "TargetDevice.h"
 #include "LLVMInclude.h"
 
+// llvm
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/Host.h"
+#include "llvm/Support/TargetRegistry.h"
+
+// stl
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 namespace ell
 {
 namespace emitters
@@ -20,5 +30,82 @@ namespace emitters
         return (t == "x86_64-pc-win32" || t == "x86_64-pc-windows-msvc" ||
                 t == "i386-pc-win32" || t == "i386-pc-windows-msvc");
     }
+
+    size_t TargetDevice::GetVectorBits() const
+    {
+        auto hasFeature = [this](const std::string& feature) { return features.find(feature) != std::string::npos; };
+        if (hasFeature("+avx512f"))
+        {
+            return 512;
+        }
+        if (hasFeature("+avx"))
+        {
+            return 256;
+        }
+        if (hasFeature("+neon"))
+        {
+            return 128;
+        }
+
+        // Fall back to the baseline vector unit of the architecture
+        auto t = triple.empty() ? llvm::sys::getDefaultTargetTriple() : triple;
+        auto arch = llvm::Triple(t).getArch();
+        switch (arch)
+        {
+            case llvm::Triple::x86:
+            case llvm::Triple::x86_64:
+            case llvm::Triple::aarch64:
+                return 128;
+            case llvm::Triple::arm:
+            case llvm::Triple::armeb:
+                // Cortex-A parts have NEON, microcontrollers don't
+                return cpu.compare(0, 8, "cortex-a") == 0 ? 128 : 0;
+            default:
+                return 0;
+        }
+    }
+
+    TargetDevice GetHostTargetDevice()
+    {
+        static const TargetDevice hostDevice = [] {
+            TargetDevice device;
+            device.deviceName = "host";
+            device.triple = llvm::sys::getProcessTriple();
+            device.cpu = llvm::sys::getHostCPUName();
+
+            llvm::StringMap<bool> hostFeatures;
+            if (llvm::sys::getHostCPUFeatures(hostFeatures))
+            {
+                // Sort the features, so the feature string is the same every time
+                std::vector<std::string> features;
+                for (const auto& feature : hostFeatures)
+                {
+                    features.push_back((feature.getValue() ? "+" : "-") + feature.getKey().str());
+                }
+                std::sort(features.begin(), features.end());
+                for (const auto& feature : features)
+                {
+                    device.features += (device.features.empty() ? "" : ",") + feature;
+                }
+            }
+
+            llvm::Triple triple(device.triple);
+            device.numBits = triple.isArch64Bit() ? 64 : (triple.isArch32Bit() ? 32 : 16);
+
+            llvm::InitializeNativeTarget();
+            std::string error;
+            const llvm::Target* target = llvm::TargetRegistry::lookupTarget(device.triple, error);
+            if (target != nullptr)
+            {
+                std::unique_ptr<llvm::TargetMachine> targetMachine(target->createTargetMachine(device.triple, device.cpu, device.features, llvm::TargetOptions(), llvm::None));
+                if (targetMachine)
+                {
+                    device.dataLayout = targetMachine->createDataLayout().getStringRepresentation();
+                }
+            }
+            return device;
+        }();
+        return hostDevice;
+    }
 }
 }
@@ -33,16 +33,12 @@ namespace emitters
     {
         assert(pRightValue != nullptr);
 
-        auto forLoop = ForLoop();
         llvm::Value* pLeftItem = Literal(leftValue);
-        forLoop.Begin(size);
-        {
-            auto i = forLoop.LoadIterationVariable();
-            llvm::Value* pRightItem = ValueAt(pRightValue, i);
+        VectorLoop(size, GetPointerElementType(pRightValue), [&](llvm::Value* i, size_t width) {
+            llvm::Value* pRightItem = VectorValueAt(pRightValue, i, width);
             llvm::Value* pTemp = Operator(type, pLeftItem, pRightItem);
             aggregator(i, pTemp);
-        }
-        forLoop.End();
+        });
     }
 
     template <typename ValueType>
@@ -50,16 +46,12 @@ namespace emitters
     {
         assert(pLeftValue != nullptr);
 
-        auto forLoop = ForLoop();
         llvm::Value* pRightItem = Literal(rightValue);
-        forLoop.Begin(size);
-        {
-            auto i = forLoop.LoadIterationVariable();
-            llvm::Value* pLeftItem = ValueAt(pLeftValue, i);
+        VectorLoop(size, GetPointerElementType(pLeftValue), [&](llvm::Value* i, size_t width) {
+            llvm::Value* pLeftItem = VectorValueAt(pLeftValue, i, width);
             llvm::Value* pTemp = Operator(type, pLeftItem, pRightItem);
             aggregator(i, pTemp);
-        }
-        forLoop.End();
+        });
     }
 
     template <typename ValueType>
@@ -34,6 +34,18 @@ namespace emitters
         return GetLogFunction(GetVariableType<ValueType>());
     }
 
+    template <typename ValueType>
+    llvm::Function* IRRuntime::GetTanhFunction()
+    {
+        return GetTanhFunction(GetVariableType<ValueType>());
+    }
+
+    template <typename ValueType>
+    llvm::Function* IRRuntime::GetSigmoidFunction()
+    {
+        return GetSigmoidFunction(GetVariableType<ValueType>());
+    }
+
     template <typename ValueType>
     llvm::Function* IRRuntime::GetDotProductFunction()
     {
@@ -16,6 +16,8 @@ void TestIfElseBlockRegions(bool runJit = false);
 void TestLogical();
 void TestMutableConditionForLoop();
 void TestMetadata();
+void TestLoopHints();
+void TestArgumentAttributes();
 
 void SetOutputPathBase(std::string path);
 std::string OutputPath(const char* pRelPath);
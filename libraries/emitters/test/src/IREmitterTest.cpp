@@ -467,3 +467,93 @@ void TestMetadata()
     IRExecutionEngine jit(std::move(module));
     jit.RunMain();
 }
+
+void TestLoopHints()
+{
+    IRModuleEmitter module("LoopHints");
+    auto int32Type = VariableType::Int32;
+    auto fn = module.BeginFunction("TestLoopHints", int32Type, { { "count", int32Type } });
+    llvm::Argument& count = *fn.Arguments().begin();
+
+    // Fill an array with 0, 1, 2, ... in a loop with hints, then sum it
+    const int size = 16;
+    auto pArray = fn.Variable(int32Type, size);
+    LoopHints hints;
+    hints.unrollCount = 4;
+    hints.vectorizeWidth = 4;
+    hints.interleaveCount = 2;
+    hints.parallelAccesses = true;
+    IRForLoopEmitter fillLoop(fn);
+    fillLoop.SetHints(hints);
+    fillLoop.Begin(&count);
+    {
+        auto i = fillLoop.LoadIterationVariable();
+        fn.SetValueAt(pArray, i, i);
+    }
+    fillLoop.End();
+
+    auto pSum = fn.Variable(int32Type, "sum");
+    fn.Store(pSum, fn.Literal(0));
+    IRForLoopEmitter sumLoop(fn);
+    sumLoop.Begin(&count);
+    {
+        fn.OperationAndUpdate(pSum, TypedOperator::add, fn.ValueAt(pArray, sumLoop.LoadIterationVariable()));
+    }
+    sumLoop.End();
+    fn.Return(fn.Load(pSum));
+    module.EndFunction();
+    fn.Verify();
+
+    // The hints are on the back edge of the first loop only, and its memory accesses are tagged as parallel
+    int numHintedLoops = 0;
+    int numParallelAccesses = 0;
+    for (auto& block : *fn.GetFunction())
+    {
+        if (block.getTerminator()->getMetadata(llvm::LLVMContext::MD_loop) != nullptr)
+        {
+            ++numHintedLoops;
+        }
+        for (auto& instruction : block)
+        {
+            if (instruction.getMetadata(llvm::LLVMContext::MD_mem_parallel_loop_access) != nullptr)
+            {
+                ++numParallelAccesses;
+            }
+        }
+    }
+    testing::ProcessTest("Testing loop hint metadata", testing::IsEqual(numHintedLoops, 1));
+    testing::ProcessTest("Testing parallel loop access metadata", numParallelAccesses > 0);
+
+    IRExecutionEngine jit(std::move(module));
+    auto testLoopHints = reinterpret_cast<int (*)(int)>(jit.ResolveFunctionAddress("TestLoopHints"));
+    testing::ProcessTest("Testing loop with hints", testing::IsEqual(testLoopHints(size), size * (size - 1) / 2));
+}
+
+void TestArgumentAttributes()
+{
+    IRModuleEmitter module("ArgumentAttributes");
+    auto fn = module.BeginFunction("TestArgumentAttributes", VariableType::Void, { { "input", VariableType::DoublePointer }, { "count", VariableType::Int32 }, { "output", VariableType::DoublePointer } });
+    fn.AddNoAliasAttribute(0);
+    fn.AddDereferenceableAttribute(0, 10);
+    fn.AddNoAliasAttribute(2);
+    module.EndFunction();
+
+    // Attribute indices are one-based
+    auto pFunction = fn.GetFunction();
+    testing::ProcessTest("Testing noalias argument attribute", pFunction->doesNotAlias(1) && !pFunction->doesNotAlias(2) && pFunction->doesNotAlias(3));
+    testing::ProcessTest("Testing dereferenceable argument attribute", testing::IsEqual(static_cast<int>(pFunction->getDereferenceableBytes(1)), 10 * static_cast<int>(sizeof(double))));
+
+    bool gotException = false;
+    try
+    {
+        fn.AddNoAliasAttribute(1); // not a pointer
+    }
+    catch (const EmitterException&)
+    {
+        gotException = true;
+    }
+    testing::ProcessTest("Testing attribute on non-pointer argument", gotException);
+
+    auto pArray = module.GlobalArray(VariableType::Double, "globalArray", 10);
+    testing::ProcessTest("Testing global array alignment", testing::IsEqual(static_cast<int>(pArray->getAlignment()), 32));
+}
@@ -25,6 +25,8 @@ void TestIR()
     TestLogical();
     TestMutableConditionForLoop();
     TestMetadata();
+    TestLoopHints();
+    TestArgumentAttributes();
 
     // From IRFunctionTest.h
     TestIRAddFunction();
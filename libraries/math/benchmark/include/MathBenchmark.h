@@ -0,0 +1,88 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     MathBenchmark.h (math_benchmarks)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// math
+#include "Operations.h"
+
+// stl
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ell
+{
+/// <summary> One timed operation on one shape. </summary>
+struct BenchmarkResult
+{
+    std::string operation;
+    std::string implementation;
+    std::string elementType;
+    std::string layout;
+    std::vector<size_t> shape;
+    double flops;
+    double bytes;
+    size_t iterations;
+    double secondsPerIteration;
+};
+
+/// <summary> Collects benchmark results and writes them as JSON. </summary>
+class BenchmarkReport
+{
+public:
+    /// <summary> Constructor. </summary>
+    ///
+    /// <param name="minTime"> The minimum time, in seconds, spent measuring each result. </param>
+    BenchmarkReport(double minTime);
+
+    /// <summary> Times a function and adds the result to the report. </summary>
+    ///
+    /// <param name="result"> The description of the result; its iterations and secondsPerIteration are filled in. </param>
+    /// <param name="function"> The function to time, which runs the operation once. </param>
+    template <typename FunctionType>
+    void Measure(BenchmarkResult result, FunctionType function);
+
+    /// <summary> Gets the results. </summary>
+    ///
+    /// <returns> The results. </returns>
+    const std::vector<BenchmarkResult>& GetResults() const { return _results; }
+
+    /// <summary> Writes the report, with a description of the machine configuration, as JSON. </summary>
+    ///
+    /// <param name="stream"> The output stream. </param>
+    void Write(std::ostream& stream) const;
+
+private:
+    double _minTime;
+    std::vector<BenchmarkResult> _results;
+};
+
+/// <summary>
+/// Runs the Dot, GEMV, GEMM, ColumnWiseSum and element-wise benchmarks for one element type and one
+/// implementation, over a sweep of sizes and layouts.
+/// </summary>
+///
+/// <param name="report"> [in,out] The report that collects the results. </param>
+/// <param name="maxMatrixSize"> The largest matrix dimension. </param>
+/// <param name="maxVectorSize"> The largest vector size. </param>
+template <typename ElementType, math::ImplementationType implementation>
+void BenchmarkOperations(BenchmarkReport& report, size_t maxMatrixSize, size_t maxVectorSize);
+
+/// <summary>
+/// Runs the GEMV and GEMM benchmarks of quantized weights (QuantizedWeightMatrix) and activations
+/// (QuantizedActivationMatrix), over a sweep of sizes.
+/// </summary>
+///
+/// <param name="report"> [in,out] The report that collects the results. </param>
+/// <param name="maxMatrixSize"> The largest matrix dimension. </param>
+void BenchmarkQuantizedOperations(BenchmarkReport& report, size_t maxMatrixSize);
+}
+
+#include "../tcc/MathBenchmark.tcc"
@@ -0,0 +1,46 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     MathBenchmarkArguments.h (math_benchmarks)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// utilities
+#include "CommandLineParser.h"
+#include "OutputStreamImpostor.h"
+
+// stl
+#include <string>
+
+namespace ell
+{
+/// <summary> Arguments for the math benchmarks. </summary>
+struct MathBenchmarkArguments
+{
+    std::string outputFilename;
+    utilities::OutputStreamImpostor outputStream;
+    double minTime;
+    size_t maxMatrixSize;
+    size_t maxVectorSize;
+    size_t numThreads;
+};
+
+/// <summary> Arguments for the parsed math benchmarks. </summary>
+struct ParsedMathBenchmarkArguments : public MathBenchmarkArguments, public utilities::ParsedArgSet
+{
+    /// <summary> Adds the arguments. </summary>
+    ///
+    /// <param name="parser"> [in,out] The parser. </param>
+    virtual void AddArgs(utilities::CommandLineParser& parser);
+
+    /// <summary> Check arguments. </summary>
+    ///
+    /// <param name="parser"> The parser. </param>
+    ///
+    /// <returns> An utilities::CommandLineParseResult. </returns>
+    virtual utilities::CommandLineParseResult PostProcess(const utilities::CommandLineParser& parser);
+};
+}
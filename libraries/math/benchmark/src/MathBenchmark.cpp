@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     MathBenchmark.cpp (math_benchmarks)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "MathBenchmark.h"
+
+// math
+#include "MatrixMultiplyKernel.h"
+#include "QuantizedMatrix.h"
+#include "VectorKernels.h"
+
+namespace ell
+{
+BenchmarkReport::BenchmarkReport(double minTime) :
+    _minTime(minTime)
+{
+}
+
+void BenchmarkReport::Write(std::ostream& stream) const
+{
+#ifdef USE_BLAS
+    const char* openBlasAvailable = "true";
+#else
+    const char* openBlasAvailable = "false";
+#endif
+
+    stream << "{\n";
+    // the vector kernels and the native matrix multiplication dispatch to the same instruction set
+    stream << "  \"instructionSet\": \"" << math::GetInstructionSetName(math::GetInstructionSet()) << "\",\n";
+    stream << "  \"matrixMultiplyKernels\": { \"float\": \"" << math::MatrixMultiplyKernel<float>::GetKernelName() << "\""
+           << ", \"double\": \"" << math::MatrixMultiplyKernel<double>::GetKernelName() << "\" },\n";
+    stream << "  \"numThreads\": " << math::Operations::GetNumThreads() << ",\n";
+    stream << "  \"openBlasAvailable\": " << openBlasAvailable << ",\n";
+    stream << "  \"results\": [";
+    for (size_t index = 0; index < _results.size(); ++index)
+    {
+        const auto& result = _results[index];
+        stream << (index == 0 ? "\n" : ",\n");
+        stream << "    { \"operation\": \"" << result.operation << "\""
+               << ", \"implementation\": \"" << result.implementation << "\""
+               << ", \"elementType\": \"" << result.elementType << "\""
+               << ", \"layout\": \"" << result.layout << "\""
+               << ", \"shape\": [";
+        for (size_t dimension = 0; dimension < result.shape.size(); ++dimension)
+        {
+            stream << (dimension == 0 ? "" : ", ") << result.shape[dimension];
+        }
+        stream << "]"
+               << ", \"iterations\": " << result.iterations
+               << ", \"secondsPerIteration\": " << result.secondsPerIteration
+               << ", \"gflops\": " << result.flops / result.secondsPerIteration * 1e-9
+               << ", \"gigabytesPerSecond\": " << result.bytes / result.secondsPerIteration * 1e-9
+               << " }";
+    }
+    stream << "\n  ]\n}\n";
+}
+
+void BenchmarkQuantizedOperations(BenchmarkReport& report, size_t maxMatrixSize)
+{
+    using namespace MathBenchmarkDetail;
+    for (auto size : GetMatrixSizes(maxMatrixSize))
+    {
+        auto weights = GetMatrix<float, math::MatrixLayout::rowMajor>(size, size);
+        auto activations = GetMatrix<float, math::MatrixLayout::columnMajor>(size, size);
+        math::QuantizedWeightMatrix A(weights);
+        math::QuantizedActivationMatrix B(activations);
+        auto v = GetVector<float, math::VectorOrientation::column>(size);
+        math::ColumnVector<float> u(size);
+        math::RowMatrix<float> C(size, size);
+        auto numElements = static_cast<double>(size) * size;
+
+        // the vector is quantized on every call, which is included in the time
+        report.Measure({ "GEMV", "native", "int8", "rowMajor", { size, size }, 2 * numElements, numElements + 8.0 * size },
+                       [&]() { math::Operations::Multiply(1.0f, A, v, 0.0f, u); });
+
+        report.Measure({ "GEMM", "native", "int8", "rowMajor*columnMajor", { size, size, size }, 2 * numElements * size, 2 * numElements + 4 * numElements },
+                       [&]() { math::Operations::Multiply(1.0f, A, B, 0.0f, C); });
+    }
+}
+}
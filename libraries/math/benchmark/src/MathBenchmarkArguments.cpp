@@ -0,0 +1,44 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     MathBenchmarkArguments.cpp (math_benchmarks)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "MathBenchmarkArguments.h"
+
+namespace ell
+{
+void ParsedMathBenchmarkArguments::AddArgs(utilities::CommandLineParser& parser)
+{
+    parser.AddOption(outputFilename, "outputFilename", "of", "Path to the JSON output file (default standard output)", "");
+    parser.AddOption(minTime, "minTime", "t", "Minimum time, in seconds, spent measuring each operation and size", 0.1);
+    parser.AddOption(maxMatrixSize, "maxMatrixSize", "mm", "Largest matrix dimension in the sweep", 1024);
+    parser.AddOption(maxVectorSize, "maxVectorSize", "mv", "Largest vector size in the sweep", 1 << 22);
+    parser.AddOption(numThreads, "numThreads", "nt", "Number of threads used by matrix multiplication", 1);
+}
+
+utilities::CommandLineParseResult ParsedMathBenchmarkArguments::PostProcess(const utilities::CommandLineParser& parser)
+{
+    std::vector<std::string> parseErrorMessages;
+    if (minTime <= 0)
+    {
+        parseErrorMessages.push_back("minTime must be positive");
+    }
+    if (numThreads == 0)
+    {
+        parseErrorMessages.push_back("numThreads must be positive");
+    }
+
+    if (outputFilename == "")
+    {
+        outputStream = utilities::OutputStreamImpostor(utilities::OutputStreamImpostor::StreamType::cout);
+    }
+    else
+    {
+        outputStream = utilities::OutputStreamImpostor(outputFilename);
+    }
+    return parseErrorMessages;
+}
+}
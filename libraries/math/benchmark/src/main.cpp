@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     main.cpp (math_benchmarks)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "MathBenchmark.h"
+#include "MathBenchmarkArguments.h"
+
+// math
+#include "Operations.h"
+
+// utilities
+#include "CommandLineParser.h"
+#include "Exception.h"
+
+// stl
+#include <iostream>
+
+using namespace ell;
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        // create a command line parser
+        utilities::CommandLineParser commandLineParser(argc, argv);
+
+        // add arguments to the command line parser
+        ParsedMathBenchmarkArguments benchmarkArguments;
+        commandLineParser.AddOptionSet(benchmarkArguments);
+        commandLineParser.Parse();
+
+        math::Operations::SetNumThreads(benchmarkArguments.numThreads);
+
+        BenchmarkReport report(benchmarkArguments.minTime);
+        auto maxMatrixSize = benchmarkArguments.maxMatrixSize;
+        auto maxVectorSize = benchmarkArguments.maxVectorSize;
+        BenchmarkOperations<float, math::ImplementationType::native>(report, maxMatrixSize, maxVectorSize);
+        BenchmarkOperations<double, math::ImplementationType::native>(report, maxMatrixSize, maxVectorSize);
+        BenchmarkQuantizedOperations(report, maxMatrixSize);
+#ifdef USE_BLAS
+        // without BLAS, the openBlas implementation is the native one, so it is not measured twice
+        BenchmarkOperations<float, math::ImplementationType::openBlas>(report, maxMatrixSize, maxVectorSize);
+        BenchmarkOperations<double, math::ImplementationType::openBlas>(report, maxMatrixSize, maxVectorSize);
+#endif
+
+        report.Write(benchmarkArguments.outputStream);
+    }
+    catch (const utilities::CommandLineParserPrintHelpException& exception)
+    {
+        std::cout << exception.GetHelpText() << std::endl;
+        return 0;
+    }
+    catch (const utilities::CommandLineParserErrorException& exception)
+    {
+        std::cerr << "Command line parse error:" << std::endl;
+        for (const auto& error : exception.GetParseErrors())
+        {
+            std::cerr << error.GetMessage() << std::endl;
+        }
+        return 1;
+    }
+    catch (const utilities::Exception& exception)
+    {
+        std::cerr << "exception: " << exception.GetMessage() << std::endl;
+        return 1;
+    }
+    return 0;
+}
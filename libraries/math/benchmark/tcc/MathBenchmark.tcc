@@ -0,0 +1,199 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     MathBenchmark.tcc (math_benchmarks)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// math
+#include "Matrix.h"
+#include "Vector.h"
+
+// utilities
+#include "TypeName.h"
+
+// stl
+#include <chrono>
+
+namespace ell
+{
+namespace MathBenchmarkDetail
+{
+    template <math::ImplementationType implementation>
+    std::string GetImplementationName()
+    {
+        return implementation == math::ImplementationType::native ? "native" : "openBlas";
+    }
+
+    template <math::MatrixLayout layout>
+    std::string GetLayoutName()
+    {
+        return layout == math::MatrixLayout::rowMajor ? "rowMajor" : "columnMajor";
+    }
+
+    // Sizes from 64 up to (and including) the maximum, growing by factors of 4
+    inline std::vector<size_t> GetVectorSizes(size_t maxSize)
+    {
+        std::vector<size_t> sizes;
+        for (size_t size = 64; size < maxSize; size *= 4)
+        {
+            sizes.push_back(size);
+        }
+        sizes.push_back(maxSize);
+        return sizes;
+    }
+
+    // Sizes from 16 up to (and including) the maximum, growing by factors of 2
+    inline std::vector<size_t> GetMatrixSizes(size_t maxSize)
+    {
+        std::vector<size_t> sizes;
+        for (size_t size = 16; size < maxSize; size *= 2)
+        {
+            sizes.push_back(size);
+        }
+        sizes.push_back(maxSize);
+        return sizes;
+    }
+
+    template <typename ElementType>
+    void Fill(ElementType* pData, size_t size)
+    {
+        // small values in [-1, 1] keep repeated accumulation finite
+        for (size_t i = 0; i < size; ++i)
+        {
+            pData[i] = static_cast<ElementType>(static_cast<int>(i % 17) - 8) / 8;
+        }
+    }
+
+    template <typename ElementType, math::MatrixLayout layout>
+    math::Matrix<ElementType, layout> GetMatrix(size_t numRows, size_t numColumns)
+    {
+        math::Matrix<ElementType, layout> M(numRows, numColumns);
+        Fill(M.GetDataPointer(), M.Size());
+        return M;
+    }
+
+    template <typename ElementType, math::VectorOrientation orientation>
+    math::Vector<ElementType, orientation> GetVector(size_t size)
+    {
+        math::Vector<ElementType, orientation> v(size);
+        Fill(v.GetDataPointer(), size);
+        return v;
+    }
+
+    template <typename ElementType, math::ImplementationType implementation, math::MatrixLayout layout>
+    void BenchmarkMatrixVector(BenchmarkReport& report, const std::vector<size_t>& sizes)
+    {
+        using Ops = math::OperationsImplementation<implementation>;
+        auto elementSize = static_cast<double>(sizeof(ElementType));
+        for (auto size : sizes)
+        {
+            auto M = GetMatrix<ElementType, layout>(size, size);
+            auto v = GetVector<ElementType, math::VectorOrientation::column>(size);
+            math::ColumnVector<ElementType> u(size);
+            auto numElements = static_cast<double>(size) * size;
+
+            report.Measure({ "GEMV", GetImplementationName<implementation>(), utilities::TypeName<ElementType>::GetName(), GetLayoutName<layout>(), { size, size }, 2 * numElements, (numElements + 3.0 * size) * elementSize },
+                           [&]() { Ops::Multiply(static_cast<ElementType>(1), M, v, static_cast<ElementType>(0), u); });
+
+            math::RowVector<ElementType> w(size);
+            report.Measure({ "ColumnWiseSum", GetImplementationName<implementation>(), utilities::TypeName<ElementType>::GetName(), GetLayoutName<layout>(), { size, size }, numElements, (numElements + size) * elementSize },
+                           [&]() { Ops::ColumnWiseSum(M, w); });
+        }
+    }
+
+    template <typename ElementType, math::ImplementationType implementation, math::MatrixLayout layoutA, math::MatrixLayout layoutB>
+    void BenchmarkMatrixMatrix(BenchmarkReport& report, const std::vector<size_t>& sizes)
+    {
+        using Ops = math::OperationsImplementation<implementation>;
+        auto elementSize = static_cast<double>(sizeof(ElementType));
+        for (auto size : sizes)
+        {
+            auto A = GetMatrix<ElementType, layoutA>(size, size);
+            auto B = GetMatrix<ElementType, layoutB>(size, size);
+            math::Matrix<ElementType, layoutA> C(size, size);
+            auto numElements = static_cast<double>(size) * size;
+
+            // the bandwidth counts each operand once, which is a lower bound on the actual traffic
+            report.Measure({ "GEMM", GetImplementationName<implementation>(), utilities::TypeName<ElementType>::GetName(), GetLayoutName<layoutA>() + "*" + GetLayoutName<layoutB>(), { size, size, size }, 2 * numElements * size, 4 * numElements * elementSize },
+                           [&]() { Ops::Multiply(static_cast<ElementType>(1), A, B, static_cast<ElementType>(0), C); });
+        }
+    }
+
+    template <typename ElementType, math::ImplementationType implementation>
+    void BenchmarkVector(BenchmarkReport& report, const std::vector<size_t>& sizes)
+    {
+        using Ops = math::OperationsImplementation<implementation>;
+        auto elementSize = static_cast<double>(sizeof(ElementType));
+        auto typeName = utilities::TypeName<ElementType>::GetName();
+        auto implementationName = GetImplementationName<implementation>();
+        for (auto size : sizes)
+        {
+            auto u = GetVector<ElementType, math::VectorOrientation::column>(size);
+            auto v = GetVector<ElementType, math::VectorOrientation::column>(size);
+            math::ColumnVector<ElementType> t(size);
+            auto n = static_cast<double>(size);
+
+            // the result of Dot goes to a volatile, so the call cannot be optimized away
+            volatile ElementType sink = 0;
+            report.Measure({ "Dot", implementationName, typeName, "", { size }, 2 * n, 2 * n * elementSize },
+                           [&]() { sink = Ops::Dot(u, v); });
+
+            report.Measure({ "AddScalar", implementationName, typeName, "", { size }, n, 2 * n * elementSize },
+                           [&]() { Ops::Add(static_cast<ElementType>(1), t); });
+
+            report.Measure({ "AddScaledVector", implementationName, typeName, "", { size }, 2 * n, 3 * n * elementSize },
+                           [&]() { Ops::Add(static_cast<ElementType>(0.5), v, t); });
+
+            // 1 * t + 0 leaves t unchanged, so repeated calls do not overflow
+            report.Measure({ "MultiplyAdd", implementationName, typeName, "", { size }, 2 * n, 2 * n * elementSize },
+                           [&]() { Ops::MultiplyAdd(static_cast<ElementType>(1), static_cast<ElementType>(0), t); });
+
+            report.Measure({ "ElementWiseMultiply", implementationName, typeName, "", { size }, n, 3 * n * elementSize },
+                           [&]() { Ops::ElementWiseMultiply(u, v, t); });
+        }
+    }
+}
+
+template <typename FunctionType>
+void BenchmarkReport::Measure(BenchmarkResult result, FunctionType function)
+{
+    using Clock = std::chrono::steady_clock;
+
+    // one untimed call warms up the caches (and the thread pool, for multithreaded operations)
+    function();
+
+    size_t iterations = 0;
+    double elapsed = 0;
+    auto start = Clock::now();
+    do
+    {
+        function();
+        ++iterations;
+        elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    } while (elapsed < _minTime);
+
+    result.iterations = iterations;
+    result.secondsPerIteration = elapsed / iterations;
+    _results.push_back(result);
+}
+
+template <typename ElementType, math::ImplementationType implementation>
+void BenchmarkOperations(BenchmarkReport& report, size_t maxMatrixSize, size_t maxVectorSize)
+{
+    using namespace MathBenchmarkDetail;
+    auto vectorSizes = GetVectorSizes(maxVectorSize);
+    auto matrixSizes = GetMatrixSizes(maxMatrixSize);
+
+    BenchmarkVector<ElementType, implementation>(report, vectorSizes);
+
+    BenchmarkMatrixVector<ElementType, implementation, math::MatrixLayout::rowMajor>(report, matrixSizes);
+    BenchmarkMatrixVector<ElementType, implementation, math::MatrixLayout::columnMajor>(report, matrixSizes);
+
+    BenchmarkMatrixMatrix<ElementType, implementation, math::MatrixLayout::rowMajor, math::MatrixLayout::rowMajor>(report, matrixSizes);
+    BenchmarkMatrixMatrix<ElementType, implementation, math::MatrixLayout::rowMajor, math::MatrixLayout::columnMajor>(report, matrixSizes);
+    BenchmarkMatrixMatrix<ElementType, implementation, math::MatrixLayout::columnMajor, math::MatrixLayout::rowMajor>(report, matrixSizes);
+    BenchmarkMatrixMatrix<ElementType, implementation, math::MatrixLayout::columnMajor, math::MatrixLayout::columnMajor>(report, matrixSizes);
+}
+}
@@ -0,0 +1,78 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     AlignedAllocator.h (math)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// stl
+#include <cstddef>
+#include <vector>
+
+namespace ell
+{
+namespace math
+{
+    /// <summary>
+    /// The alignment, in bytes, of the memory owned by Vector, Matrix and Tensor. This is a cache line,
+    /// which is also the width of the widest (AVX-512) vector registers.
+    /// </summary>
+    constexpr size_t c_storageAlignment = 64;
+
+    /// <summary> An STL allocator that returns memory aligned to a given number of bytes. </summary>
+    ///
+    /// <typeparam name="ValueType"> The type of the allocated values. </typeparam>
+    /// <typeparam name="alignment"> The alignment in bytes, which must be a power of 2. </typeparam>
+    template <typename ValueType, size_t alignment = c_storageAlignment>
+    class AlignedAllocator
+    {
+    public:
+        static_assert(alignment != 0 && (alignment & (alignment - 1)) == 0, "alignment must be a power of 2");
+
+        // STYLE intentional deviation from project style - the allocator interface is defined by the STL
+        using value_type = ValueType;
+
+        template <typename OtherType>
+        struct rebind
+        {
+            using other = AlignedAllocator<OtherType, alignment>;
+        };
+
+        AlignedAllocator() = default;
+
+        /// <summary> Converting constructor, required by the STL allocator interface. </summary>
+        template <typename OtherType>
+        AlignedAllocator(const AlignedAllocator<OtherType, alignment>&) {}
+
+        /// <summary> Allocates aligned, uninitialized memory. </summary>
+        ///
+        /// <param name="count"> The number of values to allocate. </param>
+        ///
+        /// <returns> Pointer to the allocated memory. </returns>
+        ValueType* allocate(size_t count);
+
+        /// <summary> Frees memory returned by allocate. </summary>
+        ///
+        /// <param name="pData"> Pointer to the memory. </param>
+        /// <param name="count"> The number of values that were allocated. </param>
+        void deallocate(ValueType* pData, size_t count);
+    };
+
+    /// <summary> Equality operator for aligned allocators, which are stateless and therefore always equal. </summary>
+    template <typename ValueType1, typename ValueType2, size_t alignment>
+    bool operator==(const AlignedAllocator<ValueType1, alignment>&, const AlignedAllocator<ValueType2, alignment>&) { return true; }
+
+    /// <summary> Inequality operator for aligned allocators, which are stateless and therefore always equal. </summary>
+    template <typename ValueType1, typename ValueType2, size_t alignment>
+    bool operator!=(const AlignedAllocator<ValueType1, alignment>&, const AlignedAllocator<ValueType2, alignment>&) { return false; }
+
+    /// <summary> A std::vector whose data is aligned to c_storageAlignment bytes. </summary>
+    template <typename ElementType>
+    using AlignedStorage = std::vector<ElementType, AlignedAllocator<ElementType>>;
+}
+}
+
+#include "../tcc/AlignedAllocator.tcc"
@@ -0,0 +1,139 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ChannelBlockedTensor.h (math)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "AlignedAllocator.h"
+#include "Tensor.h"
+
+// stl
+#include <cstddef>
+
+namespace ell
+{
+namespace math
+{
+    /// <summary>
+    /// A tensor whose channels are split into blocks of blockSize consecutive channels, in the style
+    /// of the NCHWc layout. Memory holds one (row, column, channel-in-block) tensor per block, so the
+    /// blockSize channels of each pixel are contiguous and aligned, and an operation that treats the
+    /// channels independently (such as convolution, pooling or batch normalization) can load them as
+    /// one SIMD vector. Choosing blockSize equal to the SIMD width of ElementType (for example, 8 for
+    /// float with AVX) gives whole vectors. The last block is padded with zero channels.
+    /// </summary>
+    ///
+    /// <typeparam name="ElementType"> Tensor element type. </typeparam>
+    /// <typeparam name="blockSize"> The number of channels in a block. </typeparam>
+    template <typename ElementType, size_t blockSize>
+    class ChannelBlockedTensor
+    {
+    public:
+        /// <summary> Constructs a tensor of zeros. </summary>
+        ///
+        /// <param name="numRows"> Number of rows. </param>
+        /// <param name="numColumns"> Number of columns. </param>
+        /// <param name="numChannels"> Number of channels, which need not be a multiple of blockSize. </param>
+        ChannelBlockedTensor(size_t numRows, size_t numColumns, size_t numChannels);
+
+        /// <summary> Constructs a copy of a tensor in any of the permuted layouts. </summary>
+        ///
+        /// <param name="tensor"> The tensor to copy. </param>
+        template <Dimension dimension0, Dimension dimension1, Dimension dimension2>
+        explicit ChannelBlockedTensor(ConstTensorReference<ElementType, dimension0, dimension1, dimension2> tensor);
+
+        /// <summary> Gets the number of rows. </summary>
+        ///
+        /// <returns> The number of rows. </returns>
+        size_t NumRows() const { return _numRows; }
+
+        /// <summary> Gets the number of columns. </summary>
+        ///
+        /// <returns> The number of columns. </returns>
+        size_t NumColumns() const { return _numColumns; }
+
+        /// <summary> Gets the number of channels, excluding the padding. </summary>
+        ///
+        /// <returns> The number of channels. </returns>
+        size_t NumChannels() const { return _numChannels; }
+
+        /// <summary> Gets the number of channel blocks. </summary>
+        ///
+        /// <returns> The number of channel blocks. </returns>
+        size_t NumChannelBlocks() const { return (_numChannels + blockSize - 1) / blockSize; }
+
+        /// <summary> Gets the number of stored elements, including the padding channels. </summary>
+        ///
+        /// <returns> The number of stored elements. </returns>
+        size_t Size() const { return _data.size(); }
+
+        /// <summary> Element access operator. </summary>
+        ///
+        /// <param name="row"> The row. </param>
+        /// <param name="column"> The column. </param>
+        /// <param name="channel"> The channel. </param>
+        ///
+        /// <returns> A copy of a tensor element. </returns>
+        ElementType operator()(size_t row, size_t column, size_t channel) const;
+
+        /// <summary> Element access operator. </summary>
+        ///
+        /// <param name="row"> The row. </param>
+        /// <param name="column"> The column. </param>
+        /// <param name="channel"> The channel. </param>
+        ///
+        /// <returns> A reference to a tensor element. </returns>
+        ElementType& operator()(size_t row, size_t column, size_t channel);
+
+        /// <summary>
+        /// Gets a pointer to the blockSize contiguous channels of a block at a given row and column.
+        /// The blocks of consecutive columns follow each other, and so do the rows.
+        /// </summary>
+        ///
+        /// <param name="channelBlock"> The channel block. </param>
+        /// <param name="row"> The row. </param>
+        /// <param name="column"> The column. </param>
+        ///
+        /// <returns> Const pointer to the first channel of the block. </returns>
+        const ElementType* GetBlockPointer(size_t channelBlock, size_t row, size_t column) const { return _data.data() + GetBlockOffset(channelBlock, row, column); }
+
+        /// <summary>
+        /// Gets a pointer to the blockSize contiguous channels of a block at a given row and column.
+        /// The blocks of consecutive columns follow each other, and so do the rows.
+        /// </summary>
+        ///
+        /// <param name="channelBlock"> The channel block. </param>
+        /// <param name="row"> The row. </param>
+        /// <param name="column"> The column. </param>
+        ///
+        /// <returns> Pointer to the first channel of the block. </returns>
+        ElementType* GetBlockPointer(size_t channelBlock, size_t row, size_t column) { return _data.data() + GetBlockOffset(channelBlock, row, column); }
+
+        /// <summary> Copies the elements of a tensor with the same shape into this tensor. </summary>
+        ///
+        /// <param name="tensor"> The tensor to copy. </param>
+        template <Dimension dimension0, Dimension dimension1, Dimension dimension2>
+        void CopyFrom(ConstTensorReference<ElementType, dimension0, dimension1, dimension2> tensor);
+
+        /// <summary> Copies the elements of this tensor into a tensor with the same shape. </summary>
+        ///
+        /// <param name="tensor"> The tensor that receives the elements. </param>
+        template <Dimension dimension0, Dimension dimension1, Dimension dimension2>
+        void CopyTo(TensorReference<ElementType, dimension0, dimension1, dimension2> tensor) const;
+
+    private:
+        size_t GetBlockOffset(size_t channelBlock, size_t row, size_t column) const { return ((channelBlock * _numRows + row) * _numColumns + column) * blockSize; }
+
+        size_t _numRows;
+        size_t _numColumns;
+        size_t _numChannels;
+        AlignedStorage<ElementType> _data;
+    };
+}
+}
+
+#include "../tcc/ChannelBlockedTensor.tcc"
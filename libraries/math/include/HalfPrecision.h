@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     HalfPrecision.h (math)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// stl
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace ell
+{
+namespace math
+{
+    /// <summary>
+    /// A 16 bit IEEE 754 floating point number (1 sign bit, 5 exponent bits, 10 mantissa bits), used
+    /// to store vectors, matrices and tensors in half the memory of float. It converts implicitly to
+    /// and from float, so all arithmetic is carried out in float. Conversion from float rounds to the
+    /// nearest representable value; values beyond +-65504 become infinite.
+    /// </summary>
+    struct Float16
+    {
+        Float16() = default;
+
+        /// <summary> Constructs a Float16 by rounding a float. </summary>
+        ///
+        /// <param name="value"> The value. </param>
+        Float16(float value);
+
+        /// <summary> Converts to float, exactly. </summary>
+        operator float() const;
+
+        /// <summary> Constructs a Float16 from its bit pattern. </summary>
+        ///
+        /// <param name="bits"> The bit pattern. </param>
+        ///
+        /// <returns> The Float16. </returns>
+        static Float16 FromBits(uint16_t bits);
+
+        uint16_t bits;
+    };
+
+    /// <summary>
+    /// A 16 bit brain floating point number (1 sign bit, 8 exponent bits, 7 mantissa bits), which is
+    /// the upper half of a float. It has the range of float and less precision than Float16. It
+    /// converts implicitly to and from float, so all arithmetic is carried out in float.
+    /// </summary>
+    struct BFloat16
+    {
+        BFloat16() = default;
+
+        /// <summary> Constructs a BFloat16 by rounding a float. </summary>
+        ///
+        /// <param name="value"> The value. </param>
+        BFloat16(float value);
+
+        /// <summary> Converts to float, exactly. </summary>
+        operator float() const;
+
+        /// <summary> Constructs a BFloat16 from its bit pattern. </summary>
+        ///
+        /// <param name="bits"> The bit pattern. </param>
+        ///
+        /// <returns> The BFloat16. </returns>
+        static BFloat16 FromBits(uint16_t bits);
+
+        uint16_t bits;
+    };
+
+    /// \name Array Conversions
+    /// Convert size consecutive elements between float and a 16 bit storage type.
+    /// @{
+    void ConvertElements(const float* pSource, Float16* pTarget, size_t size);
+    void ConvertElements(const Float16* pSource, float* pTarget, size_t size);
+    void ConvertElements(const float* pSource, BFloat16* pTarget, size_t size);
+    void ConvertElements(const BFloat16* pSource, float* pTarget, size_t size);
+    /// @}
+}
+}
+
+#include "../tcc/HalfPrecision.tcc"
@@ -7,6 +7,8 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include "AlignedAllocator.h"
+#include "TransposeKernel.h"
 #include "Vector.h"
 
 // utilities
@@ -61,6 +63,17 @@ namespace math
         rowMajor
     };
 
+    /// <summary> Enum that determines how a Matrix pads the storage of its rows (or columns). </summary>
+    enum class MatrixPadding
+    {
+        none, ///< rows of a row major matrix (columns of a column major matrix) are stored back to back
+        aligned ///< every row of a row major matrix (column of a column major matrix) starts on a c_storageAlignment boundary
+    };
+
+    /// <summary> Forward declaration of the base class of lazy matrix expressions (see MatrixExpression.h). </summary>
+    template <typename ElementType, typename DerivedType>
+    class MatrixExpression;
+
     /// <summary> Helper class to obtain the transpose of a MatrixLayout </summary>
     ///
     /// Usage: auto transposedLayout = TransposeMatrixLayout<layout>::value
@@ -409,6 +422,13 @@ namespace math
         /// <param name="other"> The other matrix. </param>
         void CopyFrom(ConstMatrixReference<ElementType, TransposeMatrixLayout<layout>::value> other);
 
+        /// <summary> Evaluates a matrix expression into this matrix, in a single pass over the elements. </summary>
+        ///
+        /// <typeparam name="ExpressionType"> The expression type. </typeparam>
+        /// <param name="expression"> The expression. </param>
+        template <typename ExpressionType>
+        void CopyFrom(const MatrixExpression<ElementType, ExpressionType>& expression);
+
         /// <summary> Sets all matrix elements to zero. </summary>
         void Reset() { Fill(0); }
 
@@ -504,6 +524,13 @@ namespace math
         /// <param name="other"> The constant value. </param>
         void operator+=(ElementType value);
 
+        /// <summary> Evaluates a matrix expression and adds it to this matrix, in a single pass over the elements. </summary>
+        ///
+        /// <typeparam name="ExpressionType"> The expression type. </typeparam>
+        /// <param name="expression"> The expression. </param>
+        template <typename ExpressionType>
+        void operator+=(const MatrixExpression<ElementType, ExpressionType>& expression);
+
         /// <summary> Subtracts a constant value from this matrix. </summary>
         ///
         /// <param name="other"> The constant value. </param>
@@ -580,7 +607,8 @@ namespace math
         ///
         /// <param name="numRows"> Number of rows in the matrix. </param>
         /// <param name="numColumns"> Number of columns in the matrix. </param>
-        Matrix(size_t numRows, size_t numColumns);
+        /// <param name="padding"> (Optional) Determines whether the increment is rounded up so that every row (or column) is aligned. </param>
+        Matrix(size_t numRows, size_t numColumns, MatrixPadding padding = MatrixPadding::none);
 
         /// <summary> Constructs a matrix from an initialization list. </summary>
         ///
@@ -639,15 +667,19 @@ namespace math
 
         /// <summary> Returns a copy of the contents of the Matrix. </summary>
         ///
-        /// <returns> A std::vector with a copy of the contents of the Matrix. </returns>
-        std::vector<ElementType> ToArray() const { return _data; }
+        /// <returns> A std::vector with a copy of the contents of the Matrix, without padding. </returns>
+        std::vector<ElementType> ToArray() const;
 
     private:
         using RectangularMatrixBase<ElementType>::_pData;
         using RectangularMatrixBase<ElementType>::_numRows;
         using RectangularMatrixBase<ElementType>::_numColumns;
         using RectangularMatrixBase<ElementType>::_increment;
-        std::vector<ElementType> _data;
+
+        static size_t GetPaddedIncrement(size_t numRows, size_t numColumns, MatrixPadding padding);
+        static size_t GetNumIntervals(size_t numRows, size_t numColumns);
+
+        AlignedStorage<ElementType> _data;
     };
 
     /// <summary> A class that implements helper functions for archiving/unarchiving Matrix instances. </summary>
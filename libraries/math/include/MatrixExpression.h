@@ -0,0 +1,194 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     MatrixExpression.h (math)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Matrix.h"
+#include "Vector.h"
+
+// stl
+#include <cstddef>
+
+namespace ell
+{
+namespace math
+{
+    /// <summary>
+    /// Base class for lazy matrix expressions, such as 2.0 * A.Transpose() + B - C. An expression only
+    /// records its operands; it is evaluated element by element, in a single pass and without
+    /// temporary matrices, by MatrixReference::CopyFrom or MatrixReference::operator+=. Because the
+    /// destination is written as the expression is evaluated, the destination may appear in the
+    /// expression only as a plain (untransposed) operand.
+    /// </summary>
+    ///
+    /// <typeparam name="ElementType"> Matrix element type. </typeparam>
+    /// <typeparam name="DerivedType"> The expression type that derives from this class. </typeparam>
+    template <typename ElementType, typename DerivedType>
+    class MatrixExpression
+    {
+    public:
+        /// <summary> Gets the derived expression. </summary>
+        ///
+        /// <returns> Reference to the derived expression. </returns>
+        const DerivedType& GetDerived() const { return static_cast<const DerivedType&>(*this); }
+    };
+
+    /// <summary> A matrix expression that refers to the elements of a matrix. </summary>
+    ///
+    /// <typeparam name="ElementType"> Matrix element type. </typeparam>
+    /// <typeparam name="layout"> Matrix layout. </typeparam>
+    template <typename ElementType, MatrixLayout layout>
+    class MatrixOperand : public MatrixExpression<ElementType, MatrixOperand<ElementType, layout>>
+    {
+    public:
+        /// <summary> Constructs a matrix operand. </summary>
+        ///
+        /// <param name="matrix"> The matrix, which must outlive the operand. </param>
+        MatrixOperand(ConstMatrixReference<ElementType, layout> matrix);
+
+        size_t NumRows() const { return _numRows; }
+        size_t NumColumns() const { return _numColumns; }
+        ElementType operator()(size_t rowIndex, size_t columnIndex) const;
+
+    private:
+        const ElementType* _pData;
+        size_t _numRows;
+        size_t _numColumns;
+        size_t _increment;
+    };
+
+    /// <summary> A matrix expression whose rows (or columns) are all copies of the same vector. </summary>
+    ///
+    /// <typeparam name="ElementType"> Vector element type. </typeparam>
+    /// <typeparam name="orientation"> Vector orientation. A row vector is repeated as the rows of the
+    /// matrix and a column vector is repeated as its columns. </typeparam>
+    template <typename ElementType, VectorOrientation orientation>
+    class RepeatedVectorOperand : public MatrixExpression<ElementType, RepeatedVectorOperand<ElementType, orientation>>
+    {
+    public:
+        /// <summary> Constructs a repeated vector operand. </summary>
+        ///
+        /// <param name="vector"> The vector, which must outlive the operand. </param>
+        /// <param name="numRepetitions"> The number of times the vector is repeated. </param>
+        RepeatedVectorOperand(ConstVectorReference<ElementType, orientation> vector, size_t numRepetitions);
+
+        size_t NumRows() const { return orientation == VectorOrientation::row ? _numRepetitions : _size; }
+        size_t NumColumns() const { return orientation == VectorOrientation::row ? _size : _numRepetitions; }
+        ElementType operator()(size_t rowIndex, size_t columnIndex) const;
+
+    private:
+        const ElementType* _pData;
+        size_t _size;
+        size_t _increment;
+        size_t _numRepetitions;
+    };
+
+    /// <summary> A matrix expression that multiplies another expression by a scalar. </summary>
+    ///
+    /// <typeparam name="ElementType"> Matrix element type. </typeparam>
+    /// <typeparam name="ExpressionType"> The type of the expression being scaled. </typeparam>
+    template <typename ElementType, typename ExpressionType>
+    class ScaledMatrixExpression : public MatrixExpression<ElementType, ScaledMatrixExpression<ElementType, ExpressionType>>
+    {
+    public:
+        /// <summary> Constructs a scaled matrix expression. </summary>
+        ///
+        /// <param name="scalar"> The scalar. </param>
+        /// <param name="expression"> The expression being scaled. </param>
+        ScaledMatrixExpression(ElementType scalar, ExpressionType expression);
+
+        size_t NumRows() const { return _expression.NumRows(); }
+        size_t NumColumns() const { return _expression.NumColumns(); }
+        ElementType operator()(size_t rowIndex, size_t columnIndex) const { return _scalar * _expression(rowIndex, columnIndex); }
+
+    private:
+        ElementType _scalar;
+        ExpressionType _expression;
+    };
+
+    /// <summary> A matrix expression that adds two other expressions. </summary>
+    ///
+    /// <typeparam name="ElementType"> Matrix element type. </typeparam>
+    /// <typeparam name="LeftExpressionType"> The type of the left expression. </typeparam>
+    /// <typeparam name="RightExpressionType"> The type of the right expression. </typeparam>
+    template <typename ElementType, typename LeftExpressionType, typename RightExpressionType>
+    class SumMatrixExpression : public MatrixExpression<ElementType, SumMatrixExpression<ElementType, LeftExpressionType, RightExpressionType>>
+    {
+    public:
+        /// <summary> Constructs a sum of two matrix expressions with the same size. </summary>
+        ///
+        /// <param name="left"> The left expression. </param>
+        /// <param name="right"> The right expression. </param>
+        SumMatrixExpression(LeftExpressionType left, RightExpressionType right);
+
+        size_t NumRows() const { return _left.NumRows(); }
+        size_t NumColumns() const { return _left.NumColumns(); }
+        ElementType operator()(size_t rowIndex, size_t columnIndex) const { return _left(rowIndex, columnIndex) + _right(rowIndex, columnIndex); }
+
+    private:
+        LeftExpressionType _left;
+        RightExpressionType _right;
+    };
+
+    /// <summary> Makes a matrix expression that repeats a row vector as the rows of a matrix. </summary>
+    ///
+    /// <param name="vector"> The row vector. </param>
+    /// <param name="numRows"> The number of rows. </param>
+    ///
+    /// <returns> The expression. </returns>
+    template <typename ElementType>
+    RepeatedVectorOperand<ElementType, VectorOrientation::row> RepeatRow(ConstVectorReference<ElementType, VectorOrientation::row> vector, size_t numRows);
+
+    /// <summary> Makes a matrix expression that repeats a column vector as the columns of a matrix. </summary>
+    ///
+    /// <param name="vector"> The column vector. </param>
+    /// <param name="numColumns"> The number of columns. </param>
+    ///
+    /// <returns> The expression. </returns>
+    template <typename ElementType>
+    RepeatedVectorOperand<ElementType, VectorOrientation::column> RepeatColumn(ConstVectorReference<ElementType, VectorOrientation::column> vector, size_t numColumns);
+
+    /// \name Expression Operators
+    /// Each operator accepts any combination of matrix references and matrix expressions.
+    /// @{
+
+    template <typename ElementType, MatrixLayout layout>
+    ScaledMatrixExpression<ElementType, MatrixOperand<ElementType, layout>> operator*(double scalar, ConstMatrixReference<ElementType, layout> matrix);
+
+    template <typename ElementType, typename ExpressionType>
+    ScaledMatrixExpression<ElementType, ExpressionType> operator*(double scalar, const MatrixExpression<ElementType, ExpressionType>& expression);
+
+    template <typename ElementType, MatrixLayout layoutA, MatrixLayout layoutB>
+    SumMatrixExpression<ElementType, MatrixOperand<ElementType, layoutA>, MatrixOperand<ElementType, layoutB>> operator+(ConstMatrixReference<ElementType, layoutA> A, ConstMatrixReference<ElementType, layoutB> B);
+
+    template <typename ElementType, MatrixLayout layout, typename ExpressionType>
+    SumMatrixExpression<ElementType, MatrixOperand<ElementType, layout>, ExpressionType> operator+(ConstMatrixReference<ElementType, layout> A, const MatrixExpression<ElementType, ExpressionType>& B);
+
+    template <typename ElementType, typename ExpressionType, MatrixLayout layout>
+    SumMatrixExpression<ElementType, ExpressionType, MatrixOperand<ElementType, layout>> operator+(const MatrixExpression<ElementType, ExpressionType>& A, ConstMatrixReference<ElementType, layout> B);
+
+    template <typename ElementType, typename LeftExpressionType, typename RightExpressionType>
+    SumMatrixExpression<ElementType, LeftExpressionType, RightExpressionType> operator+(const MatrixExpression<ElementType, LeftExpressionType>& A, const MatrixExpression<ElementType, RightExpressionType>& B);
+
+    template <typename ElementType, MatrixLayout layoutA, MatrixLayout layoutB>
+    auto operator-(ConstMatrixReference<ElementType, layoutA> A, ConstMatrixReference<ElementType, layoutB> B);
+
+    template <typename ElementType, MatrixLayout layout, typename ExpressionType>
+    auto operator-(ConstMatrixReference<ElementType, layout> A, const MatrixExpression<ElementType, ExpressionType>& B);
+
+    template <typename ElementType, typename ExpressionType, MatrixLayout layout>
+    auto operator-(const MatrixExpression<ElementType, ExpressionType>& A, ConstMatrixReference<ElementType, layout> B);
+
+    template <typename ElementType, typename LeftExpressionType, typename RightExpressionType>
+    auto operator-(const MatrixExpression<ElementType, LeftExpressionType>& A, const MatrixExpression<ElementType, RightExpressionType>& B);
+
+    /// @}
+}
+}
+
+#include "../tcc/MatrixExpression.tcc"
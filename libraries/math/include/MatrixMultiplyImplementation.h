@@ -0,0 +1,389 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     MatrixMultiplyImplementation.h (math)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// stl
+#include <cstddef>
+#include <cstdint>
+
+// Like VectorKernelImplementation.h, this header is included by translation units that are compiled
+// with instruction set flags (such as -mavx2), so it must not pull in any inline code that is shared
+// with the rest of the program. That is why it has its own Min and packing buffer, rather than using
+// std::min and AlignedStorage.
+
+namespace ell
+{
+namespace math
+{
+    /// <summary> A table of pointers to the matrix multiplication kernel for one instruction set. </summary>
+    ///
+    /// <typeparam name="ElementType"> The element type. </typeparam>
+    template <typename ElementType>
+    struct MatrixMultiplyKernelTable
+    {
+        void (*multiplyBatched)(size_t batchCount, size_t m, size_t n, size_t k, ElementType s, const ElementType* pA, size_t aBatchIncrement, size_t aRowIncrement, size_t aColumnIncrement, const ElementType* pB, size_t bBatchIncrement, size_t bRowIncrement, size_t bColumnIncrement, ElementType t, ElementType* pC, size_t cBatchIncrement, size_t cRowIncrement, size_t cColumnIncrement);
+        void (*multiplyConverted)(size_t m, size_t n, size_t k, ElementType s, const uint16_t* pA, size_t aRowIncrement, size_t aColumnIncrement, void (*convertA)(const uint16_t* pSource, ElementType* pTarget, size_t size), const ElementType* pB, size_t bRowIncrement, size_t bColumnIncrement, ElementType t, ElementType* pC, size_t cRowIncrement, size_t cColumnIncrement);
+        size_t microTileRows;
+        size_t microTileColumns;
+    };
+
+    /// <summary>
+    /// Cache-blocked, register-tiled matrix matrix multiplication, C = s * A * B + t * C, written
+    /// against a short-vector traits class that defines VectorType, width, Zero, Broadcast, Load,
+    /// Store, Multiply and MultiplyAdd. Blocks of A and B are packed into contiguous panels, and a
+    /// micro-kernel accumulates a microTileRows x (numColumnVectors * width) block of C in registers,
+    /// so the tile size should use most of the instruction set's vector registers. Each translation
+    /// unit instantiates it with traits that are local to that unit, as with VectorKernelImplementation.
+    /// </summary>
+    ///
+    /// <typeparam name="ElementType"> The element type. </typeparam>
+    /// <typeparam name="Simd"> The short-vector traits. </typeparam>
+    /// <typeparam name="microTileRows"> The number of rows in a micro-tile. </typeparam>
+    /// <typeparam name="numColumnVectors"> The number of short vectors that span the columns of a micro-tile. </typeparam>
+    template <typename ElementType, typename Simd, size_t microTileRows, size_t numColumnVectors>
+    struct MatrixMultiplyImplementation
+    {
+        /// <summary> The number of columns in a micro-tile. </summary>
+        static constexpr size_t microTileColumns = numColumnVectors * Simd::width;
+
+        /// <summary> The number of rows of A packed at once (a multiple of microTileRows), sized so the packed block stays in L2. </summary>
+        static constexpr size_t blockRows = 20 * microTileRows;
+
+        /// <summary> The number of columns of A (and rows of B) packed at once, sized so that a packed panel of B stays in L1. </summary>
+        static constexpr size_t blockDepth = 16384 / (microTileColumns * sizeof(ElementType)) < 256 ? 16384 / (microTileColumns * sizeof(ElementType)) : 256;
+
+        /// <summary> The number of columns of B packed at once (a multiple of microTileColumns). </summary>
+        static constexpr size_t blockColumns = 2048;
+
+        static void MultiplyBatched(size_t batchCount, size_t m, size_t n, size_t k, ElementType s, const ElementType* pA, size_t aBatchIncrement, size_t aRowIncrement, size_t aColumnIncrement, const ElementType* pB, size_t bBatchIncrement, size_t bRowIncrement, size_t bColumnIncrement, ElementType t, ElementType* pC, size_t cBatchIncrement, size_t cRowIncrement, size_t cColumnIncrement)
+        {
+            if (batchCount == 0 || m == 0 || n == 0)
+            {
+                return;
+            }
+
+            if (k == 0)
+            {
+                ScaleC(batchCount, m, n, t, pC, cBatchIncrement, cRowIncrement, cColumnIncrement);
+                return;
+            }
+
+            if (cColumnIncrement != 1 && cRowIncrement == 1)
+            {
+                // the micro-kernel stores rows of C with vector instructions, so a column major C is computed as C' = s * B' * A' + t * C'
+                MultiplyBatched(batchCount, n, m, k, s, pB, bBatchIncrement, bColumnIncrement, bRowIncrement, pA, aBatchIncrement, aColumnIncrement, aRowIncrement, t, pC, cBatchIncrement, cColumnIncrement, cRowIncrement);
+                return;
+            }
+
+            auto packA = [](size_t numRows, size_t depth, const ElementType* pBlock, size_t rowIncrement, size_t columnIncrement, ElementType* pPacked) {
+                PackA(numRows, depth, pBlock, rowIncrement, columnIncrement, pPacked);
+            };
+            MultiplyBlocked(batchCount, m, n, k, s, pA, aBatchIncrement, aRowIncrement, aColumnIncrement, packA, pB, bBatchIncrement, bRowIncrement, bColumnIncrement, t, pC, cBatchIncrement, cRowIncrement, cColumnIncrement);
+        }
+
+        static void MultiplyConverted(size_t m, size_t n, size_t k, ElementType s, const uint16_t* pA, size_t aRowIncrement, size_t aColumnIncrement, void (*convertA)(const uint16_t* pSource, ElementType* pTarget, size_t size), const ElementType* pB, size_t bRowIncrement, size_t bColumnIncrement, ElementType t, ElementType* pC, size_t cRowIncrement, size_t cColumnIncrement)
+        {
+            if (m == 0 || n == 0)
+            {
+                return;
+            }
+
+            if (k == 0)
+            {
+                ScaleC(1, m, n, t, pC, 0, cRowIncrement, cColumnIncrement);
+                return;
+            }
+
+            // A is converted as it is packed, so it is read once and never copied in full
+            auto packA = [convertA](size_t numRows, size_t depth, const uint16_t* pBlock, size_t rowIncrement, size_t columnIncrement, ElementType* pPacked) {
+                PackConvertedA(numRows, depth, pBlock, rowIncrement, columnIncrement, convertA, pPacked);
+            };
+            MultiplyBlocked(1, m, n, k, s, pA, 0, aRowIncrement, aColumnIncrement, packA, pB, 0, bRowIncrement, bColumnIncrement, t, pC, 0, cRowIncrement, cColumnIncrement);
+        }
+
+        static MatrixMultiplyKernelTable<ElementType> GetTable()
+        {
+            return { &MultiplyBatched, &MultiplyConverted, microTileRows, microTileColumns };
+        }
+
+    private:
+        using VectorType = typename Simd::VectorType;
+
+        static size_t Min(size_t a, size_t b) { return b < a ? b : a; }
+
+        // Memory aligned for the vector type, released when the buffer goes out of scope
+        class PackingBuffer
+        {
+        public:
+            PackingBuffer(size_t size) :
+                _pMemory(new char[size * sizeof(ElementType) + c_alignment])
+            {
+                auto address = reinterpret_cast<uintptr_t>(_pMemory);
+                _pData = reinterpret_cast<ElementType*>((address + c_alignment - 1) / c_alignment * c_alignment);
+            }
+
+            PackingBuffer(const PackingBuffer&) = delete;
+            PackingBuffer& operator=(const PackingBuffer&) = delete;
+            ~PackingBuffer() { delete[] _pMemory; }
+
+            ElementType* data() { return _pData; }
+
+        private:
+            static constexpr size_t c_alignment = 64;
+            char* _pMemory;
+            ElementType* _pData;
+        };
+
+        // Scales C by t, which is all that remains of the product when the inner dimension is empty
+        static void ScaleC(size_t batchCount, size_t m, size_t n, ElementType t, ElementType* pC, size_t cBatchIncrement, size_t cRowIncrement, size_t cColumnIncrement)
+        {
+            for (size_t b = 0; b < batchCount; ++b)
+            {
+                for (size_t i = 0; i < m; ++i)
+                {
+                    for (size_t j = 0; j < n; ++j)
+                    {
+                        auto& c = pC[b * cBatchIncrement + i * cRowIncrement + j * cColumnIncrement];
+                        c = t == 0 ? 0 : t * c;
+                    }
+                }
+            }
+        }
+
+        // The blocked product, with a function that packs blocks of A, so that A may be stored in another type
+        template <typename AType, typename PackAFunction>
+        static void MultiplyBlocked(size_t batchCount, size_t m, size_t n, size_t k, ElementType s, const AType* pA, size_t aBatchIncrement, size_t aRowIncrement, size_t aColumnIncrement, PackAFunction packA, const ElementType* pB, size_t bBatchIncrement, size_t bRowIncrement, size_t bColumnIncrement, ElementType t, ElementType* pC, size_t cBatchIncrement, size_t cRowIncrement, size_t cColumnIncrement)
+        {
+            auto maxBlockRows = Min(m, blockRows);
+            auto maxBlockColumns = Min(n, blockColumns);
+            auto maxBlockDepth = Min(k, blockDepth);
+
+            PackingBuffer packedA((maxBlockRows + microTileRows - 1) / microTileRows * microTileRows * maxBlockDepth);
+            PackingBuffer packedB((maxBlockColumns + microTileColumns - 1) / microTileColumns * microTileColumns * maxBlockDepth);
+
+            // a B that is shared by the whole batch is packed once per block, instead of once per product
+            auto isSharedB = bBatchIncrement == 0;
+
+            for (size_t jBlock = 0; jBlock < n; jBlock += blockColumns)
+            {
+                auto numColumns = Min(blockColumns, n - jBlock);
+                for (size_t pBlock = 0; pBlock < k; pBlock += blockDepth)
+                {
+                    auto depth = Min(blockDepth, k - pBlock);
+
+                    // C is scaled by t once, when the first block of the inner dimension is accumulated
+                    auto blockT = pBlock == 0 ? t : static_cast<ElementType>(1);
+
+                    for (size_t b = 0; b < batchCount; ++b)
+                    {
+                        if (b == 0 || !isSharedB)
+                        {
+                            PackB(depth, numColumns, pB + b * bBatchIncrement + pBlock * bRowIncrement + jBlock * bColumnIncrement, bRowIncrement, bColumnIncrement, packedB.data());
+                        }
+
+                        for (size_t iBlock = 0; iBlock < m; iBlock += blockRows)
+                        {
+                            auto numRows = Min(blockRows, m - iBlock);
+                            packA(numRows, depth, pA + b * aBatchIncrement + iBlock * aRowIncrement + pBlock * aColumnIncrement, aRowIncrement, aColumnIncrement, packedA.data());
+                            MultiplyBlock(numRows, numColumns, depth, s, packedA.data(), packedB.data(), blockT, pC + b * cBatchIncrement + iBlock * cRowIncrement + jBlock * cColumnIncrement, cRowIncrement, cColumnIncrement);
+                        }
+                    }
+                }
+            }
+        }
+
+        // Packs a block of A into panels of microTileRows rows, zero-padding the last panel
+        static void PackA(size_t numRows, size_t depth, const ElementType* pA, size_t rowIncrement, size_t columnIncrement, ElementType* pPacked)
+        {
+            for (size_t iPanel = 0; iPanel < numRows; iPanel += microTileRows)
+            {
+                auto panelRows = Min(microTileRows, numRows - iPanel);
+                const ElementType* pPanel = pA + iPanel * rowIncrement;
+                for (size_t p = 0; p < depth; ++p)
+                {
+                    size_t i = 0;
+                    for (; i < panelRows; ++i)
+                    {
+                        *pPacked++ = pPanel[i * rowIncrement + p * columnIncrement];
+                    }
+                    for (; i < microTileRows; ++i)
+                    {
+                        *pPacked++ = 0;
+                    }
+                }
+            }
+        }
+
+        // Packs a block of A that is stored as 16 bit values, converting runs of contiguous elements with convertA
+        static void PackConvertedA(size_t numRows, size_t depth, const uint16_t* pA, size_t rowIncrement, size_t columnIncrement, void (*convertA)(const uint16_t* pSource, ElementType* pTarget, size_t size), ElementType* pPacked)
+        {
+            ElementType line[blockDepth];
+            for (size_t iPanel = 0; iPanel < numRows; iPanel += microTileRows)
+            {
+                auto panelRows = Min(microTileRows, numRows - iPanel);
+                const uint16_t* pPanel = pA + iPanel * rowIncrement;
+                if (rowIncrement == 1)
+                {
+                    // the columns of a column major A are contiguous, as are the columns of a packed panel
+                    for (size_t p = 0; p < depth; ++p)
+                    {
+                        convertA(pPanel + p * columnIncrement, pPacked, panelRows);
+                        for (size_t i = panelRows; i < microTileRows; ++i)
+                        {
+                            pPacked[i] = 0;
+                        }
+                        pPacked += microTileRows;
+                    }
+                    continue;
+                }
+
+                for (size_t i = 0; i < microTileRows; ++i)
+                {
+                    if (i < panelRows)
+                    {
+                        if (columnIncrement == 1)
+                        {
+                            convertA(pPanel + i * rowIncrement, line, depth);
+                        }
+                        else
+                        {
+                            for (size_t p = 0; p < depth; ++p)
+                            {
+                                convertA(pPanel + i * rowIncrement + p * columnIncrement, line + p, 1);
+                            }
+                        }
+                    }
+
+                    for (size_t p = 0; p < depth; ++p)
+                    {
+                        pPacked[p * microTileRows + i] = i < panelRows ? line[p] : 0;
+                    }
+                }
+                pPacked += depth * microTileRows;
+            }
+        }
+
+        // Packs a block of B into panels of microTileColumns columns, zero-padding the last panel
+        static void PackB(size_t depth, size_t numColumns, const ElementType* pB, size_t rowIncrement, size_t columnIncrement, ElementType* pPacked)
+        {
+            for (size_t jPanel = 0; jPanel < numColumns; jPanel += microTileColumns)
+            {
+                auto panelColumns = Min(microTileColumns, numColumns - jPanel);
+                const ElementType* pPanel = pB + jPanel * columnIncrement;
+                for (size_t p = 0; p < depth; ++p)
+                {
+                    size_t j = 0;
+                    for (; j < panelColumns; ++j)
+                    {
+                        *pPacked++ = pPanel[p * rowIncrement + j * columnIncrement];
+                    }
+                    for (; j < microTileColumns; ++j)
+                    {
+                        *pPacked++ = 0;
+                    }
+                }
+            }
+        }
+
+        // Multiplies a packed block of A by a packed block of B and updates the corresponding block of C. The
+        // panel of B is the outer loop, so it stays in L1 while it is multiplied by every panel of A.
+        static void MultiplyBlock(size_t numRows, size_t numColumns, size_t depth, ElementType s, const ElementType* pPackedA, const ElementType* pPackedB, ElementType t, ElementType* pC, size_t cRowIncrement, size_t cColumnIncrement)
+        {
+            for (size_t jPanel = 0; jPanel < numColumns; jPanel += microTileColumns)
+            {
+                auto panelColumns = Min(microTileColumns, numColumns - jPanel);
+                const ElementType* pPanelB = pPackedB + jPanel * depth;
+                for (size_t iPanel = 0; iPanel < numRows; iPanel += microTileRows)
+                {
+                    auto panelRows = Min(microTileRows, numRows - iPanel);
+                    const ElementType* pPanelA = pPackedA + iPanel * depth;
+                    MultiplyMicroTile(depth, pPanelA, pPanelB, panelRows, panelColumns, s, t, pC + iPanel * cRowIncrement + jPanel * cColumnIncrement, cRowIncrement, cColumnIncrement);
+                }
+            }
+        }
+
+        // Accumulates a micro-tile in registers and updates C with it, directly from the registers when the tile is full and its rows are contiguous
+        static void MultiplyMicroTile(size_t depth, const ElementType* pPackedA, const ElementType* pPackedB, size_t numRows, size_t numColumns, ElementType s, ElementType t, ElementType* pC, size_t cRowIncrement, size_t cColumnIncrement)
+        {
+            VectorType accumulators[microTileRows][numColumnVectors];
+            for (size_t i = 0; i < microTileRows; ++i)
+            {
+                for (size_t j = 0; j < numColumnVectors; ++j)
+                {
+                    accumulators[i][j] = Simd::Zero();
+                }
+            }
+
+            for (size_t p = 0; p < depth; ++p)
+            {
+                VectorType b[numColumnVectors];
+                for (size_t j = 0; j < numColumnVectors; ++j)
+                {
+                    b[j] = Simd::Load(pPackedB + j * Simd::width);
+                }
+
+                for (size_t i = 0; i < microTileRows; ++i)
+                {
+                    auto a = Simd::Broadcast(pPackedA[i]);
+                    for (size_t j = 0; j < numColumnVectors; ++j)
+                    {
+                        accumulators[i][j] = Simd::MultiplyAdd(a, b[j], accumulators[i][j]);
+                    }
+                }
+
+                pPackedA += microTileRows;
+                pPackedB += microTileColumns;
+            }
+
+            if (numRows == microTileRows && numColumns == microTileColumns && cColumnIncrement == 1)
+            {
+                auto sVector = Simd::Broadcast(s);
+                auto tVector = Simd::Broadcast(t);
+                for (size_t i = 0; i < microTileRows; ++i)
+                {
+                    auto pRow = pC + i * cRowIncrement;
+                    for (size_t j = 0; j < numColumnVectors; ++j)
+                    {
+                        auto product = Simd::Multiply(sVector, accumulators[i][j]);
+                        Simd::Store(pRow + j * Simd::width, t == 0 ? product : Simd::MultiplyAdd(tVector, Simd::Load(pRow + j * Simd::width), product));
+                    }
+                }
+                return;
+            }
+
+            ElementType tile[microTileRows * microTileColumns];
+            for (size_t i = 0; i < microTileRows; ++i)
+            {
+                for (size_t j = 0; j < numColumnVectors; ++j)
+                {
+                    Simd::Store(tile + i * microTileColumns + j * Simd::width, accumulators[i][j]);
+                }
+            }
+
+            for (size_t i = 0; i < numRows; ++i)
+            {
+                for (size_t j = 0; j < numColumns; ++j)
+                {
+                    auto& c = pC[i * cRowIncrement + j * cColumnIncrement];
+                    auto product = s * tile[i * microTileColumns + j];
+                    c = t == 0 ? product : product + t * c;
+                }
+            }
+        }
+    };
+
+    // Kernel tables compiled with AVX2 and FMA (defined in VectorKernelsAVX2.cpp)
+    MatrixMultiplyKernelTable<float> GetAVX2MatrixMultiplyKernels(float);
+    MatrixMultiplyKernelTable<double> GetAVX2MatrixMultiplyKernels(double);
+
+    // Kernel tables compiled with AVX-512 (defined in VectorKernelsAVX512.cpp)
+    MatrixMultiplyKernelTable<float> GetAVX512MatrixMultiplyKernels(float);
+    MatrixMultiplyKernelTable<double> GetAVX512MatrixMultiplyKernels(double);
+}
+}
@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     MatrixMultiplyKernel.h (math)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "HalfPrecision.h"
+
+// stl
+#include <cstddef>
+#include <string>
+
+namespace ell
+{
+namespace math
+{
+    /// <summary>
+    /// Cache-blocked, register-tiled implementation of generalized matrix matrix multiplication,
+    /// C = s * A * B + t * C. Blocks of A and B are packed into contiguous panels that fit in cache,
+    /// and a SIMD micro-kernel accumulates a block of C in registers (see MatrixMultiplyImplementation.h).
+    /// Matrices are described by a data pointer and a pair of strides, so every combination of row
+    /// major and column major layouts is handled by the same code path. The float and double kernels
+    /// are chosen at runtime, from micro-kernels compiled for SSE2, AVX2 with FMA, and AVX-512, by the
+    /// same processor detection as VectorKernels; other element types use a portable scalar kernel.
+    /// </summary>
+    ///
+    /// <typeparam name="ElementType"> Matrix element type. </typeparam>
+    template <typename ElementType>
+    class MatrixMultiplyKernel
+    {
+    public:
+        /// <summary> Computes C = s * A * B + t * C. If t is zero, C is not read. </summary>
+        ///
+        /// <param name="m"> The number of rows in A and C. </param>
+        /// <param name="n"> The number of columns in B and C. </param>
+        /// <param name="k"> The number of columns in A and rows in B. </param>
+        /// <param name="s"> The scalar that multiplies A * B. </param>
+        /// <param name="pA"> Pointer to the first element of A. </param>
+        /// <param name="aRowIncrement"> Distance between consecutive rows of A. </param>
+        /// <param name="aColumnIncrement"> Distance between consecutive columns of A. </param>
+        /// <param name="pB"> Pointer to the first element of B. </param>
+        /// <param name="bRowIncrement"> Distance between consecutive rows of B. </param>
+        /// <param name="bColumnIncrement"> Distance between consecutive columns of B. </param>
+        /// <param name="t"> The scalar that multiplies C. </param>
+        /// <param name="pC"> [in,out] Pointer to the first element of C. </param>
+        /// <param name="cRowIncrement"> Distance between consecutive rows of C. </param>
+        /// <param name="cColumnIncrement"> Distance between consecutive columns of C. </param>
+        static void Multiply(size_t m, size_t n, size_t k, ElementType s, const ElementType* pA, size_t aRowIncrement, size_t aColumnIncrement, const ElementType* pB, size_t bRowIncrement, size_t bColumnIncrement, ElementType t, ElementType* pC, size_t cRowIncrement, size_t cColumnIncrement);
+
+        /// <summary>
+        /// Computes C = s * A * B + t * C for a batch of equally sized products, whose operands are
+        /// found at fixed distances from each other. The packing buffers are allocated once for the
+        /// whole batch, and a B that is shared by the batch (bBatchIncrement is zero) is packed once
+        /// per block rather than once per product.
+        /// </summary>
+        ///
+        /// <param name="batchCount"> The number of products. </param>
+        /// <param name="m"> The number of rows in each A and C. </param>
+        /// <param name="n"> The number of columns in each B and C. </param>
+        /// <param name="k"> The number of columns in each A and rows in each B. </param>
+        /// <param name="s"> The scalar that multiplies each A * B. </param>
+        /// <param name="pA"> Pointer to the first element of the first A. </param>
+        /// <param name="aBatchIncrement"> Distance between consecutive matrices A. </param>
+        /// <param name="aRowIncrement"> Distance between consecutive rows of A. </param>
+        /// <param name="aColumnIncrement"> Distance between consecutive columns of A. </param>
+        /// <param name="pB"> Pointer to the first element of the first B. </param>
+        /// <param name="bBatchIncrement"> Distance between consecutive matrices B. </param>
+        /// <param name="bRowIncrement"> Distance between consecutive rows of B. </param>
+        /// <param name="bColumnIncrement"> Distance between consecutive columns of B. </param>
+        /// <param name="t"> The scalar that multiplies each C. </param>
+        /// <param name="pC"> [in,out] Pointer to the first element of the first C. </param>
+        /// <param name="cBatchIncrement"> Distance between consecutive matrices C. </param>
+        /// <param name="cRowIncrement"> Distance between consecutive rows of C. </param>
+        /// <param name="cColumnIncrement"> Distance between consecutive columns of C. </param>
+        static void MultiplyBatched(size_t batchCount, size_t m, size_t n, size_t k, ElementType s, const ElementType* pA, size_t aBatchIncrement, size_t aRowIncrement, size_t aColumnIncrement, const ElementType* pB, size_t bBatchIncrement, size_t bRowIncrement, size_t bColumnIncrement, ElementType t, ElementType* pC, size_t cBatchIncrement, size_t cRowIncrement, size_t cColumnIncrement);
+
+        /// <summary> Gets the name of the micro-kernel that products are dispatched to, such as "avx2 6x16". </summary>
+        ///
+        /// <returns> The name of the micro-kernel. </returns>
+        static std::string GetKernelName();
+    };
+
+    template <>
+    class MatrixMultiplyKernel<float>
+    {
+    public:
+        static void Multiply(size_t m, size_t n, size_t k, float s, const float* pA, size_t aRowIncrement, size_t aColumnIncrement, const float* pB, size_t bRowIncrement, size_t bColumnIncrement, float t, float* pC, size_t cRowIncrement, size_t cColumnIncrement);
+
+        static void MultiplyBatched(size_t batchCount, size_t m, size_t n, size_t k, float s, const float* pA, size_t aBatchIncrement, size_t aRowIncrement, size_t aColumnIncrement, const float* pB, size_t bBatchIncrement, size_t bRowIncrement, size_t bColumnIncrement, float t, float* pC, size_t cBatchIncrement, size_t cRowIncrement, size_t cColumnIncrement);
+
+        /// <summary> Computes C = s * A * B + t * C, where A is stored in a 16 bit format and is converted to float as it is packed. </summary>
+        static void Multiply(size_t m, size_t n, size_t k, float s, const Float16* pA, size_t aRowIncrement, size_t aColumnIncrement, const float* pB, size_t bRowIncrement, size_t bColumnIncrement, float t, float* pC, size_t cRowIncrement, size_t cColumnIncrement);
+        static void Multiply(size_t m, size_t n, size_t k, float s, const BFloat16* pA, size_t aRowIncrement, size_t aColumnIncrement, const float* pB, size_t bRowIncrement, size_t bColumnIncrement, float t, float* pC, size_t cRowIncrement, size_t cColumnIncrement);
+
+        static std::string GetKernelName();
+    };
+
+    template <>
+    class MatrixMultiplyKernel<double>
+    {
+    public:
+        static void Multiply(size_t m, size_t n, size_t k, double s, const double* pA, size_t aRowIncrement, size_t aColumnIncrement, const double* pB, size_t bRowIncrement, size_t bColumnIncrement, double t, double* pC, size_t cRowIncrement, size_t cColumnIncrement);
+
+        static void MultiplyBatched(size_t batchCount, size_t m, size_t n, size_t k, double s, const double* pA, size_t aBatchIncrement, size_t aRowIncrement, size_t aColumnIncrement, const double* pB, size_t bBatchIncrement, size_t bRowIncrement, size_t bColumnIncrement, double t, double* pC, size_t cBatchIncrement, size_t cRowIncrement, size_t cColumnIncrement);
+
+        static std::string GetKernelName();
+    };
+}
+}
+
+#include "../tcc/MatrixMultiplyKernel.tcc"
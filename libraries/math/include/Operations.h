@@ -7,13 +7,22 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include "HalfPrecision.h"
 #include "Matrix.h"
+#include "MatrixMultiplyKernel.h"
+#include "QuantizedMatrix.h"
+#include "SparseMatrix.h"
 #include "Vector.h"
+#include "VectorKernels.h"
 #ifdef USE_BLAS
 #include "BlasWrapper.h"
 #endif
 
+// utilities
+#include "ThreadPool.h"
+
 // stl
+#include <memory>
 #include <string>
 
 namespace ell
@@ -39,6 +48,147 @@ namespace math
         /// <param name="M"> [in,out] The row major matrix to which the scalar is added. </param>
         template <typename ElementType, MatrixLayout layout>
         static void Add(ElementType s, MatrixReference<ElementType, layout> M);
+
+        /// <summary>
+        /// Generalized sparse matrix column-vector multiplication, u = s * A * v + t * u. A row major
+        /// (CSR) matrix is multiplied one row at a time and uses the thread pool; a column major (CSC)
+        /// matrix scatters each column into u and runs on the calling thread.
+        /// </summary>
+        ///
+        /// <typeparam name="ElementType"> Matrix and vector element type. </typeparam>
+        /// <typeparam name="layout"> Sparse matrix layout. </typeparam>
+        /// <param name="s"> The scalar that multiplies the matrix. </param>
+        /// <param name="A"> The sparse matrix. </param>
+        /// <param name="v"> The column vector that multiplies the matrix on the right. </param>
+        /// <param name="t"> The scalar that multiplies u. </param>
+        /// <param name="u"> [in,out] A column vector, multiplied by t and used to store the result. </param>
+        template <typename ElementType, MatrixLayout layout>
+        static void Multiply(ElementType s, ConstSparseMatrixReference<ElementType, layout> A, ConstVectorReference<ElementType, VectorOrientation::column> v, ElementType t, VectorReference<ElementType, VectorOrientation::column> u);
+
+        /// <summary>
+        /// Generalized sparse matrix dense matrix multiplication, C = s * A * B + t * C. The product of
+        /// a dense matrix and a sparse matrix can be computed through the transposes, since
+        /// (B * A)' = A' * B', and the transpose of a sparse matrix is free.
+        /// </summary>
+        ///
+        /// <typeparam name="ElementType"> Matrix element type. </typeparam>
+        /// <typeparam name="layoutA"> Sparse matrix layout. </typeparam>
+        /// <typeparam name="layoutB"> Layout of the dense matrix B. </typeparam>
+        /// <typeparam name="layoutC"> Layout of the result matrix C. </typeparam>
+        /// <param name="s"> The scalar that multiplies the product. </param>
+        /// <param name="A"> The sparse matrix. </param>
+        /// <param name="B"> The dense matrix. </param>
+        /// <param name="t"> The scalar that multiplies C. </param>
+        /// <param name="C"> [in,out] A matrix, multiplied by t and used to store the result. </param>
+        template <typename ElementType, MatrixLayout layoutA, MatrixLayout layoutB, MatrixLayout layoutC>
+        static void Multiply(ElementType s, ConstSparseMatrixReference<ElementType, layoutA> A, ConstMatrixReference<ElementType, layoutB> B, ElementType t, MatrixReference<ElementType, layoutC> C);
+
+        /// <summary>
+        /// Strided batched matrix-matrix multiplication, C_b = s * A_b * B_b + t * C_b for b = 0, ...,
+        /// batchCount - 1. The references describe the first product of the batch, and the operands of
+        /// each subsequent product begin a fixed number of elements after those of the previous one. An
+        /// increment of zero for A or B reuses that operand for the whole batch. Many small products are
+        /// computed with one allocation of packing buffers, and are divided among the threads a batch at
+        /// a time, so the per-product overhead of Multiply is avoided.
+        /// </summary>
+        ///
+        /// <typeparam name="ElementType"> Matrix element type. </typeparam>
+        /// <typeparam name="layoutA"> Layout of the matrices A. </typeparam>
+        /// <typeparam name="layoutB"> Layout of the matrices B. </typeparam>
+        /// <typeparam name="layoutC"> Layout of the matrices C. </typeparam>
+        /// <param name="batchCount"> The number of products. </param>
+        /// <param name="s"> The scalar that multiplies each product. </param>
+        /// <param name="A"> The first matrix A. </param>
+        /// <param name="aBatchIncrement"> Distance between the first elements of consecutive matrices A. </param>
+        /// <param name="B"> The first matrix B. </param>
+        /// <param name="bBatchIncrement"> Distance between the first elements of consecutive matrices B. </param>
+        /// <param name="t"> The scalar that multiplies each C. </param>
+        /// <param name="C"> [in,out] The first matrix C. The matrices C must not overlap. </param>
+        /// <param name="cBatchIncrement"> Distance between the first elements of consecutive matrices C. </param>
+        template <typename ElementType, MatrixLayout layoutA, MatrixLayout layoutB, MatrixLayout layoutC>
+        static void MultiplyBatched(size_t batchCount, ElementType s, ConstMatrixReference<ElementType, layoutA> A, size_t aBatchIncrement, ConstMatrixReference<ElementType, layoutB> B, size_t bBatchIncrement, ElementType t, MatrixReference<ElementType, layoutC> C, size_t cBatchIncrement);
+
+        /// \name Reduced Precision Multiplication
+        /// Generalized matrix column-vector multiplication, u = s * A * v + t * u, and matrix-matrix
+        /// multiplication, C = s * A * B + t * C, where A is stored in a 16 bit floating point format
+        /// (typically weights) and everything else is float. The products accumulate in float. The
+        /// matrix-matrix product converts A to float one block of rows at a time and multiplies each
+        /// block with the float GEMM kernel, so A is read from memory only in its 16 bit format.
+        /// @{
+        template <MatrixLayout layout>
+        static void Multiply(float s, ConstMatrixReference<Float16, layout> A, ConstVectorReference<float, VectorOrientation::column> v, float t, VectorReference<float, VectorOrientation::column> u);
+
+        template <MatrixLayout layout>
+        static void Multiply(float s, ConstMatrixReference<BFloat16, layout> A, ConstVectorReference<float, VectorOrientation::column> v, float t, VectorReference<float, VectorOrientation::column> u);
+
+        template <MatrixLayout layoutA, MatrixLayout layoutB, MatrixLayout layoutC>
+        static void Multiply(float s, ConstMatrixReference<Float16, layoutA> A, ConstMatrixReference<float, layoutB> B, float t, MatrixReference<float, layoutC> C);
+
+        template <MatrixLayout layoutA, MatrixLayout layoutB, MatrixLayout layoutC>
+        static void Multiply(float s, ConstMatrixReference<BFloat16, layoutA> A, ConstMatrixReference<float, layoutB> B, float t, MatrixReference<float, layoutC> C);
+        /// @}
+
+        /// <summary>
+        /// Quantized matrix-matrix multiplication, C = s * A * B + t * C, where A holds 8 bit signed
+        /// weights with per-row parameters and B holds 8 bit unsigned activations with per-column
+        /// parameters. The products accumulate exactly in 32 bit integers (see QuantizedKernels) over
+        /// blocks of the depth, and in 64 bit integers across blocks, so the depth is not limited. The
+        /// zero points and scales are applied once per element of C.
+        /// </summary>
+        ///
+        /// <typeparam name="layout"> Layout of the result matrix C. </typeparam>
+        /// <param name="s"> The scalar that multiplies the product. </param>
+        /// <param name="A"> The quantized weights. </param>
+        /// <param name="B"> The quantized activations. </param>
+        /// <param name="t"> The scalar that multiplies C. </param>
+        /// <param name="C"> [in,out] A matrix, multiplied by t and used to store the result. </param>
+        template <MatrixLayout layout>
+        static void Multiply(float s, const QuantizedWeightMatrix& A, const QuantizedActivationMatrix& B, float t, MatrixReference<float, layout> C);
+
+        /// <summary>
+        /// Quantized matrix column-vector multiplication, u = s * A * v + t * u, where A holds 8 bit
+        /// signed weights with per-row parameters. The vector v is quantized to 8 bit unsigned values
+        /// on entry. As in the matrix-matrix product, the products accumulate exactly.
+        /// </summary>
+        ///
+        /// <param name="s"> The scalar that multiplies the product. </param>
+        /// <param name="A"> The quantized weights. </param>
+        /// <param name="v"> The column vector that multiplies the matrix on the right. </param>
+        /// <param name="t"> The scalar that multiplies u. </param>
+        /// <param name="u"> [in,out] A column vector, multiplied by t and used to store the result. </param>
+        static void Multiply(float s, const QuantizedWeightMatrix& A, ConstVectorReference<float, VectorOrientation::column> v, float t, VectorReference<float, VectorOrientation::column> u);
+
+        /// <summary>
+        /// Sets the number of threads used by matrix-matrix and matrix-vector multiplication. The
+        /// default is 1, which keeps every operation on the calling thread. This setting is global and
+        /// should not be changed while other threads are calling into Operations.
+        /// </summary>
+        ///
+        /// <param name="numThreads"> The number of threads, or 0 to use one thread per hardware core. </param>
+        static void SetNumThreads(size_t numThreads);
+
+        /// <summary> Gets the number of threads used by matrix-matrix and matrix-vector multiplication. </summary>
+        ///
+        /// <returns> The number of threads. </returns>
+        static size_t GetNumThreads();
+
+    protected:
+        // Partitions a numRows x numColumns output into tiles and calls tileFunction(firstRow, tileRows, firstColumn, tileColumns)
+        // for each one. The tiles run on the thread pool when multithreading is enabled and numOperations is large enough.
+        template <typename TileFunctionType>
+        static void ForEachOutputTile(size_t numRows, size_t numColumns, size_t numOperations, TileFunctionType tileFunction);
+
+        template <typename StorageType, MatrixLayout layout>
+        static void MultiplyReducedPrecision(float s, ConstMatrixReference<StorageType, layout> A, ConstVectorReference<float, VectorOrientation::column> v, float t, VectorReference<float, VectorOrientation::column> u);
+
+        template <typename StorageType, MatrixLayout layoutA, MatrixLayout layoutB, MatrixLayout layoutC>
+        static void MultiplyReducedPrecision(float s, ConstMatrixReference<StorageType, layoutA> A, ConstMatrixReference<float, layoutB> B, float t, MatrixReference<float, layoutC> C);
+
+        // Converts an exact integer product of a row of A and a column of B into the product of their real values
+        static float GetQuantizedProduct(int64_t product, const QuantizedWeightMatrix& A, size_t row, const QuantizedActivationMatrix& B, size_t column);
+
+    private:
+        static std::unique_ptr<utilities::ThreadPool> _threadPool;
     };
 
     /// <summary>
@@ -146,6 +296,7 @@ namespace math
     struct OperationsImplementation<ImplementationType::native> : public DerivedOperations<OperationsImplementation<ImplementationType::native>>
     {
         using CommonOperations::Add;
+        using CommonOperations::Multiply;
         using DerivedOperations<OperationsImplementation<ImplementationType::native>>::Add;
         using DerivedOperations<OperationsImplementation<ImplementationType::native>>::Multiply;
         using DerivedOperations<OperationsImplementation<ImplementationType::native>>::MultiplyAdd;
@@ -237,6 +388,7 @@ namespace math
     struct OperationsImplementation<ImplementationType::openBlas> : public DerivedOperations<OperationsImplementation<ImplementationType::openBlas>>
     {
         using CommonOperations::Add;
+        using CommonOperations::Multiply;
         using DerivedOperations<OperationsImplementation<ImplementationType::openBlas>>::Add;
         using DerivedOperations<OperationsImplementation<ImplementationType::openBlas>>::Multiply;
         using DerivedOperations<OperationsImplementation<ImplementationType::openBlas>>::MultiplyAdd;
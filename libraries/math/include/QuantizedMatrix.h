@@ -0,0 +1,160 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     QuantizedMatrix.h (math)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "AlignedAllocator.h"
+#include "Matrix.h"
+
+// stl
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ell
+{
+namespace math
+{
+    /// <summary>
+    /// The affine map between 8 bit integers and real numbers, real = scale * (quantized - zeroPoint).
+    /// The zero point is itself a quantized value, so real zero is represented exactly.
+    /// </summary>
+    struct QuantizationParameters
+    {
+        float scale;
+        int32_t zeroPoint;
+    };
+
+    /// <summary>
+    /// A matrix of 8 bit integers in which each row (for a row major matrix) or each column (for a
+    /// column major matrix) has its own quantization parameters, such as a weight matrix with one
+    /// row per output channel, or a matrix of activations with one column per example. Each row (or
+    /// column) is stored contiguously, and the sum of its quantized values is precomputed, for the
+    /// zero point corrections in Operations::Multiply.
+    /// </summary>
+    ///
+    /// <typeparam name="QuantizedType"> The quantized type, int8_t or uint8_t. </typeparam>
+    /// <typeparam name="layout"> Matrix layout. </typeparam>
+    template <typename QuantizedType, MatrixLayout layout>
+    class QuantizedMatrix
+    {
+    public:
+        /// <summary>
+        /// Quantizes a float matrix. The parameters of each row (or column) map the range between
+        /// its smallest and largest elements, extended to include zero, onto the full range of
+        /// QuantizedType.
+        /// </summary>
+        ///
+        /// <param name="matrix"> The float matrix. </param>
+        template <MatrixLayout sourceLayout>
+        explicit QuantizedMatrix(ConstMatrixReference<float, sourceLayout> matrix);
+
+        /// <summary> Constructs a quantized matrix from quantized values and their parameters. </summary>
+        ///
+        /// <param name="numRows"> Number of rows in the matrix. </param>
+        /// <param name="numColumns"> Number of columns in the matrix. </param>
+        /// <param name="data"> The quantized values, one row (or column) after another. </param>
+        /// <param name="parameters"> The quantization parameters of each row (or column). </param>
+        QuantizedMatrix(size_t numRows, size_t numColumns, const std::vector<QuantizedType>& data, std::vector<QuantizationParameters> parameters);
+
+        /// <summary> Gets the number of rows. </summary>
+        ///
+        /// <returns> The number of rows. </returns>
+        size_t NumRows() const { return _numRows; }
+
+        /// <summary> Gets the number of columns. </summary>
+        ///
+        /// <returns> The number of columns. </returns>
+        size_t NumColumns() const { return _numColumns; }
+
+        /// <summary> Gets the number of rows of a row major matrix or columns of a column major matrix. </summary>
+        ///
+        /// <returns> The number of intervals. </returns>
+        size_t NumIntervals() const { return layout == MatrixLayout::rowMajor ? _numRows : _numColumns; }
+
+        /// <summary> Gets the size of each row of a row major matrix or column of a column major matrix. </summary>
+        ///
+        /// <returns> The interval size. </returns>
+        size_t GetIntervalSize() const { return layout == MatrixLayout::rowMajor ? _numColumns : _numRows; }
+
+        /// <summary> Gets the matrix layout. </summary>
+        ///
+        /// <returns> The matrix layout. </returns>
+        MatrixLayout GetLayout() const { return layout; }
+
+        /// <summary> Gets a pointer to the quantized values of a row (or column). </summary>
+        ///
+        /// <param name="index"> The row (or column) index. </param>
+        ///
+        /// <returns> Const pointer to the first value. </returns>
+        const QuantizedType* GetMajorVectorPointer(size_t index) const { return _data.data() + index * GetIntervalSize(); }
+
+        /// <summary> Gets the quantization parameters of a row (or column). </summary>
+        ///
+        /// <param name="index"> The row (or column) index. </param>
+        ///
+        /// <returns> The quantization parameters. </returns>
+        QuantizationParameters GetParameters(size_t index) const { return _parameters[index]; }
+
+        /// <summary> Gets the sum of the quantized values of a row (or column). </summary>
+        ///
+        /// <param name="index"> The row (or column) index. </param>
+        ///
+        /// <returns> The sum. </returns>
+        int64_t GetSum(size_t index) const { return _sums[index]; }
+
+        /// <summary> Gets the real value of an element. </summary>
+        ///
+        /// <returns> The dequantized element. </returns>
+        float operator()(size_t rowIndex, size_t columnIndex) const;
+
+        /// <summary> Copies this matrix into a float matrix. </summary>
+        ///
+        /// <returns> The dequantized matrix. </returns>
+        Matrix<float, layout> Dequantize() const;
+
+    private:
+        void ComputeSums();
+
+        size_t _numRows;
+        size_t _numColumns;
+        AlignedStorage<QuantizedType> _data;
+        std::vector<QuantizationParameters> _parameters;
+        std::vector<int64_t> _sums;
+    };
+
+    /// <summary>
+    /// Computes the parameters that map a range of real numbers onto the range of a quantized type. The
+    /// range is first extended to include zero.
+    /// </summary>
+    ///
+    /// <typeparam name="QuantizedType"> The quantized type, int8_t or uint8_t. </typeparam>
+    /// <param name="minValue"> The smallest real value. </param>
+    /// <param name="maxValue"> The largest real value. </param>
+    ///
+    /// <returns> The quantization parameters. </returns>
+    template <typename QuantizedType>
+    QuantizationParameters GetQuantizationParameters(float minValue, float maxValue);
+
+    /// <summary> Quantizes a real value, rounding to nearest and saturating. </summary>
+    ///
+    /// <typeparam name="QuantizedType"> The quantized type, int8_t or uint8_t. </typeparam>
+    /// <param name="value"> The real value. </param>
+    /// <param name="parameters"> The quantization parameters. </param>
+    ///
+    /// <returns> The quantized value. </returns>
+    template <typename QuantizedType>
+    QuantizedType Quantize(float value, QuantizationParameters parameters);
+
+    // friendly names
+    using QuantizedWeightMatrix = QuantizedMatrix<int8_t, MatrixLayout::rowMajor>;
+    using QuantizedActivationMatrix = QuantizedMatrix<uint8_t, MatrixLayout::columnMajor>;
+}
+}
+
+#include "../tcc/QuantizedMatrix.tcc"
@@ -0,0 +1,204 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     SimdTraits.h (math)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// stl
+#include <cmath>
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ELL_MATH_SSE2
+#endif
+
+namespace ell
+{
+namespace math
+{
+    /// <summary>
+    /// Short-vector traits that treat a single element as a vector of width 1, so that kernels
+    /// written against the traits interface compile (and run correctly) on every target.
+    /// </summary>
+    ///
+    /// <typeparam name="ElementType"> The element type. </typeparam>
+    template <typename ElementType>
+    struct ScalarSimdTraits
+    {
+        /// <summary> The short-vector type. </summary>
+        using VectorType = ElementType;
+
+        /// <summary> The number of elements in a VectorType. </summary>
+        static constexpr size_t width = 1;
+
+        /// <summary> Returns a vector of zeros. </summary>
+        static VectorType Zero() { return 0; }
+
+        /// <summary> Returns a vector whose elements all equal a given value. </summary>
+        static VectorType Broadcast(ElementType value) { return value; }
+
+        /// <summary> Loads a vector from (possibly unaligned) memory. </summary>
+        static VectorType Load(const ElementType* pData) { return *pData; }
+
+        /// <summary> Stores a vector to (possibly unaligned) memory. </summary>
+        static void Store(ElementType* pData, VectorType value) { *pData = value; }
+
+        /// <summary> Returns a + b, elementwise. </summary>
+        static VectorType Add(VectorType a, VectorType b) { return a + b; }
+
+        /// <summary> Returns a - b, elementwise. </summary>
+        static VectorType Subtract(VectorType a, VectorType b) { return a - b; }
+
+        /// <summary> Returns a * b, elementwise. </summary>
+        static VectorType Multiply(VectorType a, VectorType b) { return a * b; }
+
+        /// <summary> Returns a / b, elementwise. </summary>
+        static VectorType Divide(VectorType a, VectorType b) { return a / b; }
+
+        /// <summary> Returns a * b + c, elementwise. </summary>
+        static VectorType MultiplyAdd(VectorType a, VectorType b, VectorType c) { return a * b + c; }
+
+        /// <summary> Returns the elementwise minimum of a and b. </summary>
+        static VectorType Min(VectorType a, VectorType b) { return b < a ? b : a; }
+
+        /// <summary> Returns the elementwise maximum of a and b. </summary>
+        static VectorType Max(VectorType a, VectorType b) { return a < b ? b : a; }
+
+        /// <summary> Returns x where x is NaN, and y elsewhere, elementwise. </summary>
+        static VectorType SelectNaN(VectorType x, VectorType y) { return x != x ? x : y; }
+
+        /// <summary> Returns the sum of the elements of a. </summary>
+        static ElementType ReduceSum(VectorType a) { return a; }
+
+        /// <summary> Returns 2^n, elementwise, for integer-valued n in the normal exponent range. </summary>
+        static VectorType Pow2(VectorType n) { return std::ldexp(static_cast<ElementType>(1), static_cast<int>(n)); }
+
+        /// <summary> Splits positive normal x into m * 2^exponent, elementwise, with sqrt(1/2) <= m < sqrt(2). </summary>
+        static VectorType SplitExponent(VectorType x, VectorType& exponent)
+        {
+            int e;
+            auto m = std::frexp(x, &e); // 1/2 <= m < 1
+            if (m < static_cast<ElementType>(0.70710678118654752440))
+            {
+                m *= 2;
+                --e;
+            }
+            exponent = static_cast<ElementType>(e);
+            return m;
+        }
+    };
+
+    /// <summary>
+    /// Thin wrapper around the baseline short-vector instructions (SSE2 on x86-64), which the
+    /// float and double specializations use. Other element types fall back to ScalarSimdTraits.
+    /// Wider instruction sets are not selected here at compile time; their kernels live in
+    /// translation units of their own and are chosen at runtime (see VectorKernels.h), so those
+    /// units must not include this header.
+    /// </summary>
+    ///
+    /// <typeparam name="ElementType"> The element type. </typeparam>
+    template <typename ElementType>
+    struct SimdTraits : ScalarSimdTraits<ElementType>
+    {
+    };
+
+#if defined(ELL_MATH_SSE2)
+    template <>
+    struct SimdTraits<float>
+    {
+        using VectorType = __m128;
+        static constexpr size_t width = 4;
+
+        static VectorType Zero() { return _mm_setzero_ps(); }
+        static VectorType Broadcast(float value) { return _mm_set1_ps(value); }
+        static VectorType Load(const float* pData) { return _mm_loadu_ps(pData); }
+        static void Store(float* pData, VectorType value) { _mm_storeu_ps(pData, value); }
+        static VectorType Add(VectorType a, VectorType b) { return _mm_add_ps(a, b); }
+        static VectorType Subtract(VectorType a, VectorType b) { return _mm_sub_ps(a, b); }
+        static VectorType Multiply(VectorType a, VectorType b) { return _mm_mul_ps(a, b); }
+        static VectorType Divide(VectorType a, VectorType b) { return _mm_div_ps(a, b); }
+        static VectorType MultiplyAdd(VectorType a, VectorType b, VectorType c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+        static VectorType Min(VectorType a, VectorType b) { return _mm_min_ps(a, b); }
+        static VectorType Max(VectorType a, VectorType b) { return _mm_max_ps(a, b); }
+
+        static VectorType SelectNaN(VectorType x, VectorType y)
+        {
+            auto isNaN = _mm_cmpunord_ps(x, x);
+            return _mm_or_ps(_mm_and_ps(isNaN, x), _mm_andnot_ps(isNaN, y));
+        }
+
+        static VectorType Pow2(VectorType n)
+        {
+            auto biasedExponent = _mm_add_epi32(_mm_cvtps_epi32(n), _mm_set1_epi32(127));
+            return _mm_castsi128_ps(_mm_slli_epi32(biasedExponent, 23));
+        }
+
+        static VectorType SplitExponent(VectorType x, VectorType& exponent)
+        {
+            // subtracting the bits of sqrt(1/2) moves the exponent boundary from 1 to sqrt(1/2)
+            auto bits = _mm_castps_si128(x);
+            auto e = _mm_srai_epi32(_mm_sub_epi32(bits, _mm_set1_epi32(0x3f3504f3)), 23);
+            exponent = _mm_cvtepi32_ps(e);
+            return _mm_castsi128_ps(_mm_sub_epi32(bits, _mm_slli_epi32(e, 23)));
+        }
+
+        static float ReduceSum(VectorType a)
+        {
+            a = _mm_add_ps(a, _mm_movehl_ps(a, a));
+            a = _mm_add_ss(a, _mm_shuffle_ps(a, a, 1));
+            return _mm_cvtss_f32(a);
+        }
+    };
+
+    template <>
+    struct SimdTraits<double>
+    {
+        using VectorType = __m128d;
+        static constexpr size_t width = 2;
+
+        static VectorType Zero() { return _mm_setzero_pd(); }
+        static VectorType Broadcast(double value) { return _mm_set1_pd(value); }
+        static VectorType Load(const double* pData) { return _mm_loadu_pd(pData); }
+        static void Store(double* pData, VectorType value) { _mm_storeu_pd(pData, value); }
+        static VectorType Add(VectorType a, VectorType b) { return _mm_add_pd(a, b); }
+        static VectorType Subtract(VectorType a, VectorType b) { return _mm_sub_pd(a, b); }
+        static VectorType Multiply(VectorType a, VectorType b) { return _mm_mul_pd(a, b); }
+        static VectorType Divide(VectorType a, VectorType b) { return _mm_div_pd(a, b); }
+        static VectorType MultiplyAdd(VectorType a, VectorType b, VectorType c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+        static VectorType Min(VectorType a, VectorType b) { return _mm_min_pd(a, b); }
+        static VectorType Max(VectorType a, VectorType b) { return _mm_max_pd(a, b); }
+
+        static VectorType SelectNaN(VectorType x, VectorType y)
+        {
+            auto isNaN = _mm_cmpunord_pd(x, x);
+            return _mm_or_pd(_mm_and_pd(isNaN, x), _mm_andnot_pd(isNaN, y));
+        }
+        static double ReduceSum(VectorType a) { return _mm_cvtsd_f64(_mm_add_sd(a, _mm_unpackhi_pd(a, a))); }
+
+        static VectorType Pow2(VectorType n)
+        {
+            // the biased exponents are positive, so widening them to 64 bits is an unpack with zeros
+            auto biasedExponent = _mm_add_epi32(_mm_cvtpd_epi32(n), _mm_set1_epi32(1023));
+            return _mm_castsi128_pd(_mm_slli_epi64(_mm_unpacklo_epi32(biasedExponent, _mm_setzero_si128()), 52));
+        }
+
+        static VectorType SplitExponent(VectorType x, VectorType& exponent)
+        {
+            // SSE2 has no arithmetic 64 bit shift, so the exponent is kept biased (and positive) by
+            // adding the bits of 1 - sqrt(1/2), and converted to double by way of the bits of 2^52
+            auto bits = _mm_castpd_si128(x);
+            auto biasedExponent = _mm_srli_epi64(_mm_add_epi64(bits, _mm_set1_epi64x(0x00095f619980c433)), 52);
+            auto shiftedExponent = _mm_slli_epi64(biasedExponent, 52);
+            auto twoTo52 = _mm_set1_pd(4503599627370496.0);
+            exponent = _mm_sub_pd(_mm_sub_pd(_mm_castsi128_pd(_mm_or_si128(biasedExponent, _mm_castpd_si128(twoTo52))), twoTo52), _mm_set1_pd(1023));
+            return _mm_castsi128_pd(_mm_add_epi64(_mm_sub_epi64(bits, shiftedExponent), _mm_set1_epi64x(0x3ff0000000000000)));
+        }
+    };
+#endif
+}
+}
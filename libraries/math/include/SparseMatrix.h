@@ -0,0 +1,199 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     SparseMatrix.h (math)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Matrix.h"
+
+// stl
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+namespace ell
+{
+namespace math
+{
+    /// <summary>
+    /// Const reference to a compressed sparse matrix. A row major sparse matrix is stored in CSR format
+    /// (compressed sparse rows) and a column major sparse matrix in CSC format (compressed sparse
+    /// columns). In both cases, the nonzeros of interval i (a row in CSR, a column in CSC) are
+    /// indices[offsets[i]] ... indices[offsets[i+1]-1], in increasing order, with the corresponding
+    /// values. A CSR matrix and the CSC matrix of its transpose have identical arrays, so Transpose()
+    /// is free.
+    /// </summary>
+    ///
+    /// <typeparam name="ElementType"> Matrix element type. </typeparam>
+    /// <typeparam name="layout"> Matrix layout. </typeparam>
+    template <typename ElementType, MatrixLayout layout>
+    class ConstSparseMatrixReference
+    {
+    public:
+        /// <summary> Constructs a sparse matrix reference from existing arrays. </summary>
+        ///
+        /// <param name="numRows"> Number of rows. </param>
+        /// <param name="numColumns"> Number of columns. </param>
+        /// <param name="pOffsets"> Pointer to the NumIntervals() + 1 interval offsets. </param>
+        /// <param name="pIndices"> Pointer to the index of each nonzero within its interval. </param>
+        /// <param name="pValues"> Pointer to the value of each nonzero. </param>
+        ConstSparseMatrixReference(size_t numRows, size_t numColumns, const size_t* pOffsets, const size_t* pIndices, const ElementType* pValues);
+
+        /// <summary> Gets the number of rows. </summary>
+        ///
+        /// <returns> The number of rows. </returns>
+        size_t NumRows() const { return _numRows; }
+
+        /// <summary> Gets the number of columns. </summary>
+        ///
+        /// <returns> The number of columns. </returns>
+        size_t NumColumns() const { return _numColumns; }
+
+        /// <summary> Gets the number of rows of a row major matrix or columns of a column major matrix. </summary>
+        ///
+        /// <returns> The number of intervals. </returns>
+        size_t NumIntervals() const { return layout == MatrixLayout::rowMajor ? _numRows : _numColumns; }
+
+        /// <summary> Gets the number of explicitly stored elements. </summary>
+        ///
+        /// <returns> The number of nonzeros. </returns>
+        size_t NumNonzeros() const { return _pOffsets[NumIntervals()] - _pOffsets[0]; }
+
+        /// <summary> Gets the matrix layout. </summary>
+        ///
+        /// <returns> The matrix layout. </returns>
+        MatrixLayout GetLayout() const { return layout; }
+
+        /// <summary> Gets a pointer to the interval offsets. </summary>
+        ///
+        /// <returns> Const pointer to the offsets. </returns>
+        const size_t* GetOffsetsPointer() const { return _pOffsets; }
+
+        /// <summary> Gets a pointer to the nonzero indices. The offsets index into this array. </summary>
+        ///
+        /// <returns> Const pointer to the indices. </returns>
+        const size_t* GetIndicesPointer() const { return _pIndices; }
+
+        /// <summary> Gets a pointer to the nonzero values. The offsets index into this array. </summary>
+        ///
+        /// <returns> Const pointer to the values. </returns>
+        const ElementType* GetValuesPointer() const { return _pValues; }
+
+        /// <summary> Matrix element access operator, which performs a binary search in the row (or column). </summary>
+        ///
+        /// <returns> A copy of the element in a given position. </returns>
+        ElementType operator()(size_t rowIndex, size_t columnIndex) const;
+
+        /// <summary> Gets a reference to the matrix transpose, which shares the same arrays. </summary>
+        ///
+        /// <returns> A reference to the matrix transpose. </returns>
+        ConstSparseMatrixReference<ElementType, TransposeMatrixLayout<layout>::value> Transpose() const;
+
+        /// <summary> Gets a reference to a range of rows of a row major matrix, or columns of a column major matrix. </summary>
+        ///
+        /// <param name="firstInterval"> The first row (or column) in the range. </param>
+        /// <param name="numIntervals"> The number of rows (or columns) in the range. </param>
+        ///
+        /// <returns> The reference. </returns>
+        ConstSparseMatrixReference<ElementType, layout> GetMajorSubMatrix(size_t firstInterval, size_t numIntervals) const;
+
+        /// <summary> Copies this matrix into a dense matrix. </summary>
+        ///
+        /// <returns> The dense matrix. </returns>
+        Matrix<ElementType, layout> ToDense() const;
+
+    protected:
+        size_t _numRows;
+        size_t _numColumns;
+        const size_t* _pOffsets;
+        const size_t* _pIndices;
+        const ElementType* _pValues;
+    };
+
+    /// <summary> A compressed sparse matrix that owns its arrays (see ConstSparseMatrixReference). </summary>
+    ///
+    /// <typeparam name="ElementType"> Matrix element type. </typeparam>
+    /// <typeparam name="layout"> Matrix layout. </typeparam>
+    template <typename ElementType, MatrixLayout layout>
+    class SparseMatrix : public ConstSparseMatrixReference<ElementType, layout>
+    {
+    public:
+        /// <summary> Constructs an all-zeros sparse matrix. </summary>
+        ///
+        /// <param name="numRows"> Number of rows in the matrix. </param>
+        /// <param name="numColumns"> Number of columns in the matrix. </param>
+        SparseMatrix(size_t numRows, size_t numColumns);
+
+        /// <summary> Constructs a sparse matrix from compressed arrays, which are validated. </summary>
+        ///
+        /// <param name="numRows"> Number of rows in the matrix. </param>
+        /// <param name="numColumns"> Number of columns in the matrix. </param>
+        /// <param name="offsets"> The NumIntervals() + 1 interval offsets, starting at 0. </param>
+        /// <param name="indices"> The index of each nonzero within its interval, increasing within each interval. </param>
+        /// <param name="values"> The value of each nonzero. </param>
+        SparseMatrix(size_t numRows, size_t numColumns, std::vector<size_t> offsets, std::vector<size_t> indices, std::vector<ElementType> values);
+
+        /// <summary> Constructs a sparse matrix from the nonzero elements of a dense matrix. </summary>
+        ///
+        /// <param name="matrix"> The dense matrix. </param>
+        SparseMatrix(ConstMatrixReference<ElementType, layout> matrix);
+
+        /// <summary> Copy Constructor. </summary>
+        ///
+        /// <param name="other"> The matrix being copied. </param>
+        SparseMatrix(const SparseMatrix<ElementType, layout>& other);
+
+        /// <summary> Move Constructor. </summary>
+        ///
+        /// <param name="other"> [in,out] The matrix being moved. </param>
+        SparseMatrix(SparseMatrix<ElementType, layout>&& other);
+
+        /// <summary> Assignment operator. </summary>
+        ///
+        /// <param name="other"> The other matrix. </param>
+        ///
+        /// <returns> A reference to this matrix. </returns>
+        SparseMatrix<ElementType, layout>& operator=(SparseMatrix<ElementType, layout> other);
+
+        /// <summary> Swaps the contents of this matrix with the contents of another matrix. </summary>
+        ///
+        /// <param name="other"> [in,out] The other matrix. </param>
+        void Swap(SparseMatrix<ElementType, layout>& other);
+
+    private:
+        using ConstSparseMatrixReference<ElementType, layout>::_numRows;
+        using ConstSparseMatrixReference<ElementType, layout>::_numColumns;
+        using ConstSparseMatrixReference<ElementType, layout>::_pOffsets;
+        using ConstSparseMatrixReference<ElementType, layout>::_pIndices;
+        using ConstSparseMatrixReference<ElementType, layout>::_pValues;
+
+        void UpdatePointers();
+
+        std::vector<size_t> _offsets;
+        std::vector<size_t> _indices;
+        std::vector<ElementType> _values;
+    };
+
+    /// <summary> Prints a sparse matrix in dense initializer list format. </summary>
+    ///
+    /// <param name="stream"> [in,out] The output stream. </param>
+    /// <param name="M"> The sparse matrix. </param>
+    ///
+    /// <returns> Reference to the output stream. </returns>
+    template <typename ElementType, MatrixLayout layout>
+    std::ostream& operator<<(std::ostream& stream, ConstSparseMatrixReference<ElementType, layout> M);
+
+    // friendly names
+    template <typename ElementType>
+    using CSRMatrix = SparseMatrix<ElementType, MatrixLayout::rowMajor>;
+
+    template <typename ElementType>
+    using CSCMatrix = SparseMatrix<ElementType, MatrixLayout::columnMajor>;
+}
+}
+
+#include "../tcc/SparseMatrix.tcc"
@@ -7,6 +7,7 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include "AlignedAllocator.h"
 #include "Matrix.h"
 #include "Vector.h"
 
@@ -288,6 +289,16 @@ namespace math
         /// <returns> Const pointer to the data. </returns>
         const ElementType* GetDataPointer() const { return _contents.pData; }
 
+        /// <summary> Gets the distance in memory between consecutive elements along dimension1. </summary>
+        ///
+        /// <returns> The increment of dimension1. </returns>
+        size_t GetIncrement1() const { return _contents.increments[0]; }
+
+        /// <summary> Gets the distance in memory between consecutive elements along dimension2. </summary>
+        ///
+        /// <returns> The increment of dimension2. </returns>
+        size_t GetIncrement2() const { return _contents.increments[1]; }
+
     protected:
         // other protected member functions
         ConstTensorReference(TensorContents<ElementType> contents);
@@ -372,6 +383,7 @@ namespace math
         using ConstTensorRef::GetShape;
         using ConstTensorRef::NumSlices;
         using ConstTensorRef::NumPrimarySlices;
+        using ConstTensorRef::GetDataPointer;
         using ConstTensorRef::IsEqual;
         using ConstTensorRef::operator==;
         using ConstTensorRef::operator!=;
@@ -558,6 +570,11 @@ namespace math
 
         /// @}
 
+        /// <summary> Gets a pointer to the underlying data storage. </summary>
+        ///
+        /// <returns> Pointer to the data. </returns>
+        ElementType* GetDataPointer() { return _contents.pData; }
+
     protected:
         // abbreviations
         using TensorLayoutT = TensorLayout<dimension0, dimension1, dimension2>;
@@ -674,7 +691,7 @@ namespace math
         /// <summary> Returns a copy of the contents of the Tensor. </summary>
         ///
         /// <returns> A std::vector with a copy of the contents of the Tensor. </returns>
-        std::vector<ElementType> ToArray() const { return _data; }
+        std::vector<ElementType> ToArray() const { return { _data.begin(), _data.end() }; }
 
     private:
         Tensor(size_t numRows, size_t numColumns, size_t numChannels, ElementType* pData) : TensorReference<ElementType, dimension0, dimension1, dimension2>(numRows, numColumns, numChannels, pData) {};
@@ -684,7 +701,7 @@ namespace math
         
         // the array used to store the tensor
         using ConstTensorRef::_contents;
-        std::vector<ElementType> _data;
+        AlignedStorage<ElementType> _data;
     };
 
     /// <summary> A class that implements helper functions for archiving/unarchiving Tensor instances. </summary>
@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     Transcendental.h (math)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// stl
+#include <cstddef>
+
+namespace ell
+{
+namespace math
+{
+    /// <summary> An enum that selects between the standard library and the vectorized approximations of exp, log, tanh and sigmoid. </summary>
+    enum class TranscendentalPrecision
+    {
+        exact,
+        fast
+    };
+
+    /// <summary> Gets the precision used by Exp, Log, Tanh and Sigmoid. The default is exact. </summary>
+    ///
+    /// <returns> The precision. </returns>
+    TranscendentalPrecision GetTranscendentalPrecision();
+
+    /// <summary>
+    /// Sets the precision used by Exp, Log, Tanh and Sigmoid (and by everything that calls them,
+    /// such as the neural network activation and softmax layers). This setting is global and should
+    /// not be changed while other threads are calling these functions.
+    /// </summary>
+    ///
+    /// <param name="precision"> The precision. </param>
+    void SetTranscendentalPrecision(TranscendentalPrecision precision);
+
+    /// <summary>
+    /// Computes exp element-wise over a contiguous array, u = exp(v). With the fast precision, float
+    /// and double arrays use the vectorized approximation in VectorKernels. The input and output
+    /// arrays may be the same.
+    /// </summary>
+    ///
+    /// <param name="pV"> Pointer to the input array. </param>
+    /// <param name="pU"> Pointer to the output array. </param>
+    /// <param name="size"> The number of elements. </param>
+    template <typename ElementType>
+    void Exp(const ElementType* pV, ElementType* pU, size_t size);
+
+    /// <summary> Computes log element-wise over a contiguous array, u = log(v). See Exp. </summary>
+    ///
+    /// <param name="pV"> Pointer to the input array. </param>
+    /// <param name="pU"> Pointer to the output array. </param>
+    /// <param name="size"> The number of elements. </param>
+    template <typename ElementType>
+    void Log(const ElementType* pV, ElementType* pU, size_t size);
+
+    /// <summary> Computes tanh element-wise over a contiguous array, u = tanh(v). See Exp. </summary>
+    ///
+    /// <param name="pV"> Pointer to the input array. </param>
+    /// <param name="pU"> Pointer to the output array. </param>
+    /// <param name="size"> The number of elements. </param>
+    template <typename ElementType>
+    void Tanh(const ElementType* pV, ElementType* pU, size_t size);
+
+    /// <summary> Computes the logistic sigmoid element-wise over a contiguous array, u = 1 / (1 + exp(-v)). See Exp. </summary>
+    ///
+    /// <param name="pV"> Pointer to the input array. </param>
+    /// <param name="pU"> Pointer to the output array. </param>
+    /// <param name="size"> The number of elements. </param>
+    template <typename ElementType>
+    void Sigmoid(const ElementType* pV, ElementType* pU, size_t size);
+}
+}
+
+#include "../tcc/Transcendental.tcc"
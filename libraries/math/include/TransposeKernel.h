@@ -0,0 +1,38 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     TransposeKernel.h (math)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// stl
+#include <cstddef>
+
+namespace ell
+{
+namespace math
+{
+    /// <summary>
+    /// Copies a row major block of memory into the transposed position, target(j, i) = source(i, j).
+    /// The block is split recursively in half along its longer side until it is small enough for a
+    /// tile of the source and of the target to share the L1 cache, which makes the copy cache
+    /// oblivious: both reads and writes run along cache lines, whatever the cache sizes are. Matrix
+    /// and tensor layout conversions use this kernel instead of element by element strided copies.
+    /// </summary>
+    ///
+    /// <typeparam name="ElementType"> Element type. </typeparam>
+    /// <param name="numRows"> The number of rows in the source, and columns in the target. </param>
+    /// <param name="numColumns"> The number of columns in the source, and rows in the target. </param>
+    /// <param name="pSource"> Pointer to the first element of the source. </param>
+    /// <param name="sourceIncrement"> Distance between consecutive rows of the source. </param>
+    /// <param name="pTarget"> [out] Pointer to the first element of the target. </param>
+    /// <param name="targetIncrement"> Distance between consecutive rows of the target. </param>
+    template <typename ElementType>
+    void TransposeCopy(size_t numRows, size_t numColumns, const ElementType* pSource, size_t sourceIncrement, ElementType* pTarget, size_t targetIncrement);
+}
+}
+
+#include "../tcc/TransposeKernel.tcc"
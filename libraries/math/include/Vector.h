@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include "AlignedAllocator.h"
+
 // utilities
 #include "IArchivable.h"
 // stl
@@ -563,7 +565,7 @@ namespace math
         using ConstVectorReference<ElementType, orientation>::_size;
 
         // member variables
-        std::vector<ElementType> _data;
+        AlignedStorage<ElementType> _data;
     };
 
     /// <summary> A class that implements helper functions for archiving/unarchiving Vector instances. </summary>
@@ -0,0 +1,585 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     VectorKernelImplementation.h (math)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// stl
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+// This header is only included by the translation units that implement VectorKernels. Some of them
+// are compiled with instruction set flags (such as -mavx2), so it must not pull in any inline code
+// that is shared with the rest of the program.
+
+namespace ell
+{
+namespace math
+{
+    /// <summary> A table of pointers to the vector kernels for one instruction set. </summary>
+    ///
+    /// <typeparam name="ElementType"> The element type. </typeparam>
+    template <typename ElementType>
+    struct VectorKernelTable
+    {
+        void (*addScalar)(ElementType s, ElementType* pV, size_t size);
+        void (*addVector)(ElementType s, const ElementType* pV, ElementType* pU, size_t size);
+        void (*multiplyAdd)(ElementType s, ElementType b, ElementType* pV, size_t size);
+        void (*elementWiseMultiply)(const ElementType* pU, const ElementType* pV, ElementType* pT, size_t size);
+        ElementType (*sum)(const ElementType* pV, size_t size);
+        ElementType (*dot)(const ElementType* pU, const ElementType* pV, size_t size);
+        void (*exp)(const ElementType* pV, ElementType* pU, size_t size);
+        void (*log)(const ElementType* pV, ElementType* pU, size_t size);
+        void (*tanh)(const ElementType* pV, ElementType* pU, size_t size);
+        void (*sigmoid)(const ElementType* pV, ElementType* pU, size_t size);
+    };
+
+    /// <summary>
+    /// Constants of the exp and log approximations. Exp reduces its argument to r = x - n * ln(2),
+    /// with |r| <= ln(2) / 2, and evaluates the Taylor polynomial of exp(r) of degree expDegree. Log
+    /// splits its argument into m * 2^e, with sqrt(1/2) <= m < sqrt(2), and evaluates the first
+    /// logTerms terms of log(m) = 2 * atanh(t), with t = (m - 1) / (m + 1). The degrees are chosen so
+    /// that the truncation error is below the rounding error of the element type.
+    ///
+    /// Exp clamps its argument to [minExpArgument, maxExpArgument], which keeps 2^n a normal number.
+    /// Below the clamp, the result stays at exp(minExpArgument) (about 1.6e-38 for float and 3.3e-308
+    /// for double) instead of going to zero, so only the absolute error, not the relative one, stays
+    /// small there. The same holds for everything computed from Exp: the float Sigmoid of x < -87
+    /// returns about 1.6e-38 (and about 6e-39 below -88), rather than a denormal or zero.
+    /// </summary>
+    ///
+    /// <typeparam name="ElementType"> The element type, float or double. </typeparam>
+    template <typename ElementType>
+    struct TranscendentalConstants;
+
+    template <>
+    struct TranscendentalConstants<float>
+    {
+        static constexpr int expDegree = 7;
+        static constexpr int logTerms = 5;
+        static constexpr float minExpArgument = -87.0f;
+        static constexpr float maxExpArgument = 88.0f;
+        static constexpr float roundingConstant = 12582912.0f; // 1.5 * 2^23
+        static constexpr float ln2High = 0.693359375f;
+        static constexpr float ln2Low = -2.12194440e-4f;
+    };
+
+    template <>
+    struct TranscendentalConstants<double>
+    {
+        static constexpr int expDegree = 13;
+        static constexpr int logTerms = 11;
+        static constexpr double minExpArgument = -708.0;
+        static constexpr double maxExpArgument = 709.0;
+        static constexpr double roundingConstant = 6755399441055744.0; // 1.5 * 2^52
+        static constexpr double ln2High = 6.93145751953125e-1;
+        static constexpr double ln2Low = 1.42860682030941723212e-6;
+    };
+
+    /// <summary>
+    /// Vector kernels written against a short-vector traits class, which defines VectorType, width,
+    /// Zero, Broadcast, Load, Store, Add, Subtract, Multiply, Divide, MultiplyAdd, Min, Max, SelectNaN
+    /// and ReduceSum, as well as two bit-level operations used by the transcendental functions: Pow2,
+    /// which returns 2^n for integer-valued n in the normal exponent range, and SplitExponent, which
+    /// splits a positive normal x into m * 2^e, with sqrt(1/2) <= m < sqrt(2). Each translation unit
+    /// instantiates it with traits that are local to that unit (in an anonymous namespace), so the
+    /// instantiations compiled for different instruction sets never collide at link time.
+    /// </summary>
+    ///
+    /// <typeparam name="ElementType"> The element type. </typeparam>
+    /// <typeparam name="Simd"> The short-vector traits. </typeparam>
+    template <typename ElementType, typename Simd>
+    struct VectorKernelImplementation
+    {
+        static void AddScalar(ElementType s, ElementType* pV, size_t size)
+        {
+            auto sVector = Simd::Broadcast(s);
+            size_t i = 0;
+            for (; i + Simd::width <= size; i += Simd::width)
+            {
+                Simd::Store(pV + i, Simd::Add(Simd::Load(pV + i), sVector));
+            }
+            for (; i < size; ++i)
+            {
+                pV[i] += s;
+            }
+        }
+
+        static void AddVector(ElementType s, const ElementType* pV, ElementType* pU, size_t size)
+        {
+            auto sVector = Simd::Broadcast(s);
+            size_t i = 0;
+            for (; i + Simd::width <= size; i += Simd::width)
+            {
+                Simd::Store(pU + i, Simd::MultiplyAdd(sVector, Simd::Load(pV + i), Simd::Load(pU + i)));
+            }
+            for (; i < size; ++i)
+            {
+                pU[i] += s * pV[i];
+            }
+        }
+
+        static void MultiplyAdd(ElementType s, ElementType b, ElementType* pV, size_t size)
+        {
+            auto sVector = Simd::Broadcast(s);
+            auto bVector = Simd::Broadcast(b);
+            size_t i = 0;
+            for (; i + Simd::width <= size; i += Simd::width)
+            {
+                Simd::Store(pV + i, Simd::MultiplyAdd(sVector, Simd::Load(pV + i), bVector));
+            }
+            for (; i < size; ++i)
+            {
+                pV[i] = s * pV[i] + b;
+            }
+        }
+
+        static void ElementWiseMultiply(const ElementType* pU, const ElementType* pV, ElementType* pT, size_t size)
+        {
+            size_t i = 0;
+            for (; i + Simd::width <= size; i += Simd::width)
+            {
+                Simd::Store(pT + i, Simd::Multiply(Simd::Load(pU + i), Simd::Load(pV + i)));
+            }
+            for (; i < size; ++i)
+            {
+                pT[i] = pU[i] * pV[i];
+            }
+        }
+
+        static ElementType Sum(const ElementType* pV, size_t size)
+        {
+            // four independent accumulators hide the latency of the vector additions
+            auto sum0 = Simd::Zero();
+            auto sum1 = Simd::Zero();
+            auto sum2 = Simd::Zero();
+            auto sum3 = Simd::Zero();
+            size_t i = 0;
+            for (; i + 4 * Simd::width <= size; i += 4 * Simd::width)
+            {
+                sum0 = Simd::Add(sum0, Simd::Load(pV + i));
+                sum1 = Simd::Add(sum1, Simd::Load(pV + i + Simd::width));
+                sum2 = Simd::Add(sum2, Simd::Load(pV + i + 2 * Simd::width));
+                sum3 = Simd::Add(sum3, Simd::Load(pV + i + 3 * Simd::width));
+            }
+            for (; i + Simd::width <= size; i += Simd::width)
+            {
+                sum0 = Simd::Add(sum0, Simd::Load(pV + i));
+            }
+
+            auto result = Simd::ReduceSum(Simd::Add(Simd::Add(sum0, sum1), Simd::Add(sum2, sum3)));
+            for (; i < size; ++i)
+            {
+                result += pV[i];
+            }
+            return result;
+        }
+
+        static ElementType Dot(const ElementType* pU, const ElementType* pV, size_t size)
+        {
+            auto sum0 = Simd::Zero();
+            auto sum1 = Simd::Zero();
+            auto sum2 = Simd::Zero();
+            auto sum3 = Simd::Zero();
+            size_t i = 0;
+            for (; i + 4 * Simd::width <= size; i += 4 * Simd::width)
+            {
+                sum0 = Simd::MultiplyAdd(Simd::Load(pU + i), Simd::Load(pV + i), sum0);
+                sum1 = Simd::MultiplyAdd(Simd::Load(pU + i + Simd::width), Simd::Load(pV + i + Simd::width), sum1);
+                sum2 = Simd::MultiplyAdd(Simd::Load(pU + i + 2 * Simd::width), Simd::Load(pV + i + 2 * Simd::width), sum2);
+                sum3 = Simd::MultiplyAdd(Simd::Load(pU + i + 3 * Simd::width), Simd::Load(pV + i + 3 * Simd::width), sum3);
+            }
+            for (; i + Simd::width <= size; i += Simd::width)
+            {
+                sum0 = Simd::MultiplyAdd(Simd::Load(pU + i), Simd::Load(pV + i), sum0);
+            }
+
+            auto result = Simd::ReduceSum(Simd::Add(Simd::Add(sum0, sum1), Simd::Add(sum2, sum3)));
+            for (; i < size; ++i)
+            {
+                result += pU[i] * pV[i];
+            }
+            return result;
+        }
+
+        static void Exp(const ElementType* pV, ElementType* pU, size_t size)
+        {
+            Transform(pV, pU, size, &ExpVector);
+        }
+
+        static void Log(const ElementType* pV, ElementType* pU, size_t size)
+        {
+            Transform(pV, pU, size, &LogVector);
+        }
+
+        static void Tanh(const ElementType* pV, ElementType* pU, size_t size)
+        {
+            Transform(pV, pU, size, &TanhVector);
+        }
+
+        static void Sigmoid(const ElementType* pV, ElementType* pU, size_t size)
+        {
+            Transform(pV, pU, size, &SigmoidVector);
+        }
+
+        static VectorKernelTable<ElementType> GetTable()
+        {
+            return { &AddScalar, &AddVector, &MultiplyAdd, &ElementWiseMultiply, &Sum, &Dot, &Exp, &Log, &Tanh, &Sigmoid };
+        }
+
+    private:
+        using VectorType = typename Simd::VectorType;
+        using Constants = TranscendentalConstants<ElementType>;
+
+        // Applies a vector function to an array; the last few elements go through a padded buffer, so
+        // that every element gets exactly the same approximation
+        static void Transform(const ElementType* pV, ElementType* pU, size_t size, VectorType (*function)(VectorType))
+        {
+            size_t i = 0;
+            for (; i + Simd::width <= size; i += Simd::width)
+            {
+                Simd::Store(pU + i, function(Simd::Load(pV + i)));
+            }
+            if (i < size)
+            {
+                ElementType buffer[Simd::width] = {};
+                for (size_t j = i; j < size; ++j)
+                {
+                    buffer[j - i] = pV[j];
+                }
+                Simd::Store(buffer, function(Simd::Load(buffer)));
+                for (size_t j = i; j < size; ++j)
+                {
+                    pU[j] = buffer[j - i];
+                }
+            }
+        }
+
+        static VectorType ExpVector(VectorType x)
+        {
+            // arguments outside the range saturate, to the largest result or to exp(minExpArgument) (see TranscendentalConstants)
+            auto input = x;
+            x = Simd::Max(Simd::Min(x, Simd::Broadcast(Constants::maxExpArgument)), Simd::Broadcast(Constants::minExpArgument));
+
+            // n = round(x / ln(2)), by adding and subtracting a constant that leaves no fractional bits
+            auto rounding = Simd::Broadcast(Constants::roundingConstant);
+            auto n = Simd::Subtract(Simd::MultiplyAdd(x, Simd::Broadcast(static_cast<ElementType>(1.44269504088896340736)), rounding), rounding);
+
+            // r = x - n * ln(2), where ln(2) is split in two so that the first product is exact
+            auto r = Simd::MultiplyAdd(n, Simd::Broadcast(-Constants::ln2High), x);
+            r = Simd::MultiplyAdd(n, Simd::Broadcast(-Constants::ln2Low), r);
+
+            // Horner's rule on the Taylor coefficients 1/k!, where k! is exact in ElementType for every degree used
+            ElementType factorial = 1;
+            for (int k = 2; k <= Constants::expDegree; ++k)
+            {
+                factorial *= static_cast<ElementType>(k);
+            }
+            auto p = Simd::Broadcast(1 / factorial);
+            for (int k = Constants::expDegree; k > 0; --k)
+            {
+                factorial /= static_cast<ElementType>(k);
+                p = Simd::MultiplyAdd(p, r, Simd::Broadcast(1 / factorial));
+            }
+
+            // the clamp turns NaN into a number, so NaN arguments are passed through at the end
+            return Simd::SelectNaN(input, Simd::Multiply(p, Simd::Pow2(n)));
+        }
+
+        static VectorType LogVector(VectorType x)
+        {
+            // zero, negative and denormal arguments are treated as the smallest positive normal number
+            auto input = x;
+            x = Simd::Max(x, Simd::Broadcast(std::numeric_limits<ElementType>::min()));
+            VectorType e;
+            auto m = Simd::SplitExponent(x, e);
+
+            auto one = Simd::Broadcast(1);
+            auto t = Simd::Divide(Simd::Subtract(m, one), Simd::Add(m, one));
+            auto t2 = Simd::Multiply(t, t);
+
+            // log(m) = 2 * (t + t^3 / 3 + t^5 / 5 + ...)
+            auto p = Simd::Broadcast(1 / static_cast<ElementType>(2 * Constants::logTerms - 1));
+            for (int k = Constants::logTerms - 2; k >= 0; --k)
+            {
+                p = Simd::MultiplyAdd(p, t2, Simd::Broadcast(1 / static_cast<ElementType>(2 * k + 1)));
+            }
+            auto logM = Simd::Multiply(Simd::Add(t, t), p);
+
+            // log(x) = e * ln(2) + log(m), adding the small terms first
+            auto result = Simd::MultiplyAdd(e, Simd::Broadcast(Constants::ln2High), Simd::MultiplyAdd(e, Simd::Broadcast(Constants::ln2Low), logM));
+            return Simd::SelectNaN(input, result);
+        }
+
+        static VectorType TanhVector(VectorType x)
+        {
+            // tanh(x) = 1 - 2 / (exp(2x) + 1), which saturates correctly at both ends
+            auto one = Simd::Broadcast(1);
+            auto expTwoX = ExpVector(Simd::Add(x, x));
+            return Simd::Subtract(one, Simd::Divide(Simd::Broadcast(2), Simd::Add(expTwoX, one)));
+        }
+
+        static VectorType SigmoidVector(VectorType x)
+        {
+            auto one = Simd::Broadcast(1);
+            return Simd::Divide(one, Simd::Add(one, ExpVector(Simd::Subtract(Simd::Zero(), x))));
+        }
+    };
+
+    /// <summary> A table of pointers to the quantized (8 bit integer) kernels for one instruction set. </summary>
+    struct QuantizedKernelTable
+    {
+        int32_t (*dot)(const uint8_t* pU, const int8_t* pV, size_t size);
+        void (*dot4)(const uint8_t* pU, const int8_t* pV, size_t vIncrement, size_t size, int32_t* pResults);
+        void (*multiply)(size_t m, size_t n, size_t k, const int8_t* pA, size_t aRowIncrement, const uint8_t* pB, size_t bColumnIncrement, int64_t* pC, size_t cRowIncrement);
+    };
+
+    /// <summary>
+    /// Quantized kernels written against an integer traits class, which defines width (the number of
+    /// bytes processed per step), AccumulatorType, Zero, LoadUnsigned (which may also widen the bytes),
+    /// MultiplyAdd (which loads the signed bytes and adds their products with the unsigned ones to the
+    /// 32 bit accumulator, without saturation) and ReduceSum. As with VectorKernelImplementation, the
+    /// traits are local to each translation unit.
+    ///
+    /// The matrix multiplication packs the signed matrix into panels whose 32 bit lanes each hold
+    /// groupSize consecutive elements of one row, so that each accumulator holds the sums of lanes
+    /// rows for one column and is never reduced horizontally. For this, the traits also define lanes,
+    /// groupSize, PackedType, LoadPacked, BroadcastGroup (which broadcasts groupSize consecutive
+    /// unsigned bytes to every lane), MultiplyAddPacked and Store.
+    /// </summary>
+    ///
+    /// <typeparam name="Traits"> The integer traits. </typeparam>
+    /// <typeparam name="rowVectors"> The number of accumulators per column of a micro tile. </typeparam>
+    /// <typeparam name="tileColumns"> The number of columns of a micro tile. </typeparam>
+    template <typename Traits, size_t rowVectors, size_t tileColumns>
+    struct QuantizedKernelImplementation
+    {
+        static int32_t Dot(const uint8_t* pU, const int8_t* pV, size_t size)
+        {
+            auto sum = Traits::Zero();
+            size_t i = 0;
+            for (; i + Traits::width <= size; i += Traits::width)
+            {
+                sum = Traits::MultiplyAdd(sum, Traits::LoadUnsigned(pU + i), pV + i);
+            }
+
+            auto result = Traits::ReduceSum(sum);
+            for (; i < size; ++i)
+            {
+                result += static_cast<int32_t>(pU[i]) * pV[i];
+            }
+            return result;
+        }
+
+        static void Dot4(const uint8_t* pU, const int8_t* pV, size_t vIncrement, size_t size, int32_t* pResults)
+        {
+            // the unsigned array is loaded (and widened) once for all four signed arrays
+            auto sum0 = Traits::Zero();
+            auto sum1 = Traits::Zero();
+            auto sum2 = Traits::Zero();
+            auto sum3 = Traits::Zero();
+            size_t i = 0;
+            for (; i + Traits::width <= size; i += Traits::width)
+            {
+                auto u = Traits::LoadUnsigned(pU + i);
+                sum0 = Traits::MultiplyAdd(sum0, u, pV + i);
+                sum1 = Traits::MultiplyAdd(sum1, u, pV + vIncrement + i);
+                sum2 = Traits::MultiplyAdd(sum2, u, pV + 2 * vIncrement + i);
+                sum3 = Traits::MultiplyAdd(sum3, u, pV + 3 * vIncrement + i);
+            }
+
+            pResults[0] = Traits::ReduceSum(sum0);
+            pResults[1] = Traits::ReduceSum(sum1);
+            pResults[2] = Traits::ReduceSum(sum2);
+            pResults[3] = Traits::ReduceSum(sum3);
+            for (; i < size; ++i)
+            {
+                auto u = static_cast<int32_t>(pU[i]);
+                for (size_t r = 0; r < 4; ++r)
+                {
+                    pResults[r] += u * pV[r * vIncrement + i];
+                }
+            }
+        }
+
+        static void Multiply(size_t m, size_t n, size_t k, const int8_t* pA, size_t aRowIncrement, const uint8_t* pB, size_t bColumnIncrement, int64_t* pC, size_t cRowIncrement)
+        {
+            // as in MatrixMultiplyImplementation, a packed block of B stays in L2 while a packed panel of A in L1 is multiplied by it
+            alignas(64) PackedType packedA[panelRows * blockDepth];
+            PackingBuffer packedB((blockColumns + tileColumns - 1) / tileColumns * tileColumns * blockDepth);
+            int32_t tile[tileColumns][panelRows];
+            for (size_t jBlock = 0; jBlock < n; jBlock += blockColumns)
+            {
+                auto numColumns = n - jBlock < blockColumns ? n - jBlock : blockColumns;
+                for (size_t pBlock = 0; pBlock < k; pBlock += blockDepth)
+                {
+                    auto depth = k - pBlock < blockDepth ? k - pBlock : blockDepth;
+                    auto numGroups = (depth + Traits::groupSize - 1) / Traits::groupSize;
+                    PackB(pB + jBlock * bColumnIncrement + pBlock, bColumnIncrement, numColumns, depth, packedB.data());
+                    for (size_t i = 0; i < m; i += panelRows)
+                    {
+                        auto numRows = m - i < panelRows ? m - i : panelRows;
+                        PackA(pA + i * aRowIncrement + pBlock, aRowIncrement, numRows, depth, packedA);
+                        for (size_t j = 0; j < numColumns; j += tileColumns)
+                        {
+                            MultiplyTile(packedA, packedB.data() + j * numGroups * Traits::groupSize, numGroups, tile);
+
+                            auto tileColumnsUsed = numColumns - j < tileColumns ? numColumns - j : tileColumns;
+                            for (size_t r = 0; r < numRows; ++r)
+                            {
+                                auto pCRow = pC + (i + r) * cRowIncrement + jBlock + j;
+                                for (size_t c = 0; c < tileColumnsUsed; ++c)
+                                {
+                                    pCRow[c] += tile[c][r];
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        static QuantizedKernelTable GetTable()
+        {
+            return { &Dot, &Dot4, &Multiply };
+        }
+
+    private:
+        using PackedType = typename Traits::PackedType;
+        using AccumulatorType = typename Traits::AccumulatorType;
+        static constexpr size_t panelRows = rowVectors * Traits::lanes;
+
+        // a multiple of every groupSize, and far below the depth at which the 32 bit sums could overflow
+        static constexpr size_t blockDepth = 512;
+        static constexpr size_t blockColumns = 512;
+
+        // Uninitialized memory that cannot go through the standard library, since it would then share inline code with other translation units
+        class PackingBuffer
+        {
+        public:
+            PackingBuffer(size_t size) :
+                _pData(new uint8_t[size])
+            {
+            }
+
+            PackingBuffer(const PackingBuffer&) = delete;
+            PackingBuffer& operator=(const PackingBuffer&) = delete;
+            ~PackingBuffer() { delete[] _pData; }
+
+            uint8_t* data() { return _pData; }
+
+        private:
+            uint8_t* _pData;
+        };
+
+        // Stores element index of row r at pPanel[((index / groupSize) * panelRows + r) * groupSize + index % groupSize],
+        // padded with zeros up to panelRows rows and a whole number of groups
+        static void PackA(const int8_t* pA, size_t aRowIncrement, size_t numRows, size_t depth, PackedType* pPanel)
+        {
+            auto numGroups = (depth + Traits::groupSize - 1) / Traits::groupSize;
+            for (size_t r = 0; r < panelRows; ++r)
+            {
+                auto pRow = pA + (r < numRows ? r : 0) * aRowIncrement;
+                auto rowSize = r < numRows ? depth : 0;
+                for (size_t group = 0; group < numGroups; ++group)
+                {
+                    auto pTarget = pPanel + (group * panelRows + r) * Traits::groupSize;
+                    for (size_t element = 0; element < Traits::groupSize; ++element)
+                    {
+                        auto index = group * Traits::groupSize + element;
+                        pTarget[element] = index < rowSize ? pRow[index] : 0;
+                    }
+                }
+            }
+        }
+
+        // Stores the columns in tiles of tileColumns, each with element index of column c at
+        // pTile[((index / groupSize) * tileColumns + c) * groupSize + index % groupSize], padded with zeros
+        static void PackB(const uint8_t* pB, size_t bColumnIncrement, size_t numColumns, size_t depth, uint8_t* pPacked)
+        {
+            auto numGroups = (depth + Traits::groupSize - 1) / Traits::groupSize;
+            for (size_t j = 0; j < numColumns; j += tileColumns)
+            {
+                auto pTile = pPacked + j * numGroups * Traits::groupSize;
+                for (size_t c = 0; c < tileColumns; ++c)
+                {
+                    auto pColumn = pB + (j + c < numColumns ? j + c : 0) * bColumnIncrement;
+                    auto columnSize = j + c < numColumns ? depth : 0;
+                    for (size_t group = 0; group < numGroups; ++group)
+                    {
+                        auto pTarget = pTile + (group * tileColumns + c) * Traits::groupSize;
+                        for (size_t element = 0; element < Traits::groupSize; ++element)
+                        {
+                            auto index = group * Traits::groupSize + element;
+                            pTarget[element] = index < columnSize ? pColumn[index] : 0;
+                        }
+                    }
+                }
+            }
+        }
+
+        static void MultiplyTile(const PackedType* pPanel, const uint8_t* pTile, size_t numGroups, int32_t (*pResults)[panelRows])
+        {
+            AccumulatorType sums[tileColumns][rowVectors];
+            for (size_t c = 0; c < tileColumns; ++c)
+            {
+                for (size_t v = 0; v < rowVectors; ++v)
+                {
+                    sums[c][v] = Traits::Zero();
+                }
+            }
+
+            for (size_t group = 0; group < numGroups; ++group)
+            {
+                AccumulatorType a[rowVectors];
+                for (size_t v = 0; v < rowVectors; ++v)
+                {
+                    a[v] = Traits::LoadPacked(pPanel + (group * panelRows + v * Traits::lanes) * Traits::groupSize);
+                }
+                for (size_t c = 0; c < tileColumns; ++c)
+                {
+                    auto b = Traits::BroadcastGroup(pTile + (group * tileColumns + c) * Traits::groupSize);
+                    for (size_t v = 0; v < rowVectors; ++v)
+                    {
+                        sums[c][v] = Traits::MultiplyAddPacked(sums[c][v], b, a[v]);
+                    }
+                }
+            }
+
+            for (size_t c = 0; c < tileColumns; ++c)
+            {
+                for (size_t v = 0; v < rowVectors; ++v)
+                {
+                    Traits::Store(pResults[c] + v * Traits::lanes, sums[c][v]);
+                }
+            }
+        }
+    };
+
+    /// <summary> A table of pointers to the Float16 conversion kernels for one instruction set. A Float16 is passed as its bit pattern. </summary>
+    struct HalfPrecisionKernelTable
+    {
+        void (*float16ToFloat)(const uint16_t* pSource, float* pTarget, size_t size);
+        void (*floatToFloat16)(const float* pSource, uint16_t* pTarget, size_t size);
+    };
+
+    // Kernel tables compiled with AVX2, FMA and F16C (defined in VectorKernelsAVX2.cpp)
+    VectorKernelTable<float> GetAVX2VectorKernels(float);
+    VectorKernelTable<double> GetAVX2VectorKernels(double);
+    QuantizedKernelTable GetAVX2QuantizedKernels();
+    HalfPrecisionKernelTable GetAVX2HalfPrecisionKernels();
+
+    // Kernel tables compiled with AVX-512 (defined in VectorKernelsAVX512.cpp)
+    VectorKernelTable<float> GetAVX512VectorKernels(float);
+    VectorKernelTable<double> GetAVX512VectorKernels(double);
+    HalfPrecisionKernelTable GetAVX512HalfPrecisionKernels();
+
+    // Quantized kernels compiled with AVX-512 VNNI (defined in QuantizedKernelsVNNI.cpp)
+    QuantizedKernelTable GetVNNIQuantizedKernels();
+}
+}
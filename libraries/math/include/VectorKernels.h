@@ -0,0 +1,165 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     VectorKernels.h (math)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// stl
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ell
+{
+namespace math
+{
+    /// <summary> An enum that represents the instruction sets that vector kernels can be dispatched to. </summary>
+    enum class InstructionSet
+    {
+        scalar,
+        sse2,
+        avx2,
+        avx512
+    };
+
+    /// <summary> Gets the widest instruction set supported by both the processor (queried with CPUID) and this build. </summary>
+    ///
+    /// <returns> The instruction set. </returns>
+    InstructionSet GetSupportedInstructionSet();
+
+    /// <summary> Gets the instruction set that the float and double vector kernels currently dispatch to. </summary>
+    ///
+    /// <returns> The instruction set. </returns>
+    InstructionSet GetInstructionSet();
+
+    /// <summary>
+    /// Overrides the instruction set that the float and double vector kernels dispatch to. By default,
+    /// the kernels dispatch to GetSupportedInstructionSet(). This setting is global and should not be
+    /// changed while other threads are calling into Operations.
+    /// </summary>
+    ///
+    /// <param name="instructionSet"> The instruction set, which must not be wider than GetSupportedInstructionSet(). </param>
+    void SetInstructionSet(InstructionSet instructionSet);
+
+    /// <summary> Gets the name of an instruction set. </summary>
+    ///
+    /// <param name="instructionSet"> The instruction set. </param>
+    ///
+    /// <returns> The name. </returns>
+    std::string GetInstructionSetName(InstructionSet instructionSet);
+
+    /// <summary>
+    /// Element-wise kernels over contiguous arrays, used by Operations when vectors have an increment
+    /// of 1. The generic version is a plain loop; the float and double specializations dispatch at
+    /// runtime to SSE2, AVX2 or AVX-512 code, depending on the processor.
+    /// </summary>
+    ///
+    /// <typeparam name="ElementType"> The element type. </typeparam>
+    template <typename ElementType>
+    struct VectorKernels
+    {
+        /// <summary> Adds a scalar to an array, v += s. </summary>
+        static void Add(ElementType s, ElementType* pV, size_t size);
+
+        /// <summary> Adds a scaled array to another array, u += s * v. </summary>
+        static void Add(ElementType s, const ElementType* pV, ElementType* pU, size_t size);
+
+        /// <summary> Multiplies an array by a scalar and adds a scalar, v = s * v + b. </summary>
+        static void MultiplyAdd(ElementType s, ElementType b, ElementType* pV, size_t size);
+
+        /// <summary> Multiplies two arrays element-wise, t = u .* v. </summary>
+        static void ElementWiseMultiply(const ElementType* pU, const ElementType* pV, ElementType* pT, size_t size);
+
+        /// <summary> Returns the sum of the elements of an array. </summary>
+        static ElementType Sum(const ElementType* pV, size_t size);
+
+        /// <summary> Returns the dot product of two arrays. </summary>
+        static ElementType Dot(const ElementType* pU, const ElementType* pV, size_t size);
+
+        /// <summary> Approximates exp element-wise, u = exp(v). The float and double versions have a relative error of a few units in the last place, and saturate outside [-87, 88] (float) or [-708, 709] (double). </summary>
+        static void Exp(const ElementType* pV, ElementType* pU, size_t size);
+
+        /// <summary> Approximates log element-wise, u = log(v), with a relative error of a few units in the last place. Arguments must be finite; non-positive and denormal arguments are treated as the smallest positive normal number. </summary>
+        static void Log(const ElementType* pV, ElementType* pU, size_t size);
+
+        /// <summary> Approximates tanh element-wise, u = tanh(v), with an absolute error of a few units in the last place of 1. </summary>
+        static void Tanh(const ElementType* pV, ElementType* pU, size_t size);
+
+        /// <summary> Approximates the logistic sigmoid element-wise, u = 1 / (1 + exp(-v)), with a relative error of a few units in the last place. </summary>
+        static void Sigmoid(const ElementType* pV, ElementType* pU, size_t size);
+    };
+
+    template <>
+    struct VectorKernels<float>
+    {
+        static void Add(float s, float* pV, size_t size);
+        static void Add(float s, const float* pV, float* pU, size_t size);
+        static void MultiplyAdd(float s, float b, float* pV, size_t size);
+        static void ElementWiseMultiply(const float* pU, const float* pV, float* pT, size_t size);
+        static float Sum(const float* pV, size_t size);
+        static float Dot(const float* pU, const float* pV, size_t size);
+        static void Exp(const float* pV, float* pU, size_t size);
+        static void Log(const float* pV, float* pU, size_t size);
+        static void Tanh(const float* pV, float* pU, size_t size);
+        static void Sigmoid(const float* pV, float* pU, size_t size);
+    };
+
+    template <>
+    struct VectorKernels<double>
+    {
+        static void Add(double s, double* pV, size_t size);
+        static void Add(double s, const double* pV, double* pU, size_t size);
+        static void MultiplyAdd(double s, double b, double* pV, size_t size);
+        static void ElementWiseMultiply(const double* pU, const double* pV, double* pT, size_t size);
+        static double Sum(const double* pV, size_t size);
+        static double Dot(const double* pU, const double* pV, size_t size);
+        static void Exp(const double* pV, double* pU, size_t size);
+        static void Log(const double* pV, double* pU, size_t size);
+        static void Tanh(const double* pV, double* pU, size_t size);
+        static void Sigmoid(const double* pV, double* pU, size_t size);
+    };
+
+    /// <summary>
+    /// Integer dot product kernels for quantized matrices, which multiply unsigned 8 bit values by
+    /// signed 8 bit values and accumulate exactly in 32 bits (arrays are limited to 65793 elements,
+    /// beyond which the sum may overflow, so Dot and Dot4 callers must split longer arrays). They
+    /// dispatch at runtime to AVX-512 VNNI, AVX2 or SSE2 code, depending on the processor.
+    /// </summary>
+    struct QuantizedKernels
+    {
+        /// <summary> Returns the dot product of an unsigned array and a signed array. </summary>
+        static int32_t Dot(const uint8_t* pU, const int8_t* pV, size_t size);
+
+        /// <summary> Computes the dot products of an unsigned array with four signed arrays that start vIncrement elements apart. </summary>
+        static void Dot4(const uint8_t* pU, const int8_t* pV, size_t vIncrement, size_t size, int32_t* pResults);
+
+        /// <summary>
+        /// Adds the product of an m x k signed matrix, stored in rows aRowIncrement elements apart, and a
+        /// k x n unsigned matrix, stored in columns bColumnIncrement elements apart, to an m x n matrix
+        /// of 64 bit sums stored in rows cRowIncrement elements apart. The depth is not limited, since
+        /// the kernel adds its 32 bit sums to C in blocks.
+        /// </summary>
+        static void Multiply(size_t m, size_t n, size_t k, const int8_t* pA, size_t aRowIncrement, const uint8_t* pB, size_t bColumnIncrement, int64_t* pC, size_t cRowIncrement);
+    };
+
+    /// <summary>
+    /// Conversions between float and Float16 (passed as its bit pattern), which dispatch at runtime
+    /// to the F16C or AVX-512 conversion instructions when the processor has them. The results match
+    /// the scalar Float16 conversions, which round to nearest even, except for the payloads of NaNs.
+    /// </summary>
+    struct HalfPrecisionKernels
+    {
+        /// <summary> Converts an array of Float16 bit patterns to float. </summary>
+        static void Float16ToFloat(const uint16_t* pSource, float* pTarget, size_t size);
+
+        /// <summary> Converts an array of floats to Float16 bit patterns. </summary>
+        static void FloatToFloat16(const float* pSource, uint16_t* pTarget, size_t size);
+    };
+}
+}
+
+#include "../tcc/VectorKernels.tcc"
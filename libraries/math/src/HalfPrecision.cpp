@@ -0,0 +1,49 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     HalfPrecision.cpp (math)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "HalfPrecision.h"
+#include "VectorKernels.h"
+
+namespace ell
+{
+namespace math
+{
+    namespace
+    {
+        template <typename SourceType, typename TargetType>
+        void ConvertArray(const SourceType* pSource, TargetType* pTarget, size_t size)
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                pTarget[i] = static_cast<TargetType>(pSource[i]);
+            }
+        }
+    }
+
+    // Float16 conversions use the F16C or AVX-512 conversion instructions when the processor has them
+    void ConvertElements(const float* pSource, Float16* pTarget, size_t size)
+    {
+        HalfPrecisionKernels::FloatToFloat16(pSource, reinterpret_cast<uint16_t*>(pTarget), size);
+    }
+
+    void ConvertElements(const Float16* pSource, float* pTarget, size_t size)
+    {
+        HalfPrecisionKernels::Float16ToFloat(reinterpret_cast<const uint16_t*>(pSource), pTarget, size);
+    }
+
+    void ConvertElements(const float* pSource, BFloat16* pTarget, size_t size)
+    {
+        ConvertArray(pSource, pTarget, size);
+    }
+
+    void ConvertElements(const BFloat16* pSource, float* pTarget, size_t size)
+    {
+        ConvertArray(pSource, pTarget, size);
+    }
+}
+}
@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     Operations.cpp (math)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Operations.h"
+
+// stl
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace ell
+{
+namespace math
+{
+    std::unique_ptr<utilities::ThreadPool> CommonOperations::_threadPool;
+
+    void CommonOperations::SetNumThreads(size_t numThreads)
+    {
+        if (numThreads == 0)
+        {
+            numThreads = std::thread::hardware_concurrency();
+        }
+
+        if (numThreads == GetNumThreads())
+        {
+            return;
+        }
+
+        if (numThreads <= 1)
+        {
+            _threadPool.reset();
+        }
+        else
+        {
+            _threadPool = std::make_unique<utilities::ThreadPool>(numThreads);
+        }
+    }
+
+    size_t CommonOperations::GetNumThreads()
+    {
+        return _threadPool ? _threadPool->NumThreads() : 1;
+    }
+
+    void CommonOperations::Multiply(float s, const QuantizedWeightMatrix& A, ConstVectorReference<float, VectorOrientation::column> v, float t, VectorReference<float, VectorOrientation::column> u)
+    {
+        if (A.NumColumns() != v.Size() || A.NumRows() != u.Size())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Incompatible matrix and vectors sizes.");
+        }
+
+        float minValue = 0;
+        float maxValue = 0;
+        for (size_t j = 0; j < v.Size(); ++j)
+        {
+            minValue = std::min(minValue, v[j]);
+            maxValue = std::max(maxValue, v[j]);
+        }
+
+        auto parameters = GetQuantizationParameters<uint8_t>(minValue, maxValue);
+        std::vector<uint8_t> data(v.Size());
+        for (size_t j = 0; j < v.Size(); ++j)
+        {
+            data[j] = Quantize<uint8_t>(v[j], parameters);
+        }
+        QuantizedActivationMatrix V(v.Size(), 1, data, { parameters });
+
+        auto depth = A.NumColumns();
+        auto pV = V.GetMajorVectorPointer(0);
+        ForEachOutputTile(A.NumRows(), 1, A.NumRows() * A.NumColumns(), [&](size_t firstRow, size_t numRows, size_t, size_t) {
+            int32_t results[4];
+            size_t i = firstRow;
+            for (; i + 4 <= firstRow + numRows; i += 4)
+            {
+                int64_t products[4] = { 0, 0, 0, 0 };
+                for (size_t k = 0; k < depth; k += c_quantizedBlockDepth)
+                {
+                    auto blockDepth = std::min(c_quantizedBlockDepth, depth - k);
+                    QuantizedKernels::Dot4(pV + k, A.GetMajorVectorPointer(i) + k, depth, blockDepth, results);
+                    for (size_t r = 0; r < 4; ++r)
+                    {
+                        products[r] += results[r];
+                    }
+                }
+                for (size_t r = 0; r < 4; ++r)
+                {
+                    u[i + r] = s * GetQuantizedProduct(products[r], A, i + r, V, 0) + t * u[i + r];
+                }
+            }
+            for (; i < firstRow + numRows; ++i)
+            {
+                int64_t product = 0;
+                for (size_t k = 0; k < depth; k += c_quantizedBlockDepth)
+                {
+                    product += QuantizedKernels::Dot(pV + k, A.GetMajorVectorPointer(i) + k, std::min(c_quantizedBlockDepth, depth - k));
+                }
+                u[i] = s * GetQuantizedProduct(product, A, i, V, 0) + t * u[i];
+            }
+        });
+    }
+}
+}
@@ -0,0 +1,52 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     QuantizedKernelsVNNI.cpp (math)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// This file is compiled with AVX-512 VNNI code generation enabled, and its kernels are only called
+// after CPUID confirms that the processor supports them.
+
+#include "VectorKernelImplementation.h"
+
+#include <immintrin.h>
+
+namespace ell
+{
+namespace math
+{
+    namespace
+    {
+        struct VNNIQuantizedTraits
+        {
+            using AccumulatorType = __m512i;
+            using UnsignedType = __m512i;
+            static constexpr size_t width = 64;
+
+            static AccumulatorType Zero() { return _mm512_setzero_si512(); }
+            static UnsignedType LoadUnsigned(const uint8_t* pData) { return _mm512_loadu_si512(pData); }
+
+            // vpdpbusd multiplies groups of four unsigned and signed bytes and adds them to 32 bit sums, without saturation
+            static AccumulatorType MultiplyAdd(AccumulatorType sum, UnsignedType u, const int8_t* pV) { return _mm512_dpbusd_epi32(sum, u, _mm512_loadu_si512(pV)); }
+            static int32_t ReduceSum(AccumulatorType sum) { return _mm512_reduce_add_epi32(sum); }
+
+            using PackedType = int8_t;
+            static constexpr size_t lanes = 16;
+            static constexpr size_t groupSize = 4;
+
+            static AccumulatorType LoadPacked(const PackedType* pData) { return _mm512_loadu_si512(pData); }
+            static AccumulatorType BroadcastGroup(const uint8_t* pData) { return _mm512_set1_epi32(pData[0] | (pData[1] << 8) | (pData[2] << 16) | (static_cast<uint32_t>(pData[3]) << 24)); }
+            static AccumulatorType MultiplyAddPacked(AccumulatorType sum, AccumulatorType u, AccumulatorType v) { return _mm512_dpbusd_epi32(sum, u, v); }
+            static void Store(int32_t* pData, AccumulatorType sum) { _mm512_storeu_si512(pData, sum); }
+        };
+    }
+
+    // 32 vector registers hold a 2 x 12 tile of accumulators, two packed vectors and a broadcast group
+    QuantizedKernelTable GetVNNIQuantizedKernels()
+    {
+        return QuantizedKernelImplementation<VNNIQuantizedTraits, 2, 12>::GetTable();
+    }
+}
+}
@@ -0,0 +1,34 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     Transcendental.cpp (math)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Transcendental.h"
+
+namespace ell
+{
+namespace math
+{
+    namespace
+    {
+        TranscendentalPrecision& GetPrecisionSetting()
+        {
+            static TranscendentalPrecision precision = TranscendentalPrecision::exact;
+            return precision;
+        }
+    }
+
+    TranscendentalPrecision GetTranscendentalPrecision()
+    {
+        return GetPrecisionSetting();
+    }
+
+    void SetTranscendentalPrecision(TranscendentalPrecision precision)
+    {
+        GetPrecisionSetting() = precision;
+    }
+}
+}
@@ -0,0 +1,648 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     VectorKernels.cpp (math)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "VectorKernels.h"
+#include "HalfPrecision.h"
+#include "MatrixMultiplyImplementation.h"
+#include "MatrixMultiplyKernel.h"
+#include "SimdTraits.h"
+#include "VectorKernelImplementation.h"
+
+// utilities
+#include "Exception.h"
+
+// stl
+#include <string>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define ELL_MATH_X86
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#define ELL_MATH_X86
+#endif
+
+namespace ell
+{
+namespace math
+{
+    namespace
+    {
+        //
+        // Short-vector traits for the quantized kernels
+        //
+
+        struct ScalarQuantizedTraits
+        {
+            using AccumulatorType = int32_t;
+            using UnsignedType = int32_t;
+            static constexpr size_t width = 1;
+
+            static AccumulatorType Zero() { return 0; }
+            static UnsignedType LoadUnsigned(const uint8_t* pData) { return *pData; }
+            static AccumulatorType MultiplyAdd(AccumulatorType sum, UnsignedType u, const int8_t* pV) { return sum + u * *pV; }
+            static int32_t ReduceSum(AccumulatorType sum) { return sum; }
+
+            using PackedType = int8_t;
+            static constexpr size_t lanes = 1;
+            static constexpr size_t groupSize = 1;
+
+            static AccumulatorType LoadPacked(const PackedType* pData) { return *pData; }
+            static AccumulatorType BroadcastGroup(const uint8_t* pData) { return *pData; }
+            static AccumulatorType MultiplyAddPacked(AccumulatorType sum, AccumulatorType u, AccumulatorType v) { return sum + u * v; }
+            static void Store(int32_t* pData, AccumulatorType sum) { *pData = sum; }
+        };
+
+#if defined(ELL_MATH_SSE2)
+        struct SSE2QuantizedTraits
+        {
+            // 16 bytes, widened to two vectors of eight 16 bit values
+            struct UnsignedType
+            {
+                __m128i low;
+                __m128i high;
+            };
+
+            using AccumulatorType = __m128i;
+            static constexpr size_t width = 16;
+
+            static AccumulatorType Zero() { return _mm_setzero_si128(); }
+
+            static UnsignedType LoadUnsigned(const uint8_t* pData)
+            {
+                auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData));
+                auto zero = _mm_setzero_si128();
+                return { _mm_unpacklo_epi8(bytes, zero), _mm_unpackhi_epi8(bytes, zero) };
+            }
+
+            static AccumulatorType MultiplyAdd(AccumulatorType sum, UnsignedType u, const int8_t* pV)
+            {
+                // SSE2 has no sign extension, so each byte is duplicated into a 16 bit value and shifted back down arithmetically
+                auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pV));
+                auto vLow = _mm_srai_epi16(_mm_unpacklo_epi8(bytes, bytes), 8);
+                auto vHigh = _mm_srai_epi16(_mm_unpackhi_epi8(bytes, bytes), 8);
+                sum = _mm_add_epi32(sum, _mm_madd_epi16(u.low, vLow));
+                return _mm_add_epi32(sum, _mm_madd_epi16(u.high, vHigh));
+            }
+
+            static int32_t ReduceSum(AccumulatorType sum)
+            {
+                sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+                sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+                return _mm_cvtsi128_si32(sum);
+            }
+
+            // the packed panels hold pairs of 16 bit values, which pmaddwd multiplies and adds into each 32 bit lane
+            using PackedType = int16_t;
+            static constexpr size_t lanes = 4;
+            static constexpr size_t groupSize = 2;
+
+            static AccumulatorType LoadPacked(const PackedType* pData) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData)); }
+            static AccumulatorType BroadcastGroup(const uint8_t* pData) { return _mm_set1_epi32(pData[0] | (pData[1] << 16)); }
+            static AccumulatorType MultiplyAddPacked(AccumulatorType sum, AccumulatorType u, AccumulatorType v) { return _mm_add_epi32(sum, _mm_madd_epi16(u, v)); }
+            static void Store(int32_t* pData, AccumulatorType sum) { _mm_storeu_si128(reinterpret_cast<__m128i*>(pData), sum); }
+        };
+#endif
+
+        //
+        // Half precision conversions for the instruction sets without conversion instructions
+        //
+
+        void ScalarFloat16ToFloat(const uint16_t* pSource, float* pTarget, size_t size)
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                pTarget[i] = Float16::FromBits(pSource[i]);
+            }
+        }
+
+        void ScalarFloatToFloat16(const float* pSource, uint16_t* pTarget, size_t size)
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                pTarget[i] = Float16(pSource[i]).bits;
+            }
+        }
+
+        void BFloat16ToFloat(const uint16_t* pSource, float* pTarget, size_t size)
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                pTarget[i] = BFloat16::FromBits(pSource[i]);
+            }
+        }
+
+        //
+        // Processor feature detection
+        //
+
+#if defined(ELL_MATH_X86)
+        void CpuId(unsigned int leaf, unsigned int subleaf, unsigned int registers[4])
+        {
+#if defined(_MSC_VER)
+            int values[4];
+            __cpuidex(values, static_cast<int>(leaf), static_cast<int>(subleaf));
+            for (int index = 0; index < 4; ++index)
+            {
+                registers[index] = static_cast<unsigned int>(values[index]);
+            }
+#else
+            __cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+#endif
+        }
+
+        // Reads XCR0, which tells which register states the operating system saves on a context switch
+        unsigned long long GetEnabledRegisterStates()
+        {
+#if defined(_MSC_VER)
+            return _xgetbv(0);
+#else
+            unsigned int eax = 0;
+            unsigned int edx = 0;
+            __asm__ __volatile__("xgetbv"
+                                 : "=a"(eax), "=d"(edx)
+                                 : "c"(0));
+            return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+        }
+
+        // AVX-512 VNNI and the byte and word instructions of AVX512BW, which the quantized kernels also need
+        bool DetectVNNI()
+        {
+            unsigned int registers[4];
+            CpuId(0, 0, registers);
+            if (registers[0] < 7)
+            {
+                return false;
+            }
+            CpuId(7, 0, registers);
+            bool hasAVX512BW = (registers[1] & (1u << 30)) != 0;
+            bool hasVNNI = (registers[2] & (1u << 11)) != 0;
+            return hasAVX512BW && hasVNNI;
+        }
+
+        InstructionSet DetectInstructionSet()
+        {
+            unsigned int registers[4]; // eax, ebx, ecx, edx
+            CpuId(0, 0, registers);
+            auto maxLeaf = registers[0];
+
+            CpuId(1, 0, registers);
+            bool hasSSE2 = (registers[3] & (1u << 26)) != 0;
+            bool hasOSXSave = (registers[2] & (1u << 27)) != 0;
+            bool hasAVX = (registers[2] & (1u << 28)) != 0;
+            bool hasFMA = (registers[2] & (1u << 12)) != 0;
+            bool hasF16C = (registers[2] & (1u << 29)) != 0;
+
+            bool hasAVX2 = false;
+            bool hasAVX512F = false;
+            if (maxLeaf >= 7)
+            {
+                CpuId(7, 0, registers);
+                hasAVX2 = (registers[1] & (1u << 5)) != 0;
+                hasAVX512F = (registers[1] & (1u << 16)) != 0;
+            }
+
+            // the processor supporting an instruction set is not enough, the operating system must also save the wide registers
+            auto registerStates = hasOSXSave ? GetEnabledRegisterStates() : 0;
+            bool ymmEnabled = (registerStates & 0x06) == 0x06;
+            bool zmmEnabled = (registerStates & 0xe6) == 0xe6;
+
+            if (hasAVX512F && hasAVX2 && hasFMA && hasF16C && zmmEnabled)
+            {
+                return InstructionSet::avx512;
+            }
+            if (hasAVX2 && hasAVX && hasFMA && hasF16C && ymmEnabled)
+            {
+                return InstructionSet::avx2;
+            }
+            if (hasSSE2)
+            {
+                return InstructionSet::sse2;
+            }
+            return InstructionSet::scalar;
+        }
+#else
+        bool DetectVNNI()
+        {
+            return false;
+        }
+
+        InstructionSet DetectInstructionSet()
+        {
+            return InstructionSet::scalar;
+        }
+#endif
+
+        // Clamps an instruction set to the widest one that this build has kernels for
+        InstructionSet GetCompiledInstructionSet(InstructionSet instructionSet)
+        {
+#if !defined(ELL_MATH_AVX512_KERNELS)
+            if (instructionSet == InstructionSet::avx512)
+            {
+                instructionSet = InstructionSet::avx2;
+            }
+#endif
+#if !defined(ELL_MATH_AVX2_KERNELS)
+            if (instructionSet == InstructionSet::avx2)
+            {
+                instructionSet = InstructionSet::sse2;
+            }
+#endif
+#if !defined(ELL_MATH_SSE2)
+            if (instructionSet == InstructionSet::sse2)
+            {
+                instructionSet = InstructionSet::scalar;
+            }
+#endif
+            return instructionSet;
+        }
+
+        //
+        // Dispatch
+        //
+
+        template <typename ElementType>
+        VectorKernelTable<ElementType> GetVectorKernels(InstructionSet instructionSet)
+        {
+            switch (instructionSet)
+            {
+#if defined(ELL_MATH_AVX512_KERNELS)
+            case InstructionSet::avx512:
+                return GetAVX512VectorKernels(ElementType{});
+#endif
+#if defined(ELL_MATH_AVX2_KERNELS)
+            case InstructionSet::avx2:
+                return GetAVX2VectorKernels(ElementType{});
+#endif
+#if defined(ELL_MATH_SSE2)
+            case InstructionSet::sse2:
+                return VectorKernelImplementation<ElementType, SimdTraits<ElementType>>::GetTable();
+#endif
+            default:
+                return VectorKernelImplementation<ElementType, ScalarSimdTraits<ElementType>>::GetTable();
+            }
+        }
+
+        template <typename ElementType>
+        MatrixMultiplyKernelTable<ElementType> GetMatrixMultiplyKernels(InstructionSet instructionSet)
+        {
+            switch (instructionSet)
+            {
+#if defined(ELL_MATH_AVX512_KERNELS)
+            case InstructionSet::avx512:
+                return GetAVX512MatrixMultiplyKernels(ElementType{});
+#endif
+#if defined(ELL_MATH_AVX2_KERNELS)
+            case InstructionSet::avx2:
+                return GetAVX2MatrixMultiplyKernels(ElementType{});
+#endif
+#if defined(ELL_MATH_SSE2)
+            case InstructionSet::sse2:
+                return MatrixMultiplyImplementation<ElementType, SimdTraits<ElementType>, 6, 2>::GetTable();
+#endif
+            default:
+                return MatrixMultiplyImplementation<ElementType, ScalarSimdTraits<ElementType>, 4, 4>::GetTable();
+            }
+        }
+
+        QuantizedKernelTable GetQuantizedKernels(InstructionSet instructionSet)
+        {
+            switch (instructionSet)
+            {
+#if defined(ELL_MATH_AVX512_KERNELS)
+            case InstructionSet::avx512:
+            {
+#if defined(ELL_MATH_VNNI_KERNELS)
+                static bool hasVNNI = DetectVNNI();
+                if (hasVNNI)
+                {
+                    return GetVNNIQuantizedKernels();
+                }
+#endif
+                // AVX-512 processors without VNNI use the AVX2 kernels
+                return GetAVX2QuantizedKernels();
+            }
+#endif
+#if defined(ELL_MATH_AVX2_KERNELS)
+            case InstructionSet::avx2:
+                return GetAVX2QuantizedKernels();
+#endif
+#if defined(ELL_MATH_SSE2)
+            case InstructionSet::sse2:
+                return QuantizedKernelImplementation<SSE2QuantizedTraits, 2, 4>::GetTable();
+#endif
+            default:
+                return QuantizedKernelImplementation<ScalarQuantizedTraits, 4, 4>::GetTable();
+            }
+        }
+
+        HalfPrecisionKernelTable GetHalfPrecisionKernels(InstructionSet instructionSet)
+        {
+            switch (instructionSet)
+            {
+#if defined(ELL_MATH_AVX512_KERNELS)
+            case InstructionSet::avx512:
+                return GetAVX512HalfPrecisionKernels();
+#endif
+#if defined(ELL_MATH_AVX2_KERNELS)
+            case InstructionSet::avx2:
+                return GetAVX2HalfPrecisionKernels();
+#endif
+            default:
+                return { &ScalarFloat16ToFloat, &ScalarFloatToFloat16 };
+            }
+        }
+
+        struct VectorKernelDispatch
+        {
+            VectorKernelDispatch(InstructionSet instructionSet)
+            {
+                Set(instructionSet);
+            }
+
+            void Set(InstructionSet instructionSet)
+            {
+                this->instructionSet = instructionSet;
+                floatKernels = GetVectorKernels<float>(instructionSet);
+                doubleKernels = GetVectorKernels<double>(instructionSet);
+                floatMatrixMultiplyKernels = GetMatrixMultiplyKernels<float>(instructionSet);
+                doubleMatrixMultiplyKernels = GetMatrixMultiplyKernels<double>(instructionSet);
+                quantizedKernels = GetQuantizedKernels(instructionSet);
+                halfPrecisionKernels = GetHalfPrecisionKernels(instructionSet);
+            }
+
+            InstructionSet instructionSet;
+            VectorKernelTable<float> floatKernels;
+            VectorKernelTable<double> doubleKernels;
+            MatrixMultiplyKernelTable<float> floatMatrixMultiplyKernels;
+            MatrixMultiplyKernelTable<double> doubleMatrixMultiplyKernels;
+            QuantizedKernelTable quantizedKernels;
+            HalfPrecisionKernelTable halfPrecisionKernels;
+        };
+
+        VectorKernelDispatch& GetDispatch()
+        {
+            static VectorKernelDispatch dispatch(GetSupportedInstructionSet());
+            return dispatch;
+        }
+
+        const VectorKernelTable<float>& GetKernels(float)
+        {
+            return GetDispatch().floatKernels;
+        }
+
+        const VectorKernelTable<double>& GetKernels(double)
+        {
+            return GetDispatch().doubleKernels;
+        }
+
+        const MatrixMultiplyKernelTable<float>& GetMatrixMultiplyTable(float)
+        {
+            return GetDispatch().floatMatrixMultiplyKernels;
+        }
+
+        const MatrixMultiplyKernelTable<double>& GetMatrixMultiplyTable(double)
+        {
+            return GetDispatch().doubleMatrixMultiplyKernels;
+        }
+
+        template <typename ElementType>
+        std::string GetMatrixMultiplyKernelName()
+        {
+            const auto& kernels = GetMatrixMultiplyTable(ElementType{});
+            return GetInstructionSetName(GetDispatch().instructionSet) + " " + std::to_string(kernels.microTileRows) + "x" + std::to_string(kernels.microTileColumns);
+        }
+
+        // Makes sure that the processor is queried once, while the program starts, rather than on the first call to a kernel
+        const VectorKernelDispatch& c_initialDispatch = GetDispatch();
+    }
+
+    InstructionSet GetSupportedInstructionSet()
+    {
+        static InstructionSet supportedInstructionSet = GetCompiledInstructionSet(DetectInstructionSet());
+        return supportedInstructionSet;
+    }
+
+    InstructionSet GetInstructionSet()
+    {
+        return GetDispatch().instructionSet;
+    }
+
+    void SetInstructionSet(InstructionSet instructionSet)
+    {
+        if (static_cast<int>(instructionSet) > static_cast<int>(GetSupportedInstructionSet()))
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Instruction set " + GetInstructionSetName(instructionSet) + " is not supported on this processor.");
+        }
+        GetDispatch().Set(instructionSet);
+    }
+
+    std::string GetInstructionSetName(InstructionSet instructionSet)
+    {
+        switch (instructionSet)
+        {
+        case InstructionSet::scalar:
+            return "scalar";
+        case InstructionSet::sse2:
+            return "SSE2";
+        case InstructionSet::avx2:
+            return "AVX2";
+        case InstructionSet::avx512:
+            return "AVX-512";
+        }
+        return "unknown";
+    }
+
+    //
+    // VectorKernels<float>
+    //
+
+    void VectorKernels<float>::Add(float s, float* pV, size_t size)
+    {
+        GetKernels(s).addScalar(s, pV, size);
+    }
+
+    void VectorKernels<float>::Add(float s, const float* pV, float* pU, size_t size)
+    {
+        GetKernels(s).addVector(s, pV, pU, size);
+    }
+
+    void VectorKernels<float>::MultiplyAdd(float s, float b, float* pV, size_t size)
+    {
+        GetKernels(s).multiplyAdd(s, b, pV, size);
+    }
+
+    void VectorKernels<float>::ElementWiseMultiply(const float* pU, const float* pV, float* pT, size_t size)
+    {
+        GetKernels(float{}).elementWiseMultiply(pU, pV, pT, size);
+    }
+
+    float VectorKernels<float>::Sum(const float* pV, size_t size)
+    {
+        return GetKernels(float{}).sum(pV, size);
+    }
+
+    float VectorKernels<float>::Dot(const float* pU, const float* pV, size_t size)
+    {
+        return GetKernels(float{}).dot(pU, pV, size);
+    }
+
+    void VectorKernels<float>::Exp(const float* pV, float* pU, size_t size)
+    {
+        GetKernels(float{}).exp(pV, pU, size);
+    }
+
+    void VectorKernels<float>::Log(const float* pV, float* pU, size_t size)
+    {
+        GetKernels(float{}).log(pV, pU, size);
+    }
+
+    void VectorKernels<float>::Tanh(const float* pV, float* pU, size_t size)
+    {
+        GetKernels(float{}).tanh(pV, pU, size);
+    }
+
+    void VectorKernels<float>::Sigmoid(const float* pV, float* pU, size_t size)
+    {
+        GetKernels(float{}).sigmoid(pV, pU, size);
+    }
+
+    //
+    // VectorKernels<double>
+    //
+
+    void VectorKernels<double>::Add(double s, double* pV, size_t size)
+    {
+        GetKernels(s).addScalar(s, pV, size);
+    }
+
+    void VectorKernels<double>::Add(double s, const double* pV, double* pU, size_t size)
+    {
+        GetKernels(s).addVector(s, pV, pU, size);
+    }
+
+    void VectorKernels<double>::MultiplyAdd(double s, double b, double* pV, size_t size)
+    {
+        GetKernels(s).multiplyAdd(s, b, pV, size);
+    }
+
+    void VectorKernels<double>::ElementWiseMultiply(const double* pU, const double* pV, double* pT, size_t size)
+    {
+        GetKernels(double{}).elementWiseMultiply(pU, pV, pT, size);
+    }
+
+    double VectorKernels<double>::Sum(const double* pV, size_t size)
+    {
+        return GetKernels(double{}).sum(pV, size);
+    }
+
+    double VectorKernels<double>::Dot(const double* pU, const double* pV, size_t size)
+    {
+        return GetKernels(double{}).dot(pU, pV, size);
+    }
+
+    void VectorKernels<double>::Exp(const double* pV, double* pU, size_t size)
+    {
+        GetKernels(double{}).exp(pV, pU, size);
+    }
+
+    void VectorKernels<double>::Log(const double* pV, double* pU, size_t size)
+    {
+        GetKernels(double{}).log(pV, pU, size);
+    }
+
+    void VectorKernels<double>::Tanh(const double* pV, double* pU, size_t size)
+    {
+        GetKernels(double{}).tanh(pV, pU, size);
+    }
+
+    void VectorKernels<double>::Sigmoid(const double* pV, double* pU, size_t size)
+    {
+        GetKernels(double{}).sigmoid(pV, pU, size);
+    }
+
+    //
+    // MatrixMultiplyKernel<float> and MatrixMultiplyKernel<double>
+    //
+
+    void MatrixMultiplyKernel<float>::Multiply(size_t m, size_t n, size_t k, float s, const float* pA, size_t aRowIncrement, size_t aColumnIncrement, const float* pB, size_t bRowIncrement, size_t bColumnIncrement, float t, float* pC, size_t cRowIncrement, size_t cColumnIncrement)
+    {
+        GetMatrixMultiplyTable(s).multiplyBatched(1, m, n, k, s, pA, 0, aRowIncrement, aColumnIncrement, pB, 0, bRowIncrement, bColumnIncrement, t, pC, 0, cRowIncrement, cColumnIncrement);
+    }
+
+    void MatrixMultiplyKernel<float>::MultiplyBatched(size_t batchCount, size_t m, size_t n, size_t k, float s, const float* pA, size_t aBatchIncrement, size_t aRowIncrement, size_t aColumnIncrement, const float* pB, size_t bBatchIncrement, size_t bRowIncrement, size_t bColumnIncrement, float t, float* pC, size_t cBatchIncrement, size_t cRowIncrement, size_t cColumnIncrement)
+    {
+        GetMatrixMultiplyTable(s).multiplyBatched(batchCount, m, n, k, s, pA, aBatchIncrement, aRowIncrement, aColumnIncrement, pB, bBatchIncrement, bRowIncrement, bColumnIncrement, t, pC, cBatchIncrement, cRowIncrement, cColumnIncrement);
+    }
+
+    void MatrixMultiplyKernel<float>::Multiply(size_t m, size_t n, size_t k, float s, const Float16* pA, size_t aRowIncrement, size_t aColumnIncrement, const float* pB, size_t bRowIncrement, size_t bColumnIncrement, float t, float* pC, size_t cRowIncrement, size_t cColumnIncrement)
+    {
+        const auto& dispatch = GetDispatch();
+        dispatch.floatMatrixMultiplyKernels.multiplyConverted(m, n, k, s, reinterpret_cast<const uint16_t*>(pA), aRowIncrement, aColumnIncrement, dispatch.halfPrecisionKernels.float16ToFloat, pB, bRowIncrement, bColumnIncrement, t, pC, cRowIncrement, cColumnIncrement);
+    }
+
+    void MatrixMultiplyKernel<float>::Multiply(size_t m, size_t n, size_t k, float s, const BFloat16* pA, size_t aRowIncrement, size_t aColumnIncrement, const float* pB, size_t bRowIncrement, size_t bColumnIncrement, float t, float* pC, size_t cRowIncrement, size_t cColumnIncrement)
+    {
+        GetMatrixMultiplyTable(s).multiplyConverted(m, n, k, s, reinterpret_cast<const uint16_t*>(pA), aRowIncrement, aColumnIncrement, &BFloat16ToFloat, pB, bRowIncrement, bColumnIncrement, t, pC, cRowIncrement, cColumnIncrement);
+    }
+
+    std::string MatrixMultiplyKernel<float>::GetKernelName()
+    {
+        return GetMatrixMultiplyKernelName<float>();
+    }
+
+    void MatrixMultiplyKernel<double>::Multiply(size_t m, size_t n, size_t k, double s, const double* pA, size_t aRowIncrement, size_t aColumnIncrement, const double* pB, size_t bRowIncrement, size_t bColumnIncrement, double t, double* pC, size_t cRowIncrement, size_t cColumnIncrement)
+    {
+        GetMatrixMultiplyTable(s).multiplyBatched(1, m, n, k, s, pA, 0, aRowIncrement, aColumnIncrement, pB, 0, bRowIncrement, bColumnIncrement, t, pC, 0, cRowIncrement, cColumnIncrement);
+    }
+
+    void MatrixMultiplyKernel<double>::MultiplyBatched(size_t batchCount, size_t m, size_t n, size_t k, double s, const double* pA, size_t aBatchIncrement, size_t aRowIncrement, size_t aColumnIncrement, const double* pB, size_t bBatchIncrement, size_t bRowIncrement, size_t bColumnIncrement, double t, double* pC, size_t cBatchIncrement, size_t cRowIncrement, size_t cColumnIncrement)
+    {
+        GetMatrixMultiplyTable(s).multiplyBatched(batchCount, m, n, k, s, pA, aBatchIncrement, aRowIncrement, aColumnIncrement, pB, bBatchIncrement, bRowIncrement, bColumnIncrement, t, pC, cBatchIncrement, cRowIncrement, cColumnIncrement);
+    }
+
+    std::string MatrixMultiplyKernel<double>::GetKernelName()
+    {
+        return GetMatrixMultiplyKernelName<double>();
+    }
+
+    //
+    // QuantizedKernels
+    //
+
+    int32_t QuantizedKernels::Dot(const uint8_t* pU, const int8_t* pV, size_t size)
+    {
+        return GetDispatch().quantizedKernels.dot(pU, pV, size);
+    }
+
+    void QuantizedKernels::Dot4(const uint8_t* pU, const int8_t* pV, size_t vIncrement, size_t size, int32_t* pResults)
+    {
+        GetDispatch().quantizedKernels.dot4(pU, pV, vIncrement, size, pResults);
+    }
+
+    void QuantizedKernels::Multiply(size_t m, size_t n, size_t k, const int8_t* pA, size_t aRowIncrement, const uint8_t* pB, size_t bColumnIncrement, int64_t* pC, size_t cRowIncrement)
+    {
+        GetDispatch().quantizedKernels.multiply(m, n, k, pA, aRowIncrement, pB, bColumnIncrement, pC, cRowIncrement);
+    }
+
+    //
+    // HalfPrecisionKernels
+    //
+
+    void HalfPrecisionKernels::Float16ToFloat(const uint16_t* pSource, float* pTarget, size_t size)
+    {
+        GetDispatch().halfPrecisionKernels.float16ToFloat(pSource, pTarget, size);
+    }
+
+    void HalfPrecisionKernels::FloatToFloat16(const float* pSource, uint16_t* pTarget, size_t size)
+    {
+        GetDispatch().halfPrecisionKernels.floatToFloat16(pSource, pTarget, size);
+    }
+}
+}
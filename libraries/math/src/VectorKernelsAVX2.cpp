@@ -0,0 +1,223 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     VectorKernelsAVX2.cpp (math)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// This file is compiled with AVX2 and FMA code generation enabled, and its kernels are only called
+// after CPUID confirms that the processor supports them.
+
+#include "MatrixMultiplyImplementation.h"
+#include "VectorKernelImplementation.h"
+
+#include <immintrin.h>
+
+namespace ell
+{
+namespace math
+{
+    namespace
+    {
+        struct AVX2FloatTraits
+        {
+            using VectorType = __m256;
+            static constexpr size_t width = 8;
+
+            static VectorType Zero() { return _mm256_setzero_ps(); }
+            static VectorType Broadcast(float value) { return _mm256_set1_ps(value); }
+            static VectorType Load(const float* pData) { return _mm256_loadu_ps(pData); }
+            static void Store(float* pData, VectorType value) { _mm256_storeu_ps(pData, value); }
+            static VectorType Add(VectorType a, VectorType b) { return _mm256_add_ps(a, b); }
+            static VectorType Subtract(VectorType a, VectorType b) { return _mm256_sub_ps(a, b); }
+            static VectorType Multiply(VectorType a, VectorType b) { return _mm256_mul_ps(a, b); }
+            static VectorType Divide(VectorType a, VectorType b) { return _mm256_div_ps(a, b); }
+            static VectorType MultiplyAdd(VectorType a, VectorType b, VectorType c) { return _mm256_fmadd_ps(a, b, c); }
+            static VectorType Min(VectorType a, VectorType b) { return _mm256_min_ps(a, b); }
+            static VectorType Max(VectorType a, VectorType b) { return _mm256_max_ps(a, b); }
+            static VectorType SelectNaN(VectorType x, VectorType y) { return _mm256_blendv_ps(y, x, _mm256_cmp_ps(x, x, _CMP_UNORD_Q)); }
+
+            static VectorType Pow2(VectorType n)
+            {
+                auto biasedExponent = _mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127));
+                return _mm256_castsi256_ps(_mm256_slli_epi32(biasedExponent, 23));
+            }
+
+            static VectorType SplitExponent(VectorType x, VectorType& exponent)
+            {
+                // subtracting the bits of sqrt(1/2) moves the exponent boundary from 1 to sqrt(1/2)
+                auto bits = _mm256_castps_si256(x);
+                auto e = _mm256_srai_epi32(_mm256_sub_epi32(bits, _mm256_set1_epi32(0x3f3504f3)), 23);
+                exponent = _mm256_cvtepi32_ps(e);
+                return _mm256_castsi256_ps(_mm256_sub_epi32(bits, _mm256_slli_epi32(e, 23)));
+            }
+
+            static float ReduceSum(VectorType a)
+            {
+                auto sum = _mm_add_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+                sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+                sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+                return _mm_cvtss_f32(sum);
+            }
+        };
+
+        struct AVX2DoubleTraits
+        {
+            using VectorType = __m256d;
+            static constexpr size_t width = 4;
+
+            static VectorType Zero() { return _mm256_setzero_pd(); }
+            static VectorType Broadcast(double value) { return _mm256_set1_pd(value); }
+            static VectorType Load(const double* pData) { return _mm256_loadu_pd(pData); }
+            static void Store(double* pData, VectorType value) { _mm256_storeu_pd(pData, value); }
+            static VectorType Add(VectorType a, VectorType b) { return _mm256_add_pd(a, b); }
+            static VectorType Subtract(VectorType a, VectorType b) { return _mm256_sub_pd(a, b); }
+            static VectorType Multiply(VectorType a, VectorType b) { return _mm256_mul_pd(a, b); }
+            static VectorType Divide(VectorType a, VectorType b) { return _mm256_div_pd(a, b); }
+            static VectorType MultiplyAdd(VectorType a, VectorType b, VectorType c) { return _mm256_fmadd_pd(a, b, c); }
+            static VectorType Min(VectorType a, VectorType b) { return _mm256_min_pd(a, b); }
+            static VectorType Max(VectorType a, VectorType b) { return _mm256_max_pd(a, b); }
+            static VectorType SelectNaN(VectorType x, VectorType y) { return _mm256_blendv_pd(y, x, _mm256_cmp_pd(x, x, _CMP_UNORD_Q)); }
+
+            static VectorType Pow2(VectorType n)
+            {
+                auto biasedExponent = _mm256_add_epi64(_mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(n)), _mm256_set1_epi64x(1023));
+                return _mm256_castsi256_pd(_mm256_slli_epi64(biasedExponent, 52));
+            }
+
+            static VectorType SplitExponent(VectorType x, VectorType& exponent)
+            {
+                // AVX2 has no arithmetic 64 bit shift, so the exponent is kept biased (and positive) by
+                // adding the bits of 1 - sqrt(1/2), and converted to double by way of the bits of 2^52
+                auto bits = _mm256_castpd_si256(x);
+                auto biasedExponent = _mm256_srli_epi64(_mm256_add_epi64(bits, _mm256_set1_epi64x(0x00095f619980c433)), 52);
+                auto shiftedExponent = _mm256_slli_epi64(biasedExponent, 52);
+                auto twoTo52 = _mm256_set1_pd(4503599627370496.0);
+                exponent = _mm256_sub_pd(_mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(biasedExponent, _mm256_castpd_si256(twoTo52))), twoTo52), _mm256_set1_pd(1023));
+                return _mm256_castsi256_pd(_mm256_add_epi64(_mm256_sub_epi64(bits, shiftedExponent), _mm256_set1_epi64x(0x3ff0000000000000)));
+            }
+
+            static double ReduceSum(VectorType a)
+            {
+                auto sum = _mm_add_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1));
+                return _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+            }
+        };
+
+        struct AVX2QuantizedTraits
+        {
+            using AccumulatorType = __m256i;
+            using UnsignedType = __m256i;
+            static constexpr size_t width = 16;
+
+            static AccumulatorType Zero() { return _mm256_setzero_si256(); }
+            static UnsignedType LoadUnsigned(const uint8_t* pData) { return _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pData))); }
+
+            static AccumulatorType MultiplyAdd(AccumulatorType sum, UnsignedType u, const int8_t* pV)
+            {
+                // widening to 16 bits before vpmaddwd keeps the sums exact, whereas vpmaddubsw saturates pairs of products at 16 bits
+                auto v = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pV)));
+                return _mm256_add_epi32(sum, _mm256_madd_epi16(u, v));
+            }
+
+            static int32_t ReduceSum(AccumulatorType sum)
+            {
+                auto half = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+                half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+                half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+                return _mm_cvtsi128_si32(half);
+            }
+
+            // the packed panels hold pairs of 16 bit values, which vpmaddwd multiplies and adds into each 32 bit lane
+            using PackedType = int16_t;
+            static constexpr size_t lanes = 8;
+            static constexpr size_t groupSize = 2;
+
+            static AccumulatorType LoadPacked(const PackedType* pData) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pData)); }
+            static AccumulatorType BroadcastGroup(const uint8_t* pData) { return _mm256_set1_epi32(pData[0] | (pData[1] << 16)); }
+            static AccumulatorType MultiplyAddPacked(AccumulatorType sum, AccumulatorType u, AccumulatorType v) { return _mm256_add_epi32(sum, _mm256_madd_epi16(u, v)); }
+            static void Store(int32_t* pData, AccumulatorType sum) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(pData), sum); }
+        };
+
+        // F16C converts eight elements at a time; a partial vector at the end goes through a small buffer
+        void AVX2Float16ToFloat(const uint16_t* pSource, float* pTarget, size_t size)
+        {
+            size_t i = 0;
+            for (; i + 8 <= size; i += 8)
+            {
+                _mm256_storeu_ps(pTarget + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSource + i))));
+            }
+            if (i < size)
+            {
+                uint16_t source[8] = {};
+                float target[8];
+                for (size_t j = i; j < size; ++j)
+                {
+                    source[j - i] = pSource[j];
+                }
+                _mm256_storeu_ps(target, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source))));
+                for (size_t j = i; j < size; ++j)
+                {
+                    pTarget[j] = target[j - i];
+                }
+            }
+        }
+
+        void AVX2FloatToFloat16(const float* pSource, uint16_t* pTarget, size_t size)
+        {
+            size_t i = 0;
+            for (; i + 8 <= size; i += 8)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(pTarget + i), _mm256_cvtps_ph(_mm256_loadu_ps(pSource + i), _MM_FROUND_TO_NEAREST_INT));
+            }
+            if (i < size)
+            {
+                float source[8] = {};
+                uint16_t target[8];
+                for (size_t j = i; j < size; ++j)
+                {
+                    source[j - i] = pSource[j];
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(target), _mm256_cvtps_ph(_mm256_loadu_ps(source), _MM_FROUND_TO_NEAREST_INT));
+                for (size_t j = i; j < size; ++j)
+                {
+                    pTarget[j] = target[j - i];
+                }
+            }
+        }
+    }
+
+    VectorKernelTable<float> GetAVX2VectorKernels(float)
+    {
+        return VectorKernelImplementation<float, AVX2FloatTraits>::GetTable();
+    }
+
+    VectorKernelTable<double> GetAVX2VectorKernels(double)
+    {
+        return VectorKernelImplementation<double, AVX2DoubleTraits>::GetTable();
+    }
+
+    // 16 vector registers hold a 6 x 2 tile of accumulators, plus the two rows of B and a broadcast element of A
+    MatrixMultiplyKernelTable<float> GetAVX2MatrixMultiplyKernels(float)
+    {
+        return MatrixMultiplyImplementation<float, AVX2FloatTraits, 6, 2>::GetTable();
+    }
+
+    MatrixMultiplyKernelTable<double> GetAVX2MatrixMultiplyKernels(double)
+    {
+        return MatrixMultiplyImplementation<double, AVX2DoubleTraits, 6, 2>::GetTable();
+    }
+
+    // 16 vector registers hold a 2 x 6 tile of accumulators, two packed vectors and a broadcast group
+    QuantizedKernelTable GetAVX2QuantizedKernels()
+    {
+        return QuantizedKernelImplementation<AVX2QuantizedTraits, 2, 6>::GetTable();
+    }
+
+    HalfPrecisionKernelTable GetAVX2HalfPrecisionKernels()
+    {
+        return { &AVX2Float16ToFloat, &AVX2FloatToFloat16 };
+    }
+}
+}
@@ -0,0 +1,156 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     VectorKernelsAVX512.cpp (math)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// This file is compiled with AVX-512 code generation enabled, and its kernels are only called
+// after CPUID confirms that the processor supports them.
+
+#include "MatrixMultiplyImplementation.h"
+#include "VectorKernelImplementation.h"
+
+#include <immintrin.h>
+
+namespace ell
+{
+namespace math
+{
+    namespace
+    {
+        struct AVX512FloatTraits
+        {
+            using VectorType = __m512;
+            static constexpr size_t width = 16;
+
+            static VectorType Zero() { return _mm512_setzero_ps(); }
+            static VectorType Broadcast(float value) { return _mm512_set1_ps(value); }
+            static VectorType Load(const float* pData) { return _mm512_loadu_ps(pData); }
+            static void Store(float* pData, VectorType value) { _mm512_storeu_ps(pData, value); }
+            static VectorType Add(VectorType a, VectorType b) { return _mm512_add_ps(a, b); }
+            static VectorType Subtract(VectorType a, VectorType b) { return _mm512_sub_ps(a, b); }
+            static VectorType Multiply(VectorType a, VectorType b) { return _mm512_mul_ps(a, b); }
+            static VectorType Divide(VectorType a, VectorType b) { return _mm512_div_ps(a, b); }
+            static VectorType MultiplyAdd(VectorType a, VectorType b, VectorType c) { return _mm512_fmadd_ps(a, b, c); }
+            static VectorType Min(VectorType a, VectorType b) { return _mm512_min_ps(a, b); }
+            static VectorType Max(VectorType a, VectorType b) { return _mm512_max_ps(a, b); }
+            static VectorType SelectNaN(VectorType x, VectorType y) { return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(x, x, _CMP_UNORD_Q), y, x); }
+            static float ReduceSum(VectorType a) { return _mm512_reduce_add_ps(a); }
+            static VectorType Pow2(VectorType n) { return _mm512_scalef_ps(_mm512_set1_ps(1), n); }
+
+            static VectorType SplitExponent(VectorType x, VectorType& exponent)
+            {
+                // subtracting the bits of sqrt(1/2) moves the exponent boundary from 1 to sqrt(1/2)
+                auto bits = _mm512_castps_si512(x);
+                auto e = _mm512_srai_epi32(_mm512_sub_epi32(bits, _mm512_set1_epi32(0x3f3504f3)), 23);
+                exponent = _mm512_cvtepi32_ps(e);
+                return _mm512_castsi512_ps(_mm512_sub_epi32(bits, _mm512_slli_epi32(e, 23)));
+            }
+        };
+
+        struct AVX512DoubleTraits
+        {
+            using VectorType = __m512d;
+            static constexpr size_t width = 8;
+
+            static VectorType Zero() { return _mm512_setzero_pd(); }
+            static VectorType Broadcast(double value) { return _mm512_set1_pd(value); }
+            static VectorType Load(const double* pData) { return _mm512_loadu_pd(pData); }
+            static void Store(double* pData, VectorType value) { _mm512_storeu_pd(pData, value); }
+            static VectorType Add(VectorType a, VectorType b) { return _mm512_add_pd(a, b); }
+            static VectorType Subtract(VectorType a, VectorType b) { return _mm512_sub_pd(a, b); }
+            static VectorType Multiply(VectorType a, VectorType b) { return _mm512_mul_pd(a, b); }
+            static VectorType Divide(VectorType a, VectorType b) { return _mm512_div_pd(a, b); }
+            static VectorType MultiplyAdd(VectorType a, VectorType b, VectorType c) { return _mm512_fmadd_pd(a, b, c); }
+            static VectorType Min(VectorType a, VectorType b) { return _mm512_min_pd(a, b); }
+            static VectorType Max(VectorType a, VectorType b) { return _mm512_max_pd(a, b); }
+            static VectorType SelectNaN(VectorType x, VectorType y) { return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(x, x, _CMP_UNORD_Q), y, x); }
+            static double ReduceSum(VectorType a) { return _mm512_reduce_add_pd(a); }
+            static VectorType Pow2(VectorType n) { return _mm512_scalef_pd(_mm512_set1_pd(1), n); }
+
+            static VectorType SplitExponent(VectorType x, VectorType& exponent)
+            {
+                auto bits = _mm512_castpd_si512(x);
+                auto e = _mm512_srai_epi64(_mm512_sub_epi64(bits, _mm512_set1_epi64(0x3fe6a09e667f3bcd)), 52);
+                exponent = _mm512_cvtepi32_pd(_mm512_cvtepi64_epi32(e));
+                return _mm512_castsi512_pd(_mm512_sub_epi64(bits, _mm512_slli_epi64(e, 52)));
+            }
+        };
+
+        // AVX-512 converts sixteen elements at a time; a partial vector at the end goes through a small buffer
+        void AVX512Float16ToFloat(const uint16_t* pSource, float* pTarget, size_t size)
+        {
+            size_t i = 0;
+            for (; i + 16 <= size; i += 16)
+            {
+                _mm512_storeu_ps(pTarget + i, _mm512_cvtph_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSource + i))));
+            }
+            if (i < size)
+            {
+                uint16_t source[16] = {};
+                float target[16];
+                for (size_t j = i; j < size; ++j)
+                {
+                    source[j - i] = pSource[j];
+                }
+                _mm512_storeu_ps(target, _mm512_cvtph_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source))));
+                for (size_t j = i; j < size; ++j)
+                {
+                    pTarget[j] = target[j - i];
+                }
+            }
+        }
+
+        void AVX512FloatToFloat16(const float* pSource, uint16_t* pTarget, size_t size)
+        {
+            size_t i = 0;
+            for (; i + 16 <= size; i += 16)
+            {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(pTarget + i), _mm512_cvtps_ph(_mm512_loadu_ps(pSource + i), _MM_FROUND_TO_NEAREST_INT));
+            }
+            if (i < size)
+            {
+                float source[16] = {};
+                uint16_t target[16];
+                for (size_t j = i; j < size; ++j)
+                {
+                    source[j - i] = pSource[j];
+                }
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(target), _mm512_cvtps_ph(_mm512_loadu_ps(source), _MM_FROUND_TO_NEAREST_INT));
+                for (size_t j = i; j < size; ++j)
+                {
+                    pTarget[j] = target[j - i];
+                }
+            }
+        }
+    }
+
+    VectorKernelTable<float> GetAVX512VectorKernels(float)
+    {
+        return VectorKernelImplementation<float, AVX512FloatTraits>::GetTable();
+    }
+
+    VectorKernelTable<double> GetAVX512VectorKernels(double)
+    {
+        return VectorKernelImplementation<double, AVX512DoubleTraits>::GetTable();
+    }
+
+    // 32 vector registers hold a 14 x 2 tile of accumulators, plus the two rows of B and a broadcast element of A
+    MatrixMultiplyKernelTable<float> GetAVX512MatrixMultiplyKernels(float)
+    {
+        return MatrixMultiplyImplementation<float, AVX512FloatTraits, 14, 2>::GetTable();
+    }
+
+    MatrixMultiplyKernelTable<double> GetAVX512MatrixMultiplyKernels(double)
+    {
+        return MatrixMultiplyImplementation<double, AVX512DoubleTraits, 14, 2>::GetTable();
+    }
+
+    HalfPrecisionKernelTable GetAVX512HalfPrecisionKernels()
+    {
+        return { &AVX512Float16ToFloat, &AVX512FloatToFloat16 };
+    }
+}
+}
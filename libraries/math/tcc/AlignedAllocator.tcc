@@ -0,0 +1,44 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     AlignedAllocator.tcc (math)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// stl
+#include <cstdint>
+#include <limits>
+#include <new>
+
+namespace ell
+{
+namespace math
+{
+    template <typename ValueType, size_t alignment>
+    ValueType* AlignedAllocator<ValueType, alignment>::allocate(size_t count)
+    {
+        // reserve room to align the block and to remember the address returned by operator new just before the aligned block
+        const size_t overhead = alignment + sizeof(void*);
+        if (count > (std::numeric_limits<size_t>::max() - overhead) / sizeof(ValueType))
+        {
+            throw std::bad_alloc();
+        }
+
+        auto pRaw = static_cast<char*>(::operator new(count * sizeof(ValueType) + overhead));
+        auto address = reinterpret_cast<std::uintptr_t>(pRaw + sizeof(void*));
+        auto pAligned = reinterpret_cast<char*>((address + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1));
+        reinterpret_cast<void**>(pAligned)[-1] = pRaw;
+        return reinterpret_cast<ValueType*>(pAligned);
+    }
+
+    template <typename ValueType, size_t alignment>
+    void AlignedAllocator<ValueType, alignment>::deallocate(ValueType* pData, size_t)
+    {
+        if (pData != nullptr)
+        {
+            ::operator delete(reinterpret_cast<void**>(pData)[-1]);
+        }
+    }
+}
+}
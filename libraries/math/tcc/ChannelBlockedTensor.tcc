@@ -0,0 +1,157 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ChannelBlockedTensor.tcc (math)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "TransposeKernel.h"
+
+// utilities
+#include "Debug.h"
+#include "Exception.h"
+
+// stl
+#include <algorithm>
+
+namespace ell
+{
+namespace math
+{
+    namespace ChannelBlockedTensorDetail
+    {
+        // the distances in memory between consecutive rows, columns and channels of a tensor
+        template <typename TensorType, typename TensorLayoutType>
+        Triplet GetCanonicalIncrements(const TensorType& tensor)
+        {
+            Triplet layoutIncrements = { 1, tensor.GetIncrement1(), tensor.GetIncrement2() };
+            return { layoutIncrements[TensorLayoutType::rowPosition], layoutIncrements[TensorLayoutType::columnPosition], layoutIncrements[TensorLayoutType::channelPosition] };
+        }
+    }
+
+    template <typename ElementType, size_t blockSize>
+    ChannelBlockedTensor<ElementType, blockSize>::ChannelBlockedTensor(size_t numRows, size_t numColumns, size_t numChannels)
+        : _numRows(numRows), _numColumns(numColumns), _numChannels(numChannels), _data(numRows * numColumns * NumChannelBlocks() * blockSize)
+    {
+    }
+
+    template <typename ElementType, size_t blockSize>
+    template <Dimension dimension0, Dimension dimension1, Dimension dimension2>
+    ChannelBlockedTensor<ElementType, blockSize>::ChannelBlockedTensor(ConstTensorReference<ElementType, dimension0, dimension1, dimension2> tensor)
+        : ChannelBlockedTensor(tensor.NumRows(), tensor.NumColumns(), tensor.NumChannels())
+    {
+        CopyFrom(tensor);
+    }
+
+    template <typename ElementType, size_t blockSize>
+    ElementType ChannelBlockedTensor<ElementType, blockSize>::operator()(size_t row, size_t column, size_t channel) const
+    {
+        DEBUG_THROW(row >= _numRows || column >= _numColumns || channel >= _numChannels, utilities::InputException(utilities::InputExceptionErrors::indexOutOfRange, "index exceeds tensor dimensions."));
+        return GetBlockPointer(channel / blockSize, row, column)[channel % blockSize];
+    }
+
+    template <typename ElementType, size_t blockSize>
+    ElementType& ChannelBlockedTensor<ElementType, blockSize>::operator()(size_t row, size_t column, size_t channel)
+    {
+        DEBUG_THROW(row >= _numRows || column >= _numColumns || channel >= _numChannels, utilities::InputException(utilities::InputExceptionErrors::indexOutOfRange, "index exceeds tensor dimensions."));
+        return GetBlockPointer(channel / blockSize, row, column)[channel % blockSize];
+    }
+
+    template <typename ElementType, size_t blockSize>
+    template <Dimension dimension0, Dimension dimension1, Dimension dimension2>
+    void ChannelBlockedTensor<ElementType, blockSize>::CopyFrom(ConstTensorReference<ElementType, dimension0, dimension1, dimension2> tensor)
+    {
+        if (tensor.NumRows() != _numRows || tensor.NumColumns() != _numColumns || tensor.NumChannels() != _numChannels)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::sizeMismatch, "Tensors must have the same shape.");
+        }
+
+        auto increments = ChannelBlockedTensorDetail::GetCanonicalIncrements<decltype(tensor), TensorLayout<dimension0, dimension1, dimension2>>(tensor);
+        auto rowIncrement = increments[0];
+        auto columnIncrement = increments[1];
+        auto channelIncrement = increments[2];
+
+        for (size_t block = 0; block < NumChannelBlocks(); ++block)
+        {
+            auto firstChannel = block * blockSize;
+            auto numBlockChannels = std::min(blockSize, _numChannels - firstChannel);
+            for (size_t row = 0; row < _numRows; ++row)
+            {
+                auto pSource = tensor.GetDataPointer() + row * rowIncrement + firstChannel * channelIncrement;
+                auto pTarget = GetBlockPointer(block, row, 0);
+                if (channelIncrement == 1)
+                {
+                    // channels are contiguous in the source, so each pixel is a short copy
+                    for (size_t column = 0; column < _numColumns; ++column)
+                    {
+                        std::copy(pSource + column * columnIncrement, pSource + column * columnIncrement + numBlockChannels, pTarget + column * blockSize);
+                    }
+                }
+                else if (columnIncrement == 1)
+                {
+                    // the source row is a (channel, column) matrix, which becomes a (column, channel) matrix
+                    TransposeCopy(numBlockChannels, _numColumns, pSource, channelIncrement, pTarget, blockSize);
+                }
+                else
+                {
+                    for (size_t column = 0; column < _numColumns; ++column)
+                    {
+                        for (size_t channel = 0; channel < numBlockChannels; ++channel)
+                        {
+                            pTarget[column * blockSize + channel] = pSource[column * columnIncrement + channel * channelIncrement];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    template <typename ElementType, size_t blockSize>
+    template <Dimension dimension0, Dimension dimension1, Dimension dimension2>
+    void ChannelBlockedTensor<ElementType, blockSize>::CopyTo(TensorReference<ElementType, dimension0, dimension1, dimension2> tensor) const
+    {
+        if (tensor.NumRows() != _numRows || tensor.NumColumns() != _numColumns || tensor.NumChannels() != _numChannels)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::sizeMismatch, "Tensors must have the same shape.");
+        }
+
+        auto increments = ChannelBlockedTensorDetail::GetCanonicalIncrements<decltype(tensor), TensorLayout<dimension0, dimension1, dimension2>>(tensor);
+        auto rowIncrement = increments[0];
+        auto columnIncrement = increments[1];
+        auto channelIncrement = increments[2];
+
+        for (size_t block = 0; block < NumChannelBlocks(); ++block)
+        {
+            auto firstChannel = block * blockSize;
+            auto numBlockChannels = std::min(blockSize, _numChannels - firstChannel);
+            for (size_t row = 0; row < _numRows; ++row)
+            {
+                auto pSource = GetBlockPointer(block, row, 0);
+                auto pTarget = tensor.GetDataPointer() + row * rowIncrement + firstChannel * channelIncrement;
+                if (channelIncrement == 1)
+                {
+                    for (size_t column = 0; column < _numColumns; ++column)
+                    {
+                        std::copy(pSource + column * blockSize, pSource + column * blockSize + numBlockChannels, pTarget + column * columnIncrement);
+                    }
+                }
+                else if (columnIncrement == 1)
+                {
+                    TransposeCopy(_numColumns, numBlockChannels, pSource, blockSize, pTarget, channelIncrement);
+                }
+                else
+                {
+                    for (size_t column = 0; column < _numColumns; ++column)
+                    {
+                        for (size_t channel = 0; channel < numBlockChannels; ++channel)
+                        {
+                            pTarget[column * columnIncrement + channel * channelIncrement] = pSource[column * blockSize + channel];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+}
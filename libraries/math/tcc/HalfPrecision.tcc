@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     HalfPrecision.tcc (math)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace ell
+{
+namespace math
+{
+    namespace HalfPrecisionDetail
+    {
+        inline uint32_t GetBits(float value)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        inline float GetFloat(uint32_t bits)
+        {
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+    }
+
+    //
+    // Float16
+    //
+
+    inline Float16::Float16(float value)
+    {
+        using namespace HalfPrecisionDetail;
+
+        auto x = GetBits(value);
+        auto sign = static_cast<uint16_t>((x >> 16) & 0x8000);
+        x &= 0x7fffffff;
+
+        if (x >= 0x7f800000) // infinity or NaN, which stays quiet
+        {
+            bits = sign | (x > 0x7f800000 ? 0x7e00 : 0x7c00);
+        }
+        else if (x >= 0x477ff000) // rounds to a value beyond 65504
+        {
+            bits = sign | 0x7c00;
+        }
+        else if (x < 0x38800000) // below the smallest normal half, 2^-14
+        {
+            // adding 0.5 aligns the value to units of 2^-24, the smallest half subnormal, and the processor rounds it to nearest even
+            bits = sign | static_cast<uint16_t>(GetBits(GetFloat(x) + 0.5f) - 0x3f000000);
+        }
+        else
+        {
+            // rebias the exponent from 127 to 15 and round the 13 discarded mantissa bits to nearest even
+            auto isOdd = (x >> 13) & 1;
+            x += (static_cast<uint32_t>(15 - 127) << 23) + 0xfff + isOdd;
+            bits = sign | static_cast<uint16_t>(x >> 13);
+        }
+    }
+
+    inline Float16::operator float() const
+    {
+        using namespace HalfPrecisionDetail;
+
+        auto sign = static_cast<uint32_t>(bits & 0x8000) << 16;
+        uint32_t exponentAndMantissa = bits & 0x7fff;
+
+        if (exponentAndMantissa >= 0x7c00) // infinity or NaN
+        {
+            return GetFloat(sign | 0x7f800000 | ((exponentAndMantissa & 0x3ff) << 13));
+        }
+        if (exponentAndMantissa >= 0x0400) // normal
+        {
+            return GetFloat(sign | ((exponentAndMantissa << 13) + (static_cast<uint32_t>(127 - 15) << 23)));
+        }
+
+        // zero or subnormal, an integer number of 2^-24 units
+        return GetFloat(sign | GetBits(static_cast<float>(exponentAndMantissa) * 5.9604644775390625e-8f));
+    }
+
+    inline Float16 Float16::FromBits(uint16_t bits)
+    {
+        Float16 value;
+        value.bits = bits;
+        return value;
+    }
+
+    //
+    // BFloat16
+    //
+
+    inline BFloat16::BFloat16(float value)
+    {
+        auto x = HalfPrecisionDetail::GetBits(value);
+        if ((x & 0x7fffffff) > 0x7f800000) // NaN, which must not round to infinity
+        {
+            bits = static_cast<uint16_t>((x >> 16) | 0x0040);
+        }
+        else
+        {
+            // round the 16 discarded bits to nearest even
+            x += 0x7fff + ((x >> 16) & 1);
+            bits = static_cast<uint16_t>(x >> 16);
+        }
+    }
+
+    inline BFloat16::operator float() const
+    {
+        return HalfPrecisionDetail::GetFloat(static_cast<uint32_t>(bits) << 16);
+    }
+
+    inline BFloat16 BFloat16::FromBits(uint16_t bits)
+    {
+        BFloat16 value;
+        value.bits = bits;
+        return value;
+    }
+}
+}
@@ -270,9 +270,27 @@ namespace math
             throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Matrix dimensions are not the same.");
         }
 
-        for (size_t i = 0; i < other.NumRows(); ++i)
+        // the major vectors of other are the minor vectors of this matrix
+        TransposeCopy(other.NumIntervals(), NumIntervals(), other.GetDataPointer(), other.GetIncrement(), _pData, _increment);
+    }
+
+    template <typename ElementType, MatrixLayout layout>
+    template <typename ExpressionType>
+    void MatrixReference<ElementType, layout>::CopyFrom(const MatrixExpression<ElementType, ExpressionType>& expression)
+    {
+        const auto& derived = expression.GetDerived();
+        if (NumRows() != derived.NumRows() || NumColumns() != derived.NumColumns())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Matrix dimensions are not the same.");
+        }
+
+        for (size_t i = 0; i < NumIntervals(); ++i)
         {
-            GetRow(i).CopyFrom(other.GetRow(i));
+            ElementType* pInterval = _pData + i * _increment;
+            for (size_t j = 0; j < _intervalSize; ++j)
+            {
+                pInterval[j] = layout == MatrixLayout::rowMajor ? derived(i, j) : derived(j, i);
+            }
         }
     }
 
@@ -363,6 +381,26 @@ namespace math
         Transform([value](ElementType x) { return x + value; });
     }
 
+    template <typename ElementType, MatrixLayout layout>
+    template <typename ExpressionType>
+    void MatrixReference<ElementType, layout>::operator+=(const MatrixExpression<ElementType, ExpressionType>& expression)
+    {
+        const auto& derived = expression.GetDerived();
+        if (NumRows() != derived.NumRows() || NumColumns() != derived.NumColumns())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Matrix dimensions are not the same.");
+        }
+
+        for (size_t i = 0; i < NumIntervals(); ++i)
+        {
+            ElementType* pInterval = _pData + i * _increment;
+            for (size_t j = 0; j < _intervalSize; ++j)
+            {
+                pInterval[j] += layout == MatrixLayout::rowMajor ? derived(i, j) : derived(j, i);
+            }
+        }
+    }
+
     template <typename ElementType, MatrixLayout layout>
     void MatrixReference<ElementType, layout>::operator-=(ElementType value)
     {
@@ -390,8 +428,8 @@ namespace math
     //
 
     template <typename ElementType, MatrixLayout layout>
-    Matrix<ElementType, layout>::Matrix(size_t numRows, size_t numColumns)
-        : MatrixReference<ElementType, layout>(numRows, numColumns, nullptr), _data(numRows * numColumns)
+    Matrix<ElementType, layout>::Matrix(size_t numRows, size_t numColumns, MatrixPadding padding)
+        : MatrixReference<ElementType, layout>(numRows, numColumns, GetPaddedIncrement(numRows, numColumns, padding), nullptr), _data(GetPaddedIncrement(numRows, numColumns, padding) * GetNumIntervals(numRows, numColumns))
     {
         _pData = _data.data();
     }
@@ -420,28 +458,28 @@ namespace math
 
     template <typename ElementType, MatrixLayout layout>
     Matrix<ElementType, layout>::Matrix(size_t numRows, size_t numColumns, const std::vector<ElementType>& data)
-        : MatrixReference<ElementType, layout>(numRows, numColumns, nullptr), _data(data)
+        : MatrixReference<ElementType, layout>(numRows, numColumns, nullptr), _data(data.begin(), data.end())
     {
         _pData = _data.data();
     }
 
     template <typename ElementType, MatrixLayout layout>
     Matrix<ElementType, layout>::Matrix(size_t numRows, size_t numColumns, std::vector<ElementType>&& data)
-        : MatrixReference<ElementType, layout>(numRows, numColumns, nullptr), _data(std::move(data))
+        : MatrixReference<ElementType, layout>(numRows, numColumns, nullptr), _data(data.begin(), data.end())
     {
         _pData = _data.data();
     }
 
     template <typename ElementType, MatrixLayout layout>
     Matrix<ElementType, layout>::Matrix(Matrix<ElementType, layout>&& other)
-        : MatrixReference<ElementType, layout>(other.NumRows(), other.NumColumns(), nullptr), _data(std::move(other._data))
+        : MatrixReference<ElementType, layout>(other.NumRows(), other.NumColumns(), other.GetIncrement(), nullptr), _data(std::move(other._data))
     {
         _pData = _data.data();
     }
 
     template <typename ElementType, MatrixLayout layout>
     Matrix<ElementType, layout>::Matrix(const Matrix<ElementType, layout>& other)
-        : MatrixReference<ElementType, layout>(other.NumRows(), other.NumColumns(), nullptr), _data(other._data)
+        : MatrixReference<ElementType, layout>(other.NumRows(), other.NumColumns(), other.GetIncrement(), nullptr), _data(other._data)
     {
         _pData = _data.data();
     }
@@ -488,6 +526,45 @@ namespace math
         std::swap(_data, other._data);
     }
 
+    template <typename ElementType, MatrixLayout layout>
+    std::vector<ElementType> Matrix<ElementType, layout>::ToArray() const
+    {
+        if (IsContiguous())
+        {
+            return { _data.begin(), _data.end() };
+        }
+
+        // copy each row (or column) without the padding that follows it
+        auto intervalSize = GetPaddedIncrement(_numRows, _numColumns, MatrixPadding::none);
+        std::vector<ElementType> result;
+        result.reserve(Size());
+        for (size_t i = 0; i < NumIntervals(); ++i)
+        {
+            auto pInterval = _pData + i * _increment;
+            result.insert(result.end(), pInterval, pInterval + intervalSize);
+        }
+        return result;
+    }
+
+    template <typename ElementType, MatrixLayout layout>
+    size_t Matrix<ElementType, layout>::GetPaddedIncrement(size_t numRows, size_t numColumns, MatrixPadding padding)
+    {
+        size_t intervalSize = layout == MatrixLayout::rowMajor ? numColumns : numRows;
+        if (padding == MatrixPadding::none || c_storageAlignment % sizeof(ElementType) != 0)
+        {
+            return intervalSize;
+        }
+
+        const size_t elementsPerAlignment = c_storageAlignment / sizeof(ElementType);
+        return (intervalSize + elementsPerAlignment - 1) / elementsPerAlignment * elementsPerAlignment;
+    }
+
+    template <typename ElementType, MatrixLayout layout>
+    size_t Matrix<ElementType, layout>::GetNumIntervals(size_t numRows, size_t numColumns)
+    {
+        return layout == MatrixLayout::rowMajor ? numRows : numColumns;
+    }
+
     template <typename ElementType, MatrixLayout layout>
     void MatrixArchiver::Write(const Matrix<ElementType, layout>& matrix, const std::string& name, utilities::Archiver& archiver)
     {
@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     MatrixExpression.tcc (math)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// utilities
+#include "Exception.h"
+
+namespace ell
+{
+namespace math
+{
+    //
+    // MatrixOperand
+    //
+
+    template <typename ElementType, MatrixLayout layout>
+    MatrixOperand<ElementType, layout>::MatrixOperand(ConstMatrixReference<ElementType, layout> matrix)
+        : _pData(matrix.GetDataPointer()), _numRows(matrix.NumRows()), _numColumns(matrix.NumColumns()), _increment(matrix.GetIncrement())
+    {
+    }
+
+    template <typename ElementType, MatrixLayout layout>
+    ElementType MatrixOperand<ElementType, layout>::operator()(size_t rowIndex, size_t columnIndex) const
+    {
+        // the unit stride is a compile time constant, which lets the compiler vectorize the evaluation loop
+        return layout == MatrixLayout::rowMajor ? _pData[rowIndex * _increment + columnIndex] : _pData[rowIndex + columnIndex * _increment];
+    }
+
+    //
+    // RepeatedVectorOperand
+    //
+
+    template <typename ElementType, VectorOrientation orientation>
+    RepeatedVectorOperand<ElementType, orientation>::RepeatedVectorOperand(ConstVectorReference<ElementType, orientation> vector, size_t numRepetitions)
+        : _pData(vector.GetDataPointer()), _size(vector.Size()), _increment(vector.GetIncrement()), _numRepetitions(numRepetitions)
+    {
+    }
+
+    template <typename ElementType, VectorOrientation orientation>
+    ElementType RepeatedVectorOperand<ElementType, orientation>::operator()(size_t rowIndex, size_t columnIndex) const
+    {
+        return _pData[(orientation == VectorOrientation::row ? columnIndex : rowIndex) * _increment];
+    }
+
+    //
+    // ScaledMatrixExpression
+    //
+
+    template <typename ElementType, typename ExpressionType>
+    ScaledMatrixExpression<ElementType, ExpressionType>::ScaledMatrixExpression(ElementType scalar, ExpressionType expression)
+        : _scalar(scalar), _expression(expression)
+    {
+    }
+
+    //
+    // SumMatrixExpression
+    //
+
+    template <typename ElementType, typename LeftExpressionType, typename RightExpressionType>
+    SumMatrixExpression<ElementType, LeftExpressionType, RightExpressionType>::SumMatrixExpression(LeftExpressionType left, RightExpressionType right)
+        : _left(left), _right(right)
+    {
+        if (_left.NumRows() != _right.NumRows() || _left.NumColumns() != _right.NumColumns())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::sizeMismatch, "Matrix dimensions are not the same.");
+        }
+    }
+
+    //
+    // Helper functions
+    //
+
+    template <typename ElementType>
+    RepeatedVectorOperand<ElementType, VectorOrientation::row> RepeatRow(ConstVectorReference<ElementType, VectorOrientation::row> vector, size_t numRows)
+    {
+        return { vector, numRows };
+    }
+
+    template <typename ElementType>
+    RepeatedVectorOperand<ElementType, VectorOrientation::column> RepeatColumn(ConstVectorReference<ElementType, VectorOrientation::column> vector, size_t numColumns)
+    {
+        return { vector, numColumns };
+    }
+
+    //
+    // Operators
+    //
+
+    template <typename ElementType, MatrixLayout layout>
+    ScaledMatrixExpression<ElementType, MatrixOperand<ElementType, layout>> operator*(double scalar, ConstMatrixReference<ElementType, layout> matrix)
+    {
+        return { static_cast<ElementType>(scalar), matrix };
+    }
+
+    template <typename ElementType, typename ExpressionType>
+    ScaledMatrixExpression<ElementType, ExpressionType> operator*(double scalar, const MatrixExpression<ElementType, ExpressionType>& expression)
+    {
+        return { static_cast<ElementType>(scalar), expression.GetDerived() };
+    }
+
+    template <typename ElementType, MatrixLayout layoutA, MatrixLayout layoutB>
+    SumMatrixExpression<ElementType, MatrixOperand<ElementType, layoutA>, MatrixOperand<ElementType, layoutB>> operator+(ConstMatrixReference<ElementType, layoutA> A, ConstMatrixReference<ElementType, layoutB> B)
+    {
+        return { A, B };
+    }
+
+    template <typename ElementType, MatrixLayout layout, typename ExpressionType>
+    SumMatrixExpression<ElementType, MatrixOperand<ElementType, layout>, ExpressionType> operator+(ConstMatrixReference<ElementType, layout> A, const MatrixExpression<ElementType, ExpressionType>& B)
+    {
+        return { A, B.GetDerived() };
+    }
+
+    template <typename ElementType, typename ExpressionType, MatrixLayout layout>
+    SumMatrixExpression<ElementType, ExpressionType, MatrixOperand<ElementType, layout>> operator+(const MatrixExpression<ElementType, ExpressionType>& A, ConstMatrixReference<ElementType, layout> B)
+    {
+        return { A.GetDerived(), B };
+    }
+
+    template <typename ElementType, typename LeftExpressionType, typename RightExpressionType>
+    SumMatrixExpression<ElementType, LeftExpressionType, RightExpressionType> operator+(const MatrixExpression<ElementType, LeftExpressionType>& A, const MatrixExpression<ElementType, RightExpressionType>& B)
+    {
+        return { A.GetDerived(), B.GetDerived() };
+    }
+
+    template <typename ElementType, MatrixLayout layoutA, MatrixLayout layoutB>
+    auto operator-(ConstMatrixReference<ElementType, layoutA> A, ConstMatrixReference<ElementType, layoutB> B)
+    {
+        return A + (-1.0) * B;
+    }
+
+    template <typename ElementType, MatrixLayout layout, typename ExpressionType>
+    auto operator-(ConstMatrixReference<ElementType, layout> A, const MatrixExpression<ElementType, ExpressionType>& B)
+    {
+        return A + (-1.0) * B;
+    }
+
+    template <typename ElementType, typename ExpressionType, MatrixLayout layout>
+    auto operator-(const MatrixExpression<ElementType, ExpressionType>& A, ConstMatrixReference<ElementType, layout> B)
+    {
+        return A + (-1.0) * B;
+    }
+
+    template <typename ElementType, typename LeftExpressionType, typename RightExpressionType>
+    auto operator-(const MatrixExpression<ElementType, LeftExpressionType>& A, const MatrixExpression<ElementType, RightExpressionType>& B)
+    {
+        return A + (-1.0) * B;
+    }
+}
+}
@@ -0,0 +1,39 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     MatrixMultiplyKernel.tcc (math)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "MatrixMultiplyImplementation.h"
+#include "SimdTraits.h"
+
+namespace ell
+{
+namespace math
+{
+    // float and double are specialized in VectorKernels.cpp, where the kernel is chosen at runtime
+    template <typename ElementType>
+    using PortableMatrixMultiplyImplementation = MatrixMultiplyImplementation<ElementType, SimdTraits<ElementType>, 4, 4 / SimdTraits<ElementType>::width>;
+
+    template <typename ElementType>
+    void MatrixMultiplyKernel<ElementType>::Multiply(size_t m, size_t n, size_t k, ElementType s, const ElementType* pA, size_t aRowIncrement, size_t aColumnIncrement, const ElementType* pB, size_t bRowIncrement, size_t bColumnIncrement, ElementType t, ElementType* pC, size_t cRowIncrement, size_t cColumnIncrement)
+    {
+        MultiplyBatched(1, m, n, k, s, pA, 0, aRowIncrement, aColumnIncrement, pB, 0, bRowIncrement, bColumnIncrement, t, pC, 0, cRowIncrement, cColumnIncrement);
+    }
+
+    template <typename ElementType>
+    void MatrixMultiplyKernel<ElementType>::MultiplyBatched(size_t batchCount, size_t m, size_t n, size_t k, ElementType s, const ElementType* pA, size_t aBatchIncrement, size_t aRowIncrement, size_t aColumnIncrement, const ElementType* pB, size_t bBatchIncrement, size_t bRowIncrement, size_t bColumnIncrement, ElementType t, ElementType* pC, size_t cBatchIncrement, size_t cRowIncrement, size_t cColumnIncrement)
+    {
+        PortableMatrixMultiplyImplementation<ElementType>::MultiplyBatched(batchCount, m, n, k, s, pA, aBatchIncrement, aRowIncrement, aColumnIncrement, pB, bBatchIncrement, bRowIncrement, bColumnIncrement, t, pC, cBatchIncrement, cRowIncrement, cColumnIncrement);
+    }
+
+    template <typename ElementType>
+    std::string MatrixMultiplyKernel<ElementType>::GetKernelName()
+    {
+        using Implementation = PortableMatrixMultiplyImplementation<ElementType>;
+        return "scalar 4x" + std::to_string(Implementation::microTileColumns);
+    }
+}
+}
@@ -10,10 +10,26 @@
 #include "Debug.h"
 #include "Exception.h"
 
+// stl
+#include <algorithm>
+#include <vector>
+
 namespace ell
 {
 namespace math
 {
+    // multiplications with fewer multiply-adds than this always run on the calling thread
+    constexpr size_t c_minParallelMultiplyOperations = 1 << 16;
+
+    // the minimal number of rows (or columns) in an output tile that runs as a separate task
+    constexpr size_t c_minParallelTileSize = 16;
+
+    // the number of elements of a row of a 16 bit matrix that are converted to float together, so that they stay in L1
+    constexpr size_t c_reducedPrecisionChunkSize = 1024;
+
+    // the depth of the blocks over which a quantized matrix-vector product accumulates in 32 bits, well below the 65793 element limit of QuantizedKernels::Dot
+    constexpr size_t c_quantizedBlockDepth = 4096;
+
     //
     // CommonOperations
     //
@@ -21,7 +37,14 @@ namespace math
     template <typename ElementType, VectorOrientation orientation>
     void CommonOperations::Add(ElementType s, VectorReference<ElementType, orientation> v)
     {
-        v += s;
+        if (v.GetIncrement() == 1)
+        {
+            VectorKernels<ElementType>::Add(s, v.GetDataPointer(), v.Size());
+        }
+        else
+        {
+            v += s;
+        }
     }
 
     template <typename ElementType, MatrixLayout layout>
@@ -34,6 +57,348 @@ namespace math
         }
     }
 
+    template <typename ElementType, MatrixLayout layout>
+    void CommonOperations::Multiply(ElementType s, ConstSparseMatrixReference<ElementType, layout> A, ConstVectorReference<ElementType, VectorOrientation::column> v, ElementType t, VectorReference<ElementType, VectorOrientation::column> u)
+    {
+        if (A.NumColumns() != v.Size() || A.NumRows() != u.Size())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Incompatible matrix and vectors sizes.");
+        }
+
+        auto pOffsets = A.GetOffsetsPointer();
+        auto pIndices = A.GetIndicesPointer();
+        auto pValues = A.GetValuesPointer();
+
+        if (layout == MatrixLayout::rowMajor)
+        {
+            ForEachOutputTile(A.NumRows(), 1, A.NumNonzeros(), [&](size_t firstRow, size_t numRows, size_t, size_t) {
+                for (size_t i = firstRow; i < firstRow + numRows; ++i)
+                {
+                    ElementType sum = 0;
+                    for (auto position = pOffsets[i]; position < pOffsets[i + 1]; ++position)
+                    {
+                        sum += pValues[position] * v[pIndices[position]];
+                    }
+                    u[i] = s * sum + t * u[i];
+                }
+            });
+        }
+        else
+        {
+            // every column adds to arbitrary elements of u, so there is no conflict-free way to split the work
+            u *= t;
+            for (size_t j = 0; j < A.NumColumns(); ++j)
+            {
+                auto sv = s * v[j];
+                if (sv == 0)
+                {
+                    continue;
+                }
+                for (auto position = pOffsets[j]; position < pOffsets[j + 1]; ++position)
+                {
+                    u[pIndices[position]] += pValues[position] * sv;
+                }
+            }
+        }
+    }
+
+    template <typename ElementType, MatrixLayout layoutA, MatrixLayout layoutB, MatrixLayout layoutC>
+    void CommonOperations::Multiply(ElementType s, ConstSparseMatrixReference<ElementType, layoutA> A, ConstMatrixReference<ElementType, layoutB> B, ElementType t, MatrixReference<ElementType, layoutC> C)
+    {
+        if (A.NumColumns() != B.NumRows() || A.NumRows() != C.NumRows() || B.NumColumns() != C.NumColumns())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Incompatible matrix sizes.");
+        }
+
+        auto pOffsets = A.GetOffsetsPointer();
+        auto pIndices = A.GetIndicesPointer();
+        auto pValues = A.GetValuesPointer();
+        auto numOperations = A.NumNonzeros() * B.NumColumns();
+
+        if (layoutA == MatrixLayout::rowMajor)
+        {
+            // each row of C is a combination of the rows of B selected by the nonzeros in the same row of A
+            ForEachOutputTile(C.NumRows(), C.NumColumns(), numOperations, [&](size_t firstRow, size_t numRows, size_t firstColumn, size_t numColumns) {
+                for (size_t i = firstRow; i < firstRow + numRows; ++i)
+                {
+                    auto cRow = C.GetRow(i).GetSubVector(firstColumn, numColumns);
+                    cRow *= t;
+                    for (auto position = pOffsets[i]; position < pOffsets[i + 1]; ++position)
+                    {
+                        auto bRow = B.GetRow(pIndices[position]).GetSubVector(firstColumn, numColumns);
+                        auto sa = s * pValues[position];
+                        if (bRow.GetIncrement() == 1 && cRow.GetIncrement() == 1)
+                        {
+                            VectorKernels<ElementType>::Add(sa, bRow.GetDataPointer(), cRow.GetDataPointer(), numColumns);
+                        }
+                        else
+                        {
+                            for (size_t j = 0; j < numColumns; ++j)
+                            {
+                                cRow[j] += sa * bRow[j];
+                            }
+                        }
+                    }
+                }
+            });
+        }
+        else
+        {
+            // each column of A scatters into arbitrary rows of C, so the output is only split by columns (the single "row" tile spans all of C)
+            ForEachOutputTile(1, C.NumColumns(), numOperations, [&](size_t, size_t, size_t firstColumn, size_t numColumns) {
+                for (size_t j = firstColumn; j < firstColumn + numColumns; ++j)
+                {
+                    auto cColumn = C.GetColumn(j);
+                    cColumn *= t;
+                    for (size_t k = 0; k < A.NumColumns(); ++k)
+                    {
+                        auto sb = s * B(k, j);
+                        if (sb == 0)
+                        {
+                            continue;
+                        }
+                        for (auto position = pOffsets[k]; position < pOffsets[k + 1]; ++position)
+                        {
+                            cColumn[pIndices[position]] += pValues[position] * sb;
+                        }
+                    }
+                }
+            });
+        }
+    }
+
+    template <typename TileFunctionType>
+    void CommonOperations::ForEachOutputTile(size_t numRows, size_t numColumns, size_t numOperations, TileFunctionType tileFunction)
+    {
+        auto numThreads = GetNumThreads();
+        if (numThreads <= 1 || numOperations < c_minParallelMultiplyOperations)
+        {
+            tileFunction(0, numRows, 0, numColumns);
+            return;
+        }
+
+        // split the rows first, and split the columns only if there are too few rows to keep every thread busy
+        auto numRowTiles = std::max(std::min(numThreads, numRows / c_minParallelTileSize), static_cast<size_t>(1));
+        auto numColumnTiles = std::max(std::min((numThreads + numRowTiles - 1) / numRowTiles, numColumns / c_minParallelTileSize), static_cast<size_t>(1));
+        auto rowTileSize = (numRows + numRowTiles - 1) / numRowTiles;
+        auto columnTileSize = (numColumns + numColumnTiles - 1) / numColumnTiles;
+
+        _threadPool->ParallelFor(numRowTiles * numColumnTiles, [&](size_t index) {
+            auto firstRow = (index / numColumnTiles) * rowTileSize;
+            auto firstColumn = (index % numColumnTiles) * columnTileSize;
+            if (firstRow < numRows && firstColumn < numColumns)
+            {
+                tileFunction(firstRow, std::min(rowTileSize, numRows - firstRow), firstColumn, std::min(columnTileSize, numColumns - firstColumn));
+            }
+        });
+    }
+
+    template <typename ElementType, MatrixLayout layoutA, MatrixLayout layoutB, MatrixLayout layoutC>
+    void CommonOperations::MultiplyBatched(size_t batchCount, ElementType s, ConstMatrixReference<ElementType, layoutA> A, size_t aBatchIncrement, ConstMatrixReference<ElementType, layoutB> B, size_t bBatchIncrement, ElementType t, MatrixReference<ElementType, layoutC> C, size_t cBatchIncrement)
+    {
+        if (A.NumColumns() != B.NumRows() || A.NumRows() != C.NumRows() || B.NumColumns() != C.NumColumns())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Incompatible matrix sizes.");
+        }
+        if (batchCount > 1 && cBatchIncrement == 0)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "The matrices C of a batch must not overlap.");
+        }
+
+        auto aRowIncrement = layoutA == MatrixLayout::rowMajor ? A.GetIncrement() : 1;
+        auto aColumnIncrement = layoutA == MatrixLayout::rowMajor ? 1 : A.GetIncrement();
+        auto bRowIncrement = layoutB == MatrixLayout::rowMajor ? B.GetIncrement() : 1;
+        auto bColumnIncrement = layoutB == MatrixLayout::rowMajor ? 1 : B.GetIncrement();
+        auto cRowIncrement = layoutC == MatrixLayout::rowMajor ? C.GetIncrement() : 1;
+        auto cColumnIncrement = layoutC == MatrixLayout::rowMajor ? 1 : C.GetIncrement();
+
+        auto numThreads = GetNumThreads();
+        auto numOperations = batchCount * A.NumRows() * A.NumColumns() * B.NumColumns();
+        if (batchCount < numThreads && numOperations >= c_minParallelMultiplyOperations)
+        {
+            // too few products to keep every thread busy, so each product is split into tiles instead
+            for (size_t b = 0; b < batchCount; ++b)
+            {
+                ForEachOutputTile(C.NumRows(), C.NumColumns(), numOperations / batchCount, [&](size_t firstRow, size_t numRows, size_t firstColumn, size_t numColumns) {
+                    MatrixMultiplyKernel<ElementType>::Multiply(numRows, numColumns, A.NumColumns(), s,
+                        A.GetDataPointer() + b * aBatchIncrement + firstRow * aRowIncrement, aRowIncrement, aColumnIncrement,
+                        B.GetDataPointer() + b * bBatchIncrement + firstColumn * bColumnIncrement, bRowIncrement, bColumnIncrement, t,
+                        C.GetDataPointer() + b * cBatchIncrement + firstRow * cRowIncrement + firstColumn * cColumnIncrement, cRowIncrement, cColumnIncrement);
+                });
+            }
+            return;
+        }
+
+        auto multiplyBatch = [&](size_t firstProduct, size_t numProducts) {
+            MatrixMultiplyKernel<ElementType>::MultiplyBatched(numProducts, A.NumRows(), B.NumColumns(), A.NumColumns(), s,
+                A.GetDataPointer() + firstProduct * aBatchIncrement, aBatchIncrement, aRowIncrement, aColumnIncrement,
+                B.GetDataPointer() + firstProduct * bBatchIncrement, bBatchIncrement, bRowIncrement, bColumnIncrement, t,
+                C.GetDataPointer() + firstProduct * cBatchIncrement, cBatchIncrement, cRowIncrement, cColumnIncrement);
+        };
+
+        if (numThreads <= 1 || numOperations < c_minParallelMultiplyOperations)
+        {
+            multiplyBatch(0, batchCount);
+            return;
+        }
+
+        // each thread multiplies a contiguous range of the batch
+        auto batchSize = (batchCount + numThreads - 1) / numThreads;
+        _threadPool->ParallelFor(numThreads, [&](size_t index) {
+            auto firstProduct = index * batchSize;
+            if (firstProduct < batchCount)
+            {
+                multiplyBatch(firstProduct, std::min(batchSize, batchCount - firstProduct));
+            }
+        });
+    }
+
+    template <MatrixLayout layout>
+    void CommonOperations::Multiply(float s, ConstMatrixReference<Float16, layout> A, ConstVectorReference<float, VectorOrientation::column> v, float t, VectorReference<float, VectorOrientation::column> u)
+    {
+        MultiplyReducedPrecision(s, A, v, t, u);
+    }
+
+    template <MatrixLayout layout>
+    void CommonOperations::Multiply(float s, ConstMatrixReference<BFloat16, layout> A, ConstVectorReference<float, VectorOrientation::column> v, float t, VectorReference<float, VectorOrientation::column> u)
+    {
+        MultiplyReducedPrecision(s, A, v, t, u);
+    }
+
+    template <MatrixLayout layoutA, MatrixLayout layoutB, MatrixLayout layoutC>
+    void CommonOperations::Multiply(float s, ConstMatrixReference<Float16, layoutA> A, ConstMatrixReference<float, layoutB> B, float t, MatrixReference<float, layoutC> C)
+    {
+        MultiplyReducedPrecision(s, A, B, t, C);
+    }
+
+    template <MatrixLayout layoutA, MatrixLayout layoutB, MatrixLayout layoutC>
+    void CommonOperations::Multiply(float s, ConstMatrixReference<BFloat16, layoutA> A, ConstMatrixReference<float, layoutB> B, float t, MatrixReference<float, layoutC> C)
+    {
+        MultiplyReducedPrecision(s, A, B, t, C);
+    }
+
+    template <MatrixLayout layout>
+    void CommonOperations::Multiply(float s, const QuantizedWeightMatrix& A, const QuantizedActivationMatrix& B, float t, MatrixReference<float, layout> C)
+    {
+        if (A.NumColumns() != B.NumRows() || A.NumRows() != C.NumRows() || B.NumColumns() != C.NumColumns())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Incompatible matrix sizes.");
+        }
+
+        auto depth = A.NumColumns();
+        ForEachOutputTile(C.NumRows(), C.NumColumns(), A.NumRows() * A.NumColumns() * B.NumColumns(), [&](size_t firstRow, size_t numRows, size_t firstColumn, size_t numColumns) {
+            std::vector<int64_t> products(numRows * numColumns, 0);
+            QuantizedKernels::Multiply(numRows, numColumns, depth, A.GetMajorVectorPointer(firstRow), depth, B.GetMajorVectorPointer(firstColumn), depth, products.data(), numColumns);
+
+            // the terms of GetQuantizedProduct that depend only on the column are computed once per column
+            std::vector<int64_t> bZeroPoints(numColumns);
+            std::vector<int64_t> bCorrections(numColumns);
+            std::vector<float> bScales(numColumns);
+            for (size_t j = 0; j < numColumns; ++j)
+            {
+                auto bParameters = B.GetParameters(firstColumn + j);
+                bZeroPoints[j] = bParameters.zeroPoint;
+                bCorrections[j] = B.GetSum(firstColumn + j) - static_cast<int64_t>(depth) * bParameters.zeroPoint;
+                bScales[j] = bParameters.scale;
+            }
+
+            for (size_t i = 0; i < numRows; ++i)
+            {
+                auto aParameters = A.GetParameters(firstRow + i);
+                auto aSum = A.GetSum(firstRow + i);
+                auto pProducts = products.data() + i * numColumns;
+                for (size_t j = 0; j < numColumns; ++j)
+                {
+                    auto centeredProduct = pProducts[j] - bZeroPoints[j] * aSum - aParameters.zeroPoint * bCorrections[j];
+                    auto& c = C(firstRow + i, firstColumn + j);
+                    c = s * aParameters.scale * bScales[j] * static_cast<float>(centeredProduct) + t * c;
+                }
+            }
+        });
+    }
+
+    inline float CommonOperations::GetQuantizedProduct(int64_t product, const QuantizedWeightMatrix& A, size_t row, const QuantizedActivationMatrix& B, size_t column)
+    {
+        // sum_k (a_k - za) * (b_k - zb) = sum_k a_k * b_k - zb * sum_k a_k - za * sum_k b_k + depth * za * zb
+        auto aParameters = A.GetParameters(row);
+        auto bParameters = B.GetParameters(column);
+        auto depth = static_cast<int64_t>(A.NumColumns());
+        auto centeredProduct = product - static_cast<int64_t>(bParameters.zeroPoint) * A.GetSum(row) - static_cast<int64_t>(aParameters.zeroPoint) * B.GetSum(column) + depth * aParameters.zeroPoint * bParameters.zeroPoint;
+        return aParameters.scale * bParameters.scale * static_cast<float>(centeredProduct);
+    }
+
+    template <typename StorageType, MatrixLayout layout>
+    void CommonOperations::MultiplyReducedPrecision(float s, ConstMatrixReference<StorageType, layout> A, ConstVectorReference<float, VectorOrientation::column> v, float t, VectorReference<float, VectorOrientation::column> u)
+    {
+        if (A.NumColumns() != v.Size() || A.NumRows() != u.Size())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Incompatible matrix and vectors sizes.");
+        }
+
+        // the dot products need v to be contiguous
+        AlignedStorage<float> vCopy;
+        const float* pV = v.GetDataPointer();
+        if (v.GetIncrement() != 1)
+        {
+            vCopy.resize(v.Size());
+            for (size_t j = 0; j < v.Size(); ++j)
+            {
+                vCopy[j] = v[j];
+            }
+            pV = vCopy.data();
+        }
+
+        ForEachOutputTile(A.NumRows(), 1, A.NumRows() * A.NumColumns(), [&](size_t firstRow, size_t numRows, size_t, size_t) {
+            float chunk[c_reducedPrecisionChunkSize];
+            for (size_t i = firstRow; i < firstRow + numRows; ++i)
+            {
+                auto row = A.GetRow(i);
+                float sum = 0;
+                for (size_t j = 0; j < row.Size(); j += c_reducedPrecisionChunkSize)
+                {
+                    auto chunkSize = std::min(c_reducedPrecisionChunkSize, row.Size() - j);
+                    if (row.GetIncrement() == 1)
+                    {
+                        ConvertElements(row.GetDataPointer() + j, chunk, chunkSize);
+                    }
+                    else
+                    {
+                        for (size_t q = 0; q < chunkSize; ++q)
+                        {
+                            chunk[q] = row[j + q];
+                        }
+                    }
+                    sum += VectorKernels<float>::Dot(chunk, pV + j, chunkSize);
+                }
+                u[i] = s * sum + t * u[i];
+            }
+        });
+    }
+
+    template <typename StorageType, MatrixLayout layoutA, MatrixLayout layoutB, MatrixLayout layoutC>
+    void CommonOperations::MultiplyReducedPrecision(float s, ConstMatrixReference<StorageType, layoutA> A, ConstMatrixReference<float, layoutB> B, float t, MatrixReference<float, layoutC> C)
+    {
+        if (A.NumColumns() != B.NumRows() || A.NumRows() != C.NumRows() || B.NumColumns() != C.NumColumns())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Incompatible matrix sizes.");
+        }
+
+        // the kernel converts A to float while it packs it, so A is read once and never copied in full
+        auto aRowIncrement = layoutA == MatrixLayout::rowMajor ? A.GetIncrement() : 1;
+        auto aColumnIncrement = layoutA == MatrixLayout::rowMajor ? 1 : A.GetIncrement();
+        auto bRowIncrement = layoutB == MatrixLayout::rowMajor ? B.GetIncrement() : 1;
+        auto bColumnIncrement = layoutB == MatrixLayout::rowMajor ? 1 : B.GetIncrement();
+        auto cRowIncrement = layoutC == MatrixLayout::rowMajor ? C.GetIncrement() : 1;
+        auto cColumnIncrement = layoutC == MatrixLayout::rowMajor ? 1 : C.GetIncrement();
+
+        ForEachOutputTile(C.NumRows(), C.NumColumns(), A.NumRows() * A.NumColumns() * B.NumColumns(), [&](size_t firstRow, size_t numRows, size_t firstColumn, size_t numColumns) {
+            MatrixMultiplyKernel<float>::Multiply(numRows, numColumns, A.NumColumns(), s,
+                A.GetDataPointer() + firstRow * aRowIncrement, aRowIncrement, aColumnIncrement,
+                B.GetDataPointer() + firstColumn * bColumnIncrement, bRowIncrement, bColumnIncrement, t,
+                C.GetDataPointer() + firstRow * cRowIncrement + firstColumn * cColumnIncrement, cRowIncrement, cColumnIncrement);
+        });
+    }
+
     //
     // DerivedOperations
     //
@@ -76,6 +441,10 @@ namespace math
         {
             DerivedClass::Multiply(s, v);
         }
+        else if (v.GetIncrement() == 1)
+        {
+            VectorKernels<ElementType>::MultiplyAdd(s, b, v.GetDataPointer(), v.Size());
+        }
         else
         {
             v.Transform([s, b](ElementType x) { return (s*x) + b; });
@@ -106,6 +475,12 @@ namespace math
     {
         DEBUG_THROW(u.Size() != v.Size() || u.Size() != t.Size(), utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Incompatible vector sizes."));
 
+        if (u.GetIncrement() == 1 && v.GetIncrement() == 1 && t.GetIncrement() == 1)
+        {
+            VectorKernels<ElementType>::ElementWiseMultiply(u.GetDataPointer(), v.GetDataPointer(), t.GetDataPointer(), t.Size());
+            return;
+        }
+
         const ElementType* uData = u.GetDataPointer();
         const ElementType* vData = v.GetDataPointer();
 
@@ -126,9 +501,20 @@ namespace math
     {
         DEBUG_THROW(A.NumRows() != B.NumRows() || A.NumColumns() != B.NumColumns() || B.NumRows() != C.NumRows() || B.NumColumns() != C.NumColumns(), utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Incompatible matrix sizes."));
 
-        for (size_t i = 0; i < A.NumRows(); ++i)
+        if (layoutA == layoutB)
+        {
+            // the rows (or columns) of all three matrices are contiguous
+            for (size_t i = 0; i < A.NumIntervals(); ++i)
+            {
+                ElementWiseMultiply(A.GetMajorVector(i), B.GetMajorVector(i), C.GetMajorVector(i));
+            }
+        }
+        else
         {
-            ElementWiseMultiply(A.GetRow(i), B.GetRow(i), C.GetRow(i));
+            for (size_t i = 0; i < A.NumRows(); ++i)
+            {
+                ElementWiseMultiply(A.GetRow(i), B.GetRow(i), C.GetRow(i));
+            }
         }
     }
 
@@ -144,10 +530,21 @@ namespace math
             throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Incompatible result size.");
         }
 
-        math::RowVector<ElementType> ones(M.NumRows());
-        ones.Fill(1.0);
-
-        DerivedOperations::Multiply(static_cast<ElementType>(1), ones, M, static_cast<ElementType>(0), u);
+        if (layout == MatrixLayout::columnMajor)
+        {
+            for (size_t j = 0; j < M.NumColumns(); ++j)
+            {
+                u[j] = VectorKernels<ElementType>::Sum(M.GetColumn(j).GetDataPointer(), M.NumRows());
+            }
+        }
+        else
+        {
+            u.Reset();
+            for (size_t i = 0; i < M.NumRows(); ++i)
+            {
+                Add(static_cast<ElementType>(1), M.GetRow(i), u);
+            }
+        }
     }
 
     template <typename ElementType, VectorOrientation orientation>
@@ -158,6 +555,12 @@ namespace math
             throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "vectors u and v are not the same size.");
         }
 
+        if (u.GetIncrement() == 1 && v.GetIncrement() == 1)
+        {
+            VectorKernels<ElementType>::Add(s, v.GetDataPointer(), u.GetDataPointer(), u.Size());
+            return;
+        }
+
         ElementType* uData = u.GetDataPointer();
         const ElementType* vData = v.GetDataPointer();
         const ElementType* end = u.GetDataPointer() + u.GetIncrement() * u.Size();
@@ -213,11 +616,13 @@ namespace math
             throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Incompatible matrix and vectors sizes.");
         }
 
-        for (size_t i = 0; i < M.NumRows(); ++i)
-        {
-            auto row = M.GetRow(i);
-            u[i] = s * Dot(row, v) + t * u[i];
-        }
+        ForEachOutputTile(M.NumRows(), 1, M.NumRows() * M.NumColumns(), [&](size_t firstRow, size_t numRows, size_t, size_t) {
+            for (size_t i = firstRow; i < firstRow + numRows; ++i)
+            {
+                auto row = M.GetRow(i);
+                u[i] = s * Dot(row, v) + t * u[i];
+            }
+        });
     }
 
     template <typename ElementType, MatrixLayout layoutA, MatrixLayout layoutB>
@@ -228,15 +633,20 @@ namespace math
             throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Incompatible matrix sizes.");
         }
 
-        for (size_t i = 0; i < A.NumRows(); ++i)
-        {
-            for (size_t j = 0; j < B.NumColumns(); ++j)
-            {
-                auto row = A.GetRow(i);
-                auto column = B.GetColumn(j);
-                C(i, j) = s * Dot(row, column) + t * C(i, j);
-            }
-        }
+        // the kernel addresses each matrix through its row and column increments, so layouts can be mixed freely
+        auto aRowIncrement = layoutA == MatrixLayout::rowMajor ? A.GetIncrement() : 1;
+        auto aColumnIncrement = layoutA == MatrixLayout::rowMajor ? 1 : A.GetIncrement();
+        auto bRowIncrement = layoutB == MatrixLayout::rowMajor ? B.GetIncrement() : 1;
+        auto bColumnIncrement = layoutB == MatrixLayout::rowMajor ? 1 : B.GetIncrement();
+        auto cRowIncrement = layoutA == MatrixLayout::rowMajor ? C.GetIncrement() : 1;
+        auto cColumnIncrement = layoutA == MatrixLayout::rowMajor ? 1 : C.GetIncrement();
+
+        ForEachOutputTile(C.NumRows(), C.NumColumns(), A.NumRows() * A.NumColumns() * B.NumColumns(), [&](size_t firstRow, size_t numRows, size_t firstColumn, size_t numColumns) {
+            MatrixMultiplyKernel<ElementType>::Multiply(numRows, numColumns, A.NumColumns(), s,
+                A.GetDataPointer() + firstRow * aRowIncrement, aRowIncrement, aColumnIncrement,
+                B.GetDataPointer() + firstColumn * bColumnIncrement, bRowIncrement, bColumnIncrement, t,
+                C.GetDataPointer() + firstRow * cRowIncrement + firstColumn * cColumnIncrement, cRowIncrement, cColumnIncrement);
+        });
     }
 
 #ifdef USE_BLAS
@@ -314,7 +724,10 @@ namespace math
                 throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "layout not supported");
         }
 
-        Blas::Gemv(order, CBLAS_TRANSPOSE::CblasNoTrans, static_cast<int>(M.NumRows()), static_cast<int>(M.NumColumns()), s, M.GetDataPointer(), static_cast<int>(M.GetIncrement()), v.GetDataPointer(), static_cast<int>(v.GetIncrement()), t, u.GetDataPointer(), static_cast<int>(u.GetIncrement()));
+        auto rowIncrement = layout == MatrixLayout::rowMajor ? M.GetIncrement() : 1;
+        ForEachOutputTile(M.NumRows(), 1, M.NumRows() * M.NumColumns(), [&](size_t firstRow, size_t numRows, size_t, size_t) {
+            Blas::Gemv(order, CBLAS_TRANSPOSE::CblasNoTrans, static_cast<int>(numRows), static_cast<int>(M.NumColumns()), s, M.GetDataPointer() + firstRow * rowIncrement, static_cast<int>(M.GetIncrement()), v.GetDataPointer(), static_cast<int>(v.GetIncrement()), t, u.GetDataPointer() + firstRow * u.GetIncrement(), static_cast<int>(u.GetIncrement()));
+        });
     }
 
     template <typename ElementType, MatrixLayout layout>
@@ -351,9 +764,16 @@ namespace math
             transposeB = CBLAS_TRANSPOSE::CblasTrans;
         }
 
-        Blas::Gemm(order, CBLAS_TRANSPOSE::CblasNoTrans, transposeB, static_cast<int>(A.NumRows()), static_cast<int>(B.NumColumns()), static_cast<int>(A.NumColumns()), s,
-            A.GetDataPointer(), static_cast<int>(A.GetIncrement()), B.GetDataPointer(), static_cast<int>(B.GetIncrement()), t,
-            C.GetDataPointer(), static_cast<int>(C.GetIncrement()));
+        auto aRowIncrement = layoutA == MatrixLayout::rowMajor ? A.GetIncrement() : 1;
+        auto bColumnIncrement = layoutB == MatrixLayout::rowMajor ? 1 : B.GetIncrement();
+        auto cRowIncrement = layoutA == MatrixLayout::rowMajor ? C.GetIncrement() : 1;
+        auto cColumnIncrement = layoutA == MatrixLayout::rowMajor ? 1 : C.GetIncrement();
+
+        ForEachOutputTile(C.NumRows(), C.NumColumns(), A.NumRows() * A.NumColumns() * B.NumColumns(), [&](size_t firstRow, size_t numRows, size_t firstColumn, size_t numColumns) {
+            Blas::Gemm(order, CBLAS_TRANSPOSE::CblasNoTrans, transposeB, static_cast<int>(numRows), static_cast<int>(numColumns), static_cast<int>(A.NumColumns()), s,
+                A.GetDataPointer() + firstRow * aRowIncrement, static_cast<int>(A.GetIncrement()), B.GetDataPointer() + firstColumn * bColumnIncrement, static_cast<int>(B.GetIncrement()), t,
+                C.GetDataPointer() + firstRow * cRowIncrement + firstColumn * cColumnIncrement, static_cast<int>(C.GetIncrement()));
+        });
     }
 #endif
 }
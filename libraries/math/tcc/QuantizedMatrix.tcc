@@ -0,0 +1,130 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     QuantizedMatrix.tcc (math)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// utilities
+#include "Debug.h"
+#include "Exception.h"
+
+// stl
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ell
+{
+namespace math
+{
+    template <typename QuantizedType>
+    QuantizationParameters GetQuantizationParameters(float minValue, float maxValue)
+    {
+        minValue = std::min(minValue, 0.0f);
+        maxValue = std::max(maxValue, 0.0f);
+        auto quantizedMin = static_cast<int32_t>(std::numeric_limits<QuantizedType>::min());
+        auto quantizedMax = static_cast<int32_t>(std::numeric_limits<QuantizedType>::max());
+
+        auto scale = (maxValue - minValue) / static_cast<float>(quantizedMax - quantizedMin);
+        if (scale == 0)
+        {
+            return { 1.0f, 0 };
+        }
+        auto zeroPoint = static_cast<int32_t>(std::round(quantizedMin - minValue / scale));
+        return { scale, std::min(std::max(zeroPoint, quantizedMin), quantizedMax) };
+    }
+
+    template <typename QuantizedType>
+    QuantizedType Quantize(float value, QuantizationParameters parameters)
+    {
+        auto quantized = static_cast<int32_t>(std::round(value / parameters.scale)) + parameters.zeroPoint;
+        quantized = std::min(std::max(quantized, static_cast<int32_t>(std::numeric_limits<QuantizedType>::min())), static_cast<int32_t>(std::numeric_limits<QuantizedType>::max()));
+        return static_cast<QuantizedType>(quantized);
+    }
+
+    //
+    // QuantizedMatrix
+    //
+
+    template <typename QuantizedType, MatrixLayout layout>
+    template <MatrixLayout sourceLayout>
+    QuantizedMatrix<QuantizedType, layout>::QuantizedMatrix(ConstMatrixReference<float, sourceLayout> matrix)
+        : _numRows(matrix.NumRows()), _numColumns(matrix.NumColumns()), _data(matrix.NumRows() * matrix.NumColumns()), _parameters(NumIntervals())
+    {
+        auto getElement = [&](size_t intervalIndex, size_t index) { return layout == MatrixLayout::rowMajor ? matrix(intervalIndex, index) : matrix(index, intervalIndex); };
+
+        auto intervalSize = GetIntervalSize();
+        for (size_t i = 0; i < NumIntervals(); ++i)
+        {
+            float minValue = 0;
+            float maxValue = 0;
+            for (size_t j = 0; j < intervalSize; ++j)
+            {
+                minValue = std::min(minValue, getElement(i, j));
+                maxValue = std::max(maxValue, getElement(i, j));
+            }
+
+            _parameters[i] = GetQuantizationParameters<QuantizedType>(minValue, maxValue);
+            for (size_t j = 0; j < intervalSize; ++j)
+            {
+                _data[i * intervalSize + j] = Quantize<QuantizedType>(getElement(i, j), _parameters[i]);
+            }
+        }
+        ComputeSums();
+    }
+
+    template <typename QuantizedType, MatrixLayout layout>
+    QuantizedMatrix<QuantizedType, layout>::QuantizedMatrix(size_t numRows, size_t numColumns, const std::vector<QuantizedType>& data, std::vector<QuantizationParameters> parameters)
+        : _numRows(numRows), _numColumns(numColumns), _data(data.begin(), data.end()), _parameters(std::move(parameters))
+    {
+        if (_data.size() != numRows * numColumns || _parameters.size() != NumIntervals())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::sizeMismatch, "Quantized data or parameters do not match the matrix dimensions.");
+        }
+        ComputeSums();
+    }
+
+    template <typename QuantizedType, MatrixLayout layout>
+    float QuantizedMatrix<QuantizedType, layout>::operator()(size_t rowIndex, size_t columnIndex) const
+    {
+        DEBUG_THROW(rowIndex >= _numRows || columnIndex >= _numColumns, utilities::InputException(utilities::InputExceptionErrors::indexOutOfRange, "(rowIndex, columnIndex) exceeds matrix dimensions."));
+
+        auto intervalIndex = layout == MatrixLayout::rowMajor ? rowIndex : columnIndex;
+        auto index = layout == MatrixLayout::rowMajor ? columnIndex : rowIndex;
+        auto parameters = _parameters[intervalIndex];
+        return parameters.scale * static_cast<float>(static_cast<int32_t>(GetMajorVectorPointer(intervalIndex)[index]) - parameters.zeroPoint);
+    }
+
+    template <typename QuantizedType, MatrixLayout layout>
+    Matrix<float, layout> QuantizedMatrix<QuantizedType, layout>::Dequantize() const
+    {
+        Matrix<float, layout> matrix(_numRows, _numColumns);
+        for (size_t i = 0; i < _numRows; ++i)
+        {
+            for (size_t j = 0; j < _numColumns; ++j)
+            {
+                matrix(i, j) = (*this)(i, j);
+            }
+        }
+        return matrix;
+    }
+
+    template <typename QuantizedType, MatrixLayout layout>
+    void QuantizedMatrix<QuantizedType, layout>::ComputeSums()
+    {
+        _sums.resize(NumIntervals());
+        for (size_t i = 0; i < NumIntervals(); ++i)
+        {
+            auto pInterval = GetMajorVectorPointer(i);
+            int64_t sum = 0;
+            for (size_t j = 0; j < GetIntervalSize(); ++j)
+            {
+                sum += pInterval[j];
+            }
+            _sums[i] = sum;
+        }
+    }
+}
+}
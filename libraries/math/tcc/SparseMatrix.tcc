@@ -0,0 +1,202 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     SparseMatrix.tcc (math)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// utilities
+#include "Debug.h"
+#include "Exception.h"
+
+// stl
+#include <algorithm>
+#include <utility>
+
+namespace ell
+{
+namespace math
+{
+    //
+    // ConstSparseMatrixReference
+    //
+
+    template <typename ElementType, MatrixLayout layout>
+    ConstSparseMatrixReference<ElementType, layout>::ConstSparseMatrixReference(size_t numRows, size_t numColumns, const size_t* pOffsets, const size_t* pIndices, const ElementType* pValues)
+        : _numRows(numRows), _numColumns(numColumns), _pOffsets(pOffsets), _pIndices(pIndices), _pValues(pValues)
+    {
+    }
+
+    template <typename ElementType, MatrixLayout layout>
+    ElementType ConstSparseMatrixReference<ElementType, layout>::operator()(size_t rowIndex, size_t columnIndex) const
+    {
+        DEBUG_THROW(rowIndex >= _numRows || columnIndex >= _numColumns, utilities::InputException(utilities::InputExceptionErrors::indexOutOfRange, "(rowIndex, columnIndex) exceeds matrix dimensions."));
+
+        auto intervalIndex = layout == MatrixLayout::rowMajor ? rowIndex : columnIndex;
+        auto index = layout == MatrixLayout::rowMajor ? columnIndex : rowIndex;
+        auto pBegin = _pIndices + _pOffsets[intervalIndex];
+        auto pEnd = _pIndices + _pOffsets[intervalIndex + 1];
+        auto pFound = std::lower_bound(pBegin, pEnd, index);
+        if (pFound == pEnd || *pFound != index)
+        {
+            return 0;
+        }
+        return _pValues[pFound - _pIndices];
+    }
+
+    template <typename ElementType, MatrixLayout layout>
+    ConstSparseMatrixReference<ElementType, TransposeMatrixLayout<layout>::value> ConstSparseMatrixReference<ElementType, layout>::Transpose() const
+    {
+        return { _numColumns, _numRows, _pOffsets, _pIndices, _pValues };
+    }
+
+    template <typename ElementType, MatrixLayout layout>
+    ConstSparseMatrixReference<ElementType, layout> ConstSparseMatrixReference<ElementType, layout>::GetMajorSubMatrix(size_t firstInterval, size_t numIntervals) const
+    {
+        if (firstInterval + numIntervals > NumIntervals())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::indexOutOfRange, "Interval range exceeds matrix dimensions.");
+        }
+
+        // the offsets are positions in the index and value arrays, so a range of intervals only moves the offsets pointer
+        if (layout == MatrixLayout::rowMajor)
+        {
+            return { numIntervals, _numColumns, _pOffsets + firstInterval, _pIndices, _pValues };
+        }
+        return { _numRows, numIntervals, _pOffsets + firstInterval, _pIndices, _pValues };
+    }
+
+    template <typename ElementType, MatrixLayout layout>
+    Matrix<ElementType, layout> ConstSparseMatrixReference<ElementType, layout>::ToDense() const
+    {
+        Matrix<ElementType, layout> matrix(_numRows, _numColumns);
+        for (size_t i = 0; i < NumIntervals(); ++i)
+        {
+            for (auto position = _pOffsets[i]; position < _pOffsets[i + 1]; ++position)
+            {
+                if (layout == MatrixLayout::rowMajor)
+                {
+                    matrix(i, _pIndices[position]) = _pValues[position];
+                }
+                else
+                {
+                    matrix(_pIndices[position], i) = _pValues[position];
+                }
+            }
+        }
+        return matrix;
+    }
+
+    template <typename ElementType, MatrixLayout layout>
+    std::ostream& operator<<(std::ostream& stream, ConstSparseMatrixReference<ElementType, layout> M)
+    {
+        auto dense = M.ToDense();
+        Print(dense, stream);
+        return stream;
+    }
+
+    //
+    // SparseMatrix
+    //
+
+    template <typename ElementType, MatrixLayout layout>
+    SparseMatrix<ElementType, layout>::SparseMatrix(size_t numRows, size_t numColumns)
+        : ConstSparseMatrixReference<ElementType, layout>(numRows, numColumns, nullptr, nullptr, nullptr), _offsets(this->NumIntervals() + 1, 0)
+    {
+        UpdatePointers();
+    }
+
+    template <typename ElementType, MatrixLayout layout>
+    SparseMatrix<ElementType, layout>::SparseMatrix(size_t numRows, size_t numColumns, std::vector<size_t> offsets, std::vector<size_t> indices, std::vector<ElementType> values)
+        : ConstSparseMatrixReference<ElementType, layout>(numRows, numColumns, nullptr, nullptr, nullptr), _offsets(std::move(offsets)), _indices(std::move(indices)), _values(std::move(values))
+    {
+        auto numIntervals = this->NumIntervals();
+        auto intervalSize = layout == MatrixLayout::rowMajor ? numColumns : numRows;
+        if (_offsets.size() != numIntervals + 1 || _offsets.front() != 0 || _offsets.back() != _indices.size() || _indices.size() != _values.size())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::sizeMismatch, "Sparse matrix offsets, indices and values are inconsistent with each other or with the matrix dimensions.");
+        }
+
+        for (size_t i = 0; i < numIntervals; ++i)
+        {
+            if (_offsets[i] > _offsets[i + 1])
+            {
+                throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Sparse matrix offsets must be nondecreasing.");
+            }
+            for (auto position = _offsets[i]; position < _offsets[i + 1]; ++position)
+            {
+                if (_indices[position] >= intervalSize || (position > _offsets[i] && _indices[position] <= _indices[position - 1]))
+                {
+                    throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Sparse matrix indices must be increasing within each row (or column) and smaller than its size.");
+                }
+            }
+        }
+        UpdatePointers();
+    }
+
+    template <typename ElementType, MatrixLayout layout>
+    SparseMatrix<ElementType, layout>::SparseMatrix(ConstMatrixReference<ElementType, layout> matrix)
+        : ConstSparseMatrixReference<ElementType, layout>(matrix.NumRows(), matrix.NumColumns(), nullptr, nullptr, nullptr)
+    {
+        auto numIntervals = this->NumIntervals();
+        _offsets.reserve(numIntervals + 1);
+        _offsets.push_back(0);
+        for (size_t i = 0; i < numIntervals; ++i)
+        {
+            auto interval = matrix.GetMajorVector(i);
+            for (size_t j = 0; j < interval.Size(); ++j)
+            {
+                if (interval[j] != 0)
+                {
+                    _indices.push_back(j);
+                    _values.push_back(interval[j]);
+                }
+            }
+            _offsets.push_back(_indices.size());
+        }
+        UpdatePointers();
+    }
+
+    template <typename ElementType, MatrixLayout layout>
+    SparseMatrix<ElementType, layout>::SparseMatrix(const SparseMatrix<ElementType, layout>& other)
+        : ConstSparseMatrixReference<ElementType, layout>(other._numRows, other._numColumns, nullptr, nullptr, nullptr), _offsets(other._offsets), _indices(other._indices), _values(other._values)
+    {
+        UpdatePointers();
+    }
+
+    template <typename ElementType, MatrixLayout layout>
+    SparseMatrix<ElementType, layout>::SparseMatrix(SparseMatrix<ElementType, layout>&& other)
+        : ConstSparseMatrixReference<ElementType, layout>(other._numRows, other._numColumns, nullptr, nullptr, nullptr), _offsets(std::move(other._offsets)), _indices(std::move(other._indices)), _values(std::move(other._values))
+    {
+        UpdatePointers();
+    }
+
+    template <typename ElementType, MatrixLayout layout>
+    SparseMatrix<ElementType, layout>& SparseMatrix<ElementType, layout>::operator=(SparseMatrix<ElementType, layout> other)
+    {
+        Swap(other);
+        return *this;
+    }
+
+    template <typename ElementType, MatrixLayout layout>
+    void SparseMatrix<ElementType, layout>::Swap(SparseMatrix<ElementType, layout>& other)
+    {
+        std::swap(_numRows, other._numRows);
+        std::swap(_numColumns, other._numColumns);
+        std::swap(_offsets, other._offsets);
+        std::swap(_indices, other._indices);
+        std::swap(_values, other._values);
+        UpdatePointers();
+        other.UpdatePointers();
+    }
+
+    template <typename ElementType, MatrixLayout layout>
+    void SparseMatrix<ElementType, layout>::UpdatePointers()
+    {
+        _pOffsets = _offsets.data();
+        _pIndices = _indices.data();
+        _pValues = _values.data();
+    }
+}
+}
@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     Transcendental.tcc (math)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "VectorKernels.h"
+
+// stl
+#include <cmath>
+
+namespace ell
+{
+namespace math
+{
+    template <typename ElementType>
+    void Exp(const ElementType* pV, ElementType* pU, size_t size)
+    {
+        if (GetTranscendentalPrecision() == TranscendentalPrecision::fast)
+        {
+            VectorKernels<ElementType>::Exp(pV, pU, size);
+            return;
+        }
+        for (size_t i = 0; i < size; ++i)
+        {
+            pU[i] = static_cast<ElementType>(std::exp(pV[i]));
+        }
+    }
+
+    template <typename ElementType>
+    void Log(const ElementType* pV, ElementType* pU, size_t size)
+    {
+        if (GetTranscendentalPrecision() == TranscendentalPrecision::fast)
+        {
+            VectorKernels<ElementType>::Log(pV, pU, size);
+            return;
+        }
+        for (size_t i = 0; i < size; ++i)
+        {
+            pU[i] = static_cast<ElementType>(std::log(pV[i]));
+        }
+    }
+
+    template <typename ElementType>
+    void Tanh(const ElementType* pV, ElementType* pU, size_t size)
+    {
+        if (GetTranscendentalPrecision() == TranscendentalPrecision::fast)
+        {
+            VectorKernels<ElementType>::Tanh(pV, pU, size);
+            return;
+        }
+        for (size_t i = 0; i < size; ++i)
+        {
+            pU[i] = static_cast<ElementType>(std::tanh(pV[i]));
+        }
+    }
+
+    template <typename ElementType>
+    void Sigmoid(const ElementType* pV, ElementType* pU, size_t size)
+    {
+        if (GetTranscendentalPrecision() == TranscendentalPrecision::fast)
+        {
+            VectorKernels<ElementType>::Sigmoid(pV, pU, size);
+            return;
+        }
+        for (size_t i = 0; i < size; ++i)
+        {
+            // computed in double, and without ever taking exp of a positive number
+            double input = pV[i];
+            if (input >= 0.0)
+            {
+                pU[i] = static_cast<ElementType>(1.0 / (1.0 + std::exp(-input)));
+            }
+            else
+            {
+                double expValue = std::exp(input);
+                pU[i] = static_cast<ElementType>(expValue / (1.0 + expValue));
+            }
+        }
+    }
+}
+}
@@ -0,0 +1,43 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     TransposeKernel.tcc (math)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace ell
+{
+namespace math
+{
+    // blocks with both sides at most this long are transposed directly
+    constexpr size_t c_transposeTileSize = 16;
+
+    template <typename ElementType>
+    void TransposeCopy(size_t numRows, size_t numColumns, const ElementType* pSource, size_t sourceIncrement, ElementType* pTarget, size_t targetIncrement)
+    {
+        if (numRows <= c_transposeTileSize && numColumns <= c_transposeTileSize)
+        {
+            for (size_t i = 0; i < numRows; ++i)
+            {
+                for (size_t j = 0; j < numColumns; ++j)
+                {
+                    pTarget[j * targetIncrement + i] = pSource[i * sourceIncrement + j];
+                }
+            }
+        }
+        else if (numRows >= numColumns)
+        {
+            auto half = numRows / 2;
+            TransposeCopy(half, numColumns, pSource, sourceIncrement, pTarget, targetIncrement);
+            TransposeCopy(numRows - half, numColumns, pSource + half * sourceIncrement, sourceIncrement, pTarget + half, targetIncrement);
+        }
+        else
+        {
+            auto half = numColumns / 2;
+            TransposeCopy(numRows, half, pSource, sourceIncrement, pTarget, targetIncrement);
+            TransposeCopy(numRows, numColumns - half, pSource + half, sourceIncrement, pTarget + half * targetIncrement, targetIncrement);
+        }
+    }
+}
+}
@@ -477,7 +477,7 @@ namespace math
 
     template <typename ElementType, VectorOrientation orientation>
     Vector<ElementType, orientation>::Vector(std::vector<ElementType> data)
-        : VectorReference<ElementType, orientation>(nullptr, data.size(), 1), _data(std::move(data))
+        : VectorReference<ElementType, orientation>(nullptr, data.size(), 1), _data(data.begin(), data.end())
     {
         _pData = _data.data();
     }
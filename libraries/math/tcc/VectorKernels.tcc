@@ -0,0 +1,110 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     VectorKernels.tcc (math)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// stl
+#include <cmath>
+
+namespace ell
+{
+namespace math
+{
+    template <typename ElementType>
+    void VectorKernels<ElementType>::Add(ElementType s, ElementType* pV, size_t size)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            pV[i] += s;
+        }
+    }
+
+    template <typename ElementType>
+    void VectorKernels<ElementType>::Add(ElementType s, const ElementType* pV, ElementType* pU, size_t size)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            pU[i] += s * pV[i];
+        }
+    }
+
+    template <typename ElementType>
+    void VectorKernels<ElementType>::MultiplyAdd(ElementType s, ElementType b, ElementType* pV, size_t size)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            pV[i] = s * pV[i] + b;
+        }
+    }
+
+    template <typename ElementType>
+    void VectorKernels<ElementType>::ElementWiseMultiply(const ElementType* pU, const ElementType* pV, ElementType* pT, size_t size)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            pT[i] = pU[i] * pV[i];
+        }
+    }
+
+    template <typename ElementType>
+    ElementType VectorKernels<ElementType>::Sum(const ElementType* pV, size_t size)
+    {
+        ElementType result = 0;
+        for (size_t i = 0; i < size; ++i)
+        {
+            result += pV[i];
+        }
+        return result;
+    }
+
+    template <typename ElementType>
+    ElementType VectorKernels<ElementType>::Dot(const ElementType* pU, const ElementType* pV, size_t size)
+    {
+        ElementType result = 0;
+        for (size_t i = 0; i < size; ++i)
+        {
+            result += pU[i] * pV[i];
+        }
+        return result;
+    }
+
+    template <typename ElementType>
+    void VectorKernels<ElementType>::Exp(const ElementType* pV, ElementType* pU, size_t size)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            pU[i] = static_cast<ElementType>(std::exp(pV[i]));
+        }
+    }
+
+    template <typename ElementType>
+    void VectorKernels<ElementType>::Log(const ElementType* pV, ElementType* pU, size_t size)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            pU[i] = static_cast<ElementType>(std::log(pV[i]));
+        }
+    }
+
+    template <typename ElementType>
+    void VectorKernels<ElementType>::Tanh(const ElementType* pV, ElementType* pU, size_t size)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            pU[i] = static_cast<ElementType>(std::tanh(pV[i]));
+        }
+    }
+
+    template <typename ElementType>
+    void VectorKernels<ElementType>::Sigmoid(const ElementType* pV, ElementType* pU, size_t size)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            pU[i] = static_cast<ElementType>(1 / (1 + std::exp(-pV[i])));
+        }
+    }
+}
+}
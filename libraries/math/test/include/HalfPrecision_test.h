@@ -0,0 +1,24 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     HalfPrecision_test.h (math_test)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "HalfPrecision.h"
+#include "Matrix.h"
+#include "Operations.h"
+#include "Tensor.h"
+
+using namespace ell;
+
+void TestFloat16Conversion();
+
+void TestBFloat16Conversion();
+
+template <typename StorageType, math::MatrixLayout layoutA, math::MatrixLayout layoutB>
+void TestReducedPrecisionMultiply();
+
+#include "../tcc/HalfPrecision_test.tcc"
@@ -8,6 +8,8 @@
 #pragma once
 
 #include "Matrix.h"
+#include "MatrixExpression.h"
+#include "SparseMatrix.h"
 
 using namespace ell;
 
@@ -20,6 +22,9 @@ void TestMatrix2();
 template <typename ElementType, math::MatrixLayout layout>
 void TestMatrixArchiver();
 
+template <typename ElementType, math::MatrixLayout layout>
+void TestPaddedMatrix();
+
 template <typename ElementType, math::MatrixLayout layout1, math::MatrixLayout layout2>
 void TestMatrixCopy();
 
@@ -35,10 +40,25 @@ void TestContiguousMatrixOperations();
 template <typename ElementType, math::MatrixLayout layout>
 void TestConstMatrixReference();
 
+template <typename ElementType, math::MatrixLayout layoutA, math::MatrixLayout layoutB>
+void TestMatrixExpression();
+
 template <typename ElementType, math::ImplementationType Implementation>
 void TestMatrixMatrixAdd();
 
 template <typename ElementType, math::MatrixLayout layoutA, math::MatrixLayout layoutB, math::ImplementationType Implementation>
 void TestMatrixMatrixMultiply();
 
+template <typename ElementType, math::MatrixLayout layoutA, math::MatrixLayout layoutB, math::ImplementationType Implementation>
+void TestBlockedMatrixMatrixMultiply();
+
+template <typename ElementType, math::MatrixLayout layoutA, math::MatrixLayout layoutB, math::ImplementationType Implementation>
+void TestParallelMatrixMultiply();
+
+template <typename ElementType, math::MatrixLayout layoutA, math::MatrixLayout layoutB>
+void TestBatchedMatrixMultiply();
+
+template <typename ElementType, math::MatrixLayout layoutA, math::MatrixLayout layoutB>
+void TestSparseMatrix();
+
 #include "../tcc/Matrix_test.tcc"
\ No newline at end of file
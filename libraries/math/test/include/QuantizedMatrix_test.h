@@ -0,0 +1,26 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     QuantizedMatrix_test.h (math_test)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "Matrix.h"
+#include "Operations.h"
+#include "QuantizedMatrix.h"
+#include "VectorKernels.h"
+
+using namespace ell;
+
+void TestQuantizedMatrix();
+
+void TestQuantizedKernels();
+
+template <math::MatrixLayout layout>
+void TestQuantizedMatrixMultiply();
+
+void TestQuantizedMatrixMultiplyDepth();
+
+#include "../tcc/QuantizedMatrix_test.tcc"
@@ -42,5 +42,11 @@ void TestTensorVectorMultiplyAdd();
 template<typename ElementType, math::Dimension dimension0, math::Dimension dimension1, math::Dimension dimension2>
 void TestTensorArchiver();
 
+template<typename ElementType, math::Dimension dimension0, math::Dimension dimension1, math::Dimension dimension2>
+void TestChannelBlockedTensor();
+
+template<typename ElementType>
+void TestTransposeCopy();
+
 
 #include "../tcc/Tensor_test.tcc"
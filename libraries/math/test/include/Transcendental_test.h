@@ -0,0 +1,21 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     Transcendental_test.h (math_test)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "Transcendental.h"
+#include "VectorKernels.h"
+
+using namespace ell;
+
+template <typename ElementType>
+void TestTranscendental();
+
+template <typename ElementType>
+void TestTranscendentalPrecision();
+
+#include "../tcc/Transcendental_test.tcc"
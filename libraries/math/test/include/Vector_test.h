@@ -21,6 +21,9 @@ void TestVectorOperations();
 template <typename ElementType>
 void TestElementWiseOperations();
 
+template <typename ElementType>
+void TestVectorKernels();
+
 template <typename ElementType>
 void TestVectorToArray();
 
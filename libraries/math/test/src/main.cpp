@@ -6,9 +6,12 @@
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include "HalfPrecision_test.h"
 #include "Vector_test.h"
 #include "Matrix_test.h"
+#include "QuantizedMatrix_test.h"
 #include "Tensor_test.h"
+#include "Transcendental_test.h"
 
 using namespace ell;
 
@@ -31,6 +34,9 @@ int main()
     TestElementWiseOperations<double>();
     TestElementWiseOperations<float>();
 
+    TestVectorKernels<double>();
+    TestVectorKernels<float>();
+
     TestVectorToArray<double>();
     TestVectorToArray<float>();
 
@@ -70,6 +76,11 @@ int main()
     TestMatrixArchiver<double, math::MatrixLayout::rowMajor>();
     TestMatrixArchiver<double, math::MatrixLayout::columnMajor>();
 
+    TestPaddedMatrix<float, math::MatrixLayout::rowMajor>();
+    TestPaddedMatrix<float, math::MatrixLayout::columnMajor>();
+    TestPaddedMatrix<double, math::MatrixLayout::rowMajor>();
+    TestPaddedMatrix<double, math::MatrixLayout::columnMajor>();
+
     TestMatrixReference<int>();
 
     TestMatrixCopy<float, math::MatrixLayout::rowMajor, math::MatrixLayout::rowMajor>();
@@ -104,6 +115,11 @@ int main()
     TestConstMatrixReference<double, math::MatrixLayout::columnMajor>();
     TestConstMatrixReference<double, math::MatrixLayout::columnMajor>();
 
+    TestMatrixExpression<float, math::MatrixLayout::rowMajor, math::MatrixLayout::rowMajor>();
+    TestMatrixExpression<float, math::MatrixLayout::rowMajor, math::MatrixLayout::columnMajor>();
+    TestMatrixExpression<double, math::MatrixLayout::columnMajor, math::MatrixLayout::rowMajor>();
+    TestMatrixExpression<double, math::MatrixLayout::columnMajor, math::MatrixLayout::columnMajor>();
+
     TestMatrixMatrixAdd<float, math::ImplementationType::native>();
     TestMatrixMatrixAdd<float, math::ImplementationType::openBlas>();
     TestMatrixMatrixAdd<double, math::ImplementationType::native>();
@@ -118,6 +134,64 @@ int main()
     TestMatrixMatrixMultiply<double, math::MatrixLayout::columnMajor, math::MatrixLayout::rowMajor, math::ImplementationType::openBlas>();
     TestMatrixMatrixMultiply<double, math::MatrixLayout::columnMajor, math::MatrixLayout::columnMajor, math::ImplementationType::openBlas>();
 
+    TestBlockedMatrixMatrixMultiply<float, math::MatrixLayout::rowMajor, math::MatrixLayout::rowMajor, math::ImplementationType::native>();
+    TestBlockedMatrixMatrixMultiply<float, math::MatrixLayout::rowMajor, math::MatrixLayout::columnMajor, math::ImplementationType::native>();
+    TestBlockedMatrixMatrixMultiply<float, math::MatrixLayout::columnMajor, math::MatrixLayout::rowMajor, math::ImplementationType::native>();
+    TestBlockedMatrixMatrixMultiply<float, math::MatrixLayout::columnMajor, math::MatrixLayout::columnMajor, math::ImplementationType::native>();
+    TestBlockedMatrixMatrixMultiply<double, math::MatrixLayout::rowMajor, math::MatrixLayout::rowMajor, math::ImplementationType::native>();
+    TestBlockedMatrixMatrixMultiply<double, math::MatrixLayout::rowMajor, math::MatrixLayout::columnMajor, math::ImplementationType::native>();
+    TestBlockedMatrixMatrixMultiply<double, math::MatrixLayout::columnMajor, math::MatrixLayout::rowMajor, math::ImplementationType::native>();
+    TestBlockedMatrixMatrixMultiply<double, math::MatrixLayout::columnMajor, math::MatrixLayout::columnMajor, math::ImplementationType::native>();
+
+    TestParallelMatrixMultiply<float, math::MatrixLayout::rowMajor, math::MatrixLayout::rowMajor, math::ImplementationType::native>();
+    TestParallelMatrixMultiply<float, math::MatrixLayout::columnMajor, math::MatrixLayout::rowMajor, math::ImplementationType::native>();
+    TestParallelMatrixMultiply<double, math::MatrixLayout::rowMajor, math::MatrixLayout::rowMajor, math::ImplementationType::native>();
+    TestParallelMatrixMultiply<double, math::MatrixLayout::columnMajor, math::MatrixLayout::rowMajor, math::ImplementationType::native>();
+    TestParallelMatrixMultiply<float, math::MatrixLayout::rowMajor, math::MatrixLayout::rowMajor, math::ImplementationType::openBlas>();
+    TestParallelMatrixMultiply<float, math::MatrixLayout::columnMajor, math::MatrixLayout::rowMajor, math::ImplementationType::openBlas>();
+    TestParallelMatrixMultiply<double, math::MatrixLayout::rowMajor, math::MatrixLayout::rowMajor, math::ImplementationType::openBlas>();
+    TestParallelMatrixMultiply<double, math::MatrixLayout::columnMajor, math::MatrixLayout::rowMajor, math::ImplementationType::openBlas>();
+
+    TestBatchedMatrixMultiply<float, math::MatrixLayout::rowMajor, math::MatrixLayout::rowMajor>();
+    TestBatchedMatrixMultiply<float, math::MatrixLayout::rowMajor, math::MatrixLayout::columnMajor>();
+    TestBatchedMatrixMultiply<double, math::MatrixLayout::columnMajor, math::MatrixLayout::rowMajor>();
+    TestBatchedMatrixMultiply<double, math::MatrixLayout::columnMajor, math::MatrixLayout::columnMajor>();
+
+    TestSparseMatrix<float, math::MatrixLayout::rowMajor, math::MatrixLayout::rowMajor>();
+    TestSparseMatrix<float, math::MatrixLayout::rowMajor, math::MatrixLayout::columnMajor>();
+    TestSparseMatrix<double, math::MatrixLayout::columnMajor, math::MatrixLayout::rowMajor>();
+    TestSparseMatrix<double, math::MatrixLayout::columnMajor, math::MatrixLayout::columnMajor>();
+
+    //
+    // Reduced precision tests
+    //
+
+    TestFloat16Conversion();
+    TestBFloat16Conversion();
+    TestReducedPrecisionMultiply<math::Float16, math::MatrixLayout::rowMajor, math::MatrixLayout::rowMajor>();
+    TestReducedPrecisionMultiply<math::Float16, math::MatrixLayout::columnMajor, math::MatrixLayout::rowMajor>();
+    TestReducedPrecisionMultiply<math::BFloat16, math::MatrixLayout::rowMajor, math::MatrixLayout::columnMajor>();
+    TestReducedPrecisionMultiply<math::BFloat16, math::MatrixLayout::columnMajor, math::MatrixLayout::columnMajor>();
+
+    //
+    // Quantized matrix tests
+    //
+
+    TestQuantizedMatrix();
+    TestQuantizedKernels();
+    TestQuantizedMatrixMultiply<math::MatrixLayout::rowMajor>();
+    TestQuantizedMatrixMultiply<math::MatrixLayout::columnMajor>();
+    TestQuantizedMatrixMultiplyDepth();
+
+    //
+    // Transcendental function tests
+    //
+
+    TestTranscendental<float>();
+    TestTranscendental<double>();
+    TestTranscendentalPrecision<float>();
+    TestTranscendentalPrecision<double>();
+
     //
     // Tensor tests
     // 
@@ -169,6 +243,13 @@ int main()
     TestTensorArchiver<float, math::Dimension::column, math::Dimension::row, math::Dimension::channel>();
     TestTensorArchiver<float, math::Dimension::channel, math::Dimension::column, math::Dimension::row>();
 
+    TestChannelBlockedTensor<float, math::Dimension::channel, math::Dimension::column, math::Dimension::row>();
+    TestChannelBlockedTensor<float, math::Dimension::column, math::Dimension::row, math::Dimension::channel>();
+    TestChannelBlockedTensor<double, math::Dimension::row, math::Dimension::channel, math::Dimension::column>();
+
+    TestTransposeCopy<float>();
+    TestTransposeCopy<double>();
+
     if (testing::DidTestFail())
     {
         return 1;
@@ -0,0 +1,182 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     HalfPrecision_test.tcc (math_test)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// testing
+#include "testing.h"
+
+// stl
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+inline void TestFloat16Conversion()
+{
+    auto roundTrip = [](float value) { return static_cast<float>(math::Float16(value)); };
+
+    // exactly representable values, including the largest normal, the smallest normal and the smallest subnormal
+    bool isExact = true;
+    for (float value : { 0.0f, 1.0f, -2.5f, 0.1875f, 65504.0f, -65504.0f, std::ldexp(1.0f, -14), std::ldexp(1.0f, -24), std::ldexp(3.0f, -20), 1023.5f })
+    {
+        isExact = isExact && roundTrip(value) == value;
+    }
+    testing::ProcessTest("Float16 exact conversion", isExact);
+
+    // ties round to even, 2049 is halfway between 2048 and 2050
+    bool isRounded = roundTrip(2049.0f) == 2048.0f && roundTrip(2051.0f) == 2052.0f && roundTrip(1.0f + 1.0f / 4096) == 1.0f && roundTrip(3.0e-8f) == std::ldexp(1.0f, -24) && roundTrip(2.0e-8f) == 0.0f;
+    testing::ProcessTest("Float16 rounding", isRounded);
+
+    auto infinity = std::numeric_limits<float>::infinity();
+    bool isSpecial = roundTrip(65520.0f) == infinity && roundTrip(-1.0e10f) == -infinity && roundTrip(infinity) == infinity && std::isnan(roundTrip(std::numeric_limits<float>::quiet_NaN())) && math::Float16(-0.0f).bits == 0x8000;
+    testing::ProcessTest("Float16 special values", isSpecial);
+
+    // every bit pattern that is not a NaN survives a round trip through float
+    bool isBitExact = true;
+    for (uint32_t bits = 0; bits < 0x10000; ++bits)
+    {
+        auto value = math::Float16::FromBits(static_cast<uint16_t>(bits));
+        if ((bits & 0x7c00) != 0x7c00 || (bits & 0x03ff) == 0)
+        {
+            isBitExact = isBitExact && math::Float16(static_cast<float>(value)).bits == bits;
+        }
+    }
+    testing::ProcessTest("Float16 bit patterns", isBitExact);
+
+    // every bit pattern that is not a NaN, an odd number of them, so that the vector kernels also convert a partial vector
+    std::vector<math::Float16> patterns;
+    for (uint32_t bits = 0; bits < 0x10000; ++bits)
+    {
+        if ((bits & 0x7c00) != 0x7c00 || (bits & 0x03ff) == 0)
+        {
+            patterns.push_back(math::Float16::FromBits(static_cast<uint16_t>(bits)));
+        }
+    }
+    patterns.pop_back();
+
+    // values between the Float16 values, which must round like the scalar conversion
+    std::vector<float> midpoints;
+    for (float value = 1.0e-8f; value < 7.0e4f; value *= 1.0007f)
+    {
+        midpoints.push_back(value);
+        midpoints.push_back(-value);
+    }
+    midpoints.push_back(std::numeric_limits<float>::infinity());
+
+    auto supportedInstructionSet = math::GetSupportedInstructionSet();
+    for (int index = 0; index <= static_cast<int>(supportedInstructionSet); ++index)
+    {
+        auto instructionSet = static_cast<math::InstructionSet>(index);
+        math::SetInstructionSet(instructionSet);
+        auto name = "Float16 ConvertElements [" + math::GetInstructionSetName(instructionSet) + "]";
+
+        std::vector<float> values(patterns.size());
+        std::vector<math::Float16> storage(patterns.size());
+        math::ConvertElements(patterns.data(), values.data(), patterns.size());
+        math::ConvertElements(values.data(), storage.data(), values.size());
+        bool isBitExact = true;
+        for (size_t i = 0; i < patterns.size(); ++i)
+        {
+            isBitExact = isBitExact && values[i] == static_cast<float>(patterns[i]) && storage[i].bits == patterns[i].bits;
+        }
+
+        std::vector<math::Float16> rounded(midpoints.size());
+        math::ConvertElements(midpoints.data(), rounded.data(), midpoints.size());
+        bool isRounded = true;
+        for (size_t i = 0; i < midpoints.size(); ++i)
+        {
+            isRounded = isRounded && rounded[i].bits == math::Float16(midpoints[i]).bits;
+        }
+        testing::ProcessTest(name, isBitExact && isRounded);
+    }
+    math::SetInstructionSet(supportedInstructionSet);
+}
+
+inline void TestBFloat16Conversion()
+{
+    auto roundTrip = [](float value) { return static_cast<float>(math::BFloat16(value)); };
+
+    bool isExact = roundTrip(1.0f) == 1.0f && roundTrip(-2.5f) == -2.5f && roundTrip(std::ldexp(1.0f, 100)) == std::ldexp(1.0f, 100) && roundTrip(-0.1875f) == -0.1875f && roundTrip(0.0f) == 0.0f;
+    bool isRounded = roundTrip(1.0f + 1.0f / 256) == 1.0f && roundTrip(1.0f + 3.0f / 256) == 1.0f + 4.0f / 256 && roundTrip(257.0f) == 256.0f && roundTrip(259.0f) == 260.0f;
+    auto infinity = std::numeric_limits<float>::infinity();
+    bool isSpecial = roundTrip(infinity) == infinity && std::isnan(roundTrip(std::numeric_limits<float>::quiet_NaN())) && roundTrip(std::numeric_limits<float>::max()) == infinity;
+    testing::ProcessTest("BFloat16 conversion", isExact && isRounded && isSpecial);
+
+    std::vector<float> source{ 1.0f, -0.5f, 3.25f, 96.0f, 0.0f };
+    std::vector<math::BFloat16> storage(source.size());
+    std::vector<float> target(source.size());
+    math::ConvertElements(source.data(), storage.data(), source.size());
+    math::ConvertElements(storage.data(), target.data(), source.size());
+    testing::ProcessTest("BFloat16 ConvertElements", target == source);
+}
+
+template <typename StorageType, math::MatrixLayout layoutA, math::MatrixLayout layoutB>
+void TestReducedPrecisionMultiply()
+{
+    using Ops = math::Operations;
+    std::string name = std::string(std::is_same<StorageType, math::Float16>::value ? "Float16" : "BFloat16") + (layoutA == math::MatrixLayout::rowMajor ? " [row major]" : " [column major]");
+
+    // more rows than one packed block of A, a depth with a partial conversion chunk, and small integers that both formats represent exactly
+    const size_t m = 300;
+    const size_t n = 21;
+    const size_t k = 1100;
+
+    math::Matrix<StorageType, layoutA> A(m, k);
+    math::Matrix<float, layoutA> floatA(m, k);
+    for (size_t i = 0; i < m; ++i)
+    {
+        for (size_t j = 0; j < k; ++j)
+        {
+            floatA(i, j) = static_cast<float>(static_cast<int>((i * 7 + j * 3) % 13) - 6);
+            A(i, j) = floatA(i, j);
+        }
+    }
+    math::Matrix<float, layoutB> B(k, n);
+    B.Generate([]() { static int counter = 0; return static_cast<float>((counter++ * 5) % 7) - 3; });
+    math::ColumnVector<float> v(k);
+    v.Generate([]() { static int counter = 0; return static_cast<float>((counter++ * 3) % 5) - 2; });
+
+    math::ColumnVector<float> r(m);
+    math::ColumnVector<float> u(m);
+    r.Fill(1);
+    Ops::Multiply(2.0f, floatA, v, -1.0f, r);
+
+    math::Matrix<float, layoutA> R(m, n);
+    math::Matrix<float, layoutB> C(m, n);
+    R.Fill(1);
+    Ops::Multiply(2.0f, floatA, B, -1.0f, R);
+
+    // A is converted by the dispatched kernels, so each instruction set that the processor supports is tested
+    auto supportedInstructionSet = math::GetSupportedInstructionSet();
+    for (int index = 0; index <= static_cast<int>(supportedInstructionSet); ++index)
+    {
+        auto instructionSet = static_cast<math::InstructionSet>(index);
+        math::SetInstructionSet(instructionSet);
+        auto instructionSetName = " [" + math::GetInstructionSetName(instructionSet) + "]";
+
+        u.Fill(1);
+        Ops::Multiply(2.0f, A, v, -1.0f, u);
+        testing::ProcessTest("Operations::Multiply(Matrix<" + name + ">, Vector)" + instructionSetName, u == r);
+
+        C.Fill(1);
+        Ops::Multiply(2.0f, A, B, -1.0f, C);
+        testing::ProcessTest("Operations::Multiply(Matrix<" + name + ">, Matrix)" + instructionSetName, C == R);
+    }
+    math::SetInstructionSet(supportedInstructionSet);
+
+    Ops::SetNumThreads(4);
+    u.Fill(1);
+    C.Fill(1);
+    Ops::Multiply(2.0f, A, v, -1.0f, u);
+    Ops::Multiply(2.0f, A, B, -1.0f, C);
+    Ops::SetNumThreads(1);
+    testing::ProcessTest("Operations::Multiply(Matrix<" + name + ">) [4 threads]", u == r && C == R);
+
+    math::ChannelColumnRowTensor<StorageType> T(2, 3, 4);
+    T(1, 2, 3) = 1.5f;
+    testing::ProcessTest("Tensor<" + name + "> storage", static_cast<float>(T(1, 2, 3)) == 1.5f && static_cast<float>(T(0, 0, 0)) == 0.0f && sizeof(StorageType) == 2);
+}
@@ -7,6 +7,10 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "Matrix.h"
+#include "VectorKernels.h"
+
+// stl
+#include <limits>
 
 template <typename ElementType, math::MatrixLayout layout>
 void TestMatrix1()
@@ -480,3 +484,319 @@ void TestMatrixMatrixMultiply()
 
     testing::ProcessTest(implementationName + "Operations::Multiply(Matrix, Matrix)", C == R);
 }
+
+template <typename ElementType, math::MatrixLayout layoutA, math::MatrixLayout layoutB, math::ImplementationType Implementation>
+void TestBlockedMatrixMatrixMultiply()
+{
+    auto implementationName = math::OperationsImplementation<Implementation>::GetImplementationName();
+    using Ops = math::OperationsImplementation<Implementation>;
+
+    // sizes that are not multiples of the micro-tile and that span several cache blocks
+    const size_t m = 131;
+    const size_t n = 45;
+    const size_t k = 301;
+
+    // integer-valued entries keep the products exact in both float and double
+    math::Matrix<ElementType, layoutA> A(m, k);
+    math::Matrix<ElementType, layoutB> B(k, n);
+    A.Generate([]() { static int counter = 0; return static_cast<ElementType>((counter++ * 7) % 11) - 5; });
+    B.Generate([]() { static int counter = 0; return static_cast<ElementType>((counter++ * 5) % 7) - 3; });
+
+    // multiply into a sub-matrix, so that C is not contiguous
+    math::Matrix<ElementType, layoutA> D(m + 3, n + 5);
+    D.Fill(1);
+    auto C = D.GetSubMatrix(1, 2, m, n);
+
+    ElementType s = 2;
+    ElementType t = -1;
+    math::Matrix<ElementType, layoutA> P(m, n);
+    math::Matrix<ElementType, layoutA> R(m, n);
+    for (size_t i = 0; i < m; ++i)
+    {
+        for (size_t j = 0; j < n; ++j)
+        {
+            ElementType sum = 0;
+            for (size_t p = 0; p < k; ++p)
+            {
+                sum += A(i, p) * B(p, j);
+            }
+            P(i, j) = s * sum;
+            R(i, j) = s * sum + t * C(i, j);
+        }
+    }
+
+    // the float and double kernels are dispatched on the instruction set, so each one that the processor supports is tested
+    auto supportedInstructionSet = math::GetSupportedInstructionSet();
+    for (int index = 0; index <= static_cast<int>(supportedInstructionSet); ++index)
+    {
+        auto instructionSet = static_cast<math::InstructionSet>(index);
+        math::SetInstructionSet(instructionSet);
+        auto name = implementationName + "Operations::Multiply(Matrix, Matrix) [blocked, " + math::MatrixMultiplyKernel<ElementType>::GetKernelName() + "]";
+
+        D.Fill(1);
+        Ops::Multiply(s, A, B, t, C);
+        testing::ProcessTest(name, C == R && D(0, 0) == 1 && D(m + 2, n + 4) == 1);
+
+        // when t is zero, C is not read, so NaNs in C do not propagate
+        D.Fill(std::numeric_limits<ElementType>::quiet_NaN());
+        Ops::Multiply(s, A, B, static_cast<ElementType>(0), C);
+        testing::ProcessTest(name + " with t = 0", C == P);
+    }
+    math::SetInstructionSet(supportedInstructionSet);
+}
+
+template <typename ElementType, math::MatrixLayout layoutA, math::MatrixLayout layoutB, math::ImplementationType Implementation>
+void TestParallelMatrixMultiply()
+{
+    auto implementationName = math::OperationsImplementation<Implementation>::GetImplementationName();
+    using Ops = math::OperationsImplementation<Implementation>;
+
+    const size_t m = 97;
+    const size_t n = 83;
+    const size_t k = 64;
+
+    math::Matrix<ElementType, layoutA> A(m, k);
+    math::Matrix<ElementType, layoutB> B(k, n);
+    math::ColumnVector<ElementType> v(k);
+    A.Generate([]() { static int counter = 0; return static_cast<ElementType>((counter++ * 7) % 11) - 5; });
+    B.Generate([]() { static int counter = 0; return static_cast<ElementType>((counter++ * 5) % 7) - 3; });
+    v.Generate([]() { static int counter = 0; return static_cast<ElementType>((counter++ * 3) % 5) - 2; });
+
+    math::Matrix<ElementType, layoutA> R(m, n);
+    math::ColumnVector<ElementType> r(m);
+    R.Fill(1);
+    r.Fill(1);
+    Ops::Multiply(static_cast<ElementType>(2), A, B, static_cast<ElementType>(-1), R);
+    Ops::Multiply(static_cast<ElementType>(2), A, v, static_cast<ElementType>(-1), r);
+
+    Ops::SetNumThreads(4);
+    math::Matrix<ElementType, layoutA> C(m, n);
+    math::ColumnVector<ElementType> u(m);
+    C.Fill(1);
+    u.Fill(1);
+    Ops::Multiply(static_cast<ElementType>(2), A, B, static_cast<ElementType>(-1), C);
+    Ops::Multiply(static_cast<ElementType>(2), A, v, static_cast<ElementType>(-1), u);
+    auto numThreads = Ops::GetNumThreads();
+    Ops::SetNumThreads(1);
+
+    testing::ProcessTest(implementationName + "Operations::Multiply(Matrix, Matrix) [4 threads]", numThreads == 4 && C == R);
+    testing::ProcessTest(implementationName + "Operations::Multiply(Matrix, Vector) [4 threads]", u == r);
+}
+
+template <typename ElementType, math::MatrixLayout layoutA, math::MatrixLayout layoutB>
+void TestBatchedMatrixMultiply()
+{
+    using Ops = math::Operations;
+
+    // the matrices A overlap, two columns apart, as in the diagonal convolution method
+    auto test = [](size_t batchCount, size_t m, size_t n, size_t k, bool isSharedB) {
+        math::Matrix<ElementType, layoutA> A(m, k + 2 * (batchCount - 1));
+        math::Matrix<ElementType, layoutB> B(k, isSharedB ? n : n * batchCount);
+        A.Generate([]() { static int counter = 0; return static_cast<ElementType>((counter++ * 7) % 11) - 5; });
+        B.Generate([]() { static int counter = 0; return static_cast<ElementType>((counter++ * 5) % 7) - 3; });
+
+        auto A0 = A.GetSubMatrix(0, 0, m, k);
+        auto B0 = B.GetSubMatrix(0, 0, k, n);
+        size_t aBatchIncrement = batchCount > 1 ? A.GetSubMatrix(0, 2, m, k).GetDataPointer() - A0.GetDataPointer() : 0;
+        size_t bBatchIncrement = isSharedB || batchCount == 1 ? 0 : B.GetSubMatrix(0, n, k, n).GetDataPointer() - B0.GetDataPointer();
+
+        math::Matrix<ElementType, layoutA> R(m * batchCount, n);
+        math::Matrix<ElementType, layoutA> C(m * batchCount, n);
+        R.Fill(1);
+        C.Fill(1);
+        for (size_t b = 0; b < batchCount; ++b)
+        {
+            auto Bb = isSharedB ? B0 : B.GetSubMatrix(0, b * n, k, n);
+            Ops::Multiply(static_cast<ElementType>(2), A.GetSubMatrix(0, 2 * b, m, k), Bb, static_cast<ElementType>(-1), R.GetSubMatrix(b * m, 0, m, n));
+        }
+
+        auto C0 = C.GetSubMatrix(0, 0, m, n);
+        size_t cBatchIncrement = batchCount > 1 ? C.GetSubMatrix(m, 0, m, n).GetDataPointer() - C0.GetDataPointer() : 0;
+        Ops::MultiplyBatched(batchCount, static_cast<ElementType>(2), A0, aBatchIncrement, B0, bBatchIncrement, static_cast<ElementType>(-1), C0, cBatchIncrement);
+        return C == R;
+    };
+
+    bool isSerialOk = test(7, 13, 11, 9, true) && test(7, 13, 11, 9, false) && test(1, 5, 3, 4, false);
+
+    Ops::SetNumThreads(4);
+    bool isParallelOk = test(12, 20, 20, 20, true) && test(12, 20, 20, 20, false) && test(2, 40, 40, 40, true);
+    Ops::SetNumThreads(1);
+
+    testing::ProcessTest("Operations::MultiplyBatched(Matrix, Matrix)", isSerialOk);
+    testing::ProcessTest("Operations::MultiplyBatched(Matrix, Matrix) [4 threads]", isParallelOk);
+}
+
+template <typename ElementType, math::MatrixLayout layoutA, math::MatrixLayout layoutB>
+void TestSparseMatrix()
+{
+    using Ops = math::Operations;
+    auto layoutName = std::string("[") + (layoutA == math::MatrixLayout::rowMajor ? "CSR" : "CSC") + "]";
+
+    const size_t m = 53;
+    const size_t n = 41;
+    const size_t k = 37;
+
+    // roughly one element in four is nonzero, and some rows and columns are empty
+    math::Matrix<ElementType, layoutA> A(m, k);
+    A.Generate([]() { static int counter = 0; auto value = (counter++ * 7) % 29; return value < 7 ? static_cast<ElementType>(value - 3) : 0; });
+    math::Matrix<ElementType, layoutB> B(k, n);
+    B.Generate([]() { static int counter = 0; return static_cast<ElementType>((counter++ * 5) % 7) - 3; });
+    math::ColumnVector<ElementType> v(k);
+    v.Generate([]() { static int counter = 0; return static_cast<ElementType>((counter++ * 3) % 5) - 2; });
+
+    math::SparseMatrix<ElementType, layoutA> S(A);
+    size_t numNonzeros = 0;
+    bool elementsEqual = true;
+    for (size_t i = 0; i < m; ++i)
+    {
+        for (size_t j = 0; j < k; ++j)
+        {
+            numNonzeros += A(i, j) != 0 ? 1 : 0;
+            elementsEqual = elementsEqual && S(i, j) == A(i, j) && S.Transpose()(j, i) == A(i, j);
+        }
+    }
+    testing::ProcessTest("SparseMatrix(Matrix) " + layoutName, S.NumNonzeros() == numNonzeros && elementsEqual && S.ToDense() == A);
+
+    auto subMatrix = S.GetMajorSubMatrix(3, 5);
+    auto denseSubMatrix = layoutA == math::MatrixLayout::rowMajor ? A.GetSubMatrix(3, 0, 5, k) : A.GetSubMatrix(0, 3, m, 5);
+    testing::ProcessTest("SparseMatrix::GetMajorSubMatrix " + layoutName, subMatrix.ToDense() == denseSubMatrix);
+
+    math::ColumnVector<ElementType> r(m);
+    math::ColumnVector<ElementType> u(m);
+    r.Fill(1);
+    u.Fill(1);
+    Ops::Multiply(static_cast<ElementType>(2), A, v, static_cast<ElementType>(-1), r);
+    Ops::Multiply(static_cast<ElementType>(2), S, v, static_cast<ElementType>(-1), u);
+    testing::ProcessTest("Operations::Multiply(SparseMatrix, Vector) " + layoutName, u == r);
+
+    math::Matrix<ElementType, layoutA> R(m, n);
+    math::Matrix<ElementType, layoutB> C(m, n);
+    R.Fill(1);
+    C.Fill(1);
+    Ops::Multiply(static_cast<ElementType>(2), A, B, static_cast<ElementType>(-1), R);
+    Ops::Multiply(static_cast<ElementType>(2), S, B, static_cast<ElementType>(-1), C);
+    testing::ProcessTest("Operations::Multiply(SparseMatrix, Matrix) " + layoutName, C == R);
+
+    // the transpose shares the arrays of S and is multiplied by the kernel of the other layout
+    math::Matrix<ElementType, layoutB> W(m, n);
+    W.Generate([]() { static int counter = 0; return static_cast<ElementType>((counter++ * 3) % 7) - 3; });
+    math::Matrix<ElementType, math::TransposeMatrixLayout<layoutA>::value> G(k, n);
+    math::Matrix<ElementType, layoutB> F(k, n);
+    Ops::Multiply(static_cast<ElementType>(1), A.Transpose(), W, static_cast<ElementType>(0), G);
+    Ops::Multiply(static_cast<ElementType>(1), S.Transpose(), W, static_cast<ElementType>(0), F);
+    testing::ProcessTest("Operations::Multiply(SparseMatrix::Transpose, Matrix) " + layoutName, F == G);
+
+    Ops::SetNumThreads(4);
+    u.Fill(1);
+    C.Fill(1);
+    Ops::Multiply(static_cast<ElementType>(2), S, v, static_cast<ElementType>(-1), u);
+    Ops::Multiply(static_cast<ElementType>(2), S, B, static_cast<ElementType>(-1), C);
+    Ops::SetNumThreads(1);
+    testing::ProcessTest("Operations::Multiply(SparseMatrix, Vector) [4 threads] " + layoutName, u == r);
+    testing::ProcessTest("Operations::Multiply(SparseMatrix, Matrix) [4 threads] " + layoutName, C == R);
+
+    bool threw = false;
+    try
+    {
+        math::SparseMatrix<ElementType, layoutA> invalid(2, 2, { 0, 2, 3 }, { 1, 0, 1 }, { 1, 2, 3 });
+    }
+    catch (const utilities::InputException&)
+    {
+        threw = true;
+    }
+    testing::ProcessTest("SparseMatrix rejects unsorted indices " + layoutName, threw);
+}
+
+template <typename ElementType, math::MatrixLayout layout>
+void TestPaddedMatrix()
+{
+    auto isAligned = [](const ElementType* pData) { return reinterpret_cast<std::uintptr_t>(pData) % math::c_storageAlignment == 0; };
+
+    math::Matrix<ElementType, layout> M(5, 7, math::MatrixPadding::aligned);
+    M.Generate([]() { static int counter = 0; return static_cast<ElementType>(counter++ % 13); });
+    math::Matrix<ElementType, layout> S(5, 7);
+    S.CopyFrom(M);
+
+    bool intervalsAligned = true;
+    for (size_t i = 0; i < M.NumIntervals(); ++i)
+    {
+        intervalsAligned = intervalsAligned && isAligned(M.GetDataPointer() + i * M.GetIncrement());
+    }
+    testing::ProcessTest("Matrix(MatrixPadding::aligned) increment and alignment", !M.IsContiguous() && intervalsAligned && isAligned(S.GetDataPointer()));
+
+    auto copy = M;
+    testing::ProcessTest("Matrix(MatrixPadding::aligned) copy", copy.GetIncrement() == M.GetIncrement() && copy == S);
+
+    auto array = M.ToArray();
+    testing::ProcessTest("Matrix(MatrixPadding::aligned) ToArray", array == S.ToArray());
+
+    utilities::SerializationContext context;
+    std::stringstream strstream;
+    utilities::JsonArchiver archiver(strstream);
+    math::MatrixArchiver::Write(M, "test", archiver);
+    utilities::JsonUnarchiver unarchiver(strstream, context);
+    math::Matrix<ElementType, layout> Ma(0, 0);
+    math::MatrixArchiver::Read(Ma, "test", unarchiver);
+    testing::ProcessTest("Matrix(MatrixPadding::aligned) write and read", Ma == S);
+
+    math::Matrix<ElementType, layout> P(5, 5, math::MatrixPadding::aligned);
+    math::Matrix<ElementType, layout> R(5, 5);
+    math::Operations::Multiply(static_cast<ElementType>(1), M, M.Transpose(), static_cast<ElementType>(0), P);
+    math::Operations::Multiply(static_cast<ElementType>(1), S, S.Transpose(), static_cast<ElementType>(0), R);
+    testing::ProcessTest("Matrix(MatrixPadding::aligned) Operations::Multiply", P == R);
+}
+
+template <typename ElementType, math::MatrixLayout layoutA, math::MatrixLayout layoutB>
+void TestMatrixExpression()
+{
+    math::Matrix<ElementType, layoutA> A{
+        { 1, 2, 3 },
+        { 4, 5, 6 }
+    };
+
+    math::Matrix<ElementType, layoutB> B{
+        { 1, 0 },
+        { -1, 2 },
+        { 3, 1 }
+    };
+
+    math::RowVector<ElementType> u{ 1, 2, 3 };
+    math::ColumnVector<ElementType> v{ 10, 20 };
+
+    // C = 2 * A - B' + repmat(u) + repmat(v)
+    math::Matrix<ElementType, layoutA> C(2, 3);
+    C.CopyFrom(2.0 * A - B.Transpose() + math::RepeatRow(u, 2) + math::RepeatColumn(v, 3));
+
+    math::RowMatrix<ElementType> R1{
+        { 12, 17, 16 },
+        { 29, 30, 34 }
+    };
+    testing::ProcessTest("MatrixExpression, CopyFrom(2 * A - B' + RepeatRow(u) + RepeatColumn(v))", C == R1);
+
+    // the destination may also appear in the expression
+    C.CopyFrom(0.5 * (C + C.GetSubMatrix(0, 0, 2, 3)));
+    testing::ProcessTest("MatrixExpression, CopyFrom expression that reads the destination", C == R1);
+
+    C += (-1.0) * A.GetSubMatrix(0, 0, 2, 3) + A;
+    testing::ProcessTest("MatrixExpression, operator+=", C == R1);
+
+    math::Matrix<ElementType, layoutB> D(3, 2);
+    D += B - 3.0 * A.Transpose();
+    math::RowMatrix<ElementType> R2{
+        { -2, -12 },
+        { -7, -13 },
+        { -6, -17 }
+    };
+    testing::ProcessTest("MatrixExpression, operator+= with transposed operand", D == R2);
+
+    bool thrown = false;
+    try
+    {
+        C.CopyFrom(A + B);
+    }
+    catch (const utilities::InputException&)
+    {
+        thrown = true;
+    }
+    testing::ProcessTest("MatrixExpression, size mismatch", thrown);
+}
@@ -0,0 +1,202 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     QuantizedMatrix_test.tcc (math_test)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// testing
+#include "testing.h"
+
+// stl
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+inline void TestQuantizedMatrix()
+{
+    math::RowMatrix<float> M{ { -1.0f, 0.0f, 0.5f, 2.0f }, { 3.0f, 1.5f, 0.0f, 0.25f }, { 0.0f, 0.0f, 0.0f, 0.0f } };
+    math::QuantizedWeightMatrix Q(M);
+
+    // each element is within half a quantization step of its original value, and zero is exact
+    bool isClose = true;
+    for (size_t i = 0; i < M.NumRows(); ++i)
+    {
+        auto scale = Q.GetParameters(i).scale;
+        for (size_t j = 0; j < M.NumColumns(); ++j)
+        {
+            isClose = isClose && std::abs(Q(i, j) - M(i, j)) <= 0.501f * scale && (M(i, j) != 0 || Q(i, j) == 0);
+        }
+    }
+    testing::ProcessTest("QuantizedMatrix(Matrix)", isClose && Q.Dequantize().IsEqual(M, 0.02f));
+
+    math::QuantizedActivationMatrix A(2, 2, { 0, 255, 10, 20 }, { { 1.0f, 0 }, { 0.5f, 10 } });
+    testing::ProcessTest("QuantizedMatrix(data, parameters)", A(0, 0) == 0 && A(1, 0) == 255 && A(0, 1) == 0 && A(1, 1) == 5 && A.GetSum(0) == 255 && A.GetSum(1) == 30);
+
+    bool threw = false;
+    try
+    {
+        math::QuantizedActivationMatrix invalid(2, 2, { 0, 1, 2 }, { { 1.0f, 0 }, { 1.0f, 0 } });
+    }
+    catch (const utilities::InputException&)
+    {
+        threw = true;
+    }
+    testing::ProcessTest("QuantizedMatrix rejects mismatched data", threw);
+}
+
+inline void TestQuantizedKernels()
+{
+    // sizes on both sides of every vector width, and extreme values whose pairwise sums saturate 16 bit arithmetic
+    std::vector<uint8_t> u(200);
+    std::vector<int8_t> v(4 * 200);
+    for (size_t i = 0; i < u.size(); ++i)
+    {
+        u[i] = i < 40 ? 255 : static_cast<uint8_t>((i * 37) % 256);
+    }
+    for (size_t i = 0; i < v.size(); ++i)
+    {
+        v[i] = i < 40 ? -128 : static_cast<int8_t>(static_cast<int>((i * 53) % 256) - 128);
+    }
+
+    auto supportedInstructionSet = math::GetSupportedInstructionSet();
+    for (int index = 0; index <= static_cast<int>(supportedInstructionSet); ++index)
+    {
+        auto instructionSet = static_cast<math::InstructionSet>(index);
+        math::SetInstructionSet(instructionSet);
+
+        bool isCorrect = true;
+        for (size_t size : { 1, 15, 16, 17, 63, 64, 65, 200 })
+        {
+            int32_t expected[4] = { 0, 0, 0, 0 };
+            for (size_t r = 0; r < 4; ++r)
+            {
+                for (size_t i = 0; i < size; ++i)
+                {
+                    expected[r] += static_cast<int32_t>(u[i]) * v[r * 200 + i];
+                }
+            }
+
+            int32_t results[4];
+            math::QuantizedKernels::Dot4(u.data(), v.data(), 200, size, results);
+            isCorrect = isCorrect && math::QuantizedKernels::Dot(u.data(), v.data(), size) == expected[0];
+            for (size_t r = 0; r < 4; ++r)
+            {
+                isCorrect = isCorrect && results[r] == expected[r];
+            }
+        }
+
+        // a 4 x 4 product, and products with partial panels and tiles, a partial group at the end of the depth, and more than one block of the depth
+        for (size_t size : { 4, 7, 31, 33, 150 })
+        {
+            const size_t depth = size == 150 ? 1031 : size;
+            std::vector<int8_t> a(size * depth);
+            std::vector<uint8_t> b(depth * size);
+            for (size_t i = 0; i < a.size(); ++i)
+            {
+                a[i] = i % 7 == 0 ? -128 : static_cast<int8_t>(static_cast<int>((i * 53) % 256) - 128);
+                b[i] = i % 5 == 0 ? 255 : static_cast<uint8_t>((i * 37) % 256);
+            }
+
+            // C starts at 1, since the kernel adds the product to it
+            std::vector<int64_t> expected(size * size, 1);
+            for (size_t i = 0; i < size; ++i)
+            {
+                for (size_t j = 0; j < size; ++j)
+                {
+                    for (size_t l = 0; l < depth; ++l)
+                    {
+                        expected[i * size + j] += static_cast<int64_t>(a[i * depth + l]) * b[j * depth + l];
+                    }
+                }
+            }
+
+            std::vector<int64_t> c(size * size, 1);
+            math::QuantizedKernels::Multiply(size, size, depth, a.data(), depth, b.data(), depth, c.data(), size);
+            isCorrect = isCorrect && c == expected;
+        }
+        testing::ProcessTest("QuantizedKernels [" + math::GetInstructionSetName(instructionSet) + "]", isCorrect);
+    }
+    math::SetInstructionSet(supportedInstructionSet);
+}
+
+template <math::MatrixLayout layout>
+void TestQuantizedMatrixMultiply()
+{
+    using Ops = math::Operations;
+    std::string layoutName = layout == math::MatrixLayout::rowMajor ? "[row major]" : "[column major]";
+
+    const size_t m = 39;
+    const size_t n = 22;
+    const size_t k = 70;
+
+    math::RowMatrix<float> weights(m, k);
+    weights.Generate([]() { static int counter = 0; return static_cast<float>((counter++ * 7) % 23) / 4 - 3; });
+    math::ColumnMatrix<float> activations(k, n);
+    activations.Generate([]() { static int counter = 0; return static_cast<float>((counter++ * 5) % 17) / 8; });
+
+    math::QuantizedWeightMatrix A(weights);
+    math::QuantizedActivationMatrix B(activations);
+
+    // the result must match the float product of the dequantized matrices
+    auto floatA = A.Dequantize();
+    auto floatB = B.Dequantize();
+    // (up to float rounding, since the quantized product is computed exactly)
+    math::RowMatrix<float> R(m, n);
+    math::Matrix<float, layout> C(m, n);
+    R.Fill(1);
+    C.Fill(1);
+    Ops::Multiply(2.0f, floatA, floatB, -1.0f, R);
+    Ops::Multiply(2.0f, A, B, -1.0f, C);
+    testing::ProcessTest("Operations::Multiply(QuantizedMatrix, QuantizedMatrix) " + layoutName, C.IsEqual(R, 0.05f));
+
+    // integers from 0 to 255 are quantized exactly
+    math::ColumnVector<float> v(k);
+    v.Generate([]() { static int counter = 0; return static_cast<float>((counter++ * 11) % 256); });
+    v[0] = 255;
+    math::ColumnVector<float> r(m);
+    math::ColumnVector<float> u(m);
+    r.Fill(1);
+    u.Fill(1);
+    Ops::Multiply(2.0f, floatA, v, -1.0f, r);
+    Ops::Multiply(2.0f, A, v, -1.0f, u);
+    testing::ProcessTest("Operations::Multiply(QuantizedMatrix, Vector) " + layoutName, u.IsEqual(r, 1.0f));
+
+    Ops::SetNumThreads(4);
+    math::Matrix<float, layout> D(m, n);
+    math::ColumnVector<float> w(m);
+    D.Fill(1);
+    w.Fill(1);
+    Ops::Multiply(2.0f, A, B, -1.0f, D);
+    Ops::Multiply(2.0f, A, v, -1.0f, w);
+    Ops::SetNumThreads(1);
+    testing::ProcessTest("Operations::Multiply(QuantizedMatrix) [4 threads] " + layoutName, D == C && w == u);
+}
+
+inline void TestQuantizedMatrixMultiplyDepth()
+{
+    using Ops = math::Operations;
+
+    // every product is 255 * -128, so a depth of 70000 overflows 32 bit sums; a row and a column are left over after the tiles
+    const size_t m = 5;
+    const size_t n = 5;
+    const size_t k = 70000;
+    math::QuantizedWeightMatrix A(m, k, std::vector<int8_t>(m * k, -128), std::vector<math::QuantizationParameters>(m, { 1.0f, 0 }));
+    math::QuantizedActivationMatrix B(k, n, std::vector<uint8_t>(k * n, 255), std::vector<math::QuantizationParameters>(n, { 1.0f, 0 }));
+    auto expected = static_cast<float>(static_cast<int64_t>(k) * 255 * -128);
+
+    math::RowMatrix<float> C(m, n);
+    Ops::Multiply(1.0f, A, B, 0.0f, C);
+    math::RowMatrix<float> R(m, n);
+    R.Fill(expected);
+
+    math::ColumnVector<float> v(k);
+    v.Fill(255);
+    math::ColumnVector<float> u(m);
+    Ops::Multiply(1.0f, A, v, 0.0f, u);
+    math::ColumnVector<float> r(m);
+    r.Fill(expected);
+    testing::ProcessTest("Operations::Multiply(QuantizedMatrix) with a depth that overflows 32 bits", C == R && u == r);
+}
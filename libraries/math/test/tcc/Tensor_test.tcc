@@ -7,6 +7,7 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 // math
+#include "ChannelBlockedTensor.h"
 #include "TensorOperations.h"
 
 // utilities
@@ -450,3 +451,65 @@ void TestTensorArchiver()
     math::TensorArchiver::Read(Ta, "test", unarchiver);
     testing::ProcessTest("void TestTensorArchiver(), write and read tensor", Ta == T);
 }
+
+template<typename ElementType, math::Dimension dimension0, math::Dimension dimension1, math::Dimension dimension2>
+void TestChannelBlockedTensor()
+{
+    // 11 channels make one full block of 8 and one padded block, and 37 columns exceed a transpose tile
+    math::Tensor<ElementType, dimension0, dimension1, dimension2> T(5, 37, 11);
+    T.Generate([]() { static int counter = 0; return static_cast<ElementType>(counter++ % 101); });
+
+    math::ChannelBlockedTensor<ElementType, 8> B(T);
+    bool isEqual = B.NumRows() == 5 && B.NumColumns() == 37 && B.NumChannels() == 11 && B.NumChannelBlocks() == 2;
+    bool isPaddingZero = true;
+    for (size_t i = 0; i < T.NumRows(); ++i)
+    {
+        for (size_t j = 0; j < T.NumColumns(); ++j)
+        {
+            for (size_t k = 0; k < T.NumChannels(); ++k)
+            {
+                isEqual = isEqual && B(i, j, k) == T(i, j, k) && B.GetBlockPointer(k / 8, i, j)[k % 8] == T(i, j, k);
+            }
+            for (size_t k = T.NumChannels(); k < 16; ++k)
+            {
+                isPaddingZero = isPaddingZero && B.GetBlockPointer(1, i, j)[k % 8] == 0;
+            }
+        }
+    }
+
+    math::Tensor<ElementType, dimension0, dimension1, dimension2> S(5, 37, 11);
+    B.CopyTo(S);
+
+    testing::ProcessTest("ChannelBlockedTensor(Tensor)", isEqual);
+    testing::ProcessTest("ChannelBlockedTensor padding", isPaddingZero);
+    testing::ProcessTest("ChannelBlockedTensor::CopyTo", S == T);
+}
+
+template<typename ElementType>
+void TestTransposeCopy()
+{
+    math::RowMatrix<ElementType> M(67, 45);
+    M.Generate([]() { static int counter = 0; return static_cast<ElementType>(counter++); });
+
+    math::ColumnMatrix<ElementType> N(67, 45);
+    N.CopyFrom(M);
+    math::RowMatrix<ElementType> R(67, 45);
+    R.CopyFrom(N);
+
+    bool isEqual = true;
+    for (size_t i = 0; i < M.NumRows(); ++i)
+    {
+        for (size_t j = 0; j < M.NumColumns(); ++j)
+        {
+            isEqual = isEqual && N(i, j) == M(i, j);
+        }
+    }
+
+    // permuting the layout of a tensor copies transposed matrix slices
+    math::ChannelColumnRowTensor<ElementType> T(9, 40, 33);
+    T.Generate([]() { static int counter = 0; return static_cast<ElementType>(counter++); });
+    math::ColumnRowChannelTensor<ElementType> U(T);
+
+    testing::ProcessTest("Matrix::CopyFrom(transposed layout)", isEqual && R == M);
+    testing::ProcessTest("Tensor(permuted layout)", U == T);
+}
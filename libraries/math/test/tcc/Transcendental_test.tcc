@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     Transcendental_test.tcc (math_test)
+//  Authors:  Ofer Dekel
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// testing
+#include "testing.h"
+
+// stl
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace
+{
+    // Returns the largest error of an approximation, relative to max(|exact|, floor), in units of epsilon
+    template <typename ElementType, typename ApproximationType, typename ExactType>
+    double GetMaxError(const std::vector<ElementType>& arguments, ApproximationType approximation, ExactType exact, double floor)
+    {
+        std::vector<ElementType> results(arguments.size());
+        approximation(arguments.data(), results.data(), arguments.size());
+
+        double maxError = 0;
+        for (size_t i = 0; i < arguments.size(); ++i)
+        {
+            long double expected = exact(static_cast<long double>(arguments[i]));
+            auto error = std::fabs(static_cast<long double>(results[i]) - expected) / std::max(std::fabs(expected), static_cast<long double>(floor));
+            maxError = std::max(maxError, static_cast<double>(error));
+        }
+        return maxError / std::numeric_limits<ElementType>::epsilon();
+    }
+
+    template <typename ElementType>
+    std::vector<ElementType> GetArguments(double from, double to, size_t count)
+    {
+        // an odd count, so the vector kernels also go through their remainder code
+        std::vector<ElementType> arguments(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            arguments[i] = static_cast<ElementType>(from + (to - from) * i / (count - 1));
+        }
+        return arguments;
+    }
+}
+
+template <typename ElementType>
+void TestTranscendental()
+{
+    using Kernels = math::VectorKernels<ElementType>;
+    auto expArguments = GetArguments<ElementType>(-80, 80, 10001);
+    auto logArguments = GetArguments<ElementType>(1e-3, 1e3, 10001);
+    for (auto value : { 1e-30, 0.7071067811865475, 0.70710678118654757, 1.0, 1.0000001, 1.5, 1e30 })
+    {
+        logArguments.push_back(static_cast<ElementType>(value));
+    }
+    auto tanhArguments = GetArguments<ElementType>(-20, 20, 10001);
+
+    auto supportedInstructionSet = math::GetSupportedInstructionSet();
+    for (int index = 0; index <= static_cast<int>(supportedInstructionSet); ++index)
+    {
+        auto instructionSet = static_cast<math::InstructionSet>(index);
+        math::SetInstructionSet(instructionSet);
+        auto name = "VectorKernels<" + std::string(typeid(ElementType).name()) + "> [" + math::GetInstructionSetName(instructionSet) + "] ";
+
+        auto expError = GetMaxError(expArguments, &Kernels::Exp, [](long double x) { return std::exp(x); }, 0);
+        auto logError = GetMaxError(logArguments, &Kernels::Log, [](long double x) { return std::log(x); }, 0);
+        auto tanhError = GetMaxError(tanhArguments, &Kernels::Tanh, [](long double x) { return std::tanh(x); }, 1);
+        auto sigmoidError = GetMaxError(tanhArguments, &Kernels::Sigmoid, [](long double x) { return 1 / (1 + std::exp(-x)); }, 0);
+        testing::ProcessTest(name + "Exp", expError < 4);
+        testing::ProcessTest(name + "Log", logError < 4);
+        testing::ProcessTest(name + "Tanh", tanhError < 4);
+        testing::ProcessTest(name + "Sigmoid", sigmoidError < 4);
+
+        // arguments outside the approximated range saturate rather than overflow
+        std::vector<ElementType> extremes = { -1000, 1000, 0, -1 };
+        std::vector<ElementType> results(extremes.size());
+        Kernels::Exp(extremes.data(), results.data(), 2);
+        Kernels::Log(extremes.data() + 2, results.data() + 2, 2);
+        bool isSaturated = results[0] >= 0 && results[0] < 1e-30 && std::isfinite(results[1]) && results[1] > 1e30 && std::isfinite(results[2]) && results[2] == results[3];
+        Kernels::Tanh(extremes.data(), results.data(), 2);
+        Kernels::Sigmoid(extremes.data() + 2, results.data() + 2, 2);
+        isSaturated = isSaturated && results[0] == -1 && results[1] == 1;
+        Kernels::Sigmoid(extremes.data(), results.data(), 2);
+        isSaturated = isSaturated && results[0] >= 0 && results[0] < 1e-30 && results[1] == 1;
+        testing::ProcessTest(name + "saturation", isSaturated);
+
+        // NaN passes through the clamps, in the vector code and in the remainder
+        std::vector<ElementType> nans(17, std::numeric_limits<ElementType>::quiet_NaN());
+        std::vector<ElementType> nanResults(nans.size());
+        bool isNaN = true;
+        for (auto function : { &Kernels::Exp, &Kernels::Log, &Kernels::Tanh, &Kernels::Sigmoid })
+        {
+            function(nans.data(), nanResults.data(), nans.size());
+            isNaN = isNaN && std::all_of(nanResults.begin(), nanResults.end(), [](ElementType x) { return std::isnan(x); });
+        }
+        testing::ProcessTest(name + "NaN", isNaN);
+    }
+    math::SetInstructionSet(supportedInstructionSet);
+}
+
+template <typename ElementType>
+void TestTranscendentalPrecision()
+{
+    auto arguments = GetArguments<ElementType>(-10, 10, 101);
+    std::vector<ElementType> exact(arguments.size());
+    std::vector<ElementType> fast(arguments.size());
+    std::vector<ElementType> expected(arguments.size());
+    std::transform(arguments.begin(), arguments.end(), expected.begin(), [](ElementType x) { return static_cast<ElementType>(std::exp(x)); });
+
+    math::SetTranscendentalPrecision(math::TranscendentalPrecision::exact);
+    math::Exp(arguments.data(), exact.data(), arguments.size());
+    math::SetTranscendentalPrecision(math::TranscendentalPrecision::fast);
+    math::Exp(arguments.data(), fast.data(), arguments.size());
+    math::SetTranscendentalPrecision(math::TranscendentalPrecision::exact);
+
+    bool isClose = true;
+    for (size_t i = 0; i < arguments.size(); ++i)
+    {
+        isClose = isClose && std::fabs(fast[i] - expected[i]) <= 4 * std::numeric_limits<ElementType>::epsilon() * expected[i];
+    }
+    testing::ProcessTest("Exp with exact precision", exact == expected);
+    testing::ProcessTest("Exp with fast precision", isClose);
+
+    // in-place evaluation
+    math::SetTranscendentalPrecision(math::TranscendentalPrecision::fast);
+    math::Sigmoid(arguments.data(), arguments.data(), arguments.size());
+    math::SetTranscendentalPrecision(math::TranscendentalPrecision::exact);
+    testing::ProcessTest("Sigmoid in place", arguments.front() > 0 && arguments.front() < static_cast<ElementType>(1e-4) && arguments[50] == static_cast<ElementType>(0.5));
+}
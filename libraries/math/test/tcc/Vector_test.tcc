@@ -272,3 +272,73 @@ void TestVectorArchiver()
     math::VectorArchiver::Read(Va, "test", unarchiver);
     testing::ProcessTest("void TestVectorArchiver(), write and read vector", Va == V);
 }
+
+template <typename ElementType>
+void TestVectorKernels()
+{
+    using Ops = math::OperationsImplementation<math::ImplementationType::native>;
+
+    // the size is not a multiple of any vector width, so every kernel also runs its remainder loop
+    const size_t size = 67;
+    math::ColumnVector<ElementType> u(size);
+    math::ColumnVector<ElementType> v(size);
+    u.Generate([]() { static int counter = 0; return static_cast<ElementType>((counter++ * 7) % 11) - 5; });
+    v.Generate([]() { static int counter = 0; return static_cast<ElementType>((counter++ * 5) % 7) - 3; });
+
+    math::ColumnVector<ElementType> product(size);
+    math::ColumnVector<ElementType> affine(size);
+    math::ColumnVector<ElementType> shifted(size);
+    math::ColumnVector<ElementType> scaledSum(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        product[i] = u[i] * v[i];
+        affine[i] = 2 * u[i] + 3;
+        shifted[i] = u[i] + 4;
+        scaledSum[i] = u[i] - 2 * v[i];
+    }
+
+    math::RowMatrix<ElementType> M(size, 3);
+    M.Generate([]() { static int counter = 0; return static_cast<ElementType>(counter++ % 13); });
+    math::RowVector<ElementType> columnSums(3);
+    for (size_t i = 0; i < size; ++i)
+    {
+        for (size_t j = 0; j < 3; ++j)
+        {
+            columnSums[j] += M(i, j);
+        }
+    }
+    math::ColumnMatrix<ElementType> N(M);
+
+    auto supportedInstructionSet = math::GetSupportedInstructionSet();
+    for (int index = 0; index <= static_cast<int>(supportedInstructionSet); ++index)
+    {
+        auto instructionSet = static_cast<math::InstructionSet>(index);
+        math::SetInstructionSet(instructionSet);
+        auto name = "VectorKernels [" + math::GetInstructionSetName(instructionSet) + "] ";
+
+        math::ColumnVector<ElementType> t(size);
+        Ops::ElementWiseMultiply(u, v, t);
+        testing::ProcessTest(name + "Operations::ElementWiseMultiply(VectorReference, VectorReference)", t == product);
+
+        t.CopyFrom(u);
+        Ops::MultiplyAdd(static_cast<ElementType>(2), static_cast<ElementType>(3), t);
+        testing::ProcessTest(name + "Operations::MultiplyAdd(scalar, scalar, VectorReference)", t == affine);
+
+        t.CopyFrom(u);
+        Ops::Add(static_cast<ElementType>(4), t);
+        testing::ProcessTest(name + "Operations::Add(scalar, VectorReference)", t == shifted);
+
+        t.CopyFrom(u);
+        Ops::Add(static_cast<ElementType>(-2), v, t);
+        testing::ProcessTest(name + "Operations::Add(scalar, VectorReference, VectorReference)", t == scaledSum);
+
+        math::RowVector<ElementType> w(3);
+        Ops::ColumnWiseSum(M, w);
+        testing::ProcessTest(name + "Operations::ColumnWiseSum(RowMatrix)", w == columnSums);
+
+        w.Reset();
+        Ops::ColumnWiseSum(N, w);
+        testing::ProcessTest(name + "Operations::ColumnWiseSum(ColumnMatrix)", w == columnSums);
+    }
+    math::SetInstructionSet(supportedInstructionSet);
+}
@@ -113,6 +113,8 @@ namespace model
         virtual void CallNodeFunction(IRMapCompiler& compiler, emitters::IRFunctionEmitter& currentFunction);
 
     private:
+        void AddNodeFunctionArgumentAttributes(IRMapCompiler& compiler, emitters::IRFunctionEmitter& function) const;
+
         const std::string _nodeFunctionPrefix = "_Node__";
         const char _badIdentifierChars[3] = {'<', '>', ','};
     };
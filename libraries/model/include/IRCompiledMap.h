@@ -26,6 +26,7 @@
 
 // utilities
 #include "ConformingVector.h"
+#include "Exception.h"
 #include "TypeName.h"
 
 // stl
@@ -121,6 +122,16 @@ namespace model
         /// <returns> The jitter. </returns>
         emitters::IRExecutionEngine& GetJitter();
 
+        /// <summary>
+        /// Computes the output of the map for a batch of examples, with a single call to the compiled batch function.
+        /// The map must have been compiled with `emitBatchFunction` set.
+        /// </summary>
+        ///
+        /// <param name="inputs"> The input examples, one after another. </param>
+        /// <returns> The output for each example, one after another. </returns>
+        template <typename InputType, typename OutputType>
+        std::vector<OutputType> ComputeBatch(const std::vector<InputType>& inputs) const;
+
         //
         // Profiling support
         //
@@ -195,6 +206,7 @@ namespace model
         IRCompiledMap(DynamicMap map, const std::string& functionName, std::unique_ptr<emitters::IRModuleEmitter> module);
 
         void EnsureExecutionEngine() const;
+        void EnsureOptimized() const;
         void EnsureValidMap(); // fixes up model if necessary and checks inputs/outputs are compilable
         template <typename InputType, typename OutputType>
         void SetComputeFunction();
@@ -204,10 +216,30 @@ namespace model
 
         template <typename InputType>
         using ComputeFunction = std::function<void(const InputType*)>;
+        template <typename InputType, typename OutputType>
+        ComputeFunction<InputType> GetComputeFunction(uint64_t functionPointer) const;
+        void InitializeContext() const;
 
         std::string _moduleName = "ELL";
         std::unique_ptr<emitters::IRModuleEmitter> _module;
 
+        // If set, the execution engine loads the object code from (or stores it to) this cache entry
+        std::string _objectCacheDirectory;
+        std::string _objectCacheKey;
+
+        // If set, the module hasn't had its module-wide optimization yet, because the execution engine loads cached object code
+        mutable bool _isOptimizationDeferred = false;
+
+        // If set, the execution engine compiles each function the first time it's called
+        bool _lazyCompile = false;
+
+        // If set, the map function takes the context holding the map's buffers and state as its first argument
+        bool _reentrant = false;
+        mutable std::vector<int64_t> _context; // int64_t, so the context is aligned for any scalar type
+
+        // If set, the name of the batch version of the map function
+        std::string _batchFunctionName;
+
         mutable std::unique_ptr<emitters::IRExecutionEngine> _executionEngine;
 
         // Only one of the entries in each of these tuples is active, depending on the input and output types of the map
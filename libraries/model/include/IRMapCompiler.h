@@ -151,6 +151,7 @@ namespace model
         std::string GetNamespacePrefix() const;
 
     protected:
+        virtual void OnBeginCompileMap(const DynamicMap& map) override;
         virtual void OnBeginCompileModel(const Model& model) override;
         virtual void OnEndCompileModel(const Model& model) override;
         virtual void OnBeginCompileNode(const Node& node) override;
@@ -176,6 +177,12 @@ namespace model
         void EmitGetInputSizeFunction(const DynamicMap& map);
         void EmitGetOutputSizeFunction(const DynamicMap& map);
         void EmitGetNumNodesFunction(const DynamicMap& map);
+        bool CompileBatchTileFunction(const DynamicMap& map);
+        void EmitPredictBatchFunction(emitters::IRModuleEmitter& module, const DynamicMap& map, bool hasBatchTileFunction);
+        std::string GetBatchTileFunctionName() const;
+
+        // Returns a key identifying the object code the execution engine generates for the emitted module
+        std::string GetObjectCacheKey(const emitters::IRModuleEmitter& module) const;
 
         // stack of node regions
         std::vector<NodeMap<emitters::IRBlockRegion*>> _nodeRegions;
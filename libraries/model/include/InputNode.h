@@ -101,6 +101,7 @@ namespace model
     protected:
         virtual void Compute() const override;
         virtual void Compile(IRMapCompiler& compiler, emitters::IRFunctionEmitter& function) override;
+        virtual bool Batch(ModelTransformer& transformer, size_t batchSize) const override;
         virtual void WriteToArchive(utilities::Archiver& archiver) const override;
         virtual void ReadFromArchive(utilities::Unarchiver& archiver) override;
 
@@ -26,6 +26,7 @@
 #include <stack>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace ell
 {
@@ -38,6 +39,11 @@ namespace model
         bool inlineNodes = false;
         bool fuseLinearFunctionNodes = false;
         bool profile = false;
+        std::string objectCacheDirectory = ""; // if non-empty, the JIT-compiled object code is cached in this directory
+        std::vector<std::string> functionVariants; // x86 instruction sets ("sse4.2", "avx2", "avx512") to emit variants of the map function for, picked at runtime
+        bool lazyCompile = false; // if true, the JIT compiles each function the first time it's called (not compatible with the object cache)
+        bool reentrant = false; // if true, the map's buffers and state live in a caller-allocated context, passed to the map function as its first argument (not supported with profile or parallelize)
+        bool emitBatchFunction = false; // if true, also emit <mapFunctionName>_batch, which runs the map over an array of examples, a tile of examples at a time where the nodes allow it
 
         emitters::CompilerParameters compilerSettings;
     };
@@ -116,6 +122,7 @@ namespace model
         //
         // These methods may be implemented by specific compilers
         //
+        virtual void OnBeginCompileMap(const DynamicMap& map) {}
         virtual void OnBeginCompileModel(const Model& model) {}
         virtual void OnEndCompileModel(const Model& model) {}
         virtual void OnBeginCompileNode(const Node& node) {}
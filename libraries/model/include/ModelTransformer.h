@@ -101,6 +101,12 @@ namespace model
         /// <returns> A `PortElementsBase` object representing the transformed elements in the space of the new model. </returns>
         PortElementsBase GetCorrespondingPortElements(const PortElementsBase& elements) const;
 
+        /// <summary> Gets all the elements in the output model space mapped from an output port, which can be more than the port's size. </summary>
+        ///
+        /// <param name="port"> The port in the input model. </param>
+        /// <returns> A `PortElementsBase` object representing the elements mapped from the port. </returns>
+        PortElementsBase GetMappedElements(const OutputPortBase* port) const;
+
         /// <summary> Sets up an old-to-new model output mapping. Called by node implementors </summary>
         ///
         /// <param name="oldPort"> The port in the old model to map to the new model. </param>
@@ -179,12 +185,29 @@ namespace model
         /// <returns> The refined Model. </returns>
         Model TransformModel(const Model& model, const std::function<void(const Node&, ModelTransformer&)>& transformFunction, const TransformContext& context);
 
+        /// <summary>
+        /// Returns a model that computes the input model for a batch of examples, by calling Batch() on each of the model's nodes.
+        /// The input and output ports of the new model hold `batchSize` examples, one after another.
+        /// </summary>
+        ///
+        /// <param name="model"> The model. </param>
+        /// <param name="batchSize"> The number of examples in a batch. </param>
+        ///
+        /// <returns> The batched Model. It's only complete if `IsModelBatched` returns true. </returns>
+        Model BatchModel(const Model& model, size_t batchSize);
+
         /// <summary> Indicates if the last call to RefineModel produced a model that is compilable. </summary>
         ///
         /// <returns> true if the model returned by RefineModel is compilable. </returns>
         /// <remarks> Only available after calling CopyModel or RefineModel. </remarks>
         bool IsModelCompilable() const { return _isModelCompilable; }
 
+        /// <summary> Indicates if the last call to BatchModel batched all the nodes of the model. </summary>
+        ///
+        /// <returns> true if the model returned by BatchModel computes the input model for a batch of examples. </returns>
+        /// <remarks> Only available after calling BatchModel. </remarks>
+        bool IsModelBatched() const { return _isModelBatched; }
+
         /// <summary> Returns the port elements from the new model corresponding to the given port on the input model </summary>
         /// <remarks> Only available after calling CopyModel or RefineModel </remarks>
         template <typename ValueType>
@@ -229,6 +252,27 @@ namespace model
         /// <returns> A `PortElementsBase` object representing the transformed elements in the space of the new model. </returns>
         PortElementsBase TransformPortElements(const PortElementsBase& elements);
 
+        /// <summary>
+        /// Gets the elements in the batched model holding the values of a port of the input model. Called by node implementors
+        /// from Batch(). Ports that vary with the example hold `batchSize` times as many elements; unbatched ports, like
+        /// those of constants, hold the same elements.
+        /// </summary>
+        ///
+        /// <param name="elements"> The elements in the input model, which must be a full port. </param>
+        /// <returns> The elements in the batched model, or empty elements if the elements aren't a full port. </returns>
+        template <typename ValueType>
+        PortElements<ValueType> GetBatchedPortElements(const PortElements<ValueType>& elements);
+
+        /// <summary>
+        /// Gets the elements in the batched model holding the values of a port of the input model. Called by node implementors
+        /// from Batch(). Ports that vary with the example hold `batchSize` times as many elements; unbatched ports, like
+        /// those of constants, hold the same elements.
+        /// </summary>
+        ///
+        /// <param name="elements"> The elements in the input model, which must be a full port. </param>
+        /// <returns> The elements in the batched model, or empty elements if the elements aren't a full port. </returns>
+        PortElementsBase GetBatchedPortElements(const PortElementsBase& elements);
+
         /// <summary> Creates a new node in the transformed model. Called by node implementors. </summary>
         ///
         /// <typeparam name="Args"> The arguments to the constructor of NodeType. </typeparam>
@@ -274,6 +318,7 @@ namespace model
         TransformContext _context;
         PortOutputsMap _elementsMap;
         bool _isModelCompilable;
+        bool _isModelBatched = false;
     };
 }
 }
@@ -146,6 +146,16 @@ namespace model
         /// <summary> Refines this node in the model being constructed by the transformer </summary>
         virtual bool Refine(ModelTransformer& transformer) const;
 
+        /// <summary>
+        /// Adds nodes computing this node for a batch of examples to the model being constructed by the transformer.
+        /// In the new model, each port that varies with the example holds `batchSize` of its values, one after another.
+        /// </summary>
+        ///
+        /// <param name="transformer"> The `ModelTransformer` object currently creating a new model </param>
+        /// <param name="batchSize"> The number of examples in a batch </param>
+        /// <returns> `true` if the node was batched, `false` if it can't be, like nodes with state, whose output for one example depends on the earlier ones </returns>
+        virtual bool Batch(ModelTransformer& transformer, size_t batchSize) const;
+
         /// <summary> Computes the output of this node and stores it in the output ports </summary>
         virtual void Compute() const = 0;
         virtual bool HasState() const;
@@ -165,6 +175,7 @@ namespace model
         void RegisterDependencies() const;
         void InvokeCopy(ModelTransformer& transformer) const;
         bool InvokeRefine(ModelTransformer& transformer) const;
+        bool InvokeBatch(ModelTransformer& transformer, size_t batchSize) const;
 
         NodeId _id;
         std::vector<InputPortBase*> _inputs;
@@ -87,6 +87,7 @@ namespace model
     protected:
         virtual void Compute() const override;
         virtual void Compile(IRMapCompiler& compiler, emitters::IRFunctionEmitter& function) override;
+        virtual bool Batch(ModelTransformer& transformer, size_t batchSize) const override;
 
         InputPort<ValueType> _input;
         OutputPort<ValueType> _output;
@@ -66,6 +66,7 @@ namespace model
                 else
                 {
                     auto function = moduleEmitter.BeginFunction(functionName, emitters::VariableType::Void, args);
+                    AddNodeFunctionArgumentAttributes(*irCompiler, function);
                     irCompiler->NewNodeRegion(*this);
                     Compile(*irCompiler, function);
                     irCompiler->TryMergeNodeRegion(*this);
@@ -252,6 +253,32 @@ namespace model
         return {};
     }
 
+    // Every port has its own buffer, so the port arguments of the node function never overlap. (Inputs may share
+    // a buffer with each other, but only outputs are written to.) The argument order must match `GetNodeFunctionParameterList`.
+    void CompilableNode::AddNodeFunctionArgumentAttributes(IRMapCompiler& compiler, emitters::IRFunctionEmitter& function) const
+    {
+        size_t argumentIndex = 0;
+        for (auto port : GetInputPorts())
+        {
+            if (!IsScalar(*port))
+            {
+                function.AddNoAliasAttribute(argumentIndex);
+                function.AddDereferenceableAttribute(argumentIndex, port->Size());
+            }
+            ++argumentIndex;
+        }
+
+        // skip node state
+        argumentIndex += GetNodeFunctionStateParameterList(compiler).size();
+
+        for (auto port : GetOutputPorts())
+        {
+            function.AddNoAliasAttribute(argumentIndex);
+            function.AddDereferenceableAttribute(argumentIndex, port->Size());
+            ++argumentIndex;
+        }
+    }
+
     void CompilableNode::CallNodeFunction(IRMapCompiler& compiler, emitters::IRFunctionEmitter& currentFunction)
     {
         auto functionName = GetCompiledFunctionName();
@@ -10,6 +10,7 @@
 #include "CompilableNodeUtilities.h"
 #include "EmitterException.h"
 #include "IRMapCompiler.h"
+#include "IRObjectCache.h"
 
 // model
 #include "ModelTransformer.h"
@@ -31,7 +32,7 @@ namespace ell
 namespace model
 {
     IRCompiledMap::IRCompiledMap(IRCompiledMap&& other)
-        : CompiledMap(std::move(other), other._functionName), _moduleName(std::move(other._moduleName)), _module(std::move(other._module)), _executionEngine(std::move(other._executionEngine))
+        : CompiledMap(std::move(other), other._functionName), _moduleName(std::move(other._moduleName)), _module(std::move(other._module)), _objectCacheDirectory(std::move(other._objectCacheDirectory)), _objectCacheKey(std::move(other._objectCacheKey)), _isOptimizationDeferred(other._isOptimizationDeferred), _lazyCompile(other._lazyCompile), _reentrant(other._reentrant), _context(std::move(other._context)), _batchFunctionName(std::move(other._batchFunctionName)), _executionEngine(std::move(other._executionEngine))
     {
         if (_executionEngine)
         {
@@ -61,12 +62,44 @@ namespace model
     {
         if (!_executionEngine)
         {
+            // If the cached object code is gone, the execution engine generates the code, from the optimized module
+            if (_isOptimizationDeferred && !emitters::IRObjectCache(_objectCacheDirectory, _objectCacheKey).HasObject())
+            {
+                EnsureOptimized();
+            }
+
             auto moduleClone = std::unique_ptr<llvm::Module>(llvm::CloneModule(_module->GetLLVMModule()));
-            _executionEngine = std::make_unique<emitters::IRExecutionEngine>(std::move(moduleClone));
+            _executionEngine = std::make_unique<emitters::IRExecutionEngine>(std::move(moduleClone), _lazyCompile);
+            if (!_objectCacheKey.empty())
+            {
+                _executionEngine->SetObjectCache(std::make_unique<emitters::IRObjectCache>(_objectCacheDirectory, _objectCacheKey));
+            }
+            if (_reentrant)
+            {
+                InitializeContext();
+            }
             SetComputeFunction();
         }
     }
 
+    void IRCompiledMap::EnsureOptimized() const
+    {
+        if (_isOptimizationDeferred)
+        {
+            _module->Optimize();
+            _isOptimizationDeferred = false;
+        }
+    }
+
+    void IRCompiledMap::InitializeContext() const
+    {
+        auto getContextSize = reinterpret_cast<int32_t (*)()>(_executionEngine->ResolveFunctionAddress(_moduleName + "_GetContextSize"));
+        auto initializeContext = reinterpret_cast<void (*)(int8_t*)>(_executionEngine->ResolveFunctionAddress(_moduleName + "_InitializeContext"));
+        auto size = static_cast<size_t>(getContextSize());
+        _context.resize((size + sizeof(int64_t) - 1) / sizeof(int64_t));
+        initializeContext(reinterpret_cast<int8_t*>(_context.data()));
+    }
+
     void IRCompiledMap::SetComputeFunction() const
     {
         switch (GetInput(0)->GetOutputPort().GetType())
@@ -214,16 +247,19 @@ namespace model
 
     void IRCompiledMap::WriteCode(const std::string& filePath) const
     {
+        EnsureOptimized();
         _module->WriteToFile(filePath);
     }
 
     void IRCompiledMap::WriteCode(const std::string& filePath, emitters::ModuleOutputFormat format) const
     {
+        EnsureOptimized();
         _module->WriteToFile(filePath, format);
     }
 
     void IRCompiledMap::WriteCode(const std::string& filePath, emitters::ModuleOutputFormat format, emitters::MachineCodeOutputOptions options) const
     {
+        EnsureOptimized();
         _module->WriteToFile(filePath, format, options);
     }
 
@@ -235,11 +271,13 @@ namespace model
 
     void IRCompiledMap::WriteCode(std::ostream& stream, emitters::ModuleOutputFormat format) const
     {
+        EnsureOptimized();
         _module->WriteToStream(stream, format);
     }
 
     void IRCompiledMap::WriteCode(std::ostream& stream, emitters::ModuleOutputFormat format, emitters::MachineCodeOutputOptions options) const
     {
+        EnsureOptimized();
         _module->WriteToStream(stream, format, options);
     }
 
@@ -10,16 +10,38 @@
 #include "CompilableNode.h"
 #include "CompilableNodeUtilities.h"
 #include "IRModelProfiler.h"
+#include "ModelTransformer.h"
 #include "OutputNode.h"
 
 // emitters
 #include "EmitterException.h"
+#include "IRFunctionVariants.h"
+#include "IRObjectCache.h"
+#include "IRReentrantFunction.h"
+#include "TargetDevice.h"
 #include "Variable.h"
 
+// llvm
+#include "llvm/Config/llvm-config.h"
+#include "llvm/Support/raw_ostream.h"
+
+// stl
+#include <cassert>
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+
 namespace ell
 {
 namespace model
 {
+    namespace
+    {
+        // The number of examples the batch tile function computes in one call. The tile function's port buffers
+        // are global variables, so their size is fixed when the map is compiled.
+        const size_t batchTileSize = 16;
+    }
+
     IRMapCompiler::IRMapCompiler()
         : IRMapCompiler(MapCompilerParameters{})
     {
@@ -84,9 +106,23 @@ namespace model
         return GetMapCompilerParameters().mapFunctionName;
     }
 
+    std::string IRMapCompiler::GetBatchTileFunctionName() const
+    {
+        return GetPredictFunctionName() + "_batchTile";
+    }
+
     IRCompiledMap IRMapCompiler::Compile(DynamicMap map)
     {
         EnsureValidMap(map);
+        if (GetMapCompilerParameters().reentrant && GetMapCompilerParameters().profile)
+        {
+            throw emitters::EmitterException(emitters::EmitterError::notSupported, "Profiling isn't supported for reentrant maps, since the performance counters are global");
+        }
+        if (GetMapCompilerParameters().reentrant && GetCompilerParameters().parallelize)
+        {
+            throw emitters::EmitterException(emitters::EmitterError::notSupported, "Parallelization isn't supported for reentrant maps, since the tasks passed to the thread pool can't get the context");
+        }
+
         model::TransformContext context{ [](const model::Node& node) { return node.IsCompilable() ? model::NodeAction::compile : model::NodeAction::refine; } };
         map.Refine(context);
 
@@ -101,6 +137,14 @@ namespace model
         // Now we have the refined map, compile it
         CompileMap(map, GetPredictFunctionName());
 
+        // Compile the map for a tile of examples at once, for the batch function. Reentrant maps keep their buffers in
+        // the context, which only holds those of the map function, and profiled maps count calls to the map function.
+        bool hasBatchTileFunction = false;
+        if (GetMapCompilerParameters().emitBatchFunction && !GetMapCompilerParameters().reentrant && !GetMapCompilerParameters().profile)
+        {
+            hasBatchTileFunction = CompileBatchTileFunction(map);
+        }
+
         // Emit runtime model APIs
         EmitModelAPIFunctions(map);
 
@@ -110,7 +154,88 @@ namespace model
         auto module = std::make_unique<emitters::IRModuleEmitter>(std::move(_moduleEmitter));
         module->SetTargetTriple(GetCompilerParameters().targetDevice.triple);
         module->SetTargetDataLayout(GetCompilerParameters().targetDevice.dataLayout);
-        return IRCompiledMap(std::move(map), GetMapCompilerParameters().mapFunctionName, std::move(module));
+
+        // Move the map's buffers and state into a context the caller passes in
+        if (GetMapCompilerParameters().reentrant)
+        {
+            emitters::EmitReentrantFunction(*module, GetPredictFunctionName(), GetNamespacePrefix());
+        }
+
+        // Emit the batch version of the map function (after the reentrant transform, so it can forward the context)
+        if (GetMapCompilerParameters().emitBatchFunction)
+        {
+            EmitPredictBatchFunction(*module, map, hasBatchTileFunction);
+        }
+
+        // Specialize the map function for the requested instruction sets (before optimizing, so each variant is optimized for its own target)
+        const auto& functionVariants = GetMapCompilerParameters().functionVariants;
+        if (!functionVariants.empty())
+        {
+            emitters::EmitFunctionVariants(*module, GetPredictFunctionName(), functionVariants);
+        }
+
+        // Key the object cache by the emitted IR. If the execution engine will load the object code from the
+        // cache, the module-wide optimization only matters for writing the code out, so it's deferred until then.
+        // Profiling builds aren't cached, since their code depends on the profiler's state, and lazily-compiled
+        // maps aren't cached, since they never generate code for the whole module.
+        auto objectCacheDirectory = GetMapCompilerParameters().objectCacheDirectory;
+        std::string objectCacheKey;
+        bool isObjectCached = false;
+        if (!objectCacheDirectory.empty() && !GetMapCompilerParameters().profile && !GetMapCompilerParameters().lazyCompile)
+        {
+            objectCacheKey = GetObjectCacheKey(*module);
+            isObjectCached = emitters::IRObjectCache(objectCacheDirectory, objectCacheKey).HasObject();
+        }
+
+        // Run the standard optimization pipeline over the whole module, now that all the functions have been emitted
+        bool optimize = module->GetCompilerParameters().optimize;
+        if (optimize && !isObjectCached)
+        {
+            module->Optimize();
+        }
+
+        IRCompiledMap compiledMap(std::move(map), GetMapCompilerParameters().mapFunctionName, std::move(module));
+        compiledMap._objectCacheDirectory = objectCacheDirectory;
+        compiledMap._objectCacheKey = objectCacheKey;
+        compiledMap._isOptimizationDeferred = optimize && isObjectCached;
+        compiledMap._lazyCompile = GetMapCompilerParameters().lazyCompile;
+        compiledMap._reentrant = GetMapCompilerParameters().reentrant;
+        if (GetMapCompilerParameters().emitBatchFunction)
+        {
+            compiledMap._batchFunctionName = GetPredictFunctionName() + "_batch";
+        }
+        return compiledMap;
+    }
+
+    std::string IRMapCompiler::GetObjectCacheKey(const emitters::IRModuleEmitter& module) const
+    {
+        // The IR holds everything the code depends on except the settings of the code generator, which
+        // targets the host CPU, and the optimization the module gets before it's compiled
+        std::string irText;
+        llvm::raw_string_ostream irStream(irText);
+        module.GetLLVMModule()->print(irStream, nullptr);
+        irStream.flush();
+
+        const auto& compilerSettings = module.GetCompilerParameters();
+        auto hostDevice = emitters::GetHostTargetDevice();
+        std::stringstream keyStream;
+        keyStream << irText << '\n'
+                  << LLVM_VERSION_STRING << '\n'
+                  << hostDevice.cpu << '\n'
+                  << hostDevice.features << '\n'
+                  << compilerSettings.optimize << static_cast<int>(compilerSettings.optimizerLevel) << '\n';
+
+        // 64-bit FNV-1a hash: stable across processes and platforms, unlike std::hash
+        uint64_t hash = 14695981039346656037ull;
+        for (auto ch : keyStream.str())
+        {
+            hash ^= static_cast<unsigned char>(ch);
+            hash *= 1099511628211ull;
+        }
+
+        std::stringstream hashStream;
+        hashStream << module.GetModuleName() << '_' << std::hex << std::setw(16) << std::setfill('0') << hash;
+        return hashStream.str();
     }
 
     void IRMapCompiler::EmitModelAPIFunctions(const DynamicMap& map)
@@ -154,6 +279,146 @@ namespace model
         _moduleEmitter.EndFunction();
     }
 
+    bool IRMapCompiler::CompileBatchTileFunction(const DynamicMap& map)
+    {
+        // Nodes with state, or that don't know how to batch themselves, leave the batch function calling the map function per example
+        ModelTransformer transformer;
+        auto batchModel = transformer.BatchModel(map.GetModel(), batchTileSize);
+        if (!transformer.IsModelBatched())
+        {
+            return false;
+        }
+
+        auto batchOutput = transformer.GetBatchedPortElements(map.GetOutput(0));
+        if (batchOutput.Size() != map.GetOutputSize() * batchTileSize)
+        {
+            return false;
+        }
+        DynamicMap batchMap(batchModel, { { "input", transformer.GetCorrespondingInputNode(map.GetInput(0)) } }, { { "output", batchOutput } });
+
+        // The tile function's nodes get their own port variables
+        PushScope();
+        CompileMap(batchMap, GetBatchTileFunctionName());
+        PopScope();
+        return true;
+    }
+
+    void IRMapCompiler::EmitPredictBatchFunction(emitters::IRModuleEmitter& module, const DynamicMap& map, bool hasBatchTileFunction)
+    {
+        // The batch function takes a count, followed by the map function's inputs and outputs as arrays of `count`
+        // consecutive examples (so scalar inputs, passed to the map function by value, become arrays too). It calls
+        // the batch tile function, if there is one, on each full tile of examples, and the map function on each of
+        // the rest. The count and the offsets into the arrays are 64 bit, since a batch can have more than 2^31 values.
+        auto pPredictFunction = module.GetFunction(GetPredictFunctionName());
+        if (pPredictFunction == nullptr)
+        {
+            throw emitters::EmitterException(emitters::EmitterError::functionNotFound, "Map function not found");
+        }
+        llvm::Function* pBatchTileFunction = nullptr;
+        if (hasBatchTileFunction)
+        {
+            pBatchTileFunction = module.GetFunction(GetBatchTileFunctionName());
+            if (pBatchTileFunction == nullptr)
+            {
+                throw emitters::EmitterException(emitters::EmitterError::functionNotFound, "Batch tile function not found");
+            }
+        }
+
+        std::vector<size_t> portSizes; // in map function argument order, see `AllocateNodeFunctionArguments`
+        for (size_t index = 0; index < map.NumInputPorts(); ++index)
+        {
+            portSizes.push_back(map.GetInput(index)->Size());
+        }
+        const auto numInputs = portSizes.size();
+        for (size_t index = 0; index < map.NumOutputPorts(); ++index)
+        {
+            portSizes.push_back(map.GetOutput(index).Size());
+        }
+
+        // In a reentrant module, the context comes first and is passed through unchanged
+        const size_t contextArgumentCount = GetMapCompilerParameters().reentrant ? 1 : 0;
+        auto int64Type = llvm::Type::getInt64Ty(module.GetLLVMContext());
+        std::vector<llvm::Type*> argumentTypes;
+        auto predictArgument = pPredictFunction->arg_begin();
+        for (size_t index = 0; index < contextArgumentCount; ++index, ++predictArgument)
+        {
+            argumentTypes.push_back(predictArgument->getType());
+        }
+        argumentTypes.push_back(int64Type);
+        for (; predictArgument != pPredictFunction->arg_end(); ++predictArgument)
+        {
+            auto argumentType = predictArgument->getType();
+            argumentTypes.push_back(argumentType->isPointerTy() ? argumentType : argumentType->getPointerTo());
+        }
+        assert(argumentTypes.size() == contextArgumentCount + 1 + portSizes.size());
+
+        auto functionName = GetPredictFunctionName() + "_batch";
+        auto function = module.BeginFunction(functionName, llvm::Type::getVoidTy(module.GetLLVMContext()), argumentTypes);
+        function.IncludeInHeader();
+
+        std::vector<llvm::Argument*> arguments;
+        for (auto& argument : function.Arguments())
+        {
+            arguments.push_back(&argument);
+        }
+        auto pCount = arguments[contextArgumentCount];
+        pCount->setName("count");
+        for (size_t portIndex = 0; portIndex < portSizes.size(); ++portIndex)
+        {
+            // the example arrays of different ports don't overlap
+            auto argumentIndex = contextArgumentCount + 1 + portIndex;
+            arguments[argumentIndex]->setName(portIndex < numInputs ? "inputs" : "outputs");
+            function.AddNoAliasAttribute(argumentIndex);
+        }
+
+        // The arguments for the examples starting at a given (64 bit) index. Scalar inputs are passed by value to the map function.
+        auto getExampleArguments = [&](llvm::Value* pExampleIndex, bool isTile) {
+            std::vector<llvm::Value*> callArguments(arguments.begin(), arguments.begin() + contextArgumentCount);
+            for (size_t portIndex = 0; portIndex < portSizes.size(); ++portIndex)
+            {
+                auto pArray = arguments[contextArgumentCount + 1 + portIndex];
+                auto portSize = portSizes[portIndex];
+                if (!isTile && portIndex < numInputs && portSize == 1)
+                {
+                    callArguments.push_back(function.ValueAt(pArray, pExampleIndex));
+                }
+                else
+                {
+                    auto offset = function.Operator(emitters::TypedOperator::multiply, pExampleIndex, function.Literal(static_cast<int64_t>(portSize)));
+                    callArguments.push_back(function.PointerOffset(pArray, offset));
+                }
+            }
+            return callArguments;
+        };
+
+        llvm::Value* pFirstRemainingExample = function.Literal(static_cast<int64_t>(0));
+        if (pBatchTileFunction != nullptr)
+        {
+            auto pTileSize = function.Literal(static_cast<int64_t>(batchTileSize));
+            auto pNumTiles = function.Operator(emitters::TypedOperator::divideSigned, pCount, pTileSize);
+            auto tileLoop = function.ForLoop();
+            tileLoop.Begin(pNumTiles);
+            {
+                auto pFirstExample = function.Operator(emitters::TypedOperator::multiply, tileLoop.LoadIterationVariable(), pTileSize);
+                function.Call(pBatchTileFunction, getExampleArguments(pFirstExample, true));
+            }
+            tileLoop.End();
+            pFirstRemainingExample = function.Operator(emitters::TypedOperator::multiply, pNumTiles, pTileSize);
+        }
+
+        auto pNumRemainingExamples = function.Operator(emitters::TypedOperator::subtract, pCount, pFirstRemainingExample);
+        auto loop = function.ForLoop();
+        loop.Begin(pNumRemainingExamples);
+        {
+            auto pExampleIndex = function.Operator(emitters::TypedOperator::add, pFirstRemainingExample, loop.LoadIterationVariable());
+            function.Call(pPredictFunction, getExampleArguments(pExampleIndex, false));
+        }
+        loop.End();
+        module.EndFunction();
+
+        module.SetFunctionComments(functionName, { "Computes the map for count examples, stored one after another in each input and output array" });
+    }
+
     //
     // Node implementor methods:
     //
@@ -180,6 +445,32 @@ namespace model
         return GetModule().EnsureEmitted(*pVar);
     }
 
+    void IRMapCompiler::OnBeginCompileMap(const DynamicMap& map)
+    {
+        // The predict function requires its input and output buffers not to overlap, so the node code
+        // that reads and writes them can be vectorized without runtime overlap checks. The argument
+        // order must match `AllocateNodeFunctionArguments`.
+        auto& currentFunction = GetModule().GetCurrentFunction();
+        size_t argumentIndex = 0;
+        for (size_t index = 0; index < map.NumInputPorts(); ++index)
+        {
+            auto inputSize = map.GetInput(index)->Size();
+            if (inputSize != 1) // scalar inputs are passed by value
+            {
+                currentFunction.AddNoAliasAttribute(argumentIndex);
+                currentFunction.AddDereferenceableAttribute(argumentIndex, inputSize);
+            }
+            ++argumentIndex;
+        }
+
+        for (size_t index = 0; index < map.NumOutputPorts(); ++index)
+        {
+            currentFunction.AddNoAliasAttribute(argumentIndex);
+            currentFunction.AddDereferenceableAttribute(argumentIndex, map.GetOutput(index).Size());
+            ++argumentIndex;
+        }
+    }
+
     void IRMapCompiler::OnBeginCompileModel(const Model& model)
     {
         auto& currentFunction = GetModule().GetCurrentFunction();
@@ -188,9 +479,17 @@ namespace model
             currentFunction.AddRegion(currentFunction.GetCurrentBlock());
         }
 
-        // Tag the model function for declaration in the generated headers
-        currentFunction.IncludeInHeader();
-        currentFunction.IncludeInPredictInterface();
+        // Tag the model function for declaration in the generated headers. The SWIG predict interface
+        // has no way to pass a context, so reentrant maps are only declared in the C header. The batch
+        // tile function is only called by the batch function, so it isn't declared.
+        if (currentFunction.GetFunctionName() != GetBatchTileFunctionName())
+        {
+            currentFunction.IncludeInHeader();
+            if (!GetMapCompilerParameters().reentrant)
+            {
+                currentFunction.IncludeInPredictInterface();
+            }
+        }
 
         _profiler.StartModel(currentFunction);
     }
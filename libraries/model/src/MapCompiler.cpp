@@ -27,6 +27,7 @@ namespace model
 
         emitters::NamedVariableTypeList mainFunctionArguments = AllocateNodeFunctionArguments(map, *pModuleEmitter);
         pModuleEmitter->BeginMapPredictFunction(functionName, mainFunctionArguments);
+        OnBeginCompileMap(map);
 
         auto inputSize = map.GetInput(0)->Size();
         auto outputSize = map.GetOutput(0).Size();
@@ -120,6 +120,16 @@ namespace model
         return result;
     }
 
+    PortElementsBase PortOutputsMap::GetMappedElements(const OutputPortBase* port) const
+    {
+        auto it = _map.find(port);
+        if (it == _map.end())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Could not find element in new model.");
+        }
+        return it->second;
+    }
+
     void PortOutputsMap::MapNodeOutput(const OutputPortBase* oldPort, const PortElementsBase& newElements)
     {
         _map[oldPort] = newElements;
@@ -248,6 +258,33 @@ namespace model
         return _elementsMap.GetCorrespondingPortElements(elements);
     }
 
+    Model ModelTransformer::BatchModel(const Model& model, size_t batchSize)
+    {
+        _context = TransformContext();
+        _model = Model();
+        _elementsMap.Clear();
+        _isModelCompilable = true;
+        _isModelBatched = true;
+
+        // Once a node can't be batched, the nodes that depend on it can't be either, so the rest are skipped
+        model.Visit([this, batchSize](const Node& node) {
+            if (_isModelBatched && !node.InvokeBatch(*this, batchSize))
+            {
+                _isModelBatched = false;
+            }
+        });
+        return std::move(_model);
+    }
+
+    PortElementsBase ModelTransformer::GetBatchedPortElements(const PortElementsBase& elements)
+    {
+        if (!elements.IsFullPortOutput())
+        {
+            return PortElementsBase();
+        }
+        return _elementsMap.GetMappedElements(elements.GetRanges()[0].ReferencedPort());
+    }
+
     PortElementsBase ModelTransformer::GetCorrespondingOutputs(const OutputPortBase& port)
     {
         return _elementsMap.GetCorrespondingPortElements(PortElementsBase(port));
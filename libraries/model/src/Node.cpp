@@ -157,6 +157,11 @@ namespace model
         return Refine(transformer);
     }
 
+    bool Node::InvokeBatch(ModelTransformer& transformer, size_t batchSize) const
+    {
+        return Batch(transformer, batchSize);
+    }
+
     // Default implementation of Refine just copies and returns false
     bool Node::Refine(ModelTransformer& transformer) const
     {
@@ -164,6 +169,12 @@ namespace model
         return false;
     }
 
+    // Default implementation of Batch adds nothing and returns false
+    bool Node::Batch(ModelTransformer& transformer, size_t batchSize) const
+    {
+        return false;
+    }
+
     void Node::Print(std::ostream& os) const
     {
         bool isFirstInputPort = true;
@@ -10,123 +10,71 @@ namespace ell
 {
 namespace model
 {
+    template <typename InputType, typename OutputType>
+    std::vector<OutputType> IRCompiledMap::ComputeBatch(const std::vector<InputType>& inputs) const
+    {
+        if (_batchFunctionName.empty())
+        {
+            throw utilities::LogicException(utilities::LogicExceptionErrors::illegalState, "Map wasn't compiled with a batch function");
+        }
+        if (GetInput(0)->GetOutputPort().GetType() != Port::GetPortType<InputType>() || GetOutput(0).GetPortType() != Port::GetPortType<OutputType>())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch);
+        }
+
+        auto inputSize = GetInput(0)->Size();
+        if (inputs.size() % inputSize != 0)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::sizeMismatch, "Batch size isn't a multiple of the map's input size");
+        }
+        auto count = inputs.size() / inputSize;
+
+        EnsureExecutionEngine();
+        auto functionPointer = _executionEngine->ResolveFunctionAddress(_batchFunctionName);
+
+        // ConformingVector, so bool inputs and outputs have contiguous storage
+        utilities::ConformingVector<InputType> batchInput(inputs.begin(), inputs.end());
+        utilities::ConformingVector<OutputType> batchOutput(count * GetOutput(0).Size());
+        if (_reentrant)
+        {
+            auto fn = reinterpret_cast<void (*)(int8_t*, int64_t, const InputType*, OutputType*)>(functionPointer);
+            fn(reinterpret_cast<int8_t*>(_context.data()), static_cast<int64_t>(count), (const InputType*)batchInput.data(), (OutputType*)batchOutput.data());
+        }
+        else
+        {
+            auto fn = reinterpret_cast<void (*)(int64_t, const InputType*, OutputType*)>(functionPointer);
+            fn(static_cast<int64_t>(count), (const InputType*)batchInput.data(), (OutputType*)batchOutput.data());
+        }
+
+        return std::vector<OutputType>(batchOutput.begin(), batchOutput.end());
+    }
+
     template <typename InputType>
     void IRCompiledMap::SetComputeFunctionForInputType() const
     {
-        auto outputSize = GetOutput(0).Size();
         auto functionPointer = _executionEngine->ResolveFunctionAddress(_functionName);
         ComputeFunction<InputType> computeFunction;
         switch (GetOutput(0).GetPortType()) // Switch on output type
         {
             case model::Port::PortType::boolean:
-            {
-                std::get<utilities::ConformingVector<bool>>(_cachedOutput).resize(outputSize);
-                if (GetInput(0)->Size() == 1)
-                {
-                    // scalar input
-                    auto fn = reinterpret_cast<void (*)(const InputType, bool*)>(functionPointer);
-                    computeFunction = [this, functionPointer, fn](const InputType* input) {
-                        fn(*input, (bool*)std::get<utilities::ConformingVector<bool>>(_cachedOutput).data());
-                    };
-                }
-                else
-                {
-                    // vector input
-                    auto fn = reinterpret_cast<void (*)(const InputType*, bool*)>(functionPointer);
-                    computeFunction = [this, functionPointer, fn](const InputType* input) {
-                        fn(input, (bool*)std::get<utilities::ConformingVector<bool>>(_cachedOutput).data());
-                    };
-                }
-            }
-            break;
+                computeFunction = GetComputeFunction<InputType, bool>(functionPointer);
+                break;
 
             case model::Port::PortType::integer:
-            {
-                std::get<utilities::ConformingVector<int>>(_cachedOutput).resize(outputSize);
-                if (GetInput(0)->Size() == 1)
-                {
-                    // scalar input
-                    auto fn = reinterpret_cast<void (*)(const InputType, int*)>(functionPointer);
-                    computeFunction = [this, functionPointer, fn](const InputType* input) {
-                        fn(*input, std::get<utilities::ConformingVector<int>>(_cachedOutput).data());
-                    };
-                }
-                else
-                {
-                    // vector input
-                    auto fn = reinterpret_cast<void (*)(const InputType*, int*)>(functionPointer);
-                    computeFunction = [this, functionPointer, fn](const InputType* input) {
-                        fn(input, std::get<utilities::ConformingVector<int>>(_cachedOutput).data());
-                    };
-                }
-            }
-            break;
+                computeFunction = GetComputeFunction<InputType, int>(functionPointer);
+                break;
 
             case model::Port::PortType::bigInt:
-            {
-                std::get<utilities::ConformingVector<int64_t>>(_cachedOutput).resize(outputSize);
-                if (GetInput(0)->Size() == 1)
-                {
-                    // scalar input
-                    auto fn = reinterpret_cast<void (*)(const InputType, int64_t*)>(functionPointer);
-                    computeFunction = [this, functionPointer, fn](const InputType* input) {
-                        fn(*input, std::get<utilities::ConformingVector<int64_t>>(_cachedOutput).data());
-                    };
-                }
-                else
-                {
-                    // vector input
-                    auto fn = reinterpret_cast<void (*)(const InputType*, int64_t*)>(functionPointer);
-                    computeFunction = [this, functionPointer, fn](const InputType* input) {
-                        fn(input, std::get<utilities::ConformingVector<int64_t>>(_cachedOutput).data());
-                    };
-                }
-            }
-            break;
+                computeFunction = GetComputeFunction<InputType, int64_t>(functionPointer);
+                break;
 
             case model::Port::PortType::smallReal:
-            {
-                std::get<utilities::ConformingVector<float>>(_cachedOutput).resize(outputSize);
-                if (GetInput(0)->Size() == 1)
-                {
-                    // scalar input
-                    auto fn = reinterpret_cast<void (*)(const InputType, float*)>(functionPointer);
-                    computeFunction = [this, functionPointer, fn](const InputType* input) {
-                        fn(*input, std::get<utilities::ConformingVector<float>>(_cachedOutput).data());
-                    };
-                }
-                else
-                {
-                    // vector input
-                    auto fn = reinterpret_cast<void (*)(const InputType*, float*)>(functionPointer);
-                    computeFunction = [this, functionPointer, fn](const InputType* input) {
-                        fn(input, std::get<utilities::ConformingVector<float>>(_cachedOutput).data());
-                    };
-                }
-            }
-            break;
+                computeFunction = GetComputeFunction<InputType, float>(functionPointer);
+                break;
 
             case model::Port::PortType::real:
-            {
-                std::get<utilities::ConformingVector<double>>(_cachedOutput).resize(outputSize);
-                if (GetInput(0)->Size() == 1)
-                {
-                    // scalar input
-                    auto fn = reinterpret_cast<void (*)(const InputType, double*)>(functionPointer);
-                    computeFunction = [this, functionPointer, fn](const InputType* input) {
-                        fn(*input, std::get<utilities::ConformingVector<double>>(_cachedOutput).data());
-                    };
-                }
-                else
-                {
-                    // vector input
-                    auto fn = reinterpret_cast<void (*)(const InputType*, double*)>(functionPointer);
-                    computeFunction = [this, functionPointer, fn](const InputType* input) {
-                        fn(input, std::get<utilities::ConformingVector<double>>(_cachedOutput).data());
-                    };
-                }
-            }
-            break;
+                computeFunction = GetComputeFunction<InputType, double>(functionPointer);
+                break;
 
             default:
                 throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch);
@@ -134,5 +82,41 @@ namespace model
 
         std::get<ComputeFunction<InputType>>(_computeInputFunction) = computeFunction;
     }
+
+    template <typename InputType, typename OutputType>
+    IRCompiledMap::ComputeFunction<InputType> IRCompiledMap::GetComputeFunction(uint64_t functionPointer) const
+    {
+        std::get<utilities::ConformingVector<OutputType>>(_cachedOutput).resize(GetOutput(0).Size());
+        if (GetInput(0)->Size() == 1)
+        {
+            // scalar input
+            if (_reentrant)
+            {
+                auto fn = reinterpret_cast<void (*)(int8_t*, const InputType, OutputType*)>(functionPointer);
+                return [this, fn](const InputType* input) {
+                    fn(reinterpret_cast<int8_t*>(_context.data()), *input, (OutputType*)std::get<utilities::ConformingVector<OutputType>>(_cachedOutput).data());
+                };
+            }
+
+            auto fn = reinterpret_cast<void (*)(const InputType, OutputType*)>(functionPointer);
+            return [this, fn](const InputType* input) {
+                fn(*input, (OutputType*)std::get<utilities::ConformingVector<OutputType>>(_cachedOutput).data());
+            };
+        }
+
+        // vector input
+        if (_reentrant)
+        {
+            auto fn = reinterpret_cast<void (*)(int8_t*, const InputType*, OutputType*)>(functionPointer);
+            return [this, fn](const InputType* input) {
+                fn(reinterpret_cast<int8_t*>(_context.data()), input, (OutputType*)std::get<utilities::ConformingVector<OutputType>>(_cachedOutput).data());
+            };
+        }
+
+        auto fn = reinterpret_cast<void (*)(const InputType*, OutputType*)>(functionPointer);
+        return [this, fn](const InputType* input) {
+            fn(input, (OutputType*)std::get<utilities::ConformingVector<OutputType>>(_cachedOutput).data());
+        };
+    }
 }
 }
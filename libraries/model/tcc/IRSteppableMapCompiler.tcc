@@ -72,6 +72,17 @@ namespace model
     IRCompiledMap IRSteppableMapCompiler<ClockType>::Compile(SteppableMap<ClockType> map)
     {
         EnsureValidMap(map);
+        if (GetMapCompilerParameters().reentrant)
+        {
+            // The step and wait-time functions share the last sample time, which would need its own context API
+            throw emitters::EmitterException(emitters::EmitterError::notSupported, "Steppable maps can't be compiled as reentrant");
+        }
+        if (GetMapCompilerParameters().emitBatchFunction)
+        {
+            // Each step computes the map for the sample time given by the clock, so there's no batch of examples to run
+            throw emitters::EmitterException(emitters::EmitterError::notSupported, "Steppable maps can't be compiled with a batch function");
+        }
+
         model::TransformContext context{ [](const model::Node& node) { return node.IsCompilable() ? model::NodeAction::compile : model::NodeAction::refine; } };
         map.Refine(context);
 
@@ -95,6 +106,13 @@ namespace model
         auto module = std::make_unique<emitters::IRModuleEmitter>(std::move(_moduleEmitter));
         module->SetTargetTriple(GetCompilerParameters().targetDevice.triple);
         module->SetTargetDataLayout(GetCompilerParameters().targetDevice.dataLayout);
+
+        // Run the standard optimization pipeline over the whole module, now that all the functions have been emitted
+        if (module->GetCompilerParameters().optimize)
+        {
+            module->Optimize();
+        }
+
         return IRCompiledMap(std::move(map), GetMapCompilerParameters().mapFunctionName, std::move(module));
     }
 
@@ -44,6 +44,14 @@ namespace model
         transformer.MapNodeOutput(output, newNode->output);
     }
 
+    template <typename ValueType>
+    bool InputNode<ValueType>::Batch(ModelTransformer& transformer, size_t batchSize) const
+    {
+        auto newNode = transformer.AddNode<InputNode<ValueType>>(_output.Size() * batchSize);
+        transformer.MapNodeOutput(output, newNode->output);
+        return true;
+    }
+
     template <typename ValueType>
     void InputNode<ValueType>::Compile(IRMapCompiler& compiler, emitters::IRFunctionEmitter& function)
     {
@@ -20,6 +20,13 @@ namespace model
         return PortElements<ValueType>(result);
     }
 
+    template <typename ValueType>
+    PortElements<ValueType> ModelTransformer::GetBatchedPortElements(const PortElements<ValueType>& elements)
+    {
+        auto result = GetBatchedPortElements(PortElementsBase(elements));
+        return PortElements<ValueType>(result);
+    }
+
     template <typename ValueType>
     PortElements<ValueType> ModelTransformer::GetCorrespondingOutputs(const OutputPort<ValueType>& port)
     {
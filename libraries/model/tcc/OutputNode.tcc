@@ -32,6 +32,19 @@ namespace model
         transformer.MapNodeOutput(output, newNode->output);
     }
 
+    template <typename ValueType>
+    bool OutputNode<ValueType>::Batch(ModelTransformer& transformer, size_t batchSize) const
+    {
+        auto newPortElements = transformer.GetBatchedPortElements(_input.GetPortElements());
+        if (newPortElements.Size() != _input.Size() * batchSize)
+        {
+            return false;
+        }
+        auto newNode = transformer.AddNode<OutputNode<ValueType>>(newPortElements);
+        transformer.MapNodeOutput(output, newNode->output);
+        return true;
+    }
+
     template <typename ValueType>
     void OutputNode<ValueType>::Compile(IRMapCompiler& compiler, emitters::IRFunctionEmitter& function)
     {
@@ -23,6 +23,7 @@ void TestCompilableMulticlassDTW();
 void TestCompilableScalarSumNode();
 void TestCompilableSumNode();
 void TestCompilableUnaryOperationNode();
+void TestCompilableUnaryOperationNodeFastMath();
 void TestCompilableBinaryOperationNode();
 void TestCompilableScalarBinaryPredicateNode();
 void TestCompilableBinaryPredicateNode();
@@ -55,7 +56,7 @@ void TestBinaryConvolutionalLayerNode2(size_t inputPadding = 1, size_t outputPad
 void TestConvolutionalLayerNode(ConvolutionType convolutionType, size_t inputPadding = 1, size_t outputPadding = 0);
 void TestConvolutionalLayerNode2(ConvolutionType convolutionType, size_t inputPadding = 1, size_t outputPadding = 0);
 void TestFullyConnectedLayerNode(size_t inputPadding = 0, size_t outputPadding = 0);
-void TestMaxPoolingLayerNode(size_t inputPadding = 0, size_t outputPadding = 0);
-void TestMeanPoolingLayerNode(size_t inputPadding = 0, size_t outputPadding = 0);
+void TestMaxPoolingLayerNode(size_t inputPadding = 0, size_t outputPadding = 0, bool parallelize = false);
+void TestMeanPoolingLayerNode(size_t inputPadding = 0, size_t outputPadding = 0, bool parallelize = false);
 void TestScalingLayerNode(size_t inputPadding = 0, size_t outputPadding = 0);
 void TestSoftmaxLayerNode(size_t inputPadding = 0, size_t outputPadding = 0);
@@ -40,3 +40,12 @@ void TestSteppableMap(bool runJit = false);
 void TestMultiOutputMap();
 void TestMultiOutputMap2();
 void TestCompiledMapMove();
+void TestCompiledMapObjectCache();
+void TestCompiledMapLazyJit();
+void TestCompiledMapLazyJitCompilesOnFirstCall();
+void TestCompiledMapFunctionVariants();
+void TestCompiledMapReentrant();
+void TestCompiledMapBatch();
+void TestCompiledMapBatchWithState();
+void TestCompiledMatrixMatrixMultiply();
+void TestCompiledTransposedMatrixMatrixMultiply();
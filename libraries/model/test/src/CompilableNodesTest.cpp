@@ -66,6 +66,9 @@
 #include "SigmoidActivation.h"
 #include "SoftmaxLayer.h"
 
+// thread pool interface
+#include "ThreadingInterface.h"
+
 // testing
 #include "testing.h"
 
@@ -73,7 +76,9 @@
 #include "LoadModel.h" // for RegisterNodeTypes
 
 // stl
+#include <cmath>
 #include <iostream>
+#include <limits>
 #include <ostream>
 #include <string>
 
@@ -317,6 +322,87 @@ void TestCompilableUnaryOperationNode()
     VerifyCompiledOutput(map, compiledMap, signal, "UnaryOperationNode");
 }
 
+namespace
+{
+// NaN matches NaN and an infinity matches the same infinity, which the tolerance of testing::IsEqual doesn't allow
+bool IsEqualOrBothNonFinite(const std::vector<double>& a, const std::vector<double>& b)
+{
+    if (a.size() != b.size())
+    {
+        return false;
+    }
+
+    for (size_t index = 0; index < a.size(); ++index)
+    {
+        auto isEqual = std::isnan(a[index]) ? std::isnan(b[index]) : (std::isinf(a[index]) ? a[index] == b[index] : testing::IsEqual(a[index], b[index], 1.0e-8));
+        if (!isEqual)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void VerifyCompiledOutputWithNonFinite(const model::DynamicMap& map, const model::IRCompiledMap& compiledMap, const std::vector<std::vector<double>>& signal, const std::string& name)
+{
+    bool ok = true;
+    for (const auto& input : signal)
+    {
+        map.SetInputValue(0, input);
+        auto computedResult = map.ComputeOutput<double>(0);
+        compiledMap.SetInputValue(0, input);
+        auto compiledResult = compiledMap.ComputeOutput<double>(0);
+        ok = ok && IsEqualOrBothNonFinite(computedResult, compiledResult);
+    }
+    testing::ProcessTest("Testing compiled " + name + " compute", ok);
+}
+}
+
+void TestCompilableUnaryOperationNodeFastMath()
+{
+    // 11 elements, so both the vector loop and the remainder loop are exercised, and see NaN and infinities
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double inf = std::numeric_limits<double>::infinity();
+    std::vector<std::vector<double>> signal = { { -9, -5, -2.5, -1, -0.25, 0, 0.1, 0.5, 1, 3, 8 }, { 4, 5, 6, -4, -5, -6, 0.01, -0.01, 2, -2, 0.7 }, { nan, inf, -inf, 1, -1, 0.5, -0.5, 2, nan, inf, -inf } };
+
+    // the fast log treats zero and negative arguments as the smallest normal number, so it is only compared on positive ones
+    std::vector<std::vector<double>> positiveSignal = { { 1.0e-300, 1.0e-5, 0.1, 0.5, 0.9, 1, 1.1, 2, 10, 1.0e5, 1.0e300 }, { nan, inf, 3, 0.25, 7, 0.01, 100, 0.7, nan, inf, 42 } };
+
+    // without fast math, the vector loop calls the math library for each element
+    for (auto useFastMath : { true, false })
+    {
+        model::MapCompilerParameters settings;
+        settings.compilerSettings.useFastMath = useFastMath;
+        const std::string prefix = useFastMath ? "fast " : "";
+        for (auto operation : { emitters::UnaryOperationType::exp, emitters::UnaryOperationType::log, emitters::UnaryOperationType::tanh })
+        {
+            model::Model model;
+            auto inputNode = model.AddNode<model::InputNode<double>>(11);
+            auto testNode = model.AddNode<nodes::UnaryOperationNode<double>>(inputNode->output, operation);
+            auto map = model::DynamicMap(model, { { "input", inputNode } }, { { "output", testNode->output } });
+            model::IRMapCompiler compiler(settings);
+            auto compiledMap = compiler.Compile(map);
+
+            auto& operationSignal = operation == emitters::UnaryOperationType::log ? positiveSignal : signal;
+            VerifyCompiledOutputWithNonFinite(map, compiledMap, operationSignal, "UnaryOperationNode (" + prefix + nodes::UnaryOperations::to_string(operation) + ")");
+        }
+
+        // the runtime's sigmoid is emitted for activation layers
+        using LayerType = predictors::neural::ActivationLayer<double, predictors::neural::SigmoidActivation>;
+        LayerType::TensorType layerInput(1, 11, 1);
+        LayerType::LayerParameters layerParameters{ layerInput, predictors::neural::NoPadding(), { 1, 11, 1 }, predictors::neural::NoPadding() };
+        LayerType layer(layerParameters);
+
+        model::Model model;
+        auto inputNode = model.AddNode<model::InputNode<double>>(11);
+        auto testNode = model.AddNode<nodes::ActivationLayerNode<double, predictors::neural::SigmoidActivation>>(inputNode->output, layer);
+        auto map = model::DynamicMap(model, { { "input", inputNode } }, { { "output", testNode->output } });
+        model::IRMapCompiler compiler(settings);
+        auto compiledMap = compiler.Compile(map);
+        VerifyCompiledOutputWithNonFinite(map, compiledMap, signal, "ActivationLayerNode (" + prefix + "sigmoid)");
+    }
+}
+
 void TestCompilableBinaryOperationNode()
 {
     model::Model model;
@@ -491,6 +577,9 @@ void CompiledSinkNode_OutputCallback_Vector(double* output)
 }
 TESTING_FORCE_DEFINE_SYMBOL(CompiledSinkNode_OutputCallback_Vector, void, double*);
 
+// Ensure that LLVM jit can find the thread pool used by parallel loops
+TESTING_FORCE_DEFINE_SYMBOL(ELL_ParallelFor, void, int32_t, ell_runtime::ParallelForTask, int8_t*);
+
 void TestCompilableSinkNode(size_t inputSize, const std::string& sinkFunctionName, bool runJit)
 {
     g_sinkOutputSize = inputSize;
@@ -669,7 +758,7 @@ void TestIRNode()
 
 // Helper function
 template <typename ElementType>
-void VerifyLayerMap(const ell::model::DynamicMap& map, const ell::model::Node* computeNode, const typename ell::predictors::neural::Layer<ElementType>::TensorType& inputWithPadding, const typename ell::predictors::neural::Layer<ElementType>::ConstTensorReferenceType& output)
+void VerifyLayerMap(const ell::model::DynamicMap& map, const ell::model::Node* computeNode, const typename ell::predictors::neural::Layer<ElementType>::TensorType& inputWithPadding, const typename ell::predictors::neural::Layer<ElementType>::ConstTensorReferenceType& output, bool parallelize = false)
 {
     std::vector<std::vector<double>> signal = { inputWithPadding.ToArray() };
     std::vector<std::vector<double>> expectedOutput = { output.ToArray() };
@@ -677,12 +766,13 @@ void VerifyLayerMap(const ell::model::DynamicMap& map, const ell::model::Node* c
 
     model::MapCompilerParameters settings;
     settings.compilerSettings.useBlas = true;
+    settings.compilerSettings.parallelize = parallelize;
     model::IRMapCompiler compiler(settings);
     auto compiledMap = compiler.Compile(map);
     // PrintIR(compiledMap);
 
     // compare output
-    VerifyCompiledOutput(map, compiledMap, signal, computeNode->GetRuntimeTypeName());
+    VerifyCompiledOutput(map, compiledMap, signal, computeNode->GetRuntimeTypeName() + (parallelize ? "_parallel" : ""));
 }
 
 void TestNeuralNetworkPredictorNode1()
@@ -1441,7 +1531,7 @@ void TestFullyConnectedLayerNode(size_t inputPaddingSize, size_t outputPaddingSi
 }
 
 template <template <typename> class PoolingFunction>
-void TestPoolingLayerNode(size_t inputPaddingSize, size_t outputPaddingSize)
+void TestPoolingLayerNode(size_t inputPaddingSize, size_t outputPaddingSize, bool parallelize)
 {
     using namespace ell::predictors;
     using namespace ell::predictors::neural;
@@ -1481,17 +1571,17 @@ void TestPoolingLayerNode(size_t inputPaddingSize, size_t outputPaddingSize)
     auto computeNode = model.AddNode<nodes::PoolingLayerNode<double, PoolingFunction>>(inputNode->output, layer);
     auto map = model::DynamicMap(model, { { "input", inputNode } }, { { "output", computeNode->output } });
 
-    VerifyLayerMap<ElementType>(map, computeNode, inputWithPadding, output);
+    VerifyLayerMap<ElementType>(map, computeNode, inputWithPadding, output, parallelize);
 }
 
-void TestMaxPoolingLayerNode(size_t inputPaddingSize, size_t outputPaddingSize)
+void TestMaxPoolingLayerNode(size_t inputPaddingSize, size_t outputPaddingSize, bool parallelize)
 {
-    TestPoolingLayerNode<predictors::neural::MaxPoolingFunction>(inputPaddingSize, outputPaddingSize);
+    TestPoolingLayerNode<predictors::neural::MaxPoolingFunction>(inputPaddingSize, outputPaddingSize, parallelize);
 }
 
-void TestMeanPoolingLayerNode(size_t inputPaddingSize, size_t outputPaddingSize)
+void TestMeanPoolingLayerNode(size_t inputPaddingSize, size_t outputPaddingSize, bool parallelize)
 {
-    TestPoolingLayerNode<ell::predictors::neural::MeanPoolingFunction>(inputPaddingSize, outputPaddingSize);
+    TestPoolingLayerNode<ell::predictors::neural::MeanPoolingFunction>(inputPaddingSize, outputPaddingSize, parallelize);
 }
 
 void TestScalingLayerNode(size_t inputPaddingSize, size_t outputPaddingSize)
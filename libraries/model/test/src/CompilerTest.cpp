@@ -19,20 +19,25 @@
 
 // nodes
 #include "AccumulatorNode.h"
+#include "BinaryOperationNode.h"
 #include "ConstantNode.h"
 #include "DelayNode.h"
 #include "DotProductNode.h"
 #include "ForestPredictorNode.h"
 #include "LinearPredictorNode.h"
+#include "MatrixMatrixMultiplyNode.h"
+#include "MatrixVectorMultiplyNode.h"
 #include "SinkNode.h"
 #include "SourceNode.h"
 #include "SumNode.h"
+#include "UnaryOperationNode.h"
 
 // emitters
 #include "EmitterException.h"
 #include "EmitterTypes.h"
 #include "IREmitter.h"
 #include "IRFunctionEmitter.h"
+#include "IRFunctionVariants.h"
 #include "IRMapCompiler.h"
 #include "IRModuleEmitter.h"
 #include "IRSteppableMapCompiler.h"
@@ -48,8 +53,17 @@
 // testing
 #include "testing.h"
 
+// llvm
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/Support/Host.h"
+
 // stl
+#include <algorithm>
 #include <chrono>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
 #include <ostream>
 #include <string>
@@ -197,6 +211,404 @@ void TestCompiledMapMove()
     VerifyCompiledOutput(map, compiledMap2, signal, " moved compiled map");
 }
 
+// Returns the directory for temporary files
+std::string GetTempDirectory()
+{
+    for (auto name : { "TMPDIR", "TEMP", "TMP" })
+    {
+        auto value = std::getenv(name);
+        if (value != nullptr && *value != '\0')
+        {
+            return value;
+        }
+    }
+    return "/tmp";
+}
+
+void TestCompiledMapObjectCache()
+{
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<double>>(3);
+    auto accumNode = model.AddNode<nodes::AccumulatorNode<double>>(inputNode->output);
+    auto map = model::DynamicMap(model, { { "input", inputNode } }, { { "output", accumNode->output } });
+    model::MapCompilerParameters settings;
+    settings.objectCacheDirectory = GetTempDirectory();
+
+    // A module name unique to this run, so an object cached by an earlier run isn't found
+    settings.moduleName = "ObjectCacheTest" + std::to_string(std::chrono::system_clock::now().time_since_epoch().count());
+    std::vector<std::vector<double>> signal = { { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 }, { 3, 4, 5 }, { 2, 3, 2 }, { 1, 5, 3 }, { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 }, { 7, 4, 2 }, { 5, 2, 1 } };
+
+    // The first compile populates the cache, and the second one loads from it
+    model::IRMapCompiler compiler1(settings);
+    auto compiledMap1 = compiler1.Compile(map);
+    VerifyCompiledOutput(map, compiledMap1, signal, " object-cached compiled map");
+    const auto& cache1 = *compiledMap1.GetJitter().GetObjectCache();
+    testing::ProcessTest("Testing object cache miss", cache1.GetNumObjectsLoaded() == 0 && cache1.GetNumObjectsStored() == 1 && cache1.HasObject());
+
+    model::IRMapCompiler compiler2(settings);
+    auto compiledMap2 = compiler2.Compile(map);
+    testing::ProcessTest("Testing IsValid of cached map", testing::IsEqual(compiledMap2.IsValid(), true));
+    VerifyCompiledOutput(map, compiledMap2, signal, " object-cached compiled map (cache hit)");
+    const auto& cache2 = *compiledMap2.GetJitter().GetObjectCache();
+    testing::ProcessTest("Testing object cache hit", cache2.GetObjectPath() == cache1.GetObjectPath() && cache2.GetNumObjectsLoaded() == 1 && cache2.GetNumObjectsStored() == 0);
+
+    std::remove(cache1.GetObjectPath().c_str());
+}
+
+void TestCompiledMapLazyJit()
+{
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<double>>(3);
+    auto accumNode = model.AddNode<nodes::AccumulatorNode<double>>(inputNode->output);
+    auto dotNode = model.AddNode<nodes::DotProductNode<double>>(inputNode->output, accumNode->output);
+    auto map = model::DynamicMap(model, { { "input", inputNode } }, { { "output", dotNode->output } });
+    model::MapCompilerParameters settings;
+    settings.lazyCompile = true;
+    model::IRMapCompiler compiler(settings);
+    auto compiledMap = compiler.Compile(map);
+
+    testing::ProcessTest("Testing IsValid of lazily-compiled map", testing::IsEqual(compiledMap.IsValid(), true));
+
+    // compare output
+    std::vector<std::vector<double>> signal = { { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 }, { 3, 4, 5 }, { 2, 3, 2 }, { 1, 5, 3 }, { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 }, { 7, 4, 2 }, { 5, 2, 1 } };
+    VerifyCompiledOutput(map, compiledMap, signal, " lazily-compiled map");
+}
+
+void TestCompiledMapLazyJitCompilesOnFirstCall()
+{
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<double>>(3);
+    auto accumNode = model.AddNode<nodes::AccumulatorNode<double>>(inputNode->output);
+    auto map = model::DynamicMap(model, { { "input", inputNode } }, { { "output", accumNode->output } });
+    model::MapCompilerParameters settings;
+    settings.lazyCompile = true;
+    settings.profile = true; // adds profiling functions the predict function never calls
+    model::IRMapCompiler compiler(settings);
+    auto compiledMap = compiler.Compile(map);
+
+    std::vector<std::vector<double>> signal = { { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 } };
+    VerifyCompiledOutput(map, compiledMap, signal, " lazily-compiled profiling map");
+
+    auto& jitter = compiledMap.GetJitter();
+    auto printFunctionName = settings.moduleName + "_PrintModelProfilingInfo";
+    auto resetFunctionName = settings.moduleName + "_ResetModelProfilingInfo";
+    testing::ProcessTest("Testing lazy JIT compiled the called function", jitter.IsFunctionCompiled(settings.mapFunctionName));
+    testing::ProcessTest("Testing lazy JIT didn't compile the uncalled functions", !jitter.IsFunctionCompiled(printFunctionName) && !jitter.IsFunctionCompiled(resetFunctionName));
+
+    compiledMap.ResetModelProfilingInfo();
+    testing::ProcessTest("Testing lazy JIT compiles a function on its first call", jitter.IsFunctionCompiled(resetFunctionName) && !jitter.IsFunctionCompiled(printFunctionName));
+}
+
+void TestCompiledMapFunctionVariants()
+{
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<double>>(3);
+    auto accumNode = model.AddNode<nodes::AccumulatorNode<double>>(inputNode->output);
+    auto dotNode = model.AddNode<nodes::DotProductNode<double>>(inputNode->output, accumNode->output);
+    auto map = model::DynamicMap(model, { { "input", inputNode } }, { { "output", dotNode->output } });
+    model::MapCompilerParameters settings;
+    settings.functionVariants = { "sse4.2", "avx2", "avx512" };
+    model::IRMapCompiler compiler(settings);
+    auto compiledMap = compiler.Compile(map);
+
+    testing::ProcessTest("Testing IsValid of multi-versioned map", testing::IsEqual(compiledMap.IsValid(), true));
+
+    // compare output (whichever variant this CPU picks)
+    std::vector<std::vector<double>> signal = { { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 }, { 3, 4, 5 }, { 2, 3, 2 }, { 1, 5, 3 }, { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 }, { 7, 4, 2 }, { 5, 2, 1 } };
+    VerifyCompiledOutput(map, compiledMap, signal, " multi-versioned map");
+
+    // Each variant is compiled for its instruction set's features
+    auto pModule = compiledMap.GetModule().GetLLVMModule();
+    bool hasVariants = true;
+    for (const auto& instructionSet : settings.functionVariants)
+    {
+        auto variantName = settings.mapFunctionName + "_" + instructionSet;
+        std::replace(variantName.begin(), variantName.end(), '.', '_');
+        auto pVariant = pModule->getFunction(variantName);
+        hasVariants = hasVariants && pVariant != nullptr && pVariant->getFnAttribute("target-features").getValueAsString() == emitters::GetFunctionVariantFeatures(instructionSet);
+    }
+    testing::ProcessTest("Testing function variants are compiled for their instruction sets", hasVariants);
+
+    // The dispatcher uses the most capable variant whose features the host supports (the variants are requested in increasing order of capability)
+    llvm::StringMap<bool> hostFeatures;
+    llvm::sys::getHostCPUFeatures(hostFeatures);
+    int expectedVariant = -1;
+    for (size_t index = 0; index < settings.functionVariants.size(); ++index)
+    {
+        // the StringRefs point into variantFeatures, so it must outlive them
+        auto variantFeatures = emitters::GetFunctionVariantFeatures(settings.functionVariants[index]);
+        llvm::SmallVector<llvm::StringRef, 16> features;
+        llvm::StringRef(variantFeatures).split(features, ',');
+        if (std::all_of(features.begin(), features.end(), [&hostFeatures](llvm::StringRef feature) { return hostFeatures.lookup(feature.drop_front()); }))
+        {
+            expectedVariant = static_cast<int>(index);
+        }
+    }
+    auto getVariant = reinterpret_cast<int32_t (*)()>(compiledMap.GetJitter().ResolveFunctionAddress(settings.mapFunctionName + "_GetVariant"));
+    testing::ProcessTest("Testing the selected function variant", testing::IsEqual(getVariant(), expectedVariant));
+}
+
+void TestCompiledMapReentrant()
+{
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<double>>(3);
+    auto accumNode = model.AddNode<nodes::AccumulatorNode<double>>(inputNode->output);
+    auto dotNode = model.AddNode<nodes::DotProductNode<double>>(inputNode->output, accumNode->output);
+    auto map = model::DynamicMap(model, { { "input", inputNode } }, { { "output", dotNode->output } });
+    model::MapCompilerParameters settings;
+    settings.reentrant = true;
+    model::IRMapCompiler compiler(settings);
+    auto compiledMap = compiler.Compile(map);
+
+    testing::ProcessTest("Testing IsValid of reentrant map", testing::IsEqual(compiledMap.IsValid(), true));
+
+    // compare output
+    std::vector<std::vector<double>> signal = { { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 }, { 3, 4, 5 }, { 2, 3, 2 }, { 1, 5, 3 } };
+    VerifyCompiledOutput(map, compiledMap, signal, " reentrant map");
+
+    // the accumulator's state lives in the context, which has to survive a move
+    auto movedMap = std::move(compiledMap);
+    signal = { { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 }, { 7, 4, 2 }, { 5, 2, 1 } };
+    VerifyCompiledOutput(map, movedMap, signal, " moved reentrant map");
+
+    // Calls with separate contexts keep separate state, even when they're interleaved
+    auto accumMap = model::DynamicMap(model, { { "input", inputNode } }, { { "output", accumNode->output } });
+    model::IRMapCompiler accumCompiler(settings);
+    auto compiledAccumMap = accumCompiler.Compile(accumMap);
+    auto& jitter = compiledAccumMap.GetJitter();
+    auto getContextSize = reinterpret_cast<int32_t (*)()>(jitter.ResolveFunctionAddress(settings.moduleName + "_GetContextSize"));
+    auto initializeContext = reinterpret_cast<void (*)(int8_t*)>(jitter.ResolveFunctionAddress(settings.moduleName + "_InitializeContext"));
+    auto predict = reinterpret_cast<void (*)(int8_t*, const double*, double*)>(jitter.ResolveFunctionAddress(settings.mapFunctionName));
+
+    // int64_t, so the contexts are aligned for any scalar type
+    auto contextSize = (static_cast<size_t>(getContextSize()) + sizeof(int64_t) - 1) / sizeof(int64_t);
+    std::vector<int64_t> context1(contextSize);
+    std::vector<int64_t> context2(contextSize);
+    initializeContext(reinterpret_cast<int8_t*>(context1.data()));
+    initializeContext(reinterpret_cast<int8_t*>(context2.data()));
+
+    std::vector<std::vector<double>> signal1 = { { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 } };
+    std::vector<std::vector<double>> signal2 = { { 10, 20, 30 }, { -1, -1, -1 }, { 0, 0, 1 } };
+    std::vector<double> expected1(3, 0);
+    std::vector<double> expected2(3, 0);
+    std::vector<double> output1(3);
+    std::vector<double> output2(3);
+    bool isIndependent = true;
+    for (size_t index = 0; index < signal1.size(); ++index)
+    {
+        predict(reinterpret_cast<int8_t*>(context1.data()), signal1[index].data(), output1.data());
+        predict(reinterpret_cast<int8_t*>(context2.data()), signal2[index].data(), output2.data());
+        for (size_t element = 0; element < 3; ++element)
+        {
+            expected1[element] += signal1[index][element];
+            expected2[element] += signal2[index][element];
+        }
+        isIndependent = isIndependent && testing::IsEqual(output1, expected1) && testing::IsEqual(output2, expected2);
+    }
+    testing::ProcessTest("Testing reentrant map with interleaved contexts", isIndependent);
+
+    // Reentrant maps can't be parallelized, since the thread pool's tasks don't get a context
+    settings.compilerSettings.parallelize = true;
+    model::IRMapCompiler parallelCompiler(settings);
+    bool isRejected = false;
+    try
+    {
+        parallelCompiler.Compile(map);
+    }
+    catch (const emitters::EmitterException&)
+    {
+        isRejected = true;
+    }
+    testing::ProcessTest("Testing reentrant map can't be parallelized", isRejected);
+}
+
+// Returns true if the function calls a function whose name contains the given (lower case) string, ignoring case
+bool CallsFunction(const llvm::Function& function, const std::string& name)
+{
+    for (const auto& block : function)
+    {
+        for (const auto& instruction : block)
+        {
+            auto call = llvm::dyn_cast<llvm::CallInst>(&instruction);
+            if (call != nullptr && call->getCalledFunction() != nullptr && call->getCalledFunction()->getName().lower().find(name) != std::string::npos)
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void TestCompiledMapBatch()
+{
+    // A fully-connected layer, as it's refined: the weights times the input, plus the bias, through an activation
+    const size_t inputSize = 5;
+    const size_t outputSize = 4;
+    std::vector<double> weights(outputSize * inputSize);
+    for (size_t index = 0; index < weights.size(); ++index)
+    {
+        weights[index] = static_cast<double>(index % 5) - 2;
+    }
+
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<double>>(inputSize);
+    auto weightsNode = model.AddNode<nodes::ConstantNode<double>>(weights);
+    auto biasNode = model.AddNode<nodes::ConstantNode<double>>(std::vector<double>{ 1, -1, 0.5, 2 });
+    auto multiplyNode = model.AddNode<nodes::MatrixVectorMultiplyNode<double>>(weightsNode->output, outputSize, inputSize, inputSize, inputNode->output);
+    auto addNode = model.AddNode<nodes::BinaryOperationNode<double>>(multiplyNode->output, biasNode->output, emitters::BinaryOperationType::add);
+    auto activationNode = model.AddNode<nodes::UnaryOperationNode<double>>(addNode->output, emitters::UnaryOperationType::tanh);
+    auto map = model::DynamicMap(model, { { "input", inputNode } }, { { "output", activationNode->output } });
+    model::MapCompilerParameters settings;
+    settings.emitBatchFunction = true;
+    settings.compilerSettings.useBlas = false;
+    settings.compilerSettings.optimize = false; // keep the calls to the GEMM kernel
+    model::IRMapCompiler compiler(settings);
+    auto compiledMap = compiler.Compile(map);
+
+    testing::ProcessTest("Testing IsValid of map with batch function", testing::IsEqual(compiledMap.IsValid(), true));
+
+    // The stateless map is compiled for a tile of examples at once, with the matrix-vector products of the tile done as one GEMM
+    auto pTileFunction = compiledMap.GetModule().GetLLVMModule()->getFunction(settings.mapFunctionName + "_batchTile");
+    testing::ProcessTest("Testing batch tile function is emitted", pTileFunction != nullptr);
+    testing::ProcessTest("Testing batch tile function calls GEMM", pTileFunction != nullptr && CallsFunction(*pTileFunction, "gemm"));
+
+    // 2 full tiles and a remainder of 3 examples, which go through the map function one at a time
+    std::vector<double> batchInput;
+    std::vector<double> expectedOutput;
+    for (size_t example = 0; example < 35; ++example)
+    {
+        std::vector<double> input(inputSize);
+        for (size_t index = 0; index < inputSize; ++index)
+        {
+            input[index] = static_cast<double>((example + 2 * index) % 7) / 4 - 0.75;
+        }
+        batchInput.insert(batchInput.end(), input.begin(), input.end());
+        map.SetInputValue(0, input);
+        auto output = map.ComputeOutput<double>(0);
+        expectedOutput.insert(expectedOutput.end(), output.begin(), output.end());
+    }
+
+    auto batchOutput = compiledMap.ComputeBatch<double, double>(batchInput);
+    testing::ProcessTest("Testing compiled batch function with batch tiles", testing::IsEqual(batchOutput, expectedOutput));
+}
+
+void TestCompiledMapBatchWithState()
+{
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<double>>(3);
+    auto accumNode = model.AddNode<nodes::AccumulatorNode<double>>(inputNode->output);
+    auto dotNode = model.AddNode<nodes::DotProductNode<double>>(inputNode->output, accumNode->output);
+    auto map = model::DynamicMap(model, { { "input", inputNode } }, { { "output", dotNode->output } });
+    model::MapCompilerParameters settings;
+    settings.emitBatchFunction = true;
+    model::IRMapCompiler compiler(settings);
+    auto compiledMap = compiler.Compile(map);
+
+    testing::ProcessTest("Testing IsValid of map with state and batch function", testing::IsEqual(compiledMap.IsValid(), true));
+
+    // The accumulator's output for an example depends on the earlier ones, so there's no batch tile function
+    testing::ProcessTest("Testing batch tile function isn't emitted for a map with state", compiledMap.GetModule().GetLLVMModule()->getFunction(settings.mapFunctionName + "_batchTile") == nullptr);
+
+    // the batch runs the examples in order, so the accumulator sees the same sequence as the reference map
+    std::vector<std::vector<double>> signal = { { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 }, { 3, 4, 5 }, { 2, 3, 2 }, { 1, 5, 3 } };
+    std::vector<double> batchInput;
+    std::vector<double> expectedOutput;
+    for (const auto& input : signal)
+    {
+        batchInput.insert(batchInput.end(), input.begin(), input.end());
+        map.SetInputValue(0, input);
+        auto output = map.ComputeOutput<double>(0);
+        expectedOutput.insert(expectedOutput.end(), output.begin(), output.end());
+    }
+
+    auto batchOutput = compiledMap.ComputeBatch<double, double>(batchInput);
+    testing::ProcessTest("Testing compiled batch function with state", testing::IsEqual(batchOutput, expectedOutput));
+}
+
+void TestCompiledMatrixMatrixMultiply()
+{
+    // sizes that leave partial tiles in every dimension, and an inner dimension spanning more than one cache block
+    const int m = 9;
+    const int n = 21;
+    const int k = 300;
+
+    // small integer entries, so the result is exact regardless of the order of summation
+    std::vector<double> matrix2Values(k * n);
+    for (int index = 0; index < k * n; ++index)
+    {
+        matrix2Values[index] = (index % 7) - 3;
+    }
+
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<double>>(m * k);
+    auto matrix2Node = model.AddNode<nodes::ConstantNode<double>>(matrix2Values);
+    auto matrixMultNode = model.AddNode<nodes::MatrixMatrixMultiplyNode<double>>(inputNode->output, m, n, k, k, matrix2Node->output, n, n);
+    auto map = model::DynamicMap(model, { { "input", inputNode } }, { { "output", matrixMultNode->output } });
+    model::MapCompilerParameters settings;
+    settings.compilerSettings.useBlas = false;
+    model::IRMapCompiler compiler(settings);
+    auto compiledMap = compiler.Compile(map);
+
+    std::vector<std::vector<double>> signal;
+    for (int sample = 0; sample < 3; ++sample)
+    {
+        std::vector<double> matrix1Values(m * k);
+        for (int index = 0; index < m * k; ++index)
+        {
+            matrix1Values[index] = ((index + sample) % 5) - 2;
+        }
+        signal.push_back(matrix1Values);
+    }
+    VerifyCompiledOutput(map, compiledMap, signal, " emitted GEMM");
+}
+
+void TestCompiledTransposedMatrixMatrixMultiply()
+{
+    // the same partial tiles and cache blocks, with the second matrix stored transposed, as a batched matrix-vector product stores it
+    const int m = 9;
+    const int n = 21;
+    const int k = 300;
+
+    std::vector<double> matrix2Values(n * k);
+    for (int index = 0; index < n * k; ++index)
+    {
+        matrix2Values[index] = (index % 7) - 3;
+    }
+
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<double>>(m * k);
+    auto matrix2Node = model.AddNode<nodes::ConstantNode<double>>(matrix2Values);
+    auto matrixMultNode = model.AddNode<nodes::MatrixMatrixMultiplyNode<double>>(inputNode->output, m, n, k, k, false, matrix2Node->output, k, true, n);
+    auto map = model::DynamicMap(model, { { "input", inputNode } }, { { "output", matrixMultNode->output } });
+    model::MapCompilerParameters settings;
+    settings.compilerSettings.useBlas = false;
+    model::IRMapCompiler compiler(settings);
+    auto compiledMap = compiler.Compile(map);
+
+    std::vector<double> matrix1Values(m * k);
+    for (int index = 0; index < m * k; ++index)
+    {
+        matrix1Values[index] = (index % 5) - 2;
+    }
+
+    // the reference node doesn't compute transposed products, so the expected result is computed here
+    std::vector<double> expectedOutput(m * n);
+    for (int row = 0; row < m; ++row)
+    {
+        for (int column = 0; column < n; ++column)
+        {
+            for (int p = 0; p < k; ++p)
+            {
+                expectedOutput[row * n + column] += matrix1Values[row * k + p] * matrix2Values[column * k + p];
+            }
+        }
+    }
+
+    compiledMap.SetInputValue(0, matrix1Values);
+    auto compiledOutput = compiledMap.ComputeOutput<double>(0);
+    testing::ProcessTest("Testing emitted GEMM with transposed B", testing::IsEqual(compiledOutput, expectedOutput));
+}
+
 typedef void (*MapPredictFunction)(double*, double*);
 
 void TestBinaryVector(bool expanded, bool runJit)
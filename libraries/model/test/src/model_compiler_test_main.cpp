@@ -29,6 +29,15 @@ void TestIRCompiler()
     TestSimpleMap(false);
     TestSimpleMap(true);
     TestCompiledMapMove();
+    TestCompiledMapObjectCache();
+    TestCompiledMapLazyJit();
+    TestCompiledMapLazyJitCompilesOnFirstCall();
+    TestCompiledMapFunctionVariants();
+    TestCompiledMapReentrant();
+    TestCompiledMapBatch();
+    TestCompiledMapBatchWithState();
+    TestCompiledMatrixMatrixMultiply();
+    TestCompiledTransposedMatrixMatrixMultiply();
     TestBinaryScalar();
     TestBinaryVector(true);
     TestBinaryVector(false);
@@ -60,6 +69,7 @@ void TestIRCompiler()
     TestCompilableScalarSumNode();
     TestCompilableSumNode();
     TestCompilableUnaryOperationNode();
+    TestCompilableUnaryOperationNodeFastMath();
     TestCompilableBinaryOperationNode();
     TestCompilableScalarBinaryPredicateNode();
     TestCompilableBinaryPredicateNode();
@@ -130,12 +140,14 @@ void TestIRCompiler()
     TestMaxPoolingLayerNode(0, 2);
     TestMaxPoolingLayerNode(1, 0);
     TestMaxPoolingLayerNode(2, 1);
+    TestMaxPoolingLayerNode(1, 0, true);
 
     TestMeanPoolingLayerNode();
     TestMeanPoolingLayerNode(0, 1);
     TestMeanPoolingLayerNode(0, 2);
     TestMeanPoolingLayerNode(1, 0);
     TestMeanPoolingLayerNode(2, 1);
+    TestMeanPoolingLayerNode(1, 0, true);
 
     TestScalingLayerNode();
     TestScalingLayerNode(0, 1);
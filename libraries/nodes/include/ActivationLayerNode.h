@@ -52,7 +52,7 @@ namespace nodes
         using BroadcastUnaryFunction<ValueType>::Compile;
 
         /// <summary> Indicates if the function can operate on vector types </summary>
-        bool CanUseVectorTypes() const { return false; }
+        bool CanUseVectorTypes() const { return true; }
     };
 
     template <typename ValueType>
@@ -81,7 +81,7 @@ namespace nodes
         using BroadcastUnaryFunction<ValueType>::Compile;
 
         /// <summary> Indicates if the function can operate on vector types </summary>
-        bool CanUseVectorTypes() const { return false; }
+        bool CanUseVectorTypes() const { return true; }
 
         /// <summary> Gets the leaky factor </summary>
         ///
@@ -112,7 +112,7 @@ namespace nodes
         using BroadcastUnaryFunction<ValueType>::Compile;
 
         /// <summary> Indicates if the function can operate on vector types </summary>
-        bool CanUseVectorTypes() const { return false; }
+        bool CanUseVectorTypes() const { return true; }
     };
 
     //
@@ -0,0 +1,40 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     BatchedInput.h (nodes)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ConstantNode.h"
+
+// model
+#include "InputPort.h"
+#include "ModelTransformer.h"
+#include "PortElements.h"
+
+// stl
+#include <vector>
+
+namespace ell
+{
+namespace nodes
+{
+    /// <summary>
+    /// Gets the elements holding an input's values for a batch of examples, for nodes that batch themselves. Inputs that
+    /// vary with the example are batched already, and the values of a constant input are repeated for each example.
+    /// </summary>
+    ///
+    /// <param name="input"> The input port, in the model being batched. </param>
+    /// <param name="transformer"> [in,out] The model transformer. </param>
+    /// <param name="batchSize"> The number of examples in a batch. </param>
+    ///
+    /// <returns> The elements in the batched model, or empty elements if the input can't be batched. </returns>
+    template <typename ValueType>
+    model::PortElements<ValueType> GetBatchedInput(const model::InputPort<ValueType>& input, model::ModelTransformer& transformer, size_t batchSize);
+}
+}
+
+#include "../tcc/BatchedInput.tcc"
@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include "BatchedInput.h"
+
 // model
 #include "CompilableNodeUtilities.h"
 #include "CompilableNode.h"
@@ -79,6 +81,7 @@ namespace nodes
     protected:
         virtual void Compute() const override;
         virtual void Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function) override;
+        virtual bool Batch(model::ModelTransformer& transformer, size_t batchSize) const override;
         virtual void WriteToArchive(utilities::Archiver& archiver) const override;
         virtual void ReadFromArchive(utilities::Unarchiver& archiver) override;
 
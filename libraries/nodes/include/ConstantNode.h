@@ -84,6 +84,7 @@ namespace nodes
         virtual void Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function) override;
         virtual bool HasState() const override { return true; }
         virtual bool ShouldCompileInline() const override { return true; }
+        virtual bool Batch(model::ModelTransformer& transformer, size_t batchSize) const override;
         virtual void WriteToArchive(utilities::Archiver& archiver) const override;
         virtual void ReadFromArchive(utilities::Unarchiver& archiver) override;
 
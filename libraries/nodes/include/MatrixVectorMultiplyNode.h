@@ -8,6 +8,9 @@
 
 #pragma once
 
+#include "BatchedInput.h"
+#include "MatrixMatrixMultiplyNode.h"
+
 // model
 #include "CompilableNode.h"
 #include "IRMapCompiler.h"
@@ -74,6 +77,7 @@ namespace nodes
     protected:
         virtual void Compute() const override;
         virtual void Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function) override;
+        virtual bool Batch(model::ModelTransformer& transformer, size_t batchSize) const override;
         virtual void WriteToArchive(utilities::Archiver& archiver) const override;
         virtual void ReadFromArchive(utilities::Unarchiver& archiver) override;
 
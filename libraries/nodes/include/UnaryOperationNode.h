@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include "BatchedInput.h"
+
 // model
 #include "CompilableNode.h"
 #include "IRMapCompiler.h"
@@ -76,11 +78,12 @@ namespace nodes
     protected:
         virtual void Compute() const override;
         virtual void Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function) override;
+        virtual bool Batch(model::ModelTransformer& transformer, size_t batchSize) const override;
         virtual void WriteToArchive(utilities::Archiver& archiver) const override;
         virtual void ReadFromArchive(utilities::Unarchiver& archiver) override;
 
     private:
-        llvm::Function* GetOperator(emitters::IRFunctionEmitter& function) const;
+        llvm::Function* GetOperator(emitters::IRFunctionEmitter& function, llvm::Type* pArgType) const;
         void CompileLoop(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function);
         void CompileExpanded(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function);
 
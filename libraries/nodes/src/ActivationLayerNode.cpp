@@ -92,27 +92,9 @@ namespace nodes
     template <typename ValueType>
     llvm::Value* SigmoidActivationFunction<ValueType>::Compile(emitters::IRFunctionEmitter& function, llvm::Value* x) const
     {
-        auto expFunc = function.GetModule().GetRuntime().GetExpFunction<ValueType>();
-
-        llvm::Value* result = function.Variable(emitters::GetVariableType<ValueType>(), "result");
-        auto ifEmitter = function.If();
-        ifEmitter.If(emitters::TypedComparison::greaterThanFloat, x, function.Literal(static_cast<ValueType>(0.0)));
-        {
-            auto negatedInput = function.Operator(emitters::TypedOperator::multiplyFloat, x, function.Literal(static_cast<ValueType>(-1.0)));
-            auto expNegInput = function.Call(expFunc, { negatedInput });
-            auto expNegPlusOne = function.Operator(emitters::TypedOperator::addFloat, expNegInput, function.Literal(static_cast<ValueType>(1.0)));
-            auto sigmoid = function.Operator(emitters::TypedOperator::divideFloat, function.Literal(static_cast<ValueType>(1.0)), expNegPlusOne);
-            function.Store(result, sigmoid);
-        }
-        ifEmitter.Else();
-        {
-            auto expInput = function.Call(expFunc, { x });
-            auto expPlusOne = function.Operator(emitters::TypedOperator::addFloat, expInput, function.Literal(static_cast<ValueType>(1.0)));
-            auto sigmoid = function.Operator(emitters::TypedOperator::divideFloat, expInput, expPlusOne);
-            function.Store(result, sigmoid);
-        }
-        ifEmitter.End();
-        return function.Load(result);
+        // x may be a vector
+        auto sigmoidFunction = function.GetModule().GetRuntime().GetSigmoidFunction(x->getType());
+        return function.Call(sigmoidFunction, { x });
     }
 
     //
@@ -63,49 +63,57 @@ namespace nodes
             function.Call(gemm, args);
         }
 
-        // TODO: emit this as a function in the module
+        // Calls a GEMM kernel emitted into the module and specialized to these sizes, for when there's no BLAS library
         template <typename ValueType>
-        void EmitMatrixMatrixMultiplySlow(emitters::IRFunctionEmitter& function, bool transposeA, bool transposeB, int m, int n, int k, llvm::Value* A, int lda, llvm::Value* B, int ldb, llvm::Value* C, int ldc)
+        void EmitMatrixMatrixMultiplyTiled(emitters::IRFunctionEmitter& function, bool transposeA, bool transposeB, int m, int n, int k, llvm::Value* A, int lda, llvm::Value* B, int ldb, llvm::Value* C, int ldc)
         {
-            if (transposeA || transposeB)
-            {
-                assert(false && "Transpose not implemented in slow mat mult path");
-            }
-
-            llvm::Value* accum = function.Variable(emitters::GetVariableType<ValueType>(), "accum");
+            llvm::Function* gemm = function.GetModule().GetRuntime().GetTiledGEMMFunction<ValueType>(transposeA, transposeB, m, n, k, lda, ldb, ldc);
+            function.Call(gemm, { function.PointerOffset(A, 0), function.PointerOffset(B, 0), function.PointerOffset(C, 0) });
+        }
 
-            auto mLoop = function.ForLoop();
-            mLoop.Begin(m);
+        // Computes C_i = A_i * B_i for a batch of products whose operands are spaced by fixed strides
+        template <typename ValueType>
+        void EmitMatrixMatrixMultiplyBatched(emitters::IRFunctionEmitter& function, bool useBlas, bool transposeA, bool transposeB, int m, int n, int k, llvm::Value* A, int lda, int strideA, llvm::Value* B, int ldb, int strideB, llvm::Value* C, int ldc, int strideC, int batchCount)
+        {
+            if (!useBlas)
             {
-                auto mIndex = mLoop.LoadIterationVariable();
-
-                auto nLoop = function.ForLoop();
-                nLoop.Begin(n);
+                // The sizes are the same for every product in the batch, so they can all share one specialized kernel
+                llvm::Function* gemm = function.GetModule().GetRuntime().GetTiledGEMMFunction<ValueType>(transposeA, transposeB, m, n, k, lda, ldb, ldc);
+                auto batchLoop = function.ForLoop();
+                batchLoop.Begin(batchCount);
                 {
-                    auto nIndex = nLoop.LoadIterationVariable();
-
-                    function.Store(accum, function.Literal(static_cast<ValueType>(0.0)));
-                    auto kLoop = function.ForLoop();
-                    kLoop.Begin(k);
-                    {
-                        auto kIndex = kLoop.LoadIterationVariable();
-
-                        auto aIndex = function.Operator(plus, function.Operator(times, mIndex, function.Literal(lda)), kIndex);
-                        auto aValue = function.ValueAt(A, aIndex);
-                        auto bIndex = function.Operator(plus, function.Operator(times, kIndex, function.Literal(ldb)), nIndex);
-                        auto bValue = function.ValueAt(B, bIndex);
-                        auto value = function.Operator(timesFloat, aValue, bValue);
-                        function.OperationAndUpdate(accum, plusFloat, value);
-                    }
-                    kLoop.End();
-
-                    // store output in C[m,n]
-                    auto cIndex = function.Operator(plus, function.Operator(times, mIndex, function.Literal(ldc)), nIndex);
-                    function.SetValueAt(C, cIndex, function.Load(accum));
+                    auto batchIndex = batchLoop.LoadIterationVariable();
+                    auto pA = function.PointerOffset(A, function.Operator(times, batchIndex, function.Literal(strideA)));
+                    auto pB = function.PointerOffset(B, function.Operator(times, batchIndex, function.Literal(strideB)));
+                    auto pC = function.PointerOffset(C, function.Operator(times, batchIndex, function.Literal(strideC)));
+                    function.Call(gemm, { pA, pB, pC });
                 }
-                nLoop.End();
+                batchLoop.End();
+                return;
             }
-            mLoop.End();
+
+            llvm::Function* gemm = function.GetModule().GetRuntime().GetGEMMStridedBatchedFunction<ValueType>(useBlas);
+
+            emitters::IRValueList args{
+                function.Literal(transposeA ? CBLAS_TRANSPOSE::CblasTrans : CBLAS_TRANSPOSE::CblasNoTrans), // transposeA
+                function.Literal(transposeB ? CBLAS_TRANSPOSE::CblasTrans : CBLAS_TRANSPOSE::CblasNoTrans), // transposeB
+                function.Literal(m),
+                function.Literal(n),
+                function.Literal(k),
+                function.Literal(static_cast<ValueType>(1.0)), // alpha
+                A,
+                function.Literal(lda), // lda
+                function.Literal(strideA), // strideA
+                B,
+                function.Literal(ldb), // ldb
+                function.Literal(strideB), // strideB
+                function.Literal(static_cast<ValueType>(0.0)), // beta
+                C, // C (output)
+                function.Literal(ldc), // ldc
+                function.Literal(strideC), // strideC
+                function.Literal(batchCount) // batchCount
+            };
+            function.Call(gemm, args);
         }
 
         template <typename ValueType>
@@ -117,7 +125,7 @@ namespace nodes
             }
             else
             {
-                EmitMatrixMatrixMultiplySlow<ValueType>(function, transposeA, transposeB, m, n, k, A, lda, B, ldb, C, ldc);
+                EmitMatrixMatrixMultiplyTiled<ValueType>(function, transposeA, transposeB, m, n, k, A, lda, B, ldb, C, ldc);
             }
         }
     } // end anonymous namespace
@@ -415,43 +423,42 @@ namespace nodes
             pStackedInput = pInput;
         }
 
-        // Allocate scratch memory for 'A' matrix
+        // Allocate scratch memory for the 'A' matrix of each convolution
         // TODO: this is really paddedHeight * filterWidth * batchSize * stackSize - padding * filterWidth * batchSize
         //              == (inputHeight + padding) * filterWidth * batchSize * (stackSize + padding);
         const size_t scratchMemSize = paddedHeight * filterWidth * batchSize * stackSize;
-        llvm::GlobalVariable* scratch = function.GetModule().GlobalArray(emitters::GetVariableType<ValueType>(), "scratch", scratchMemSize);
-        auto scratchPtr = function.PointerOffset(scratch, 0); // Convert LLVM array to pointer
-
         const int outputStride = paddedWidth * numFilters;
         const size_t numConvolutions = (inputWidth - 1) / stackSize + 1;
-        auto convLoop = function.ForLoop();
-        convLoop.Begin(numConvolutions);
-        {
-            auto j = convLoop.LoadIterationVariable(); // j = start column for convolution
-
-            // Get the submatrix for Vj
-            auto inputOffset = function.Operator(times, j, function.Literal<int>(inputDepth));
-            llvm::Value* Vj = function.PointerOffset(pStackedInput, inputOffset);
+        llvm::GlobalVariable* scratch = function.GetModule().GlobalArray(emitters::GetVariableType<ValueType>(), "scratch", scratchMemSize * numConvolutions);
+        auto scratchPtr = function.PointerOffset(scratch, 0); // Convert LLVM array to pointer
 
-            // now for each batch of filter weights
-            for (size_t filterStart = 0; filterStart < numFilters; filterStart += batchSize)
+        // for each batch of filter weights
+        for (size_t filterStart = 0; filterStart < numFilters; filterStart += batchSize)
+        {
+            size_t numFiltersToUse = std::min(batchSize, numFilters - filterStart);
+
+            // Get the submatrix for Wl
+            auto weightsOffset = filterStart * filterWidth;
+            llvm::Value* Wl = function.PointerOffset(pWeights, weightsOffset);
+
+            // int m = paddedHeight;
+            int m = stackedInputHeight;
+            int n = filterWidth * numFiltersToUse; // this batch
+            int k = inputDepth * filterWidth;
+            int lda = stackedInputWidth * inputDepth;
+            int ldb = filterWidth * numFilters;
+            int ldc = filterWidth * batchSize;
+
+            // The submatrix Vj for convolution j starts j * inputDepth elements into the stacked input, and every
+            // convolution uses the same Wl, so all the products are computed by one strided batched call.
+            // Note: Wl is transposed
+            EmitMatrixMatrixMultiplyBatched<ValueType>(function, useBlas, false, true, m, n, k, pStackedInput, lda, inputDepth, Wl, ldb, 0, scratchPtr, ldc, scratchMemSize, numConvolutions);
+
+            auto convLoop = function.ForLoop();
+            convLoop.Begin(numConvolutions);
             {
-                size_t numFiltersToUse = std::min(batchSize, numFilters - filterStart);
-
-                // Get the submatrix for Wl
-                auto weightsOffset = filterStart * filterWidth;
-                llvm::Value* Wl = function.PointerOffset(pWeights, weightsOffset);
-
-                // int m = paddedHeight;
-                int m = stackedInputHeight;
-                int n = filterWidth * numFiltersToUse; // this batch
-                int k = inputDepth * filterWidth;
-                int lda = stackedInputWidth * inputDepth;
-                int ldb = filterWidth * numFilters;
-                int ldc = filterWidth * batchSize;
-
-                // Note: Wl is transposed
-                EmitMatrixMatrixMultiply<ValueType>(function, useBlas, false, true, m, n, k, Vj, lda, Wl, ldb, scratchPtr, ldc);
+                auto j = convLoop.LoadIterationVariable(); // j = start column for convolution
+                auto pScratch = function.PointerOffset(scratchPtr, function.Operator(times, j, function.Literal<int>(scratchMemSize)));
 
                 // S loop here as well
                 auto stackLoop = function.ForLoop();
@@ -476,12 +483,11 @@ namespace nodes
                             {
                                 auto currRow = function.Operator(plus, stackStartRow, function.Literal<int>(diagonal));
                                 auto currRowOffset = function.Operator(times, currRow, function.Literal<int>(batchSize * filterWidth));
-                                // auto currColOffset = function.Operator(plus, function.Literal<int>(batchSize * diagonal), l);
                                 // col offset = l*k + diagonal
                                 auto currColOffset = function.Operator(plus, function.Operator(times, l, function.Literal<int>(filterWidth)), function.Literal<int>(diagonal));
 
                                 auto inputIndex = function.Operator(plus, currRowOffset, currColOffset);
-                                llvm::Value* diagonalValue = function.ValueAt(scratchPtr, inputIndex);
+                                llvm::Value* diagonalValue = function.ValueAt(pScratch, inputIndex);
                                 // diagonalValue = A[startRow + diagonal, l*k + diagonal]
                                 if (sum == nullptr)
                                     sum = diagonalValue;
@@ -499,8 +505,8 @@ namespace nodes
                 }
                 stackLoop.End();
             }
+            convLoop.End();
         }
-        convLoop.End();
     }
 
     // Explicit specializations
@@ -71,54 +71,12 @@ namespace nodes
             function.Call(gemm, args);
         }
 
-        // TODO: emit this as a function in the module
+        // Calls a GEMM kernel emitted into the module and specialized to these sizes, for when there's no BLAS library
         template <typename ValueType>
-        void EmitMatrixMatrixMultiplySlow(emitters::IRFunctionEmitter& function, bool transposeA, bool transposeB, int m, int n, int k, llvm::Value* A, int lda, llvm::Value* B, int ldb, llvm::Value* C, int ldc)
+        void EmitMatrixMatrixMultiplyTiled(emitters::IRFunctionEmitter& function, bool transposeA, bool transposeB, int m, int n, int k, llvm::Value* A, int lda, llvm::Value* B, int ldb, llvm::Value* C, int ldc)
         {
-            llvm::Value* accum = function.Variable(emitters::GetVariableType<ValueType>(), "accum");
-
-            auto mLoop = function.ForLoop();
-            mLoop.Begin(m);
-            {
-                auto mIndex = mLoop.LoadIterationVariable();
-
-                auto nLoop = function.ForLoop();
-                nLoop.Begin(n);
-                {
-                    auto nIndex = nLoop.LoadIterationVariable();
-
-                    function.Store(accum, function.Literal(static_cast<ValueType>(0.0)));
-                    auto kLoop = function.ForLoop();
-                    kLoop.Begin(k);
-                    {
-                        auto kIndex = kLoop.LoadIterationVariable();
-
-                        llvm::Value* aIndex = nullptr;
-                        llvm::Value* bIndex = nullptr;
-                        if (transposeA)
-                            aIndex = function.Operator(plus, function.Operator(times, kIndex, function.Literal(lda)), mIndex);
-                        else
-                            aIndex = function.Operator(plus, function.Operator(times, mIndex, function.Literal(lda)), kIndex);
-
-                        if (transposeB)
-                            bIndex = function.Operator(plus, function.Operator(times, nIndex, function.Literal(ldb)), kIndex);
-                        else
-                            bIndex = function.Operator(plus, function.Operator(times, kIndex, function.Literal(ldb)), nIndex);
-
-                        auto aValue = function.ValueAt(A, aIndex);
-                        auto bValue = function.ValueAt(B, bIndex);
-                        auto value = function.Operator(timesFloat, aValue, bValue);
-                        function.OperationAndUpdate(accum, plusFloat, value);
-                    }
-                    kLoop.End();
-
-                    // store output in C[m,n]
-                    auto cIndex = function.Operator(plus, function.Operator(times, mIndex, function.Literal(ldc)), nIndex);
-                    function.SetValueAt(C, cIndex, function.Load(accum));
-                }
-                nLoop.End();
-            }
-            mLoop.End();
+            llvm::Function* gemm = function.GetModule().GetRuntime().GetTiledGEMMFunction<ValueType>(transposeA, transposeB, m, n, k, lda, ldb, ldc);
+            function.Call(gemm, { function.PointerOffset(A, 0), function.PointerOffset(B, 0), function.PointerOffset(C, 0) });
         }
     } // end anonymous namespace
 
@@ -201,7 +159,7 @@ namespace nodes
         }
         else
         {
-            EmitMatrixMatrixMultiplySlow<ValueType>(function, _transpose1, _transpose2, (int)_m, (int)_n, (int)_k, pInput1, (int)_lda, pInput2, (int)_ldb, pOutput, (int)_ldc);
+            EmitMatrixMatrixMultiplyTiled<ValueType>(function, _transpose1, _transpose2, (int)_m, (int)_n, (int)_k, pInput1, (int)_lda, pInput2, (int)_ldb, pOutput, (int)_ldc);
         }
     }
 
@@ -153,6 +153,26 @@ namespace nodes
         transformer.MapNodeOutput(output, newNode->output);
     }
 
+    template <typename ValueType>
+    bool MatrixVectorMultiplyNode<ValueType>::Batch(model::ModelTransformer& transformer, size_t batchSize) const
+    {
+        // With the batch of vectors as the rows of a matrix X, the batch of outputs is the matrix X * M^T, which is a
+        // single GEMM call instead of a GEMV call per example. The matrix must be the same for each example.
+        auto matrixElements = transformer.GetBatchedPortElements(_inputMatrix.GetPortElements());
+        if (_incx != 1 || matrixElements.Size() != _inputMatrix.Size())
+        {
+            return false;
+        }
+        auto vectorElements = GetBatchedInput(_inputVector, transformer, batchSize);
+        if (vectorElements.Size() == 0)
+        {
+            return false;
+        }
+        auto newNode = transformer.AddNode<MatrixMatrixMultiplyNode<ValueType>>(vectorElements, batchSize, _m, _n, _n, false, matrixElements, _lda, true, _m);
+        transformer.MapNodeOutput(output, newNode->output);
+        return true;
+    }
+
     template <typename ValueType>
     void MatrixVectorMultiplyNode<ValueType>::Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function)
     {
@@ -186,54 +186,56 @@ namespace nodes
 
         // TODO: add prologue / epilogue for padded / out-of-bounds values
 
-        // Create the pooling function
         using FType = typename PoolingFunctionT<PoolingFunctionType, ValueType>::type;
-        FType poolingFunction{ function };
 
         // TODO: implement these nested loops via recursion
         const int rowDimension = 0;
         const int columnDimension = 1;
         const int channelDimension = 2;
 
-        auto rowLoop = function.ForLoop();
-        rowLoop.Begin(outputRows); // for each row
-        {
-            auto outputRowIndex = rowLoop.LoadIterationVariable();
-            auto inputRowIndex = function.Operator(times, outputRowIndex, function.Literal(stride));
+        // The rows are independent, so they may be computed in parallel
+        function.ParallelFor(outputRows, { pInput, pOutput }, [&](emitters::IRFunctionEmitter& rowFunction, llvm::Value* outputRowIndex, const emitters::IRValueList& capturedValues) {
+            llvm::Value* pRowInput = capturedValues[0];
+            llvm::Value* pRowOutput = capturedValues[1];
+
+            // Create the pooling function
+            FType poolingFunction{ rowFunction };
 
-            llvm::Value* rowInputInternalOffset = function.Operator(plus, inputRowIndex, function.Literal<int>(inputOffset[rowDimension]));
-            llvm::Value* rowOutputInternalOffset = function.Operator(plus, outputRowIndex, function.Literal<int>(outputOffset[rowDimension]));
+            auto inputRowIndex = rowFunction.Operator(times, outputRowIndex, rowFunction.Literal(stride));
 
-            llvm::Value* rowInputOffset = function.Operator(times, rowInputInternalOffset, function.Literal<int>(inputIncrement[rowDimension]));
-            llvm::Value* rowOutputOffset = function.Operator(times, rowOutputInternalOffset, function.Literal<int>(outputIncrement[rowDimension]));
+            llvm::Value* rowInputInternalOffset = rowFunction.Operator(plus, inputRowIndex, rowFunction.Literal<int>(inputOffset[rowDimension]));
+            llvm::Value* rowOutputInternalOffset = rowFunction.Operator(plus, outputRowIndex, rowFunction.Literal<int>(outputOffset[rowDimension]));
 
-            auto columnLoop = function.ForLoop();
+            llvm::Value* rowInputOffset = rowFunction.Operator(times, rowInputInternalOffset, rowFunction.Literal<int>(inputIncrement[rowDimension]));
+            llvm::Value* rowOutputOffset = rowFunction.Operator(times, rowOutputInternalOffset, rowFunction.Literal<int>(outputIncrement[rowDimension]));
+
+            auto columnLoop = rowFunction.ForLoop();
             columnLoop.Begin(outputColumns); // for each column
             {
                 auto outputColumnIndex = columnLoop.LoadIterationVariable();
-                auto inputColumnIndex = function.Operator(times, outputColumnIndex, function.Literal(stride));
+                auto inputColumnIndex = rowFunction.Operator(times, outputColumnIndex, rowFunction.Literal(stride));
 
-                llvm::Value* columnInputInternalOffset = function.Operator(plus, inputColumnIndex, function.Literal<int>(inputOffset[columnDimension]));
-                auto scaledColumnInputOffset = function.Operator(times, columnInputInternalOffset, function.Literal<int>(inputIncrement[columnDimension]));
-                auto columnInputOffset = function.Operator(plus, rowInputOffset, scaledColumnInputOffset);
+                llvm::Value* columnInputInternalOffset = rowFunction.Operator(plus, inputColumnIndex, rowFunction.Literal<int>(inputOffset[columnDimension]));
+                auto scaledColumnInputOffset = rowFunction.Operator(times, columnInputInternalOffset, rowFunction.Literal<int>(inputIncrement[columnDimension]));
+                auto columnInputOffset = rowFunction.Operator(plus, rowInputOffset, scaledColumnInputOffset);
 
-                llvm::Value* columnOutputInternalOffset = function.Operator(plus, outputColumnIndex, function.Literal<int>(outputOffset[columnDimension]));
-                auto scaledColumnOutputOffset = function.Operator(times, columnOutputInternalOffset, function.Literal<int>(outputIncrement[columnDimension]));
-                auto columnOutputOffset = function.Operator(plus, rowOutputOffset, scaledColumnOutputOffset);
+                llvm::Value* columnOutputInternalOffset = rowFunction.Operator(plus, outputColumnIndex, rowFunction.Literal<int>(outputOffset[columnDimension]));
+                auto scaledColumnOutputOffset = rowFunction.Operator(times, columnOutputInternalOffset, rowFunction.Literal<int>(outputIncrement[columnDimension]));
+                auto columnOutputOffset = rowFunction.Operator(plus, rowOutputOffset, scaledColumnOutputOffset);
 
-                auto channelLoop = function.ForLoop();
+                auto channelLoop = rowFunction.ForLoop();
                 channelLoop.Begin(inputDepth); // for each channel
                 {
                     auto channelIndex = channelLoop.LoadIterationVariable();
 
                     // Note that channel stride == 1, so we don't really need to scale it. The optimizer should get rid of the unnecessary multiply by 1
-                    llvm::Value* channelInputInternalOffset = function.Operator(plus, channelIndex, function.Literal<int>(inputOffset[channelDimension]));
-                    auto scaledChannelInputOffset = function.Operator(times, channelInputInternalOffset, function.Literal<int>(inputIncrement[channelDimension]));
-                    auto channelInputOffset = function.Operator(plus, columnInputOffset, scaledChannelInputOffset);
+                    llvm::Value* channelInputInternalOffset = rowFunction.Operator(plus, channelIndex, rowFunction.Literal<int>(inputOffset[channelDimension]));
+                    auto scaledChannelInputOffset = rowFunction.Operator(times, channelInputInternalOffset, rowFunction.Literal<int>(inputIncrement[channelDimension]));
+                    auto channelInputOffset = rowFunction.Operator(plus, columnInputOffset, scaledChannelInputOffset);
 
-                    llvm::Value* channelOutputInternalOffset = function.Operator(plus, channelIndex, function.Literal<int>(outputOffset[channelDimension]));
-                    auto scaledChannelOutputOffset = function.Operator(times, channelOutputInternalOffset, function.Literal<int>(outputIncrement[channelDimension]));
-                    auto channelOutputOffset = function.Operator(plus, columnOutputOffset, scaledChannelOutputOffset);
+                    llvm::Value* channelOutputInternalOffset = rowFunction.Operator(plus, channelIndex, rowFunction.Literal<int>(outputOffset[channelDimension]));
+                    auto scaledChannelOutputOffset = rowFunction.Operator(times, channelOutputInternalOffset, rowFunction.Literal<int>(outputIncrement[channelDimension]));
+                    auto channelOutputOffset = rowFunction.Operator(plus, columnOutputOffset, scaledChannelOutputOffset);
 
                     // inputLocationOffset is the offset to the beginning corner of the input window
                     // outputLocationOffset is the offset to the output entry
@@ -242,7 +244,7 @@ namespace nodes
 
                     // Now loop over the input window
                     //
-                    poolingFunction.Reset(function);
+                    poolingFunction.Reset(rowFunction);
                     for (int poolRowIndex = 0; poolRowIndex < poolingSize; ++poolRowIndex)
                     {
                         for (int poolColumnIndex = 0; poolColumnIndex < poolingSize; ++poolColumnIndex)
@@ -253,9 +255,9 @@ namespace nodes
 
                             if (canSkipBoundsCheck)
                             {
-                                auto valueIndex = function.Operator(plus, inputLocationOffset, function.Literal<int>(totalOffset));
-                                auto value = function.ValueAt(pInput, valueIndex);
-                                poolingFunction.Accumulate(function, value);
+                                auto valueIndex = rowFunction.Operator(plus, inputLocationOffset, rowFunction.Literal<int>(totalOffset));
+                                auto value = rowFunction.ValueAt(pRowInput, valueIndex);
+                                poolingFunction.Accumulate(rowFunction, value);
                             }
                             else
                             {
@@ -263,42 +265,41 @@ namespace nodes
                                 // This is a bit of a mess, but it works
                                 //
 
-                                auto xCoordinate = function.Operator(plus, function.Literal<int>(offsetX), inputColumnIndex);
-                                auto yCoordinate = function.Operator(plus, function.Literal<int>(offsetY), inputRowIndex);
+                                auto xCoordinate = rowFunction.Operator(plus, rowFunction.Literal<int>(offsetX), inputColumnIndex);
+                                auto yCoordinate = rowFunction.Operator(plus, rowFunction.Literal<int>(offsetY), inputRowIndex);
 
-                                auto xTooSmall = function.Comparison(lessThan, xCoordinate, function.Literal<int>(0));
-                                auto xTooBig = function.Comparison(greaterThanOrEqual, xCoordinate, function.Literal(inputColumns));
-                                auto yTooSmall = function.Comparison(lessThan, yCoordinate, function.Literal<int>(0));
-                                auto yTooBig = function.Comparison(greaterThanOrEqual, yCoordinate, function.Literal(inputRows));
-                                auto xBad = function.Operator(emitters::TypedOperator::logicalOr, xTooSmall, xTooBig);
-                                auto yBad = function.Operator(emitters::TypedOperator::logicalOr, yTooSmall, yTooBig);
-                                auto outOfBounds = function.Operator(emitters::TypedOperator::logicalOr, xBad, yBad);
+                                auto xTooSmall = rowFunction.Comparison(lessThan, xCoordinate, rowFunction.Literal<int>(0));
+                                auto xTooBig = rowFunction.Comparison(greaterThanOrEqual, xCoordinate, rowFunction.Literal(inputColumns));
+                                auto yTooSmall = rowFunction.Comparison(lessThan, yCoordinate, rowFunction.Literal<int>(0));
+                                auto yTooBig = rowFunction.Comparison(greaterThanOrEqual, yCoordinate, rowFunction.Literal(inputRows));
+                                auto xBad = rowFunction.Operator(emitters::TypedOperator::logicalOr, xTooSmall, xTooBig);
+                                auto yBad = rowFunction.Operator(emitters::TypedOperator::logicalOr, yTooSmall, yTooBig);
+                                auto outOfBounds = rowFunction.Operator(emitters::TypedOperator::logicalOr, xBad, yBad);
 
-                                auto ifEmitter = function.If();
+                                auto ifEmitter = rowFunction.If();
                                 ifEmitter.If(outOfBounds, true);
                                 {
-                                    auto paddingValue = poolingFunction.GetValueAtPadding(function);
-                                    poolingFunction.Accumulate(function, paddingValue);
+                                    auto paddingValue = poolingFunction.GetValueAtPadding(rowFunction);
+                                    poolingFunction.Accumulate(rowFunction, paddingValue);
                                 }
                                 ifEmitter.Else();
                                 {
-                                    auto valueIndex = function.Operator(plus, inputLocationOffset, function.Literal<int>(totalOffset));
-                                    auto value = function.ValueAt(pInput, valueIndex);
-                                    poolingFunction.Accumulate(function, value);
+                                    auto valueIndex = rowFunction.Operator(plus, inputLocationOffset, rowFunction.Literal<int>(totalOffset));
+                                    auto value = rowFunction.ValueAt(pRowInput, valueIndex);
+                                    poolingFunction.Accumulate(rowFunction, value);
                                 }
                                 ifEmitter.End();
                             }
                         }
                     }
 
-                    auto value = poolingFunction.GetValue(function);
-                    function.SetValueAt(pOutput, outputLocationOffset, value);
+                    auto value = poolingFunction.GetValue(rowFunction);
+                    rowFunction.SetValueAt(pRowOutput, outputLocationOffset, value);
                 }
                 channelLoop.End();
             }
             columnLoop.End();
-        }
-        rowLoop.End();
+        });
 
     } // end function
 
@@ -0,0 +1,41 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     BatchedInput.tcc (nodes)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace ell
+{
+namespace nodes
+{
+    template <typename ValueType>
+    model::PortElements<ValueType> GetBatchedInput(const model::InputPort<ValueType>& input, model::ModelTransformer& transformer, size_t batchSize)
+    {
+        auto elements = transformer.GetBatchedPortElements(input.GetPortElements());
+        if (elements.Size() == input.Size() * batchSize)
+        {
+            return elements;
+        }
+
+        if (elements.Size() == input.Size() && elements.IsFullPortOutput())
+        {
+            auto constantNode = dynamic_cast<const ConstantNode<ValueType>*>(elements.GetRanges()[0].ReferencedPort()->GetNode());
+            if (constantNode != nullptr)
+            {
+                const auto& values = constantNode->GetValues();
+                std::vector<ValueType> batchValues;
+                batchValues.reserve(values.size() * batchSize);
+                for (size_t index = 0; index < batchSize; ++index)
+                {
+                    batchValues.insert(batchValues.end(), values.begin(), values.end());
+                }
+                auto newNode = transformer.AddNode<ConstantNode<ValueType>>(batchValues);
+                return newNode->output;
+            }
+        }
+        return {};
+    }
+}
+}
@@ -209,6 +209,21 @@ namespace nodes
         transformer.MapNodeOutput(output, newNode->output);
     }
 
+    template <typename ValueType>
+    bool BinaryOperationNode<ValueType>::Batch(model::ModelTransformer& transformer, size_t batchSize) const
+    {
+        // The operation is elementwise, so it applies to a batch of inputs as is
+        auto PortElements1 = GetBatchedInput(_input1, transformer, batchSize);
+        auto PortElements2 = GetBatchedInput(_input2, transformer, batchSize);
+        if (PortElements1.Size() == 0 || PortElements2.Size() == 0)
+        {
+            return false;
+        }
+        auto newNode = transformer.AddNode<BinaryOperationNode<ValueType>>(PortElements1, PortElements2, _operation);
+        transformer.MapNodeOutput(output, newNode->output);
+        return true;
+    }
+
     template <typename ValueType>
     void BinaryOperationNode<ValueType>::Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function)
     {
@@ -233,7 +233,7 @@ namespace nodes
                                                                                   std::vector<llvm::Value*>& secondaryValues) const
     {
         // Note: It should be easy to unroll the last K levels by putting a real loop here when dimension < k
-        //       Or, instead of unrolling, vectorizing --- if broadcastDimension = 1, let secondaryValue be a vector and load it one loop previous
+        //       The innermost loop is vectorized below when the secondary values are constant along it
 
         const auto numDimensions = NumPrimaryInputDimensions();
         auto&& inputLayout = GetInputLayout();
@@ -247,11 +247,9 @@ namespace nodes
         const auto numSecondaryInputs = NumSecondaryInputs();
         const auto secondaryInputSize = GetSecondaryInputSize();
 
-        auto loop = function.ForLoop();
-        loop.Begin(inputSize[dimension]);
-        {
-            auto loopIndex = loop.LoadIterationVariable();
-
+        // Emits the body of the loop for the given index. In the innermost loop, `width` consecutive
+        // elements are computed at once when the function can operate on vector values.
+        auto emitLoopBody = [&](llvm::Value* loopIndex, size_t width) {
             // Calculate the offset within this dimension = (loopIndex + offset[dimension])
             llvm::Value* thisInputDimensionInternalOffset = function.Operator(emitters::GetAddForValueType<int>(), loopIndex, function.Literal<int>(inputOffset[dimension]));
             llvm::Value* thisOutputDimensionInternalOffset = function.Operator(emitters::GetAddForValueType<int>(), loopIndex, function.Literal<int>(outputOffset[dimension]));
@@ -301,12 +299,27 @@ namespace nodes
             else
             {
                 // We're in the innermost loop --- compute the value
-                auto primaryValue = function.ValueAt(primaryInput, thisInputDimensionOffset);
+                auto primaryValue = function.VectorValueAt(primaryInput, thisInputDimensionOffset, width);
                 auto outputValue = GetFunction().Compile(function, primaryValue, secondaryValues);
                 function.SetValueAt(output, thisOutputDimensionOffset, outputValue);
             }
+        };
+
+        // The innermost dimension is contiguous, so it can be computed with SIMD vectors unless
+        // the secondary values change along it
+        if (dimension == numDimensions - 1 && dimension != broadcastDimension && GetFunction().CanUseVectorTypes())
+        {
+            function.VectorLoop(inputSize[dimension], function.GetEmitter().Type(emitters::GetVariableType<ValueType>()), emitLoopBody);
+        }
+        else
+        {
+            auto loop = function.ForLoop();
+            loop.Begin(inputSize[dimension]);
+            {
+                emitLoopBody(loop.LoadIterationVariable(), 1);
+            }
+            loop.End();
         }
-        loop.End();
     }
 
     template <typename ValueType, typename FunctionType>
@@ -40,6 +40,14 @@ namespace nodes
         transformer.MapNodeOutput(output, newNode->output);
     }
 
+    // The values are the same for each example, so the node is copied rather than repeated
+    template <typename ValueType>
+    bool ConstantNode<ValueType>::Batch(model::ModelTransformer& transformer, size_t batchSize) const
+    {
+        Copy(transformer);
+        return true;
+    }
+
     template <typename ValueType>
     void ConstantNode<ValueType>::Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function)
     {
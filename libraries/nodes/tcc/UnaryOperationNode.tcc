@@ -27,6 +27,7 @@ namespace nodes
                 ADD_TO_STRING_ENTRY(emitters::UnaryOperationType, logicalNot);
                 ADD_TO_STRING_ENTRY(emitters::UnaryOperationType, tanh);
                 ADD_TO_STRING_ENTRY(emitters::UnaryOperationType, exp);
+                ADD_TO_STRING_ENTRY(emitters::UnaryOperationType, log);
 
                 default:
                     throw utilities::InputException(utilities::InputExceptionErrors::indexOutOfRange, "Unknown unary operation");
@@ -41,6 +42,7 @@ namespace nodes
             ADD_FROM_STRING_ENTRY(emitters::UnaryOperationType, logicalNot);
             ADD_FROM_STRING_ENTRY(emitters::UnaryOperationType, tanh);
             ADD_FROM_STRING_ENTRY(emitters::UnaryOperationType, exp);
+            ADD_FROM_STRING_ENTRY(emitters::UnaryOperationType, log);
 
             throw utilities::InputException(utilities::InputExceptionErrors::indexOutOfRange, "Unknown unary operation");
         }
@@ -92,6 +94,18 @@ namespace nodes
         {
             throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch, "Error: taking exp of a boolean value");
         }
+
+        template <typename ValueType>
+        ValueType Log(ValueType a)
+        {
+            return std::log(a);
+        }
+
+        template <>
+        inline bool Log(bool x)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch, "Error: taking log of a boolean value");
+        }
     }
 
     template <typename ValueType>
@@ -139,6 +153,11 @@ namespace nodes
                 output = ComputeOutput(UnaryOperations::Exp<ValueType>);
             }
             break;
+            case emitters::UnaryOperationType::log:
+            {
+                output = ComputeOutput(UnaryOperations::Log<ValueType>);
+            }
+            break;
             case emitters::UnaryOperationType::tanh:
             {
                 output = ComputeOutput(UnaryOperations::Tanh<ValueType>);
@@ -160,13 +179,42 @@ namespace nodes
     }
 
     template <typename ValueType>
-    llvm::Function* UnaryOperationNode<ValueType>::GetOperator(emitters::IRFunctionEmitter& function) const
+    bool UnaryOperationNode<ValueType>::Batch(model::ModelTransformer& transformer, size_t batchSize) const
+    {
+        // The operation is elementwise, so it applies to a batch of inputs as is
+        auto newPortElements = GetBatchedInput(_input, transformer, batchSize);
+        if (newPortElements.Size() == 0)
+        {
+            return false;
+        }
+        auto newNode = transformer.AddNode<UnaryOperationNode<ValueType>>(newPortElements, _operation);
+        transformer.MapNodeOutput(output, newNode->output);
+        return true;
+    }
+
+    template <typename ValueType>
+    llvm::Function* UnaryOperationNode<ValueType>::GetOperator(emitters::IRFunctionEmitter& function, llvm::Type* pArgType) const
     {
         switch (this->GetOperation())
         {
             case emitters::UnaryOperationType::sqrt:
             {
-                return function.GetModule().GetRuntime().GetSqrtFunction<ValueType>();
+                return function.GetModule().GetRuntime().GetSqrtFunction(pArgType);
+            }
+            break;
+            case emitters::UnaryOperationType::exp:
+            {
+                return function.GetModule().GetRuntime().GetExpFunction(pArgType);
+            }
+            break;
+            case emitters::UnaryOperationType::log:
+            {
+                return function.GetModule().GetRuntime().GetLogFunction(pArgType);
+            }
+            break;
+            case emitters::UnaryOperationType::tanh:
+            {
+                return function.GetModule().GetRuntime().GetTanhFunction(pArgType);
             }
             break;
             default:
@@ -190,20 +238,17 @@ namespace nodes
     template <typename ValueType>
     void UnaryOperationNode<ValueType>::CompileLoop(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function)
     {
-        // Loop version broken
-        auto count = input.Size();
         llvm::Value* pInput = compiler.EnsurePortEmitted(input);
         llvm::Value* pResult = compiler.EnsurePortEmitted(output);
 
-        auto forLoop = function.ForLoop();
-        forLoop.Begin(count);
-        {
-            auto i = forLoop.LoadIterationVariable();
-            llvm::Value* inputValue = function.ValueAt(pInput, i);
-            llvm::Value* pOpResult = function.Call(GetOperator(function), { inputValue });
+        auto emitLoopBody = [&](llvm::Value* i, size_t width) {
+            llvm::Value* inputValue = function.VectorValueAt(pInput, i, width);
+            llvm::Value* pOpResult = function.Call(GetOperator(function, inputValue->getType()), { inputValue });
             function.SetValueAt(pResult, i, pOpResult);
-        }
-        forLoop.End();
+        };
+
+        // The runtime's math functions accept vectors of floating point values, so all but the last few elements are computed a vector at a time
+        function.VectorLoop(input.Size(), function.GetEmitter().Type(emitters::GetVariableType<ValueType>()), emitLoopBody);
     }
 
     template <typename ValueType>
@@ -214,7 +259,7 @@ namespace nodes
         for (size_t i = 0; i < input.Size(); ++i)
         {
             llvm::Value* inputValue = compiler.LoadPortElementVariable(input.GetInputElement(i));
-            llvm::Value* pOpResult = function.Call(GetOperator(function), { inputValue });
+            llvm::Value* pOpResult = function.Call(GetOperator(function, inputValue->getType()), { inputValue });
             function.SetValueAt(pResult, function.Literal((int)i), pOpResult);
         }
     }
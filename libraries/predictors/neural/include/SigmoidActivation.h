@@ -24,6 +24,16 @@ namespace neural
         /// <param name="input"> The input value. </param>
         ElementType Apply(const ElementType input) const;
 
+        /// <summary>
+        /// Sets the elements of an output array as a function of the elements of an input array. This
+        /// version uses the vectorized approximation when the math library's transcendental precision is fast.
+        /// </summary>
+        ///
+        /// <param name="pInput"> Pointer to the input array. </param>
+        /// <param name="pOutput"> Pointer to the output array, which may equal pInput. </param>
+        /// <param name="size"> The number of elements. </param>
+        void Apply(const ElementType* pInput, ElementType* pOutput, size_t size) const;
+
         /// <summary> Typename used for serialization. </summary>
         static std::string GetTypeName() { return "SigmoidActivation"; }
     };
@@ -33,15 +33,14 @@ namespace neural
         auto output = GetOutputMinusPadding();
         auto input = _layerParameters.input;
 
+        // the channels of each pixel are contiguous, in both the input and the output, so the
+        // activation is applied to one array per pixel
         for (size_t i = 0; i < input.NumRows(); i++)
         {
             for (size_t j = 0; j < input.NumColumns(); j++)
             {
-                for (size_t k = 0; k < input.NumChannels(); k++)
-                {
-                    ElementType value = input(i, j, k);
-                    output(i, j, k) = _activation.Apply(value);
-                }
+                const ElementType* pInput = input.GetDataPointer() + i * input.GetIncrement2() + j * input.GetIncrement1();
+                _activation.Apply(pInput, &output(i, j, 0), input.NumChannels());
             }
         }
     }
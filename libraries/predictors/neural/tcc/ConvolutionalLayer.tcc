@@ -91,29 +91,36 @@ namespace neural
             const size_t numFilters = _layerParameters.outputShape[2];
             auto weightsMatrix = _weights.ReferenceAsMatrix().Transpose();
 
-            for (size_t j = 0; j < numConvolutions; j++)
-            {
-                // Get the sub matrix for Vj
-                auto Vj = inputMatrix.GetSubMatrix(0, j * depth, inputMatrix.NumRows(), kt);
+            const size_t receptiveField = _convolutionalParameters.receptiveField;
+            const size_t numRows = inputMatrix.NumRows();
 
-                for (size_t filterStart = 0; filterStart < numFilters; filterStart += numFiltersAtAtime)
-                {
-                    size_t numFiltersToUse = std::min(numFiltersAtAtime, numFilters - filterStart);
+            // Each convolution j multiplies the submatrix Vj, which starts j * depth columns into the input, by
+            // the weights of a group of filters. The products for all the convolutions share their weights, so
+            // they are computed as one strided batch, and stacked vertically in A.
+            auto V0 = inputMatrix.GetSubMatrix(0, 0, numRows, kt);
+            MatrixType A(numConvolutions * numRows, receptiveField * std::min(numFiltersAtAtime, numFilters));
+            const size_t aBatchIncrement = numRows * A.NumColumns();
 
-                    auto Wl = weightsMatrix.GetSubMatrix(0, filterStart * _convolutionalParameters.receptiveField, weightsMatrix.NumRows(), numFiltersToUse * _convolutionalParameters.receptiveField);
+            for (size_t filterStart = 0; filterStart < numFilters; filterStart += numFiltersAtAtime)
+            {
+                size_t numFiltersToUse = std::min(numFiltersAtAtime, numFilters - filterStart);
 
-                    MatrixType A(Vj.NumRows(), _convolutionalParameters.receptiveField * numFiltersToUse);
+                auto Wl = weightsMatrix.GetSubMatrix(0, filterStart * receptiveField, weightsMatrix.NumRows(), numFiltersToUse * receptiveField);
+                auto A0 = A.GetSubMatrix(0, 0, numRows, numFiltersToUse * receptiveField);
 
-                    math::Operations::Multiply(static_cast<ElementType>(1.0), Vj, Wl, static_cast<ElementType>(0.0), A);
+                math::Operations::MultiplyBatched(numConvolutions, static_cast<ElementType>(1.0), V0, depth, Wl, 0, static_cast<ElementType>(0.0), A0, aBatchIncrement);
 
+                for (size_t j = 0; j < numConvolutions; j++)
+                {
+                    const size_t firstRow = j * numRows;
                     for (size_t l = 0; l < numFiltersToUse; l++)
                     {
-                        for (size_t row = 0; row < (A.NumRows() - 2 * paddingSize); row++)
+                        for (size_t row = 0; row < (numRows - 2 * paddingSize); row++)
                         {
                             ElementType sum = 0.0;
-                            for (size_t diagonal = 0; diagonal < _convolutionalParameters.receptiveField; diagonal++)
+                            for (size_t diagonal = 0; diagonal < receptiveField; diagonal++)
                             {
-                                sum += A(row + diagonal, l * _convolutionalParameters.receptiveField + diagonal);
+                                sum += A(firstRow + row + diagonal, l * receptiveField + diagonal);
                             }
                             output(row, j, filterStart + l) = sum;
                         }
@@ -18,6 +18,15 @@ namespace neural
         return (( input > 0) ? input : _leakyFactor * input);
     }
 
+    template <typename ElementType>
+    void LeakyReLUActivation<ElementType>::Apply(const ElementType* pInput, ElementType* pOutput, size_t size) const
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            pOutput[i] = Apply(pInput[i]);
+        }
+    }
+
 }
 }
 }
\ No newline at end of file
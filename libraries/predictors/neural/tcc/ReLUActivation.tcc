@@ -17,6 +17,15 @@ namespace neural
     {
         return ((input > 0) ? input : 0);
     }
+
+    template <typename ElementType>
+    void ReLUActivation<ElementType>::Apply(const ElementType* pInput, ElementType* pOutput, size_t size) const
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            pOutput[i] = Apply(pInput[i]);
+        }
+    }
 }
 }
 }
@@ -7,6 +7,9 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 // math
+#include "Transcendental.h"
+
+// stl
 #include <cmath>
 
 namespace ell
@@ -31,6 +34,12 @@ namespace neural
         }
         return output;
     }
+
+    template <typename ElementType>
+    void SigmoidActivation<ElementType>::Apply(const ElementType* pInput, ElementType* pOutput, size_t size) const
+    {
+        math::Sigmoid(pInput, pOutput, size);
+    }
 }
 }
 }
@@ -6,6 +6,9 @@
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// math
+#include "Transcendental.h"
+
 // STL
 #include <limits>
 
@@ -50,17 +53,20 @@ namespace neural
             }
         }
 
-        // Use the max to calculate the Euler value
+        // Use the max to calculate the Euler value, on the (contiguous) channels of one pixel at a time
         for (size_t i = 0; i < input.NumRows(); i++)
         {
             for (size_t j = 0; j < input.NumColumns(); j++)
             {
+                ElementType* pOutput = &output(i, j, 0);
                 for (size_t k = 0; k < input.NumChannels(); k++)
                 {
-                    ElementType value = input(i, j, k);
-                    ElementType eulerVal = std::exp(value - maxValue);
-                    output(i, j, k) = eulerVal;
-                    sum += eulerVal;
+                    pOutput[k] = input(i, j, k) - maxValue;
+                }
+                math::Exp(pOutput, pOutput, input.NumChannels());
+                for (size_t k = 0; k < input.NumChannels(); k++)
+                {
+                    sum += pOutput[k];
                 }
             }
         }
@@ -8,6 +8,9 @@
 
 #include "ProtoNNPredictor.h"
 
+// math
+#include "Transcendental.h"
+
 // stl
 #include <memory>
 
@@ -52,9 +55,9 @@ namespace predictors
             math::ColumnVector<double> prototype(prototypes.GetColumn(i).ToArray());
             prototype -= projectedInput;
             auto prototypeDistance = prototype.Norm2();
-            auto similarity = std::exp(-1 * gammaVal * gammaVal * prototypeDistance * prototypeDistance);
-            similarityToPrototypes[i] = similarity;
+            similarityToPrototypes[i] = -1 * gammaVal * gammaVal * prototypeDistance * prototypeDistance;
         }
+        math::Exp(similarityToPrototypes.GetDataPointer(), similarityToPrototypes.GetDataPointer(), numPrototypes);
 
         // Get the prediction label
         math::ColumnVector<double> labels(GetNumLabels());
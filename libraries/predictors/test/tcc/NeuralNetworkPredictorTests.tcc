@@ -10,6 +10,10 @@
 #include "MaxPoolingFunction.h"
 #include "NeuralNetworkPredictor.h"
 #include "ReLUActivation.h"
+#include "SigmoidActivation.h"
+
+// math
+#include "Transcendental.h"
 
 // testing
 #include "testing.h"
@@ -109,6 +113,18 @@ void ActivationLayerTest()
     auto output0 = activationLayer.GetOutput();
     testing::ProcessTest("Testing ActivationLayer, values", output0(1, 1, 0) == 1.0 && output0(1, 2, 0) == 0 && output0(2, 1, 1) == 3.0 && output0(2, 2, 1) == 0);
     testing::ProcessTest("Testing ActivationLayer, padding", output0(0, 0, 0) == 0 && output0(0, 1, 0) == 0 && output0(2, 3, 1) == 0 && output0(3, 3, 1) == 0);
+
+    // The sigmoid activation, with both the exact and the vectorized approximation of exp
+    ActivationLayer<ElementType, SigmoidActivation> sigmoidLayer(activationParameters);
+    for (auto precision : { math::TranscendentalPrecision::exact, math::TranscendentalPrecision::fast })
+    {
+        math::SetTranscendentalPrecision(precision);
+        sigmoidLayer.Compute();
+        auto output1 = sigmoidLayer.GetOutput();
+        auto name = std::string("Testing ActivationLayer with SigmoidActivation") + (precision == math::TranscendentalPrecision::fast ? " (fast)" : "");
+        testing::ProcessTest(name, Equals(output1(1, 1, 0), 0.7310585786) && Equals(output1(1, 2, 0), 0.1192029220) && Equals(output1(2, 1, 1), 0.9525741268) && Equals(output1(2, 2, 1), 0.0179862100) && Equals(output1(1, 1, 1), 0.5) && output1(0, 0, 0) == 0);
+    }
+    math::SetTranscendentalPrecision(math::TranscendentalPrecision::exact);
 }
 
 template <typename ElementType>
@@ -518,6 +534,12 @@ void SoftmaxLayerTest()
     auto output = softmaxLayer.GetOutput();
     testing::ProcessTest("Testing SoftmaxLayer, values", Equals(output(1, 1, 0), 0.0900305733) && Equals(output(1, 1, 1), 0.244728476) && Equals(output(1, 1, 2), 0.665240943));
     testing::ProcessTest("Testing SoftmaxLayer, padding", output(0, 0, 0) == 0 && output(0, 1, 0) == 0 && output(2, 2, 0) == 0 && output(2, 2, 1) == 0);
+
+    math::SetTranscendentalPrecision(math::TranscendentalPrecision::fast);
+    softmaxLayer.Compute();
+    math::SetTranscendentalPrecision(math::TranscendentalPrecision::exact);
+    output = softmaxLayer.GetOutput();
+    testing::ProcessTest("Testing SoftmaxLayer (fast), values", Equals(output(1, 1, 0), 0.0900305733) && Equals(output(1, 1, 1), 0.244728476) && Equals(output(1, 1, 2), 0.665240943));
 }
 
 template <typename ElementType>
@@ -8,6 +8,7 @@
 #include "KMeansTrainer.h"
 
 // math
+#include "MatrixExpression.h"
 #include "Operations.h"
 
 // stl
@@ -79,36 +80,23 @@ namespace trainers
         auto n = X.NumColumns();
         auto k = means.NumColumns();
 
-        math::ColumnMatrix<double> xSq(X.NumRows(), n);
-        math::Operations::ElementWiseMultiply(X, X, xSq);
-
-        math::ColumnMatrix<double> muSq(means.NumRows(), k);
-        math::Operations::ElementWiseMultiply(means, means, muSq);
-
-        math::ColumnMatrix<double> xSqNorm(1, xSq.NumColumns());
-        math::Operations::ColumnWiseSum(xSq, xSqNorm.GetRow(0));
-
-        math::ColumnMatrix<double> muSqNorm(1, muSq.NumColumns());
-        math::Operations::ColumnWiseSum(muSq, muSqNorm.GetRow(0));
-
-        math::RowMatrix<double> onesMultiplier(k, 1);
-        onesMultiplier.Fill(1.0);
-        math::RowMatrix<double> distFactor1(k, n);
-        math::Operations::Multiply(1.0, onesMultiplier, xSqNorm, 0.0, distFactor1);
-
-        math::ColumnMatrix<double> onesMultiplier1 = math::ColumnMatrix<double>(n, 1);
-        onesMultiplier1.Fill(1.0);
-        math::ColumnMatrix<double> distFactor2(n, k);
-        math::Operations::Multiply(1.0, onesMultiplier1, muSqNorm, 0.0, distFactor2);
+        math::ColumnVector<double> xSqNorm(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            xSqNorm[i] = X.GetColumn(i).Norm2Squared();
+        }
 
-        math::RowMatrix<double> muX(n, k);
-        math::Operations::Multiply(1.0, X.Transpose(), means, 1.0, muX);
+        math::RowVector<double> muSqNorm(k);
+        for (size_t j = 0; j < k; ++j)
+        {
+            muSqNorm[j] = means.GetColumn(j).Norm2Squared();
+        }
 
-        math::ColumnMatrix<double> tempD(n, k);
-        math::Operations::Add(1.0, distFactor1.Transpose(), -2.0, muX, tempD);
+        math::RowMatrix<double> distance(n, k);
+        math::Operations::Multiply(-2.0, X.Transpose(), means, 0.0, distance);
 
-        math::ColumnMatrix<double> distance(n, k);
-        math::Operations::Add(1.0, tempD, 1.0, distFactor2, distance);
+        // add the squared norms in a single pass, without materializing them as n x k matrices
+        distance += math::RepeatColumn(xSqNorm, k) + math::RepeatRow(muSqNorm, n);
 
         return distance;
     }
@@ -12,6 +12,7 @@
 #include <cmath>
 
 // math
+#include "MatrixExpression.h"
 #include "Vector.h"
 
 // data
@@ -126,49 +127,28 @@ namespace trainers
         }
 
         // full(sum(B. ^ 2, 1));
-        math::ColumnMatrix<double> bSquare(B.NumRows(), B.NumColumns());
-        math::Operations::ElementWiseMultiply(B, B, bSquare);
-
-        math::ColumnMatrix<double> bColNormSquare(1, bSquare.NumColumns());
-        math::Operations::ColumnWiseSum(bSquare, bColNormSquare.GetRow(0));
-
-        // full(sum(WX. ^ 2, 1));
-        math::ColumnMatrix<double> wxSquare(wx.NumRows(), wx.NumColumns());
-        math::Operations::ElementWiseMultiply(wx, wx, wxSquare);
-
-        math::ColumnMatrix<double> wxColNormSquare(1, wxSquare.NumColumns());
-        math::Operations::ColumnWiseSum(wxSquare, wxColNormSquare.GetRow(0));
-
-        // wxb = (2.0 * gamma * gamma) * WX.transpose() * B;
-        math::RowMatrix<double> wxb(wx.NumColumns(), B.NumColumns());
-        math::Operations::Multiply(2 * gamma * gamma, wx.Transpose(), B, 0.0, wxb);
-
-        // repmat of bColNormSquare and scaling by -gamma * gamma
-        math::RowMatrix<double> gammaSquareCol(end - begin, 1);
-        gammaSquareCol.Fill(-gamma*gamma);
-        math::RowMatrix<double> bColNormSquareResized(gammaSquareCol.NumRows(), bColNormSquare.NumColumns());
-        // S1 = gammaSquareCol * bColSum;
-        math::Operations::Multiply<double>(1, gammaSquareCol, bColNormSquare, 0, bColNormSquareResized);
+        math::RowVector<double> bColNormSquare(B.NumColumns());
+        for (size_t j = 0; j < B.NumColumns(); ++j)
+        {
+            bColNormSquare[j] = B.GetColumn(j).Norm2Squared();
+        }
 
-        // repmat of wxColNormSquare and scaling by -gamma * gamma
-        math::RowMatrix<double> gammaSquareRow(B.NumColumns(), 1);
-        gammaSquareRow.Fill(-gamma*gamma);
-        math::RowMatrix<double> wxColNormSquareResized(gammaSquareRow.NumRows(), wxColNormSquare.NumColumns());
-        // S2 = gammaSquareRow * wxColSum;
-        math::Operations::Multiply<double>(1, gammaSquareRow, wxColNormSquare, 0, wxColNormSquareResized);
+        // full(sum(WX. ^ 2, 1))';
+        math::ColumnVector<double> wxColNormSquare(wx.NumColumns());
+        for (size_t i = 0; i < wx.NumColumns(); ++i)
+        {
+            wxColNormSquare[i] = wx.GetColumn(i).Norm2Squared();
+        }
 
-        // D = wxb + bColNormSquareResized
-        math::RowMatrix<double> similarityMatrix(wxb.NumRows(), wxb.NumColumns());
-        math::Operations::Add(1.0, wxb, 1.0, bColNormSquareResized, similarityMatrix);
+        // D = (2.0 * gamma * gamma) * WX.transpose() * B;
+        math::RowMatrix<double> distance(wx.NumColumns(), B.NumColumns());
+        math::Operations::Multiply(2 * gamma * gamma, wx.Transpose(), B, 0.0, distance);
 
-        // D = D + wxColNormSquareResized'
-        math::RowMatrix<double> distance(similarityMatrix.NumRows(), similarityMatrix.NumColumns());
-        math::Operations::Add(1.0, similarityMatrix, 1.0, wxColNormSquareResized.Transpose(), distance);
+        // D = D - gamma * gamma * (repmat(bColNormSquare) + repmat(wxColNormSquare)), in a single pass over D
+        distance += (-gamma * gamma) * (math::RepeatRow(bColNormSquare, distance.NumRows()) + math::RepeatColumn(wxColNormSquare, distance.NumColumns()));
 
         // similarityMatrix = exp(D)
-        similarityMatrix = ProtoNNTrainerUtils::MatrixExp(distance);
-
-        return similarityMatrix;
+        return ProtoNNTrainerUtils::MatrixExp(distance);
     }
 
     math::ColumnMatrix<double> ProtoNNTrainer::SimilarityKernel(std::map<ProtoNNParameterIndex, std::shared_ptr<ProtoNNModelParameter>> &modelMap, ConstColumnMatrixReference X, math::MatrixReference<double, math::MatrixLayout::columnMajor> WX, const double gamma, bool recomputeWX) const
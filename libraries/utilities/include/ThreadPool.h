@@ -0,0 +1,83 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ThreadPool.h (utilities)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// stl
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ell
+{
+namespace utilities
+{
+    /// <summary>
+    /// A pool of persistent worker threads that execute data-parallel loops. The thread that calls
+    /// ParallelFor participates in the loop, so nested and concurrent calls always make progress.
+    /// </summary>
+    class ThreadPool
+    {
+    public:
+        /// <summary> Constructs a thread pool. </summary>
+        ///
+        /// <param name="numThreads"> The total number of threads that execute a loop, including the calling thread. </param>
+        ThreadPool(size_t numThreads);
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /// <summary> Destructor. Waits for the worker threads to exit. </summary>
+        ~ThreadPool();
+
+        /// <summary> Gets the total number of threads that execute a loop, including the calling thread. </summary>
+        ///
+        /// <returns> The number of threads. </returns>
+        size_t NumThreads() const { return _workers.size() + 1; }
+
+        /// <summary>
+        /// Calls a task once for each index in [0, numTasks) and returns when all of the calls are
+        /// complete. If a task throws, the first exception is rethrown in the calling thread.
+        /// </summary>
+        ///
+        /// <param name="numTasks"> The number of tasks. </param>
+        /// <param name="task"> The task, which takes the task index as its argument. </param>
+        void ParallelFor(size_t numTasks, const std::function<void(size_t)>& task);
+
+    private:
+        struct Job
+        {
+            Job(size_t numTasks, const std::function<void(size_t)>& task);
+
+            size_t numTasks;
+            const std::function<void(size_t)>& task;
+            std::atomic<size_t> nextTask;
+            size_t numCompletedTasks = 0;
+            std::exception_ptr exception;
+            std::mutex mutex;
+            std::condition_variable completed;
+        };
+
+        void RunWorker();
+        static void RunTasks(Job& job);
+
+        std::vector<std::thread> _workers;
+        std::deque<std::shared_ptr<Job>> _jobs;
+        std::mutex _mutex;
+        std::condition_variable _jobAvailable;
+        bool _stop = false;
+    };
+}
+}
@@ -0,0 +1,138 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ThreadPool.cpp (utilities)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ThreadPool.h"
+
+// stl
+#include <algorithm>
+
+namespace ell
+{
+namespace utilities
+{
+    ThreadPool::Job::Job(size_t numTasks, const std::function<void(size_t)>& task)
+        : numTasks(numTasks), task(task), nextTask(0)
+    {
+    }
+
+    ThreadPool::ThreadPool(size_t numThreads)
+    {
+        for (size_t index = 1; index < numThreads; ++index)
+        {
+            _workers.emplace_back([this]() { RunWorker(); });
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _jobAvailable.notify_all();
+
+        for (auto& worker : _workers)
+        {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::ParallelFor(size_t numTasks, const std::function<void(size_t)>& task)
+    {
+        if (_workers.empty() || numTasks <= 1)
+        {
+            for (size_t index = 0; index < numTasks; ++index)
+            {
+                task(index);
+            }
+            return;
+        }
+
+        auto job = std::make_shared<Job>(numTasks, task);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _jobs.push_back(job);
+        }
+        _jobAvailable.notify_all();
+
+        // the calling thread works on its own job until every task has been claimed
+        RunTasks(*job);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto iter = std::find(_jobs.begin(), _jobs.end(), job);
+            if (iter != _jobs.end())
+            {
+                _jobs.erase(iter);
+            }
+        }
+
+        std::unique_lock<std::mutex> jobLock(job->mutex);
+        job->completed.wait(jobLock, [&job]() { return job->numCompletedTasks == job->numTasks; });
+        if (job->exception)
+        {
+            std::rethrow_exception(job->exception);
+        }
+    }
+
+    void ThreadPool::RunWorker()
+    {
+        while (true)
+        {
+            std::shared_ptr<Job> job;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _jobAvailable.wait(lock, [this]() { return _stop || !_jobs.empty(); });
+                if (_stop)
+                {
+                    return;
+                }
+
+                job = _jobs.front();
+                if (job->nextTask >= job->numTasks)
+                {
+                    // every task of this job is already running, so it no longer needs helpers
+                    _jobs.pop_front();
+                    continue;
+                }
+            }
+            RunTasks(*job);
+        }
+    }
+
+    void ThreadPool::RunTasks(Job& job)
+    {
+        while (true)
+        {
+            auto index = job.nextTask++;
+            if (index >= job.numTasks)
+            {
+                return;
+            }
+
+            try
+            {
+                job.task(index);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(job.mutex);
+                if (!job.exception)
+                {
+                    job.exception = std::current_exception();
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(job.mutex);
+            if (++job.numCompletedTasks == job.numTasks)
+            {
+                job.completed.notify_all();
+            }
+        }
+    }
+}
+}
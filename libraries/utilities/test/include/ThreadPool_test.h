@@ -0,0 +1,16 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ThreadPool_test.h (utilities)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+namespace ell
+{
+void TestThreadPoolParallelFor();
+void TestThreadPoolNestedParallelFor();
+void TestThreadPoolException();
+}
@@ -0,0 +1,65 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ThreadPool_test.cpp (utilities)
+//  Authors:  Chuck Jacobs
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ThreadPool_test.h"
+
+// testing
+#include "testing.h"
+
+// utilities
+#include "ThreadPool.h"
+
+// stl
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace ell
+{
+void TestThreadPoolParallelFor()
+{
+    utilities::ThreadPool pool(4);
+    std::vector<int> values(1000, 0);
+    pool.ParallelFor(values.size(), [&values](size_t index) { values[index] = static_cast<int>(index); });
+
+    std::vector<int> expected(values.size());
+    std::iota(expected.begin(), expected.end(), 0);
+    testing::ProcessTest("ThreadPool::ParallelFor", pool.NumThreads() == 4 && values == expected);
+}
+
+void TestThreadPoolNestedParallelFor()
+{
+    utilities::ThreadPool pool(3);
+    std::atomic<int> count(0);
+    pool.ParallelFor(8, [&pool, &count](size_t) {
+        pool.ParallelFor(8, [&count](size_t) { ++count; });
+    });
+    testing::ProcessTest("ThreadPool::ParallelFor nested", count == 64);
+}
+
+void TestThreadPoolException()
+{
+    utilities::ThreadPool pool(2);
+    bool caught = false;
+    try
+    {
+        pool.ParallelFor(10, [](size_t index) {
+            if (index == 5)
+            {
+                throw std::runtime_error("task failed");
+            }
+        });
+    }
+    catch (const std::runtime_error&)
+    {
+        caught = true;
+    }
+    testing::ProcessTest("ThreadPool::ParallelFor exception", caught);
+}
+}
@@ -11,6 +11,7 @@
 #include "IArchivable_test.h"
 #include "Iterator_test.h"
 #include "ObjectArchive_test.h"
+#include "ThreadPool_test.h"
 #include "TypeFactory_test.h"
 #include "TypeName_test.h"
 #include "Variant_test.h"
@@ -44,6 +45,11 @@ int main()
         TestTransformIterator();
         TestParallelTransformIterator();
 
+        // ThreadPool tests
+        TestThreadPoolParallelFor();
+        TestThreadPoolNestedParallelFor();
+        TestThreadPoolException();
+
         // TypeFactory tests
         TypeFactoryTest();
 
@@ -28,6 +28,9 @@
 #include "ModelSaveArguments.h"
 #include "TrainerArguments.h"
 
+// math
+#include "Operations.h"
+
 // model
 #include "DynamicMap.h"
 #include "Model.h"
@@ -66,6 +69,8 @@ int main(int argc, char* argv[])
         // parse command line
         commandLineParser.Parse();
 
+        math::Operations::SetNumThreads(trainerArguments.numThreads);
+
         if (trainerArguments.verbose)
         {
             std::cout << "Sorting Tree Trainer" << std::endl;
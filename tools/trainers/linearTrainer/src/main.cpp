@@ -29,6 +29,9 @@
 #include "ModelSaveArguments.h"
 #include "TrainerArguments.h"
 
+// math
+#include "Operations.h"
+
 // model
 #include "DynamicMap.h"
 #include "Model.h"
@@ -76,6 +79,8 @@ int main(int argc, char* argv[])
         // parse command line
         commandLineParser.Parse();
 
+        math::Operations::SetNumThreads(trainerArguments.numThreads);
+
         if (trainerArguments.verbose)
         {
             std::cout << "Linear Trainer" << std::endl;
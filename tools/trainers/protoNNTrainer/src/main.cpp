@@ -31,6 +31,9 @@
 #include "TrainerArguments.h"
 #include "ProtoNNTrainerArguments.h"
 
+// math
+#include "Operations.h"
+
 // model
 #include "DynamicMap.h"
 #include "InputNode.h"
@@ -78,6 +81,9 @@ int main(int argc, char* argv[])
         // parse command line
         commandLineParser.Parse();
 
+        // let the matrix operations in the trainer's inner loops use multiple cores
+        math::Operations::SetNumThreads(trainerArguments.numThreads);
+
         if (protoNNTrainerArguments.verbose)
         {
             std::cout << "ProtoNN Trainer" << std::endl;
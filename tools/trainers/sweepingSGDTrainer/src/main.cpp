@@ -28,6 +28,9 @@
 #include "ParametersEnumerator.h"
 #include "TrainerArguments.h"
 
+// math
+#include "Operations.h"
+
 // trainers
 #include "EvaluatingTrainer.h"
 #include "SGDTrainer.h"
@@ -70,6 +73,8 @@ int main(int argc, char* argv[])
         // parse command line
         commandLineParser.Parse();
 
+        math::Operations::SetNumThreads(trainerArguments.numThreads);
+
         // manually define regularization parameters to sweep over
         std::vector<double> regularization{ 1.0e-0, 1.0e-1, 1.0e-2, 1.0e-3, 1.0e-4, 1.0e-5, 1.0e-6 };
 
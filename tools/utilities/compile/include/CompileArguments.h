@@ -8,6 +8,9 @@
 
 #pragma once
 
+// emitters
+#include "ModuleEmitter.h"
+
 // utilities
 #include "CommandLineParser.h"
 #include "OutputStreamImpostor.h"
@@ -40,10 +43,15 @@ struct CompileArguments
     // model-generation options
     int maxRefinementIterations = 0;
     bool profile = false;
+    bool reentrant = false;
+    bool emitBatchFunction = false;
 
     // compilation options
     bool optimize = true;
+    emitters::OptimizerLevel optimizerLevel = emitters::OptimizerLevel::O3;
     bool useBlas = false;
+    bool parallelize = false;
+    bool useFastMath = false;
     bool foldLinearOperations = true;
 
     // target machine options
@@ -57,6 +65,7 @@ struct CompileArguments
     std::string targetArchitecture = "";
     std::string targetFeatures = "";
     std::string targetDataLayout = "";
+    std::string functionVariants = ""; // comma-separated list of x86 instruction sets
 };
 
 /// <summary> Parsed command line arguments for the compile executable. </summary>
@@ -104,6 +104,20 @@ void ParsedCompileArguments::AddArgs(utilities::CommandLineParser& parser)
         "Emit profiling code",
         false);
 
+    parser.AddOption(
+        reentrant,
+        "reentrant",
+        "",
+        "Keep the map's buffers and state in a caller-allocated context, passed to the map function as its first argument",
+        false);
+
+    parser.AddOption(
+        emitBatchFunction,
+        "batch",
+        "",
+        "Also emit <function>_batch, which computes the map for an array of examples",
+        false);
+
     parser.AddOption(
         optimize,
         "optimize",
@@ -111,6 +125,14 @@ void ParsedCompileArguments::AddArgs(utilities::CommandLineParser& parser)
         "Optimize output code",
         true);
 
+    parser.AddOption(
+        optimizerLevel,
+        "optimizerLevel",
+        "O",
+        "The level of the optimization pipeline to run, if optimizing",
+        { { "1", emitters::OptimizerLevel::O1 }, { "2", emitters::OptimizerLevel::O2 }, { "3", emitters::OptimizerLevel::O3 }, { "s", emitters::OptimizerLevel::Os } },
+        "3");
+
     parser.AddOption(
         useBlas,
         "blas",
@@ -118,6 +140,20 @@ void ParsedCompileArguments::AddArgs(utilities::CommandLineParser& parser)
         "Emit code that calls BLAS",
         true);
 
+    parser.AddOption(
+        parallelize,
+        "parallelize",
+        "par",
+        "Emit code that runs layer loops on a thread pool (requires ELL_ParallelFor, see ThreadingInterface.h)",
+        false);
+
+    parser.AddOption(
+        useFastMath,
+        "fastMath",
+        "",
+        "Emit polynomial approximations of exp, log, tanh and sigmoid, which can be vectorized, instead of calling the math library",
+        false);
+
     parser.AddOption(
         foldLinearOperations,
         "foldLinearOps",
@@ -170,6 +206,13 @@ void ParsedCompileArguments::AddArgs(utilities::CommandLineParser& parser)
         "A string describing target-specific features to enable or disable (these are LLVM attributes, in the format the llc -mattr option uses)",
         "");
 
+    parser.AddOption(
+        functionVariants,
+        "functionVariants",
+        "",
+        "A comma-separated list of x86 instruction sets (sse4.2, avx2, avx512) to emit variants of the model function for. The best variant the CPU supports is picked at runtime, falling back to code for the target options above",
+        "");
+
     parser.AddDocumentationString("");
     parser.AddDocumentationString("Misc options");
     parser.AddOption(
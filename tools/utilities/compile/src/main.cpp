@@ -128,8 +128,13 @@ void ProduceMapOutput(ParsedCompileArguments& compileArguments, common::MapLoadA
     settings.moduleName = namespacePrefix;
     settings.mapFunctionName = functionName;
     settings.compilerSettings.useBlas = compileArguments.useBlas;
+    settings.compilerSettings.parallelize = compileArguments.parallelize;
+    settings.compilerSettings.useFastMath = compileArguments.useFastMath;
     settings.compilerSettings.optimize = compileArguments.optimize;
+    settings.compilerSettings.optimizerLevel = compileArguments.optimizerLevel;
     settings.profile = compileArguments.profile;
+    settings.reentrant = compileArguments.reentrant;
+    settings.emitBatchFunction = compileArguments.emitBatchFunction;
 
     if (compileArguments.target != "")
     {
@@ -156,6 +161,16 @@ void ProduceMapOutput(ParsedCompileArguments& compileArguments, common::MapLoadA
         settings.compilerSettings.targetDevice.numBits = compileArguments.numBits;
     }
 
+    std::stringstream functionVariantsStream(compileArguments.functionVariants);
+    std::string functionVariant;
+    while (std::getline(functionVariantsStream, functionVariant, ','))
+    {
+        if (functionVariant != "")
+        {
+            settings.functionVariants.push_back(functionVariant);
+        }
+    }
+
     if (compileArguments.outputRefinedMap)
     {
         model::TransformContext context;
@@ -88,6 +88,7 @@ function(generate_ell_model_compile_target model_name arch_name target_name demo
         COMMAND ${CMAKE_COMMAND} -E copy_if_different ${ell_root}interfaces/common/include/CallbackInterface.h ${target_path}/include/CallbackInterface.h
         COMMAND ${CMAKE_COMMAND} -E copy_if_different ${ell_root}interfaces/common/tcc/CallbackInterface.tcc ${target_path}/tcc/CallbackInterface.tcc
         COMMAND ${CMAKE_COMMAND} -E copy_if_different ${ell_root}libraries/emitters/include/ClockInterface.h ${target_path}/include/ClockInterface.h
+        COMMAND ${CMAKE_COMMAND} -E copy_if_different ${ell_root}libraries/emitters/include/ThreadingInterface.h ${target_path}/include/ThreadingInterface.h
         COMMENT "Generating SWIG wrappers for ${model_name}")
 
     # configure CMake files for compiling on the target